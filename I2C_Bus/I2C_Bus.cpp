@@ -0,0 +1,229 @@
+/**
+ * FILENAME :        I2C_Bus.cpp
+ *
+ * DESCRIPTION :
+ *       I2C_Bus / Shared I2C bus with a queue of asynchronous transactions.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "I2C_Bus.h"
+
+/**************************************************************
+ *	Transactions
+ **************************************************************/
+
+I2C_Transaction::I2C_Transaction(void){
+    this->address = 0;
+    this->frequency = I2C_BUS_FREQ;
+    this->priority = I2C_BUS_PRIORITY_NORMAL;
+    this->tx_data = NULL;
+    this->tx_length = 0;
+    this->rx_data = NULL;
+    this->rx_length = 0;
+    this->context = NULL;
+    this->result = I2C_BUS_OK;
+    this->next = NULL;
+}
+
+void        I2C_Transaction::setDevice(int address, int frequency, uint8_t priority){
+    this->address = address;
+    this->frequency = frequency;
+    this->priority = priority;
+}
+
+void        I2C_Transaction::setData(const char *tx_data, int tx_length, char *rx_data, int rx_length){
+    this->tx_data = tx_data;
+    this->tx_length = tx_length;
+    this->rx_data = rx_data;
+    this->rx_length = rx_length;
+}
+
+bool        I2C_Transaction::isPending(void){
+    return (this->result == I2C_BUS_PENDING);
+}
+
+/**************************************************************
+ *	Bus
+ **************************************************************/
+
+I2C_Bus::I2C_Bus(PinName sda, PinName scl) : __i2c(sda, scl){
+    this->__frequency = I2C_BUS_FREQ;
+    this->__i2c.frequency(this->__frequency);
+    this->__first = NULL;
+    this->__current = NULL;
+    this->__busy = false;
+    this->__event = 0;
+    this->__errors = 0;
+}
+
+bool        I2C_Bus::submit(I2C_Transaction *t){
+    CriticalSectionLock lock;
+    if(t->result == I2C_BUS_PENDING){ return false; }
+    t->result = I2C_BUS_PENDING;
+    // after the transactions of the same or of a higher priority
+    I2C_Transaction **p = &this->__first;
+    while((*p != NULL) && ((*p)->priority >= t->priority)){
+        p = &(*p)->next;
+    }
+    t->next = *p;
+    *p = t;
+    if(!this->__busy){
+        this->__busy = (mbed_event_queue()->call(callback(this, &I2C_Bus::startNext)) != 0);
+    }
+    return true;
+}
+
+bool        I2C_Bus::cancel(I2C_Transaction *t){
+    {
+        CriticalSectionLock lock;
+        if(t->result != I2C_BUS_PENDING){ return false; }
+        for(I2C_Transaction **p = &this->__first; *p != NULL; p = &(*p)->next){
+            if(*p == t){
+                *p = t->next;
+                t->next = NULL;
+                t->result = I2C_BUS_TIMEOUT;
+                return true;
+            }
+        }
+        if((t != this->__current) || (this->__event != 0)){
+            // end of transfer already signaled : endTransfer will call done
+            return false;
+        }
+        // detached : ISR_transfer ignores the end of this transfer
+        this->__current = NULL;
+        this->__event = I2C_EVENT_ERROR;
+        t->result = I2C_BUS_TIMEOUT;
+    }
+    // outside of the critical section : abort_transfer takes the mutex of the I2C interface
+    this->__i2c.abort_transfer();
+    // endTransfer only starts the next transaction
+    mbed_event_queue()->call(callback(this, &I2C_Bus::endTransfer));
+    return true;
+}
+
+int         I2C_Bus::getPending(void){
+    CriticalSectionLock lock;
+    int cnt = 0;
+    for(I2C_Transaction *t = this->__first; t != NULL; t = t->next){
+        cnt++;
+    }
+    return cnt;
+}
+
+uint32_t    I2C_Bus::getErrors(void){
+    return this->__errors;
+}
+
+/**************************************************************
+ *	Transfers
+ **************************************************************/
+
+void        I2C_Bus::startNext(void){
+    I2C_Transaction *t;
+    {
+        CriticalSectionLock lock;
+        t = this->__first;
+        if(t == NULL){
+            this->__busy = false;
+            return;
+        }
+        this->__first = t->next;
+        t->next = NULL;
+        this->__current = t;
+        this->__event = 0;
+    }
+    // clock of the device - only when it changes
+    if(t->frequency != this->__frequency){
+        this->__frequency = t->frequency;
+        this->__i2c.frequency(this->__frequency);
+    }
+    int ret = this->__i2c.transfer(t->address, t->tx_data, t->tx_length,
+            t->rx_data, t->rx_length, callback(this, &I2C_Bus::ISR_transfer),
+            I2C_EVENT_ALL, false);
+    if(ret != 0){
+        this->__event = I2C_EVENT_ERROR;
+        mbed_event_queue()->call(callback(this, &I2C_Bus::endTransfer));
+    }
+}
+
+void        I2C_Bus::ISR_transfer(int event){
+    // transaction cancelled : endTransfer is already called by cancel
+    if(this->__current == NULL){ return; }
+    this->__event = event;
+    mbed_event_queue()->call(callback(this, &I2C_Bus::endTransfer));
+}
+
+void        I2C_Bus::endTransfer(void){
+    I2C_Transaction *t;
+    {
+        CriticalSectionLock lock;
+        t = this->__current;
+        this->__current = NULL;
+    }
+    // transaction cancelled during its transfer
+    if(t == NULL){
+        this->startNext();
+        return;
+    }
+    if(this->__event & (I2C_EVENT_ERROR | I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)){
+        this->__errors++;
+        t->result = I2C_BUS_ERROR;
+    }
+    else{
+        t->result = I2C_BUS_OK;
+    }
+    // t can be submitted again or destroyed by its done function
+    Callback<void(I2C_Transaction *t)>  done = t->done;
+    if(done){ done(t); }
+    this->startNext();
+}
+
+/**************************************************************
+ *	Blocking transactions
+ **************************************************************/
+
+void        I2C_Bus::syncDone(I2C_Transaction *t){
+    ((Semaphore *)t->context)->release();
+}
+
+int         I2C_Bus::transferSync(I2C_Transaction *t){
+    Semaphore   end(0);
+    t->context = &end;
+    t->done = callback(&I2C_Bus::syncDone);
+    if(!this->submit(t)){ return I2C_BUS_ERROR; }
+    if(!end.try_acquire_for(I2C_BUS_SYNC_TIMEOUT)){
+        // t and its buffers are on the stack of the caller
+        if(this->cancel(t)){ return I2C_BUS_TIMEOUT; }
+        // done is being called by endTransfer
+        end.acquire();
+    }
+    return t->result;
+}
+
+int         I2C_Bus::write(int address, const char *data, int length, int frequency, uint8_t priority){
+    I2C_Transaction t;
+    t.setDevice(address, frequency, priority);
+    t.setData(data, length);
+    return this->transferSync(&t);
+}
+
+int         I2C_Bus::read(int address, char *data, int length, int frequency, uint8_t priority){
+    I2C_Transaction t;
+    t.setDevice(address, frequency, priority);
+    t.setData(NULL, 0, data, length);
+    return this->transferSync(&t);
+}
+
+int         I2C_Bus::readRegister(int address, uint8_t reg, char *data, int length, int frequency, uint8_t priority){
+    char        cmd = (char)reg;
+    I2C_Transaction t;
+    t.setDevice(address, frequency, priority);
+    t.setData(&cmd, 1, data, length);
+    return this->transferSync(&t);
+}
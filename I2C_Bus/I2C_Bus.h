@@ -0,0 +1,241 @@
+/**
+ * FILENAME :        I2C_Bus.h
+ *
+ * DESCRIPTION :
+ *       I2C_Bus / Shared I2C bus with a queue of asynchronous transactions.
+ *
+ *       The bus owns the I2C peripheral. Each driver submits transactions
+ *  (write, read, or register read : write then read with a repeated
+ *  start) with its own clock frequency and a priority. Transactions are
+ *  sent one after the other by the asynchronous transfers of MBED OS :
+ *  a display refresh can be interleaved with the reading of sensors
+ *  without waiting in the caller thread.
+ *
+ *       The end of a transfer is an interrupt : the completion callback
+ *  of the transaction and the start of the next transaction are deferred
+ *  to the shared event queue (I2C::frequency and I2C::transfer lock a
+ *  mutex and can not be called from an interrupt routine).
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __I2C_BUS_HEADER_H__
+#define __I2C_BUS_HEADER_H__
+
+#include <cstdint>
+#include <mbed.h>
+
+/** Constant definition */
+/// Default frequency of the bus
+#define     I2C_BUS_FREQ                100000
+/// Priority of the transactions - higher first
+#define     I2C_BUS_PRIORITY_LOW        0
+#define     I2C_BUS_PRIORITY_NORMAL     1
+#define     I2C_BUS_PRIORITY_HIGH       2
+/// Result of a transaction
+#define     I2C_BUS_OK                  0
+#define     I2C_BUS_PENDING             -1
+#define     I2C_BUS_ERROR               -2
+#define     I2C_BUS_TIMEOUT             -3
+/// Longest wait of a blocking transaction (queue and transfer)
+#define     I2C_BUS_SYNC_TIMEOUT        500ms
+
+/**
+ * @class I2C_Transaction
+ * @brief Transaction on the bus - owned by the driver
+ * @details The object and its buffers must remain valid until the end
+ *  of the transaction (usually a member of the driver class).
+ */
+class I2C_Transaction{
+    public:
+        /// 8 bits address of the device (7 bits address << 1)
+        int         address;
+        /// Clock frequency of the device
+        int         frequency;
+        /// Priority of the transaction
+        uint8_t     priority;
+        /// Data to write - NULL if none
+        const char  *tx_data;
+        int         tx_length;
+        /// Buffer for the read data - NULL if none
+        char        *rx_data;
+        int         rx_length;
+        /// Function called at the end of the transaction - in the event queue
+        Callback<void(I2C_Transaction *t)>  done;
+        /// Data of the driver, for the done function
+        void        *context;
+        /// Result : I2C_BUS_OK, I2C_BUS_PENDING, I2C_BUS_ERROR or I2C_BUS_TIMEOUT
+        volatile int    result;
+        /// Next transaction in the queue
+        I2C_Transaction *next;
+
+        /**
+        * @brief Simple constructor of the I2C_Transaction class.
+        */
+        I2C_Transaction(void);
+
+        /**
+        * @brief Set the device of the transaction.
+        * @param address 8 bits address of the device
+        * @param frequency clock frequency of the device
+        * @param priority priority of the transaction
+        */
+        void        setDevice(int address, int frequency = I2C_BUS_FREQ,
+                            uint8_t priority = I2C_BUS_PRIORITY_NORMAL);
+
+        /**
+        * @brief Set the data of the transaction.
+        * @param tx_data data to write - NULL if none
+        * @param tx_length number of bytes to write
+        * @param rx_data buffer for the read data - NULL if none
+        * @param rx_length number of bytes to read
+        */
+        void        setData(const char *tx_data, int tx_length,
+                            char *rx_data = NULL, int rx_length = 0);
+
+        /**
+        * @brief Return true if the transaction is waiting or in progress.
+        */
+        bool        isPending(void);
+};
+
+/**
+ * @class I2C_Bus
+ * @brief Shared I2C bus with a priority queue of transactions
+ * @details     submit() can be called from a thread or an interrupt
+ *  routine. The blocking functions (write, read, readRegister) wait for
+ *  the end of their transaction, at most I2C_BUS_SYNC_TIMEOUT : they
+ *  must not be called from an interrupt routine or from the shared
+ *  event queue.
+ */
+class I2C_Bus{
+    private:
+        /// I2C interface
+        I2C         __i2c;
+        /// Current frequency of the interface
+        int         __frequency;
+        /// First transaction of the queue
+        I2C_Transaction     *__first;
+        /// Transaction in progress - NULL if none
+        I2C_Transaction     *volatile __current;
+        /// True when a transaction is in progress or scheduled
+        volatile bool       __busy;
+        /// Event of the last transfer
+        volatile int        __event;
+        /// Number of transactions ended with an error
+        volatile uint32_t   __errors;
+
+        /**
+        * @brief Start the first transaction of the queue - thread context.
+        */
+        void        startNext(void);
+
+        /**
+        * @brief End of transfer event - from interrupt.
+        */
+        void        ISR_transfer(int event);
+
+        /**
+        * @brief End of the current transaction - thread context.
+        */
+        void        endTransfer(void);
+
+        /**
+        * @brief Submit a transaction and wait for its end.
+        * @details After I2C_BUS_SYNC_TIMEOUT, the transaction is removed
+        *   from the queue or its transfer is aborted.
+        * @return I2C_BUS_OK, I2C_BUS_ERROR or I2C_BUS_TIMEOUT.
+        */
+        int         transferSync(I2C_Transaction *t);
+
+        /**
+        * @brief Done function of the blocking transactions.
+        */
+        static void syncDone(I2C_Transaction *t);
+
+    public:
+        /**
+        * @brief Simple constructor of the I2C_Bus class.
+        * @param sda SDA pin of the bus
+        * @param scl SCL pin of the bus
+        */
+        I2C_Bus(PinName sda, PinName scl);
+
+        /**
+        * @brief Add a transaction to the queue.
+        * @details The transaction is inserted after the transactions
+        *   of the same or of a higher priority.
+        * @param t transaction to add
+        * @return false if the transaction is already in the queue.
+        */
+        bool        submit(I2C_Transaction *t);
+
+        /**
+        * @brief Remove a transaction from the queue, or abort its transfer.
+        * @details The done function of the transaction is not called.
+        *   Not from an interrupt routine : aborting a transfer takes the
+        *   mutex of the I2C interface.
+        * @param t transaction to cancel
+        * @return false if the transaction is already ended or its end
+        *   is being processed (the done function is called).
+        */
+        bool        cancel(I2C_Transaction *t);
+
+        /**
+        * @brief Write data to a device - blocking.
+        * @param address 8 bits address of the device
+        * @param data data to write
+        * @param length number of bytes to write
+        * @param frequency clock frequency of the device
+        * @param priority priority of the transaction
+        * @return I2C_BUS_OK, I2C_BUS_ERROR or I2C_BUS_TIMEOUT.
+        */
+        int         write(int address, const char *data, int length,
+                            int frequency = I2C_BUS_FREQ,
+                            uint8_t priority = I2C_BUS_PRIORITY_NORMAL);
+
+        /**
+        * @brief Read data from a device - blocking.
+        * @param address 8 bits address of the device
+        * @param data buffer for the read data
+        * @param length number of bytes to read
+        * @param frequency clock frequency of the device
+        * @param priority priority of the transaction
+        * @return I2C_BUS_OK, I2C_BUS_ERROR or I2C_BUS_TIMEOUT.
+        */
+        int         read(int address, char *data, int length,
+                            int frequency = I2C_BUS_FREQ,
+                            uint8_t priority = I2C_BUS_PRIORITY_NORMAL);
+
+        /**
+        * @brief Read registers of a device - blocking.
+        * @details Write the register address, then read with a repeated start.
+        * @param address 8 bits address of the device
+        * @param reg register address
+        * @param data buffer for the read data
+        * @param length number of bytes to read
+        * @param frequency clock frequency of the device
+        * @param priority priority of the transaction
+        * @return I2C_BUS_OK, I2C_BUS_ERROR or I2C_BUS_TIMEOUT.
+        */
+        int         readRegister(int address, uint8_t reg, char *data, int length,
+                            int frequency = I2C_BUS_FREQ,
+                            uint8_t priority = I2C_BUS_PRIORITY_NORMAL);
+
+        /**
+        * @brief Return the number of transactions waiting in the queue.
+        */
+        int         getPending(void);
+
+        /**
+        * @brief Return the number of transactions ended with an error.
+        */
+        uint32_t    getErrors(void);
+};
+
+#endif
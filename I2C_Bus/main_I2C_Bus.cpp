@@ -0,0 +1,80 @@
+/**
+ * FILENAME :        main_I2C_Bus.cpp
+ *
+ * DESCRIPTION :
+ *       I2C_Bus / Program for testing the shared I2C bus.
+ *
+ *       A SSD1306 OLED display (100 kHz, low priority) and a TCS34725
+ *  RGB sensor (400 kHz, high priority) share the same bus. The sensor
+ *  is read every 50 ms by an asynchronous transaction submitted from
+ *  a Ticker interrupt, while the main thread refreshes the display :
+ *  the readings are interleaved between the blocks of the display.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "mbed.h"
+#include "I2C_Bus.h"
+#include "ssd1306.h"
+
+/// TCS34725 sensor
+#define     TCS_ADDRESS     (0x29 << 1)
+#define     TCS_FREQ        400000
+#define     TCS_CMD_BIT     0x80
+#define     TCS_ENABLE      0x00
+#define     TCS_CDATAL      0x14
+
+I2C_Bus     my_bus(D14, D15);
+SSD1306     my_lcd(&my_bus, MAX_X, MAX_Y);
+Ticker      my_tik;
+
+/// Asynchronous reading of the sensor
+I2C_Transaction     tcs_read;
+char        tcs_reg = (char)(TCS_CMD_BIT | TCS_CDATAL);
+char        tcs_data[8];
+volatile uint16_t   tcs_clear = 0;
+volatile int        tcs_cnt = 0;
+
+// End of the reading - in the event queue
+void tcs_done(I2C_Transaction *t){
+    if(t->result == I2C_BUS_OK){
+        tcs_clear = (tcs_data[1] << 8) | tcs_data[0];
+        tcs_cnt++;
+    }
+}
+
+void ISR_tik(void){
+    // false if the previous reading is not ended
+    my_bus.submit(&tcs_read);
+}
+
+int main()
+{
+    char    str[32];
+    char    cmd[2] = {(char)(TCS_CMD_BIT | TCS_ENABLE), 0x03};   // power on, RGBC enable
+
+    my_bus.write(TCS_ADDRESS, cmd, 2, TCS_FREQ);
+    tcs_read.setDevice(TCS_ADDRESS, TCS_FREQ, I2C_BUS_PRIORITY_HIGH);
+    tcs_read.setData(&tcs_reg, 1, tcs_data, 8);
+    tcs_read.done = callback(&tcs_done);
+
+    my_lcd.init();
+    my_lcd.clear_screen();
+    my_tik.attach(&ISR_tik, 50ms);
+
+    while (true)
+    {
+        sprintf(str, "C = %5d / %d", tcs_clear, tcs_cnt);
+        my_lcd.fill_rect(0, 20, MAX_X, 8, SSD1306_BLACK);
+        my_lcd.set_position(0, 20);
+        my_lcd.draw_string(str, SSD1306_WHITE, NORMAL);
+        my_lcd.display();
+        printf("Errors = %d\r\n", (int)my_bus.getErrors());
+        thread_sleep_for(200);
+    }
+}
@@ -17,6 +17,29 @@
 #include <mbed.h>
  #include "LCD_EA_DOG.h"
 
+/// Glyphs of the big digits : top bar, bottom bar, both, full block
+static const uint8_t big_glyphs[4][8] = {
+    {0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F},
+    {0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F},
+    {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}
+};
+/// Big digits : 3 characters of the first line, then of the second line
+/// 0 : space, 1 to 4 : glyphs of big_glyphs
+static const uint8_t big_digits[11][6] = {
+    {4, 1, 4, 4, 2, 4},   // 0
+    {0, 0, 4, 0, 0, 4},   // 1
+    {3, 3, 4, 4, 2, 2},   // 2
+    {3, 3, 4, 2, 2, 4},   // 3
+    {4, 2, 4, 0, 0, 4},   // 4
+    {4, 3, 3, 2, 2, 4},   // 5
+    {4, 3, 3, 4, 2, 4},   // 6
+    {1, 1, 4, 0, 0, 4},   // 7
+    {4, 3, 4, 4, 2, 4},   // 8
+    {4, 3, 4, 2, 2, 4},   // 9
+    {2, 2, 2, 0, 0, 0}    // -
+};
+
 
 /****************************************************************/
 LCD_EA_DOG::LCD_EA_DOG(PinName rs, PinName cs, SPI *spi, int freq, uint8_t nb_lines, uint8_t nb_chars): 
@@ -24,36 +47,97 @@ LCD_EA_DOG::LCD_EA_DOG(PinName rs, PinName cs, SPI *spi, int freq, uint8_t nb_li
     this->_frequency = freq;
     this->_nb_lines = nb_lines;
     this->_nb_chars = nb_chars;
+    /* Shadow buffer - empty screen */
+    this->__shadow.assign(nb_lines * nb_chars, ' ');
+    this->__sent.assign(nb_lines * nb_chars, ' ');
+    this->__sent_valid = false;
+    this->__cgram_tick = 0;
+    this->__cgram_valid = 0;
+    this->__cgram_dirty = 0;
     /* Initialisation of the SPI connection */
     if (spi){ delete this->__spi; }
     this->__spi=spi;
     this->__spi->frequency(this->_frequency);
     this->__spi->format(8, 3);      // 8 bits, mode 3
+    this->__dev = NULL;
     /* Initialisation of RS and CS pin */
     this->__rs.write(1);
     this->__cs.write(1);
     thread_sleep_for(10);      // 10 ms
 }
 
+LCD_EA_DOG::LCD_EA_DOG(PinName rs, SPI_Device *dev, int freq, uint8_t nb_lines, uint8_t nb_chars): 
+    __cs(NC), __rs(rs){
+    this->_frequency = freq;
+    this->_nb_lines = nb_lines;
+    this->_nb_chars = nb_chars;
+    /* Shadow buffer - empty screen */
+    this->__shadow.assign(nb_lines * nb_chars, ' ');
+    this->__sent.assign(nb_lines * nb_chars, ' ');
+    this->__sent_valid = false;
+    this->__cgram_tick = 0;
+    this->__cgram_valid = 0;
+    this->__cgram_dirty = 0;
+    /* Shared SPI bus - Chip Select pin is driven by the device */
+    this->__spi = NULL;
+    this->__dev = dev;
+    this->__dev->setFormat(8, 3, freq);     // 8 bits, mode 3
+    this->__rs.write(1);
+    thread_sleep_for(10);      // 10 ms
+}
+
+/****************************************************************/
+void LCD_EA_DOG::select(void){
+    if(this->__dev){ this->__dev->select(); }
+    else{ this->__cs.write(0); }
+}
+
+void LCD_EA_DOG::deselect(void){
+    if(this->__dev){ this->__dev->deselect(); }
+    else{ this->__cs.write(1); }
+}
+
+void LCD_EA_DOG::spiWrite(char c){
+    if(this->__dev){ this->__dev->write(c); }
+    else{ this->__spi->write(c); }
+    // next byte before the end of the execution of this one
+    if(this->_frequency > LCD_DOG_BURST_FREQ){ wait_us(LCD_DOG_EXEC_TIME_US); }
+}
+
+void LCD_EA_DOG::spiWrite(const char *c, int length){
+    if(this->_frequency > LCD_DOG_BURST_FREQ){
+        // too fast for the driver : one byte per execution time
+        for(int k = 0; k < length; k++){ this->spiWrite(c[k]); }
+        return;
+    }
+    if(this->__dev){ this->__dev->write(c, length, NULL, 0); }
+    else{ this->__spi->write(c, length, NULL, 0); }
+}
+
 /****************************************************************/
 void LCD_EA_DOG::initLCD(void){
     this->__rs.write(0);
-    this->__cs.write(0);
+    this->select();
     thread_sleep_for(10);       // 10 ms
-    this->__spi->write(0x29);   // Function Set - table 1
-    this->__spi->write(0x1D);   // Bias Set
-    this->__spi->write(0x50);   // Power Control
-    this->__spi->write(0x6C);   // Follower Control
-    this->__spi->write(0x78);   // Contrast Set
-    this->__spi->write(0x03);   // Function Set - table 0
-    this->__spi->write(0x0F);   
-    this->__spi->write(0x01);   // Clear Display
+    this->spiWrite(0x29);   // Function Set - table 1
+    this->spiWrite(0x1D);   // Bias Set
+    this->spiWrite(0x50);   // Power Control
+    this->spiWrite(0x6C);   // Follower Control
+    this->spiWrite(0x78);   // Contrast Set
+    this->spiWrite(0x03);   // Function Set - table 0
+    this->spiWrite(0x0F);   
+    this->spiWrite(0x01);   // Clear Display
     thread_sleep_for(2);        // 2 ms
-    this->__spi->write(0x06);   // Display On
+    this->spiWrite(0x06);   // Display On
     thread_sleep_for(10);       // 10 ms
     this->__rs.write(1);
-    this->__cs.write(1);
+    this->deselect();
     thread_sleep_for(10);       // 10 ms
+    // DDRAM filled with spaces by Clear Display
+    std::fill(this->__sent.begin(), this->__sent.end(), ' ');
+    this->__sent_valid = true;
+    // CGRAM : the loaded glyphs are sent again
+    this->__cgram_dirty = this->__cgram_valid;
 
     /*
     writeLCD('_');
@@ -64,20 +148,20 @@ void LCD_EA_DOG::initLCD(void){
 
 void LCD_EA_DOG::display_off(void){
     this->__rs.write(0);
-    this->__cs.write(0);
-    this->__spi->write(0x08);  // Display Off
+    this->select();
+    this->spiWrite(0x08);  // Display Off
     thread_sleep_for(2);       // 10 ms
     this->__rs.write(1);
-    this->__cs.write(1);
+    this->deselect();
 }
 
 void LCD_EA_DOG::display_on(void){
     this->__rs.write(0);
-    this->__cs.write(0);
-    this->__spi->write(0x0F);  // Display On
+    this->select();
+    this->spiWrite(0x0F);  // Display On
     thread_sleep_for(2);       // 10 ms
     this->__rs.write(1);
-    this->__cs.write(1);
+    this->deselect();
 }
 
 bool LCD_EA_DOG::set_contrast(uint8_t val){
@@ -86,33 +170,36 @@ bool LCD_EA_DOG::set_contrast(uint8_t val){
     }
     uint8_t contrast = 0x78 + val;
     this->__rs.write(0);
-    this->__cs.write(0);
-    this->__spi->write(contrast);   // Contrast Set
+    this->select();
+    this->spiWrite(contrast);   // Contrast Set
     thread_sleep_for(2);       // 10 ms
     this->__rs.write(1);
-    this->__cs.write(1);
+    this->deselect();
     return true;
 }
  
 /****************************************************************/
 void LCD_EA_DOG::clearLCD(void){
     this->__rs.write(0);
-    this->__cs.write(0);
-    this->__spi->write(0x01);   // Clear Display
+    this->select();
+    this->spiWrite(0x01);   // Clear Display
     thread_sleep_for(2);        // 2 ms
     this->__rs.write(1);
-    this->__cs.write(1); 
+    this->deselect(); 
+    std::fill(this->__shadow.begin(), this->__shadow.end(), ' ');
+    std::fill(this->__sent.begin(), this->__sent.end(), ' ');
+    this->__sent_valid = true;
     return;
 }
 
 /****************************************************************/
 void LCD_EA_DOG::writeCmdLCD(char c){
     this->__rs.write(0);
-    this->__cs.write(0);
-    this->__spi->write(c);   // Send command
+    this->select();
+    this->spiWrite(c);   // Send command
     thread_sleep_for(1);     // 1 ms
     this->__rs.write(1);
-    this->__cs.write(1); 
+    this->deselect(); 
     return;
 }
 
@@ -120,35 +207,29 @@ void LCD_EA_DOG::writeCmdLCD(char c){
 /****************************************************************/
 void LCD_EA_DOG::writeLCD(char c){
     this->__rs.write(1);
-    this->__cs.write(0);
-    this->__spi->write(c);   // Send char
+    this->select();
+    this->spiWrite(c);   // Send char
     thread_sleep_for(1);     // 1 ms
-    this->__cs.write(1);
+    this->deselect();
+    // position of the cursor unknown
+    this->__sent_valid = false;
     return;
 }
 
 /****************************************************************/
 bool LCD_EA_DOG::writeStrLCD(char c[], char line, char col){
-    char i = 0;
-    bool pos = setPosition(line, col);
+    bool pos = this->setStrLCD(c, line, col);
     if(pos){
-        while(c[i] != '\0'){
-            writeLCD(c[i]);
-            i++;
-        }
+        this->flush();
     }
     return pos;
 }
 
 /****************************************************************/
 bool LCD_EA_DOG::writeCstStrLCD(const char c[], char line, char col){
-    char i = 0;
-    bool pos = setPosition(line, col);
+    bool pos = this->setStrLCD(c, line, col);
     if(pos){
-        while(c[i] != '\0'){
-            writeLCD(c[i]);
-            i++;
-        }
+        this->flush();
     }
     return pos;
 }
@@ -165,4 +246,246 @@ bool LCD_EA_DOG::setPosition(uint8_t line, uint8_t col){
     this->writeCmdLCD(adress);
     thread_sleep_for(1);        // 1 ms
     return true;
-}
\ No newline at end of file
+}
+
+/****************************************************************/
+bool LCD_EA_DOG::setStrLCD(const char c[], uint8_t line, uint8_t col){
+    if((line <= 0) || (line > this->_nb_lines)){
+        return false;
+    }
+    if((col <= 0) || (col > this->_nb_chars)){
+        return false;
+    }
+    char *dst = &this->__shadow[(line-1) * this->_nb_chars];
+    uint8_t i = 0;
+    while((c[i] != '\0') && (col - 1 + i < this->_nb_chars)){
+        dst[col - 1 + i] = c[i];
+        i++;
+    }
+    return true;
+}
+
+/****************************************************************/
+int LCD_EA_DOG::flush(void){
+    int cnt = 0;
+    // new glyphs first
+    for(uint8_t slot = 0; slot < LCD_DOG_CGRAM_SLOTS; slot++){
+        if(this->__cgram_dirty & (1 << slot)){
+            this->writeGlyphLCD(slot);
+        }
+    }
+    this->__cgram_dirty = 0;
+    for(uint8_t line = 0; line < this->_nb_lines; line++){
+        const char *shadow = &this->__shadow[line * this->_nb_chars];
+        char *sent = &this->__sent[line * this->_nb_chars];
+        int col = 0;
+        while(col < this->_nb_chars){
+            // first changed character
+            if(this->__sent_valid && (shadow[col] == sent[col])){
+                col++;
+                continue;
+            }
+            // end of the run - short gaps of unchanged characters are sent again
+            int end = col + 1;
+            int last = col;
+            while((end < this->_nb_chars) && (end - last <= LCD_DOG_MERGE_GAP + 1)){
+                if(!this->__sent_valid || (shadow[end] != sent[end])){ last = end; }
+                end++;
+            }
+            int length = last - col + 1;
+            this->writeRunLCD(line * LCD_DOG_LINE_OFFSET + col, &shadow[col], length);
+            memcpy(&sent[col], &shadow[col], length);
+            cnt += length;
+            col = last + 1;
+        }
+    }
+    this->__sent_valid = true;
+    return cnt;
+}
+
+/****************************************************************/
+void LCD_EA_DOG::writeRunLCD(uint8_t address, const char *c, int length){
+    // Set DDRAM address
+    this->__rs.write(0);
+    this->select();
+    this->spiWrite(LCD_DOG_SET_DDRAM | address);
+    this->deselect();
+    // Characters in one burst - 80 us per byte at 100 kHz, longer than
+    // the execution time of the driver (split above LCD_DOG_BURST_FREQ)
+    this->__rs.write(1);
+    this->select();
+    this->spiWrite(c, length);
+    this->deselect();
+}
+
+/****************************************************************/
+void LCD_EA_DOG::writeGlyphLCD(uint8_t slot){
+    // CGRAM address - instruction table 0
+    this->__rs.write(0);
+    this->select();
+    this->spiWrite(LCD_DOG_FUNCTION_IS0);
+    this->spiWrite(LCD_DOG_SET_CGRAM | (slot << 3));
+    this->deselect();
+    // 8 lines of the glyph
+    this->__rs.write(1);
+    this->select();
+    this->spiWrite((const char *)this->__cgram[slot], 8);
+    this->deselect();
+    // back to instruction table 1 (contrast...)
+    this->__rs.write(0);
+    this->select();
+    this->spiWrite(LCD_DOG_FUNCTION_IS1);
+    this->deselect();
+    this->__rs.write(1);
+}
+
+/****************************************************************/
+int LCD_EA_DOG::loadGlyphLCD(const uint8_t pattern[8]){
+    this->__cgram_tick++;
+    // already loaded
+    for(uint8_t slot = 0; slot < LCD_DOG_CGRAM_SLOTS; slot++){
+        if((this->__cgram_valid & (1 << slot)) && (memcmp(this->__cgram[slot], pattern, 8) == 0)){
+            this->__cgram_use[slot] = this->__cgram_tick;
+            return LCD_DOG_CGRAM_CODE + slot;
+        }
+    }
+    // slots in the shadow buffer can not be replaced
+    uint8_t used = 0;
+    for(size_t k = 0; k < this->__shadow.size(); k++){
+        uint8_t c = this->__shadow[k];
+        if(c < 2 * LCD_DOG_CGRAM_SLOTS){ used |= 1 << (c % LCD_DOG_CGRAM_SLOTS); }
+    }
+    // free slot, or least recently used slot
+    int victim = -1;
+    for(uint8_t slot = 0; slot < LCD_DOG_CGRAM_SLOTS; slot++){
+        if(used & (1 << slot)){ continue; }
+        if(!(this->__cgram_valid & (1 << slot))){
+            victim = slot;
+            break;
+        }
+        if((victim < 0) || (this->__cgram_use[slot] < this->__cgram_use[victim])){
+            victim = slot;
+        }
+    }
+    if(victim < 0){
+        return -1;
+    }
+    memcpy(this->__cgram[victim], pattern, 8);
+    this->__cgram_use[victim] = this->__cgram_tick;
+    this->__cgram_valid |= 1 << victim;
+    this->__cgram_dirty |= 1 << victim;
+    return LCD_DOG_CGRAM_CODE + victim;
+}
+
+/****************************************************************/
+bool LCD_EA_DOG::setCharLCD(char c, uint8_t line, uint8_t col){
+    if((line <= 0) || (line > this->_nb_lines)){
+        return false;
+    }
+    if((col <= 0) || (col > this->_nb_chars)){
+        return false;
+    }
+    this->__shadow[(line-1) * this->_nb_chars + (col-1)] = c;
+    return true;
+}
+
+/****************************************************************/
+bool LCD_EA_DOG::setGlyphLCD(const uint8_t pattern[8], uint8_t line, uint8_t col){
+    int code = this->loadGlyphLCD(pattern);
+    this->setCharLCD((code < 0) ? LCD_DOG_NO_GLYPH : (char)code, line, col);
+    return (code >= 0);
+}
+
+/****************************************************************/
+bool LCD_EA_DOG::setBarLCD(uint8_t line, uint8_t col, uint8_t width, uint16_t value, uint16_t max){
+    if((width == 0) || (max == 0) || (col + width - 1 > this->_nb_chars)){
+        return false;
+    }
+    if((line <= 0) || (line > this->_nb_lines) || (col <= 0)){
+        return false;
+    }
+    if(value > max){ value = max; }
+    // number of pixels - 5 per character
+    uint16_t pixels = ((uint32_t)value * width * 5 + max / 2) / max;
+    uint8_t pattern[8];
+    bool ret = true;
+    // empty bar first : the slots of the previous bar can be replaced
+    for(uint8_t k = 0; k < width; k++){
+        this->setCharLCD(' ', line, col + k);
+    }
+    for(uint8_t k = 0; k < width; k++){
+        uint8_t nb = (pixels >= 5) ? 5 : pixels;
+        pixels -= nb;
+        if(nb == 0){ break; }
+        memset(pattern, (0x1F << (5 - nb)) & 0x1F, 8);
+        ret &= this->setGlyphLCD(pattern, line, col + k);
+    }
+    return ret;
+}
+
+/****************************************************************/
+bool LCD_EA_DOG::setSparklineLCD(uint8_t line, uint8_t col, const uint16_t *values, uint8_t nb_values, uint16_t max){
+    if((nb_values == 0) || (max == 0) || (col + nb_values - 1 > this->_nb_chars)){
+        return false;
+    }
+    if((line <= 0) || (line > this->_nb_lines) || (col <= 0)){
+        return false;
+    }
+    uint8_t pattern[8];
+    bool ret = true;
+    for(uint8_t k = 0; k < nb_values; k++){
+        this->setCharLCD(' ', line, col + k);
+    }
+    for(uint8_t k = 0; k < nb_values; k++){
+        uint16_t value = (values[k] > max) ? max : values[k];
+        // height - 0 to 8 pixels
+        uint8_t height = ((uint32_t)value * 8 + max / 2) / max;
+        if(height == 0){ continue; }
+        for(uint8_t j = 0; j < 8; j++){
+            pattern[j] = (j >= 8 - height) ? 0x1F : 0x00;
+        }
+        ret &= this->setGlyphLCD(pattern, line, col + k);
+    }
+    return ret;
+}
+
+/****************************************************************/
+bool LCD_EA_DOG::setBigDigitsLCD(const char c[], uint8_t line, uint8_t col){
+    if((line <= 0) || (line + 1 > this->_nb_lines)){
+        return false;
+    }
+    if((col <= 0) || (col > this->_nb_chars)){
+        return false;
+    }
+    // empty area first : the slots of the previous digits can be replaced
+    uint8_t end = col;
+    for(uint8_t i = 0; c[i] != '\0'; i++){
+        end += ((c[i] == '.') ? 1 : 4);
+    }
+    for(uint8_t k = col; (k < end) && (k <= this->_nb_chars); k++){
+        this->setCharLCD(' ', line, k);
+        this->setCharLCD(' ', line + 1, k);
+    }
+    bool ret = true;
+    for(uint8_t i = 0; c[i] != '\0'; i++){
+        if(c[i] == '.'){
+            this->setCharLCD('.', line + 1, col);
+            col++;
+            continue;
+        }
+        int idx = -1;
+        if((c[i] >= '0') && (c[i] <= '9')){ idx = c[i] - '0'; }
+        if(c[i] == '-'){ idx = 10; }
+        if(idx >= 0){
+            for(uint8_t k = 0; k < 6; k++){
+                uint8_t glyph = big_digits[idx][k];
+                if(glyph == 0){ continue; }
+                if(col + k % 3 > this->_nb_chars){ ret = false; continue; }
+                ret &= this->setGlyphLCD(big_glyphs[glyph - 1], line + k / 3, col + k % 3);
+            }
+        }
+        // 3 characters and a space
+        col += 4;
+    }
+    return ret;
+}
@@ -23,9 +23,30 @@
 
 #include <cstdint>
 #include <mbed.h>
+#include <vector>
+#include "SPI_Bus.h"
  
 /** Constant definition */
 #define     DEBUG_MODE                  1
+/// Set DDRAM address command and DDRAM offset between two lines
+#define     LCD_DOG_SET_DDRAM           0x80
+#define     LCD_DOG_LINE_OFFSET         0x10
+/// Execution time of an instruction or of a character by the driver (us)
+#define     LCD_DOG_EXEC_TIME_US        27
+/// Highest SPI frequency of a burst - one byte lasts longer than the execution time (296 kHz)
+#define     LCD_DOG_BURST_FREQ          (8 * 1000000 / LCD_DOG_EXEC_TIME_US)
+/// Unchanged characters sent again to merge two runs (instead of a new address)
+#define     LCD_DOG_MERGE_GAP           1
+/// Function set - instruction table 0 (CGRAM access) and table 1 (default)
+#define     LCD_DOG_FUNCTION_IS0        0x28
+#define     LCD_DOG_FUNCTION_IS1        0x29
+/// Set CGRAM address command
+#define     LCD_DOG_SET_CGRAM           0x40
+/// Number of custom glyphs and code of the first glyph (0x08 to 0x0F, same as 0x00 to 0x07)
+#define     LCD_DOG_CGRAM_SLOTS         8
+#define     LCD_DOG_CGRAM_CODE          0x08
+/// Character displayed when no CGRAM slot is free
+#define     LCD_DOG_NO_GLYPH            '#'
 
 /**
  * @class LCD_EA_DOG
@@ -43,6 +64,75 @@ class LCD_EA_DOG{
         DigitalOut  __rs; 
         DigitalOut  __cs;
         SPI         *__spi;
+        /// Device on a shared SPI bus - NULL if the SPI interface is used
+        SPI_Device  *__dev;
+
+        /**
+        * @brief Select the screen - takes the shared bus.
+        */
+        void    select(void);
+
+        /**
+        * @brief Deselect the screen - releases the shared bus.
+        */
+        void    deselect(void);
+
+        /**
+        * @brief Write a byte, on the SPI interface or on the shared bus.
+        * @details Above LCD_DOG_BURST_FREQ, waits for the execution
+        *   time of the driver after the byte.
+        */
+        void    spiWrite(char c);
+
+        /**
+        * @brief Write a block of bytes, on the SPI interface or on the shared bus.
+        * @details One burst up to LCD_DOG_BURST_FREQ. Above, the block is
+        *   split in bytes separated by the execution time of the driver.
+        */
+        void    spiWrite(const char *c, int length);
+
+        /// Characters to display - nb_lines x nb_chars
+        std::vector<char>   __shadow;
+        /// Characters on the screen - last flush
+        std::vector<char>   __sent;
+        /// False when the screen was written without the shadow buffer
+        bool        __sent_valid;
+
+        /**
+        * @brief Write a run of characters at a DDRAM address.
+        * @details One address command, then one SPI burst of data.
+        * @param address DDRAM address of the first character.
+        * @param c Characters to display.
+        * @param length Number of characters.
+        */
+        void    writeRunLCD(uint8_t address, const char *c, int length);
+
+        /// Custom glyphs - patterns of the CGRAM slots
+        uint8_t     __cgram[LCD_DOG_CGRAM_SLOTS][8];
+        /// Last use of each slot (LRU replacement)
+        uint32_t    __cgram_use[LCD_DOG_CGRAM_SLOTS];
+        uint32_t    __cgram_tick;
+        /// Slots with a pattern / slots to upload at the next flush
+        uint8_t     __cgram_valid;
+        uint8_t     __cgram_dirty;
+
+        /**
+        * @brief Write the pattern of a CGRAM slot to the screen.
+        * @param slot CGRAM slot, 0 to 7.
+        */
+        void    writeGlyphLCD(uint8_t slot);
+
+        /**
+        * @brief Write a character in the shadow buffer.
+        * @return true if the line and the column are in the good range.
+        */
+        bool    setCharLCD(char c, uint8_t line, uint8_t col);
+
+        /**
+        * @brief Write a glyph in the shadow buffer, or LCD_DOG_NO_GLYPH.
+        * @return false if no CGRAM slot is free.
+        */
+        bool    setGlyphLCD(const uint8_t pattern[8], uint8_t line, uint8_t col);
 
 
     public:
@@ -55,11 +145,25 @@ class LCD_EA_DOG{
         * @param rs RS pin of the LCD screen
         * @param cs Chip Select pin of the LCD screen
         * @param spi SPI connection of the LCS screen
-        * @param freq SPI frequency - default 100 kHz
+        * @param freq SPI frequency - default 100 kHz (bytes separated by
+        *   LCD_DOG_EXEC_TIME_US above LCD_DOG_BURST_FREQ)
         * @param nb_lines number of lines of the LCD screen - default 3
         * @param nb_chars number of characters per line of the LCD screen - default 16
         */
         LCD_EA_DOG(PinName rs, PinName cs, SPI *spi, int freq=100000, uint8_t nb_lines=3, uint8_t nb_chars=16);
+
+        /**
+        * @brief Constructor of the LCD_EA_DOG class on a shared SPI bus.
+        * @details The format of the device is set to 8 bits, mode 3.
+        *    The Chip Select pin is driven by the device.
+        * @param rs RS pin of the LCD screen
+        * @param dev device on a shared SPI bus (with the CS pin)
+        * @param freq SPI frequency - default 100 kHz (bytes separated by
+        *   LCD_DOG_EXEC_TIME_US above LCD_DOG_BURST_FREQ)
+        * @param nb_lines number of lines of the LCD screen - default 3
+        * @param nb_chars number of characters per line of the LCD screen - default 16
+        */
+        LCD_EA_DOG(PinName rs, SPI_Device *dev, int freq=100000, uint8_t nb_lines=3, uint8_t nb_chars=16);
         
         /**
         * @brief Initialization of the LCD screen.
@@ -90,6 +194,8 @@ class LCD_EA_DOG{
 
         /**
         * @brief Write a char on the LCD screen at the next position.
+        * @details  The shadow buffer is no more valid : the next flush()
+        *       sends all the characters.
         * @param c Character to display.
         */        
         void    writeLCD(char c);
@@ -97,7 +203,8 @@ class LCD_EA_DOG{
         /**
         * @brief Write a string of characters.
         * @details  Write a string of characters on the LCD screen 
-        *       at a specific position.
+        *       at a specific position. Only the changed characters are sent
+        *       (see setStrLCD and flush).
         * @param c* String of characters to display.
         * @param line Number of the line to display the string of characters.
         * @param col Number of the column to display the string of characters.
@@ -108,7 +215,8 @@ class LCD_EA_DOG{
         /**
         * @brief Write a constant string of characters.
         * @details  Write a constant string of characters on the LCD screen 
-        *       at a specific position.
+        *       at a specific position. Only the changed characters are sent
+        *       (see setStrLCD and flush).
         * @param c* Constant string of characters to display.
         * @param line Number of the line to display the string of characters.
         * @param col Number of the column to display the string of characters.
@@ -130,6 +238,72 @@ class LCD_EA_DOG{
         */
         bool    setPosition(uint8_t line, uint8_t col);
 
+        /**
+        * @brief Write a string of characters in the shadow buffer.
+        * @details  The screen is updated by the next flush().
+        *       The string is cut at the end of the line.
+        * @param c* Constant string of characters to display.
+        * @param line Number of the line to display the string of characters.
+        * @param col Number of the column to display the string of characters.
+        * @return true if the line and the column are in the good range.
+        */
+        bool    setStrLCD(const char c[], uint8_t line, uint8_t col);
+
+        /**
+        * @brief Send the changes of the shadow buffer to the screen.
+        * @details  Only the runs of changed characters are sent, each
+        *       with one address command and one SPI burst.
+        * @return number of characters sent.
+        */
+        int     flush(void);
+
+        /**
+        * @brief Get the character code of a custom glyph.
+        * @details  The 8 CGRAM slots are a cache of glyphs : a new glyph
+        *       replaces the least recently used glyph which is not in the
+        *       shadow buffer. The pattern is sent to the screen by the
+        *       next flush().
+        * @param pattern 8 lines of 5 pixels (bit 4 : left pixel).
+        * @return character code of the glyph (0x08 to 0x0F) or -1 if
+        *       all the slots are displayed.
+        */
+        int     loadGlyphLCD(const uint8_t pattern[8]);
+
+        /**
+        * @brief Write a horizontal bar graph in the shadow buffer.
+        * @details  5 pixels per character - 2 glyphs.
+        * @param line Number of the line of the bar graph.
+        * @param col Number of the first column of the bar graph.
+        * @param width Number of characters of the bar graph.
+        * @param value Value to display, between 0 and max.
+        * @param max Value of the full bar graph.
+        * @return false if out of range or if no CGRAM slot is free.
+        */
+        bool    setBarLCD(uint8_t line, uint8_t col, uint8_t width, uint16_t value, uint16_t max);
+
+        /**
+        * @brief Write a sparkline in the shadow buffer.
+        * @details  One value per character, 8 levels - up to 8 glyphs.
+        * @param line Number of the line of the sparkline.
+        * @param col Number of the first column of the sparkline.
+        * @param values Values to display, between 0 and max.
+        * @param nb_values Number of values.
+        * @param max Value of the full height.
+        * @return false if out of range or if no CGRAM slot is free.
+        */
+        bool    setSparklineLCD(uint8_t line, uint8_t col, const uint16_t *values, uint8_t nb_values, uint16_t max);
+
+        /**
+        * @brief Write big digits on 2 lines in the shadow buffer.
+        * @details  3 x 2 characters per digit, like 7 segments - 4 glyphs.
+        *       Characters : '0' to '9', '-', '.' and ' '.
+        * @param c* String of characters to display.
+        * @param line Number of the first line of the digits.
+        * @param col Number of the first column of the digits.
+        * @return false if out of range or if no CGRAM slot is free.
+        */
+        bool    setBigDigitsLCD(const char c[], uint8_t line, uint8_t col);
+
 };
 
 #endif
\ No newline at end of file
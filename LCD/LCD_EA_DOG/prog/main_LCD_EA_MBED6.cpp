@@ -45,6 +45,9 @@ int main()
         k++;
         sprintf(str_to_write, "Test k = %d", k);
         my_lcd.writeStrLCD(str_to_write, 2, 1);
+        // bar graph with custom glyphs - sent by flush
+        my_lcd.setBarLCD(3, 1, 16, k % 81, 80);
+        my_lcd.flush();
         thread_sleep_for(500);
         if(k % 4 == 0){
             my_lcd.display_on();
@@ -0,0 +1,79 @@
+/**
+ * FILENAME :        LCD_glyph.h
+ *
+ * DESCRIPTION :
+ *       Graphics core library for LCD display - Scaled characters.
+ *       Each column of the font (8 rows, bit 0 at the top) is expanded
+ *      to 8*scale bits by tables (one bit repeated scale times), instead
+ *      of one test per bit of the font and per pixel.
+ *       Used by LCD_graphics, LCD_graphics_t and the LCD libraries which
+ *      write the expanded columns directly (pages of the SSD1306).
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __LCD_GLYPH_H__
+#define __LCD_GLYPH_H__
+
+#include "mbed.h"
+#include "font.h"
+#include <cstdint>
+
+/** Bit expansion of a nibble - each bit repeated 2 times */
+static constexpr uint8_t    lcd_expand2[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+/** Bit expansion of a nibble - each bit repeated 4 times */
+static constexpr uint16_t   lcd_expand4[16] = {
+    0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+    0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF
+};
+
+/** Column of 8 bits expanded to 8*scale bits - bit 0 at the top */
+static inline uint64_t  lcd_expand_column(uint8_t bits, uint8_t scale)
+{
+    uint16_t    x2;
+    switch (scale) {
+        case 1:
+            return bits;
+        case 2:
+            return lcd_expand2[bits & 0x0F] | (lcd_expand2[bits >> 4] << 8);
+        case 4:
+            return lcd_expand4[bits & 0x0F] | ((uint32_t)lcd_expand4[bits >> 4] << 16);
+        case 8:
+            // 2 times, then 4 times
+            x2 = lcd_expand2[bits & 0x0F] | (lcd_expand2[bits >> 4] << 8);
+            return (uint64_t)lcd_expand4[x2 & 0x0F] | ((uint64_t)lcd_expand4[(x2 >> 4) & 0x0F] << 16) |
+                   ((uint64_t)lcd_expand4[(x2 >> 8) & 0x0F] << 32) | ((uint64_t)lcd_expand4[x2 >> 12] << 48);
+        default: {
+            // other factors - one mask per bit of the font
+            uint64_t    col = 0;
+            uint64_t    run = (1ULL << scale) - 1;
+            for (uint8_t k = 0; k < CHARS_ROWS_LEN; k++) {
+                if (bits & (1 << k)) { col |= run << (k * scale); }
+            }
+            return col;
+        }
+    }
+}
+
+/**
+ * @brief Expanded columns of a character - CHARS_COLS_LEN+1 columns
+ * @details The last column is the space between the characters.
+ *      The character must be in the font and scale in 1 to 8.
+ */
+static inline void  lcd_glyph_columns(char character, uint8_t scale, uint64_t *columns)
+{
+    for (uint8_t c = 0; c < CHARS_COLS_LEN; c++) {
+        columns[c] = lcd_expand_column(FONTS[character - MIN_ASCII_CHAR][c], scale);
+    }
+    columns[CHARS_COLS_LEN] = 0;
+}
+
+#endif
@@ -21,8 +21,29 @@
  */
 
 #include "LCD_graphics.h"
+#include "LCD_glyph.h"
 
 
+/** Region codes - Cohen-Sutherland */
+#define CLIP_INSIDE     0x00
+#define CLIP_LEFT       0x01
+#define CLIP_RIGHT      0x02
+#define CLIP_TOP        0x04
+#define CLIP_BOTTOM     0x08
+
+
+LCD_graphics::LCD_graphics(void)
+{
+    this->__text_x = 0;
+    this->__text_y = 0;
+    this->__text_opaque = false;
+    this->__text_bg = 0;
+    // size of the screen unknown : only positive coordinates
+    this->__screen_w = INT16_MAX;
+    this->__screen_h = INT16_MAX;
+    this->reset_clip();
+}
+
 bool    LCD_graphics::set_position (uint16_t x, uint16_t y)
 {
     // check if coordinates is out of range
@@ -33,11 +54,16 @@ bool    LCD_graphics::set_position (uint16_t x, uint16_t y)
     return  LCD_SUCCESS;
 }
 
-bool 	LCD_graphics::draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)  
+bool 	LCD_graphics::draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)  
 {  
-    // check if coordinates is out of range
-    if (!this->check_range(x0, y0)) { return    LCD_ERROR; }
-    if (!this->check_range(x1, y1)) { return    LCD_ERROR; }
+    // part of the line in the clipping rectangle
+    if (!this->clip_line(x0, y0, x1, y1)) { return    LCD_ERROR; }
+    // horizontal line
+    if (y0 == y1) {
+        if (x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }
+        this->write_span(x0, x1, y0, color);
+        return  LCD_SUCCESS;
+    }
 
 	// Bresenham's Algorithm
 	// @see : https://www.baeldung.com/cs/bresenhams-line-algorithm
@@ -53,7 +79,8 @@ bool 	LCD_graphics::draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1
     if(y0 > y1) { sy = -1; }
 
     err = dx - dy;
-    this->draw_pixel(x0, y0, color);
+    // all the pixels are in the clipping rectangle
+    this->write_pixel(x0, y0, color);
     
     while((x0 != x1) || (y0 != y1)){
         e2 = err << 1;  // err * 2
@@ -65,7 +92,7 @@ bool 	LCD_graphics::draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1
             err += dx;
             y0 += sy;
         }
-        this->draw_pixel(x0, y0, color);
+        this->write_pixel(x0, y0, color);
     }
 
 	return	LCD_SUCCESS;
@@ -73,129 +100,61 @@ bool 	LCD_graphics::draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1
 
 bool 	LCD_graphics::draw_char(char character, uint16_t color, enum Size size)
 {
-	// variables
-	uint8_t letter, idxCol, idxRow;
+    return this->draw_char_scale(character, color, (uint8_t)size);
+}
+
+bool    LCD_graphics::draw_char_scale(char character, uint16_t color, uint8_t scale)
+{
 	// check if character is out of range
-	if ((character < MIN_ASCII_CHAR) &&
-		(character > MAX_ASCII_CHAR)) { 
-		// out of range
-		return LCD_ERROR;
-	}
-	
-	// last column of character array - 5 columns 
-	idxCol = CHARS_COLS_LEN;
-	// last row of character array - 8 rows / bits
-	idxRow = CHARS_ROWS_LEN;
-
-    switch(size){
-	    case HUGE:
-        // ------------------
-        // SIZE X4 - font 4x
-        // ------------------
-	    // loop through 5 bytes
-            while (idxCol--) {
-                // read from ROM memory 
-                letter = FONTS[character - 0x20][idxCol];
-                // loop through 8 bits
-                while (idxRow--) {
-                    // check if bit set
-                    if (letter & (1 << idxRow)) {
-                        for(int k = 0; k < 4; k++){
-                            // draw pixels 
-                            this->draw_pixel(this->__text_x + 4*idxCol + k, this->__text_y + 4*idxRow, color);
-                            this->draw_pixel(this->__text_x + 4*idxCol + k, this->__text_y + 4*idxRow + 1, color);
-                            this->draw_pixel(this->__text_x + 4*idxCol + k, this->__text_y + 4*idxRow + 2, color);
-                            this->draw_pixel(this->__text_x + 4*idxCol + k, this->__text_y + 4*idxRow + 3, color);
-                        }
-                    }
-                }
-                // fill index row again
-                idxRow = CHARS_ROWS_LEN;
-            }
-	        // update x position
-	        this->__text_x += 4*(CHARS_COLS_LEN + 1);
-            break;
-	    case LARGE:
-        // ------------------
-        // SIZE X2 - font 2x
-        // ------------------
-	    // loop through 5 bytes
-            while (idxCol--) {
-                // read from ROM memory 
-                letter = FONTS[character - 0x20][idxCol];
-                // loop through 8 bits
-                while (idxRow--) {
-                    // check if bit set
-                    if (letter & (1 << idxRow)) {
-                        // draw pixel 
-                        this->draw_pixel(this->__text_x + 2*idxCol, this->__text_y + 2*idxRow, color);
-                        this->draw_pixel(this->__text_x + 2*idxCol + 1, this->__text_y + 2*idxRow, color);
-                        this->draw_pixel(this->__text_x + 2*idxCol, this->__text_y + 2*idxRow + 1, color);
-                        this->draw_pixel(this->__text_x + 2*idxCol + 1, this->__text_y + 2*idxRow + 1, color);
-                    }
-                }
-                // fill index row again
-                idxRow = CHARS_ROWS_LEN;
-            }
-	        // update x position
-	        this->__text_x += 2*(CHARS_COLS_LEN + 1);
-            break;
-
-        case NORMAL:  
-        default:
-        // ------------------------
-        // SIZE X1 - normal font 1x
-        // ------------------------
-            // loop through 5 bits
-            while (idxCol--) {
-                // read from ROM memory 
-                letter = FONTS[character - 0x20][idxCol];
-                // loop through 8 bits
-                while (idxRow--) {
-                    // check if bit set
-                    if (letter & (1 << idxRow)) {
-                        // draw pixel 
-                        this->draw_pixel(this->__text_x + idxCol, this->__text_y + idxRow, color);
-                    }
-                }
-                // fill index row again
-                idxRow = CHARS_ROWS_LEN;
-            }
-            // update x position
-            this->__text_x += (CHARS_COLS_LEN + 1);
-            break;
+    if ((character < MIN_ASCII_CHAR) || (character > MAX_ASCII_CHAR)) { return LCD_ERROR; }
+    if ((scale < 1) || (scale > LCD_SCALE_MAX)) { return LCD_ERROR; }
+    // expanded columns - the last one is the space between the characters
+    uint64_t    columns[CHARS_COLS_LEN + 1];
+    lcd_glyph_columns(character, scale, columns);
+    int16_t     x = this->__text_x;
+    int16_t     y = this->__text_y;
+    int16_t     w = (CHARS_COLS_LEN + 1) * scale;
+    int16_t     h = CHARS_ROWS_LEN * scale;
+    if (this->is_inside(x, y, x + w - 1, y + h - 1)) {
+        this->write_glyph(x, y, columns, scale, color, this->__text_opaque, this->__text_bg);
+    }
+    else if (this->is_visible(x, y, x + w - 1, y + h - 1)) {
+        // clipped spans
+        this->LCD_graphics::write_glyph(x, y, columns, scale, color, this->__text_opaque, this->__text_bg);
     }
-	
-	// return exit
-	return LCD_SUCCESS;
+    // update x position
+    this->__text_x += w;
+    return LCD_SUCCESS;
 }
 
-
 bool 	LCD_graphics::draw_string(char *str, uint16_t color, enum Size size)
 {
-	// variables
-	unsigned int i = 0;
-	bool check;
-	unsigned char delta_y;
-	uint16_t max_x_pos;
-	uint16_t max_y_pos;
-	unsigned char new_x_pos;
-	unsigned char new_y_pos;
-	
-	// Check if string size is in the range of the screen
-	max_x_pos = this->__text_x + ((CHARS_COLS_LEN+1) * size);
-	max_y_pos = this->__text_y + (CHARS_ROWS_LEN * size);
-	// check if coordinates is out of range - NOT WORKING WITH SIZE !
-    if (!this->check_range(max_x_pos, max_y_pos)) { return  LCD_ERROR; }
+    return this->draw_string_scale(str, color, (uint8_t)size);
+}
 
+bool    LCD_graphics::draw_string_scale(const char *str, uint16_t color, uint8_t scale)
+{
+	// check if coordinates is out of range - first character only
+    if (!this->check_range(this->__text_x + ((CHARS_COLS_LEN+1) * scale),
+                           this->__text_y + (CHARS_ROWS_LEN * scale))) { return LCD_ERROR; }
 	// loop through character of string
-	while (str[i] != '\0') {
-		// read characters and increment index
-		this->draw_char(str[i++], color, size);
-	}
+    while (*str != '\0') {
+        this->draw_char_scale(*str++, color, scale);
+    }
     return LCD_SUCCESS;
 }
 
+void    LCD_graphics::set_text_background(uint16_t color)
+{
+    this->__text_opaque = true;
+    this->__text_bg = color;
+}
+
+void    LCD_graphics::set_text_transparent(void)
+{
+    this->__text_opaque = false;
+}
+
 bool    LCD_graphics::draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
     // check if coordinates is out of range
@@ -218,9 +177,408 @@ bool    LCD_graphics::fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint
     if (!this->check_range(x, y)) { return  LCD_ERROR; } 
     // check if coordinates is out of range
     if (!this->check_range(x+w, y+h)) { return  LCD_ERROR; } 
-    for(uint16_t k = x; k < x+w; k++){
-        this->draw_line(k, y, k, y+h, color);
+    // same pixels as vertical lines from x to x+w-1 - one span per row
+    if (w <= 0) { return LCD_SUCCESS; }
+    for(int16_t j = y; j <= y+h; j++){
+        this->span(x, x+w-1, j, color);
+    }
+
+    return LCD_SUCCESS;
+}
+
+
+/**************************************************************
+ *	Circles, ellipses and polygons
+ **************************************************************/
+
+bool    LCD_graphics::draw_circle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    if ((r < 0) || !this->is_visible(x0-r, y0-r, x0+r, y0+r)) { return LCD_ERROR; }
+	// Midpoint circle algorithm - 8 octants
+    int16_t     x = r;
+    int16_t     y = 0;
+    int16_t     err = 1 - r;
+    while (x >= y) {
+        this->plot(x0 + x, y0 + y, color);
+        this->plot(x0 - x, y0 + y, color);
+        this->plot(x0 + x, y0 - y, color);
+        this->plot(x0 - x, y0 - y, color);
+        this->plot(x0 + y, y0 + x, color);
+        this->plot(x0 - y, y0 + x, color);
+        this->plot(x0 + y, y0 - x, color);
+        this->plot(x0 - y, y0 - x, color);
+        y++;
+        if (err < 0) {
+            err += 2*y + 1;
+        }
+        else {
+            x--;
+            err += 2*(y - x) + 1;
+        }
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::fill_circle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    if ((r < 0) || !this->is_visible(x0-r, y0-r, x0+r, y0+r)) { return LCD_ERROR; }
+	// Midpoint circle algorithm - spans between the symmetric points
+    int16_t     x = r;
+    int16_t     y = 0;
+    int16_t     err = 1 - r;
+    while (x >= y) {
+        this->span(x0 - x, x0 + x, y0 + y, color);
+        if (y != 0) { this->span(x0 - x, x0 + x, y0 - y, color); }
+        y++;
+        if (err < 0) {
+            err += 2*y + 1;
+        }
+        else {
+            // rows of the other octants - once per value of x
+            if (x >= y) {
+                this->span(x0 - y + 1, x0 + y - 1, y0 + x, color);
+                this->span(x0 - y + 1, x0 + y - 1, y0 - x, color);
+            }
+            x--;
+            err += 2*(y - x) + 1;
+        }
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::draw_ellipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color)
+{
+    if ((rx < 0) || (ry < 0) || !this->is_visible(x0-rx, y0-ry, x0+rx, y0+ry)) { return LCD_ERROR; }
+	// Midpoint ellipse algorithm - 2 regions, 4 quadrants
+    int32_t     rx2 = (int32_t)rx * rx;
+    int32_t     ry2 = (int32_t)ry * ry;
+    int32_t     x = 0;
+    int32_t     y = ry;
+    int32_t     px = 0;
+    int32_t     py = 2 * rx2 * y;
+    // region 1 - slope > -1
+    int32_t     p = ry2 - rx2 * ry + rx2 / 4;
+    while (px < py) {
+        this->plot(x0 + x, y0 + y, color);
+        this->plot(x0 - x, y0 + y, color);
+        this->plot(x0 + x, y0 - y, color);
+        this->plot(x0 - x, y0 - y, color);
+        x++;
+        px += 2 * ry2;
+        if (p < 0) {
+            p += ry2 + px;
+        }
+        else {
+            y--;
+            py -= 2 * rx2;
+            p += ry2 + px - py;
+        }
+    }
+    // region 2 - slope < -1
+    p = ry2 * (2*x + 1) * (2*x + 1) / 4 + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
+    while (y >= 0) {
+        this->plot(x0 + x, y0 + y, color);
+        this->plot(x0 - x, y0 + y, color);
+        this->plot(x0 + x, y0 - y, color);
+        this->plot(x0 - x, y0 - y, color);
+        y--;
+        py -= 2 * rx2;
+        if (p > 0) {
+            p += rx2 - py;
+        }
+        else {
+            x++;
+            px += 2 * ry2;
+            p += rx2 - py + px;
+        }
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::fill_ellipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color)
+{
+    if ((rx < 0) || (ry < 0) || !this->is_visible(x0-rx, y0-ry, x0+rx, y0+ry)) { return LCD_ERROR; }
+	// Midpoint ellipse algorithm - one span per row, at the last x of the row
+    int32_t     rx2 = (int32_t)rx * rx;
+    int32_t     ry2 = (int32_t)ry * ry;
+    int32_t     x = 0;
+    int32_t     y = ry;
+    int32_t     px = 0;
+    int32_t     py = 2 * rx2 * y;
+    // region 1 - slope > -1
+    int32_t     p = ry2 - rx2 * ry + rx2 / 4;
+    while (px < py) {
+        x++;
+        px += 2 * ry2;
+        if (p < 0) {
+            p += ry2 + px;
+        }
+        else {
+            // end of the row y
+            this->span(x0 - x + 1, x0 + x - 1, y0 + y, color);
+            this->span(x0 - x + 1, x0 + x - 1, y0 - y, color);
+            y--;
+            py -= 2 * rx2;
+            p += ry2 + px - py;
+        }
+    }
+    // region 2 - slope < -1
+    p = ry2 * (2*x + 1) * (2*x + 1) / 4 + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
+    while (y >= 0) {
+        this->span(x0 - x, x0 + x, y0 + y, color);
+        if (y != 0) { this->span(x0 - x, x0 + x, y0 - y, color); }
+        y--;
+        py -= 2 * rx2;
+        if (p > 0) {
+            p += rx2 - py;
+        }
+        else {
+            x++;
+            px += 2 * ry2;
+            p += rx2 - py + px;
+        }
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::draw_polygon(const int16_t *points, uint8_t nb_points, uint16_t color)
+{
+    if (nb_points < 2) { return LCD_ERROR; }
+    for (uint8_t k = 0; k < nb_points; k++) {
+        uint8_t n = (k + 1) % nb_points;
+        this->draw_line(points[2*k], points[2*k+1], points[2*n], points[2*n+1], color);
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::fill_polygon(const int16_t *points, uint8_t nb_points, uint16_t color)
+{
+    if ((nb_points < 3) || (nb_points > LCD_POLYGON_MAX)) { return LCD_ERROR; }
+    // rows of the polygon, in the clipping rectangle
+    int16_t     y_min = points[1];
+    int16_t     y_max = points[1];
+    for (uint8_t k = 1; k < nb_points; k++) {
+        if (points[2*k+1] < y_min) { y_min = points[2*k+1]; }
+        if (points[2*k+1] > y_max) { y_max = points[2*k+1]; }
+    }
+    if (y_min < this->__clip_y0) { y_min = this->__clip_y0; }
+    if (y_max > this->__clip_y1) { y_max = this->__clip_y1; }
+	// Scanline algorithm - crossings of the edges at the center of the row
+    int16_t     nodes[LCD_POLYGON_MAX];
+    for (int16_t y = y_min; y <= y_max; y++) {
+        uint8_t nb_nodes = 0;
+        for (uint8_t k = 0; k < nb_points; k++) {
+            uint8_t n = (k + 1) % nb_points;
+            int32_t xa = points[2*k], ya = points[2*k+1];
+            int32_t xb = points[2*n], yb = points[2*n+1];
+            // half-open edges : a vertex is counted once
+            if (((ya <= y) && (yb > y)) || ((yb <= y) && (ya > y))) {
+                nodes[nb_nodes++] = (int16_t)(xa + (y - ya) * (xb - xa) / (yb - ya));
+            }
+        }
+        // sort the crossings - insertion sort, few nodes
+        for (uint8_t i = 1; i < nb_nodes; i++) {
+            int16_t v = nodes[i];
+            int8_t  j = i - 1;
+            while ((j >= 0) && (nodes[j] > v)) {
+                nodes[j+1] = nodes[j];
+                j--;
+            }
+            nodes[j+1] = v;
+        }
+        // spans between pairs of crossings
+        for (uint8_t i = 0; i + 1 < nb_nodes; i += 2) {
+            this->span(nodes[i], nodes[i+1], y, color);
+        }
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::draw_bitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *bitmap, uint16_t color)
+{
+    if (!this->is_visible(x, y, x+w-1, y+h-1)) { return LCD_ERROR; }
+    uint16_t    row_size = (w + 7) / 8;
+    for (uint16_t j = 0; j < h; j++) {
+        const uint8_t   *row = &bitmap[j * row_size];
+        uint16_t    i = 0;
+        while (i < w) {
+            // first pixel of a run
+            if (!(row[i/8] & (0x80 >> (i%8)))) { i++; continue; }
+            uint16_t start = i;
+            while ((i < w) && (row[i/8] & (0x80 >> (i%8)))) { i++; }
+            this->span(x + start, x + i - 1, y + j, color);
+        }
+    }
+    return LCD_SUCCESS;
+}
+
+bool    LCD_graphics::draw_image(int16_t x, int16_t y, const LCD_Image *img)
+{
+    if (!this->is_visible(x, y, x+img->width-1, y+img->height-1)) { return LCD_ERROR; }
+    LCD_ImageDecoder    dec(img);
+    uint8_t     index;
+    uint16_t    len;
+    uint16_t    i = 0, j = 0;
+    // runs split at the end of the rows
+    while ((j < img->height) && ((len = dec.next_run(&index, img->width - i)) > 0)) {
+        if (index < img->nb_colors) {
+            this->span(x + i, x + i + len - 1, y + j, img->palette[index]);
+        }
+        i += len;
+        if (i == img->width) { i = 0; j++; }
+    }
+    return LCD_SUCCESS;
+}
+
+
+/**************************************************************
+ *	Clipping
+ **************************************************************/
+
+void    LCD_graphics::set_screen(uint16_t width, uint16_t height)
+{
+    this->__screen_w = width;
+    this->__screen_h = height;
+    this->reset_clip();
+}
+
+bool    LCD_graphics::set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    // limited to the screen
+    if (x0 < 0) { x0 = 0; }
+    if (y0 < 0) { y0 = 0; }
+    if (x1 > this->__screen_w - 1) { x1 = this->__screen_w - 1; }
+    if (y1 > this->__screen_h - 1) { y1 = this->__screen_h - 1; }
+    if ((x0 > x1) || (y0 > y1)) { return LCD_ERROR; }
+    this->__clip_x0 = x0;
+    this->__clip_y0 = y0;
+    this->__clip_x1 = x1;
+    this->__clip_y1 = y1;
+    return LCD_SUCCESS;
+}
+
+void    LCD_graphics::reset_clip(void)
+{
+    this->__clip_x0 = 0;
+    this->__clip_y0 = 0;
+    this->__clip_x1 = this->__screen_w - 1;
+    this->__clip_y1 = this->__screen_h - 1;
+}
+
+void    LCD_graphics::write_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+    this->draw_pixel(x, y, color);
+}
+
+void    LCD_graphics::write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+{
+    for (uint16_t x = x0; x <= x1; x++) {
+        this->write_pixel(x, y, color);
+    }
+}
+
+void    LCD_graphics::write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+                                  uint16_t color, bool opaque, uint16_t bg)
+{
+    // one span per run of columns of the same bit, on each row
+    for (uint8_t row = 0; row < CHARS_ROWS_LEN * scale; row++) {
+        uint8_t     c = 0;
+        while (c <= CHARS_COLS_LEN) {
+            bool    bit = (columns[c] >> row) & 1;
+            uint8_t start = c;
+            while ((c <= CHARS_COLS_LEN) && (((columns[c] >> row) & 1) == bit)) { c++; }
+            if (bit || opaque) {
+                this->span(x + start * scale, x + c * scale - 1, y + row, bit ? color : bg);
+            }
+        }
     }
+}
 
+uint8_t LCD_graphics::out_code(int32_t x, int32_t y)
+{
+    uint8_t code = CLIP_INSIDE;
+    if (x < this->__clip_x0) { code |= CLIP_LEFT; }
+    else if (x > this->__clip_x1) { code |= CLIP_RIGHT; }
+    if (y < this->__clip_y0) { code |= CLIP_TOP; }
+    else if (y > this->__clip_y1) { code |= CLIP_BOTTOM; }
+    return code;
+}
+
+bool    LCD_graphics::clip_line(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1)
+{
+	// Cohen-Sutherland Algorithm
+	// @see : https://en.wikipedia.org/wiki/Cohen%E2%80%93Sutherland_algorithm
+    int32_t     xa = x0, ya = y0, xb = x1, yb = y1;
+    uint8_t     code_a = this->out_code(xa, ya);
+    uint8_t     code_b = this->out_code(xb, yb);
+    while (true) {
+        // both points inside
+        if (!(code_a | code_b)) { break; }
+        // both points on the same outside side
+        if (code_a & code_b) { return LCD_ERROR; }
+        // move the outside point to the border - rounded to the nearest pixel
+        uint8_t code = code_a ? code_a : code_b;
+        int32_t x, y, dx = xb - xa, dy = yb - ya;
+        if (code & CLIP_BOTTOM) {
+            y = this->__clip_y1;
+            x = xa + (2 * dx * (y - ya) + dy) / (2 * dy);
+        }
+        else if (code & CLIP_TOP) {
+            y = this->__clip_y0;
+            x = xa + (2 * dx * (y - ya) + dy) / (2 * dy);
+        }
+        else if (code & CLIP_RIGHT) {
+            x = this->__clip_x1;
+            y = ya + (2 * dy * (x - xa) + dx) / (2 * dx);
+        }
+        else {
+            x = this->__clip_x0;
+            y = ya + (2 * dy * (x - xa) + dx) / (2 * dx);
+        }
+        if (code == code_a) {
+            xa = x; ya = y;
+            code_a = this->out_code(xa, ya);
+        }
+        else {
+            xb = x; yb = y;
+            code_b = this->out_code(xb, yb);
+        }
+    }
+    x0 = xa; y0 = ya; x1 = xb; y1 = yb;
     return LCD_SUCCESS;
 }
+
+bool    LCD_graphics::is_inside(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    return ((x0 >= this->__clip_x0) && (x1 <= this->__clip_x1) && (y0 >= this->__clip_y0) && (y1 <= this->__clip_y1));
+}
+
+void    LCD_graphics::get_clip(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1)
+{
+    x0 = this->__clip_x0;
+    y0 = this->__clip_y0;
+    x1 = this->__clip_x1;
+    y1 = this->__clip_y1;
+}
+
+void    LCD_graphics::plot(int16_t x, int16_t y, uint16_t color)
+{
+    if ((x < this->__clip_x0) || (x > this->__clip_x1) ||
+        (y < this->__clip_y0) || (y > this->__clip_y1)) { return; }
+    this->write_pixel(x, y, color);
+}
+
+void    LCD_graphics::span(int16_t x0, int16_t x1, int16_t y, uint16_t color)
+{
+    if ((y < this->__clip_y0) || (y > this->__clip_y1)) { return; }
+    if (x0 < this->__clip_x0) { x0 = this->__clip_x0; }
+    if (x1 > this->__clip_x1) { x1 = this->__clip_x1; }
+    if (x0 > x1) { return; }
+    this->write_span(x0, x1, y, color);
+}
+
+bool    LCD_graphics::is_visible(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    return ((x1 >= this->__clip_x0) && (x0 <= this->__clip_x1) &&
+            (y1 >= this->__clip_y0) && (y0 <= this->__clip_y1));
+}
@@ -10,6 +10,9 @@
  *      - a **check_range** method with parameters : 
  *          -> uint16_t x, uint16_t y
  *          -> returns false if x and y are out of the range of the screen
+ *       LCD library should also call **set_screen** with the size of the
+ *      screen and can override **write_pixel** and **write_span**
+ *      (no range check - primitives are clipped before).
  *
  * NOTES :
  *       Developped by Villou / LEnsE
@@ -26,10 +29,15 @@
 
 #include "mbed.h"
 #include "font.h"
+#include "LCD_image.h"
 #include <cstdint>
 
 #define LCD_SUCCESS        true
 #define LCD_ERROR          false
+/// Maximum number of points of a polygon
+#define LCD_POLYGON_MAX    16
+/// Maximum scale factor of the characters - 8 rows x 8 in 64 bits
+#define LCD_SCALE_MAX      8
 
 
 /**
@@ -46,6 +54,11 @@
 
 class LCD_graphics {
     public:
+        /**
+		 * @brief    Simple constructor of the LCD_graphics class
+		 * @details  No clipping rectangle until set_screen is called by the LCD library
+		 */
+        LCD_graphics(void);
 
 		/**
 		 * @brief    Draw a pixel at a specific position
@@ -54,7 +67,7 @@ class LCD_graphics {
 		 * @param color - uint16_t - Color in 16 bits mode
          * @return  false if x and y are out of range
 		 */
-        virtual bool    draw_pixel(uint16_t x, uint16_t y, uint16_t color);
+        virtual bool    draw_pixel(uint16_t x, uint16_t y, uint16_t color) = 0;
 
 		/**
         * @brief Check if the coordinates are in the range of the screen size
@@ -62,7 +75,7 @@ class LCD_graphics {
 		* @param y 	uint16_t - coordinate on Y axis
 		* @return true if is in the range of the screen size
 		*/
-        virtual bool    check_range(uint16_t x, uint16_t y);
+        virtual bool    check_range(uint16_t x, uint16_t y) = 0;
 		
         /**
 		 * @param x - uint16_t - coordinate on X axis
@@ -73,14 +86,15 @@ class LCD_graphics {
 
 		/**
 		 * @brief    Draw a line using Bresenham's Algorithm
+		 * @details  The line is clipped to the clipping rectangle (Cohen-Sutherland)
 		 * @param x0 - uint16_t - x0 position of the first point of the line
 		 * @param y0 - uint16_t - y0 position of the first point of the line
 		 * @param x1 - uint16_t - x1 position of the first point of the line
 		 * @param y1 - uint16_t - y1 position of the first point of the line
 		 * @param color - uint16_t - Color in 16 bits mode
-         * @return  false if x0,y0 and x1,y1 are out of range
+         * @return  false if the line is out of the clipping rectangle
 		 */		
-		bool 	draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+		bool 	draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
         
         /**
 		 * @brief    Draw a rectangle using its top-left corner and its dimension
@@ -104,6 +118,105 @@ class LCD_graphics {
 		 */	
         bool    fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
 
+        /**
+		 * @brief    Draw a circle using the midpoint algorithm
+		 * @param x0 - int16_t - x position of the center
+		 * @param y0 - int16_t - y position of the center
+		 * @param r - int16_t - radius of the circle
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if the circle is out of the clipping rectangle
+		 */	
+        bool    draw_circle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+        /**
+		 * @brief    Draw a filled circle - one span per line
+		 * @param x0 - int16_t - x position of the center
+		 * @param y0 - int16_t - y position of the center
+		 * @param r - int16_t - radius of the circle
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if the circle is out of the clipping rectangle
+		 */	
+        bool    fill_circle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+        /**
+		 * @brief    Draw an ellipse using the midpoint algorithm
+		 * @param x0 - int16_t - x position of the center
+		 * @param y0 - int16_t - y position of the center
+		 * @param rx - int16_t - radius on X axis
+		 * @param ry - int16_t - radius on Y axis
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if the ellipse is out of the clipping rectangle
+		 */	
+        bool    draw_ellipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color);
+
+        /**
+		 * @brief    Draw a filled ellipse - one span per line
+		 * @param x0 - int16_t - x position of the center
+		 * @param y0 - int16_t - y position of the center
+		 * @param rx - int16_t - radius on X axis
+		 * @param ry - int16_t - radius on Y axis
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if the ellipse is out of the clipping rectangle
+		 */	
+        bool    fill_ellipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color);
+
+        /**
+		 * @brief    Draw a closed polygon
+		 * @param points - const int16_t * - x and y positions of the points (x0, y0, x1, y1...)
+		 * @param nb_points - uint8_t - number of points
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if the polygon has less than 2 points
+		 */	
+        bool    draw_polygon(const int16_t *points, uint8_t nb_points, uint16_t color);
+
+        /**
+		 * @brief    Draw a filled polygon - scanline algorithm, even-odd rule
+		 * @param points - const int16_t * - x and y positions of the points (x0, y0, x1, y1...)
+		 * @param nb_points - uint8_t - number of points, up to LCD_POLYGON_MAX
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if the number of points is out of range
+		 */	
+        bool    fill_polygon(const int16_t *points, uint8_t nb_points, uint16_t color);
+
+        /**
+		 * @brief    Draw a bitmap of 1 bit per pixel - one span per run of pixels
+		 * @param x - int16_t - x position of the top-left corner
+		 * @param y - int16_t - y position of the top-left corner
+		 * @param w - uint16_t - width of the bitmap
+		 * @param h - uint16_t - height of the bitmap
+		 * @param bitmap - const uint8_t * - rows of (w+7)/8 bytes, MSB first (left pixel)
+		 * @param color - uint16_t - Color of the pixels at 1, pixels at 0 are not drawn
+         * @return  false if the bitmap is out of the clipping rectangle
+		 */	
+        bool    draw_bitmap(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t *bitmap, uint16_t color);
+
+        /**
+		 * @brief    Draw a compressed image - one span per run of the decoder
+		 * @details  No decode buffer. LCD library can override it to stream
+		 *      the pixels to the memory of the screen (see ST7735).
+		 * @param x - int16_t - x position of the top-left corner
+		 * @param y - int16_t - y position of the top-left corner
+		 * @param img - const LCD_Image * - image (see LCD_image.h)
+         * @return  false if the image is out of the clipping rectangle
+		 */	
+        virtual bool    draw_image(int16_t x, int16_t y, const LCD_Image *img);
+
+        /**
+		 * @brief    Set the clipping rectangle of the primitives
+		 * @details  The rectangle is limited to the screen.
+		 * @param x0 - int16_t - left column
+		 * @param y0 - int16_t - top row
+		 * @param x1 - int16_t - right column
+		 * @param y1 - int16_t - bottom row
+         * @return  false if the rectangle is out of the screen
+		 */	
+        bool    set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+        /**
+		 * @brief    Set the clipping rectangle to the whole screen
+		 */	
+        void    reset_clip(void);
+
 
         /**
 		 * @brief   Draw a character on the screen
@@ -124,11 +237,130 @@ class LCD_graphics {
 		 */
 		bool 	draw_string(char *str, uint16_t color, enum Size size);
 
+        /**
+		 * @brief   Draw a character with an integer scale factor
+		 * @details  Each column of the font is expanded by tables (one bit
+		 *      to scale bits), then written by write_glyph in one call when
+		 *      the character is in the clipping rectangle.
+		 * @param character - char - character to draw
+		 * @param color - uint16_t - Color of the character
+		 * @param scale - uint8_t - scale factor, 1 to LCD_SCALE_MAX
+		 * @return false if character is not in the font or if the scale is out of range
+		 */
+        virtual bool    draw_char_scale(char character, uint16_t color, uint8_t scale);
+
+		/**
+		 * @brief    Draw a string of characters with an integer scale factor
+		 * @param str - const char * - String to display
+		 * @param color - uint16_t - Color of the string
+		 * @param scale - uint8_t - scale factor, 1 to LCD_SCALE_MAX
+		 * @return  false if the string of characters is too large for the screen
+		 */
+        bool    draw_string_scale(const char *str, uint16_t color, uint8_t scale);
+
+		/**
+		 * @brief    Draw the characters on a background color - whole cell of each character
+		 * @details  Readouts overwrite the previous characters without clearing them first.
+		 * @param color - uint16_t - background color
+		 */
+        void    set_text_background(uint16_t color);
+
+		/**
+		 * @brief    Draw only the pixels of the characters (default)
+		 */
+        void    set_text_transparent(void);
+
+
+    protected:
+		/**
+		 * @brief    Set the size of the screen - called by the LCD library
+		 * @param width - uint16_t - number of columns
+		 * @param height - uint16_t - number of rows
+		 */
+        void    set_screen(uint16_t width, uint16_t height);
+
+		/**
+		 * @brief    Write a pixel in the clipping rectangle - no range check
+		 * @details  Calls draw_pixel by default.
+		 */
+        virtual void    write_pixel(uint16_t x, uint16_t y, uint16_t color);
+
+		/**
+		 * @brief    Write a horizontal span in the clipping rectangle - no range check
+		 * @details  Calls write_pixel by default.
+		 * @param x0 - uint16_t - first column
+		 * @param x1 - uint16_t - last column, x1 >= x0
+		 * @param y - uint16_t - row
+		 * @param color - uint16_t - Color in 16 bits mode
+		 */
+        virtual void    write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color);
+
+		/**
+		 * @brief    Write a scaled character in the clipping rectangle - no range check
+		 * @details  Spans of the rows by default. The cell of the character is
+		 *      (CHARS_COLS_LEN+1)*scale columns and CHARS_ROWS_LEN*scale rows.
+		 * @param x - uint16_t - left column of the cell
+		 * @param y - uint16_t - top row of the cell
+		 * @param columns - const uint64_t * - CHARS_COLS_LEN+1 expanded columns, bit 0 at the top
+		 * @param scale - uint8_t - scale factor
+		 * @param color - uint16_t - Color of the character
+		 * @param opaque - bool - true to draw the background of the cell
+		 * @param bg - uint16_t - background color
+		 */
+        virtual void    write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+                                    uint16_t color, bool opaque, uint16_t bg);
+
+        /**
+		 * @brief    Check if a bounding box is inside the clipping rectangle
+		 */
+        bool    is_inside(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+        /**
+		 * @brief    Return the clipping rectangle - inclusive
+		 */
+        void    get_clip(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1);
 
     private:
         /// Text cursor position
         uint16_t        __text_x;
         uint16_t        __text_y;
+        /// Background of the characters
+        bool            __text_opaque;
+        uint16_t        __text_bg;
+        /// Size of the screen
+        int16_t         __screen_w;
+        int16_t         __screen_h;
+        /// Clipping rectangle - inclusive
+        int16_t         __clip_x0;
+        int16_t         __clip_y0;
+        int16_t         __clip_x1;
+        int16_t         __clip_y1;
+
+        /**
+		 * @brief    Cohen-Sutherland region code of a point
+		 */
+        uint8_t out_code(int32_t x, int32_t y);
+
+        /**
+		 * @brief    Clip a line to the clipping rectangle (Cohen-Sutherland)
+         * @return  false if the line is out of the clipping rectangle
+		 */
+        bool    clip_line(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1);
+
+        /**
+		 * @brief    Draw a pixel if it is in the clipping rectangle
+		 */
+        void    plot(int16_t x, int16_t y, uint16_t color);
+
+        /**
+		 * @brief    Draw a horizontal span clipped to the clipping rectangle
+		 */
+        void    span(int16_t x0, int16_t x1, int16_t y, uint16_t color);
+
+        /**
+		 * @brief    Check if a bounding box crosses the clipping rectangle
+		 */
+        bool    is_visible(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,330 @@
+/**
+ * FILENAME :        LCD_graphics_t.h
+ *
+ * DESCRIPTION :
+ *       Graphics core library for LCD display - compile-time version.
+ *       Same primitives as LCD_graphics, templated on the LCD library :
+ *      the pixels are written by inline methods of the LCD library,
+ *      without virtual call. LCD_graphics is still available for the
+ *      code which needs a runtime choice of the display (widgets...).
+ *       LCD library must implement (public, inline in its header) :
+ *          -> void put_pixel(uint16_t x, uint16_t y, uint16_t color)
+ *          -> void put_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+ *              (no range check - primitives are clipped before)
+ *          -> uint16_t get_width(void), uint16_t get_height(void)
+ *
+ *       SSD1306     my_lcd(&my_i2c, MAX_X, MAX_Y);
+ *       LCD_graphics_t<SSD1306>    my_gfx(&my_lcd);
+ *       my_gfx.draw_line(0, 0, 127, 63, SSD1306_WHITE);
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __LCD_GRAPHICS_T_H__
+#define __LCD_GRAPHICS_T_H__
+
+#include "mbed.h"
+#include "font.h"
+#include "LCD_graphics.h"
+#include "LCD_glyph.h"
+#include <cstdint>
+
+/**
+ * @class LCD_graphics_t
+ * @brief 	Graphics primitives inlined in the LCD library
+ * @details  All the methods are in this header : the compiler
+ *      inlines put_pixel and put_span of the LCD library in the loops
+ *      of the primitives.
+ */
+template <class LCD>
+class LCD_graphics_t {
+    private:
+        /// LCD library
+        LCD             *__lcd;
+        /// Text cursor position
+        uint16_t        __text_x;
+        uint16_t        __text_y;
+        /// Size of the screen
+        int16_t         __screen_w;
+        int16_t         __screen_h;
+        /// Clipping rectangle - inclusive
+        int16_t         __clip_x0;
+        int16_t         __clip_y0;
+        int16_t         __clip_x1;
+        int16_t         __clip_y1;
+
+        /**
+		 * @brief    Check if the coordinates are in the range of the screen size
+		 * @details  Same test as check_range of the LCD libraries - the pixels are clipped after.
+		 */
+        inline bool check_range(uint16_t x, uint16_t y)
+        {
+            return ((x <= this->__screen_w) && (y <= this->__screen_h));
+        }
+
+        /**
+		 * @brief    Draw a horizontal span clipped to the clipping rectangle
+		 */
+        inline void span(int16_t x0, int16_t x1, int16_t y, uint16_t color)
+        {
+            if ((y < this->__clip_y0) || (y > this->__clip_y1)) { return; }
+            if (x0 < this->__clip_x0) { x0 = this->__clip_x0; }
+            if (x1 > this->__clip_x1) { x1 = this->__clip_x1; }
+            if (x0 > x1) { return; }
+            this->__lcd->put_span(x0, x1, y, color);
+        }
+
+        /**
+		 * @brief    Cohen-Sutherland region code of a point - CLIP_* of LCD_graphics.cpp
+		 */
+        inline uint8_t out_code(int32_t x, int32_t y)
+        {
+            uint8_t code = 0;
+            if (x < this->__clip_x0) { code |= 0x01; }
+            else if (x > this->__clip_x1) { code |= 0x02; }
+            if (y < this->__clip_y0) { code |= 0x04; }
+            else if (y > this->__clip_y1) { code |= 0x08; }
+            return code;
+        }
+
+        /**
+		 * @brief    Clip a line to the clipping rectangle (Cohen-Sutherland)
+         * @return  false if the line is out of the clipping rectangle
+		 */
+        bool    clip_line(int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1)
+        {
+            int32_t     xa = x0, ya = y0, xb = x1, yb = y1;
+            uint8_t     code_a = this->out_code(xa, ya);
+            uint8_t     code_b = this->out_code(xb, yb);
+            while (code_a | code_b) {
+                // both points on the same outside side
+                if (code_a & code_b) { return LCD_ERROR; }
+                // move the outside point to the border - rounded to the nearest pixel
+                uint8_t     code = code_a ? code_a : code_b;
+                int32_t     x, y, dx = xb - xa, dy = yb - ya;
+                if (code & 0x08) {
+                    y = this->__clip_y1;
+                    x = xa + (2 * dx * (y - ya) + dy) / (2 * dy);
+                }
+                else if (code & 0x04) {
+                    y = this->__clip_y0;
+                    x = xa + (2 * dx * (y - ya) + dy) / (2 * dy);
+                }
+                else if (code & 0x02) {
+                    x = this->__clip_x1;
+                    y = ya + (2 * dy * (x - xa) + dx) / (2 * dx);
+                }
+                else {
+                    x = this->__clip_x0;
+                    y = ya + (2 * dy * (x - xa) + dx) / (2 * dx);
+                }
+                if (code == code_a) { xa = x; ya = y; code_a = this->out_code(xa, ya); }
+                else { xb = x; yb = y; code_b = this->out_code(xb, yb); }
+            }
+            x0 = xa; y0 = ya; x1 = xb; y1 = yb;
+            return LCD_SUCCESS;
+        }
+
+    public:
+        /**
+		 * @brief    Simple constructor of the LCD_graphics_t class
+		 * @param lcd - LCD * - LCD library, size of the screen already set
+		 */
+        LCD_graphics_t(LCD *lcd)
+        {
+            this->__lcd = lcd;
+            this->__text_x = 0;
+            this->__text_y = 0;
+            this->__screen_w = lcd->get_width();
+            this->__screen_h = lcd->get_height();
+            this->reset_clip();
+        }
+
+        /**
+		 * @brief    Set the clipping rectangle of the primitives - limited to the screen
+         * @return  false if the rectangle is out of the screen
+		 */
+        bool    set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+        {
+            if (x0 < 0) { x0 = 0; }
+            if (y0 < 0) { y0 = 0; }
+            if (x1 > this->__screen_w - 1) { x1 = this->__screen_w - 1; }
+            if (y1 > this->__screen_h - 1) { y1 = this->__screen_h - 1; }
+            if ((x0 > x1) || (y0 > y1)) { return LCD_ERROR; }
+            this->__clip_x0 = x0;
+            this->__clip_y0 = y0;
+            this->__clip_x1 = x1;
+            this->__clip_y1 = y1;
+            return LCD_SUCCESS;
+        }
+
+        /**
+		 * @brief    Set the clipping rectangle to the whole screen
+		 */
+        void    reset_clip(void)
+        {
+            this->__clip_x0 = 0;
+            this->__clip_y0 = 0;
+            this->__clip_x1 = this->__screen_w - 1;
+            this->__clip_y1 = this->__screen_h - 1;
+        }
+
+        /**
+		 * @brief    Set the text cursor position
+		 * @return true if is in the range of the screen size
+		 */
+        bool    set_position(uint16_t x, uint16_t y)
+        {
+            if (!this->check_range(x, y)) { return LCD_ERROR; }
+            this->__text_x = x;
+            this->__text_y = y;
+            return LCD_SUCCESS;
+        }
+
+		/**
+		 * @brief    Draw a pixel at a specific position
+         * @return  false if x and y are out of the clipping rectangle
+		 */
+        inline bool draw_pixel(int16_t x, int16_t y, uint16_t color)
+        {
+            if ((x < this->__clip_x0) || (x > this->__clip_x1) || (y < this->__clip_y0) || (y > this->__clip_y1)) { return LCD_ERROR; }
+            this->__lcd->put_pixel(x, y, color);
+            return LCD_SUCCESS;
+        }
+
+		/**
+		 * @brief    Draw a line using Bresenham's Algorithm - clipped (Cohen-Sutherland)
+         * @return  false if the line is out of the clipping rectangle
+		 */
+        bool    draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+        {
+            if (!this->clip_line(x0, y0, x1, y1)) { return LCD_ERROR; }
+            // horizontal line
+            if (y0 == y1) {
+                if (x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }
+                this->__lcd->put_span(x0, x1, y0, color);
+                return LCD_SUCCESS;
+            }
+            // Bresenham's Algorithm
+            int8_t      sx = (x0 > x1) ? -1 : 1;
+            int8_t      sy = (y0 > y1) ? -1 : 1;
+            int16_t     dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+            int16_t     dy = (y1 > y0) ? y1 - y0 : y0 - y1;
+            int16_t     err = dx - dy, e2;
+            // all the pixels are in the clipping rectangle
+            this->__lcd->put_pixel(x0, y0, color);
+            while ((x0 != x1) || (y0 != y1)) {
+                e2 = err << 1;
+                if (e2 > -dy) { err -= dy; x0 += sx; }
+                if (e2 < dx) { err += dx; y0 += sy; }
+                this->__lcd->put_pixel(x0, y0, color);
+            }
+            return LCD_SUCCESS;
+        }
+
+        /**
+		 * @brief    Draw a rectangle using its top-left corner and its dimension
+         * @return  false if x, y, x+w and y+h are out of range
+		 */
+        bool    draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+        {
+            if (!this->check_range(x, y) || !this->check_range(x+w, y+h)) { return LCD_ERROR; }
+            this->draw_line(x, y, x+w, y, color);
+            this->draw_line(x, y+h, x+w, y+h, color);
+            this->draw_line(x, y, x, y+h, color);
+            this->draw_line(x+w, y, x+w, y+h, color);
+            return LCD_SUCCESS;
+        }
+
+        /**
+		 * @brief    Draw a filled rectangle - same pixels as LCD_graphics::fill_rect
+         * @return  false if x, y, x+w and y+h are out of range
+		 */
+        bool    fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+        {
+            if (!this->check_range(x, y) || !this->check_range(x+w, y+h)) { return LCD_ERROR; }
+            if (w <= 0) { return LCD_SUCCESS; }
+            for (int16_t j = y; j <= y+h; j++) {
+                this->span(x, x+w-1, j, color);
+            }
+            return LCD_SUCCESS;
+        }
+
+        /**
+		 * @brief    Draw a filled circle - one span per line
+         * @return  false if the circle is out of the clipping rectangle
+		 */
+        bool    fill_circle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+        {
+            if (r < 0) { return LCD_ERROR; }
+            if ((x0 + r < this->__clip_x0) || (x0 - r > this->__clip_x1) ||
+                (y0 + r < this->__clip_y0) || (y0 - r > this->__clip_y1)) { return LCD_ERROR; }
+            int16_t     x = r, y = 0;
+            int16_t     err = 1 - r;
+            while (x >= y) {
+                this->span(x0 - x, x0 + x, y0 + y, color);
+                if (y != 0) { this->span(x0 - x, x0 + x, y0 - y, color); }
+                y++;
+                if (err < 0) { err += 2*y + 1; }
+                else {
+                    // spans of the top and bottom octants, before x changes
+                    if (x >= y) {
+                        this->span(x0 - y + 1, x0 + y - 1, y0 + x, color);
+                        this->span(x0 - y + 1, x0 + y - 1, y0 - x, color);
+                    }
+                    x--;
+                    err += 2*(y - x) + 1;
+                }
+            }
+            return LCD_SUCCESS;
+        }
+
+		/**
+		 * @brief    Draw a character at the text cursor position
+		 * @param character - char - Character to display
+		 * @param color - uint16_t - Color of the character
+		 * @param size - enum Size - (NORMAL, LARGE, HUGE)
+		 * @return  false if the character is not in the font
+		 */
+        bool    draw_char(char character, uint16_t color, enum Size size)
+        {
+            if ((character < MIN_ASCII_CHAR) || (character > MAX_ASCII_CHAR)) { return LCD_ERROR; }
+            uint8_t     scale = (size == HUGE) ? 4 : ((size == LARGE) ? 2 : 1);
+            // expanded columns, then one span per run of set bits on each row
+            uint64_t    columns[CHARS_COLS_LEN + 1];
+            lcd_glyph_columns(character, scale, columns);
+            for (uint8_t row = 0; row < CHARS_ROWS_LEN * scale; row++) {
+                uint8_t     c = 0;
+                while (c < CHARS_COLS_LEN) {
+                    if (!((columns[c] >> row) & 1)) { c++; continue; }
+                    uint8_t start = c;
+                    while ((columns[c] >> row) & 1) { c++; }
+                    this->span(this->__text_x + start * scale, this->__text_x + c * scale - 1,
+                                this->__text_y + row, color);
+                }
+            }
+            this->__text_x += scale*(CHARS_COLS_LEN + 1);
+            return LCD_SUCCESS;
+        }
+
+		/**
+		 * @brief    Draw a string of characters at the text cursor position
+		 * @return  false if the first character is out of the screen
+		 */
+        bool    draw_string(const char *str, uint16_t color, enum Size size)
+        {
+            if (!this->check_range(this->__text_x + ((CHARS_COLS_LEN+1) * size),
+                                    this->__text_y + (CHARS_ROWS_LEN * size))) { return LCD_ERROR; }
+            while (*str != '\0') {
+                this->draw_char(*str++, color, size);
+            }
+            return LCD_SUCCESS;
+        }
+};
+
+#endif
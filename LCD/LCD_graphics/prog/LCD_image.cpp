@@ -0,0 +1,82 @@
+/**
+ * FILENAME :        LCD_image.cpp
+ *
+ * DESCRIPTION :
+ *       Compressed images for LCD display - palette and RLE.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "LCD_image.h"
+
+LCD_ImageDecoder::LCD_ImageDecoder(const LCD_Image *img)
+{
+    this->__img = img;
+    this->rewind();
+}
+
+void    LCD_ImageDecoder::rewind(void)
+{
+    this->__ptr = this->__img->data;
+    this->__end = this->__img->data + this->__img->size;
+    this->__count = 0;
+    this->__repeat = false;
+    this->__value = 0;
+    this->__bit = 0;
+}
+
+uint16_t    LCD_ImageDecoder::next_run(uint8_t *index, uint16_t max)
+{
+    if (max == 0) { return 0; }
+    // next control byte
+    if (this->__count == 0) {
+        if (this->__ptr >= this->__end) { return 0; }
+        uint8_t ctrl = *this->__ptr++;
+        this->__count = (ctrl & LCD_IMAGE_COUNT) + 1;
+        this->__repeat = (ctrl & LCD_IMAGE_REPEAT);
+        this->__bit = 0;
+        if (this->__repeat) {
+            if (this->__ptr >= this->__end) { this->__count = 0; return 0; }
+            this->__value = *this->__ptr++;
+        }
+    }
+    // repeated index
+    if (this->__repeat) {
+        uint16_t len = (this->__count < max) ? this->__count : max;
+        this->__count -= len;
+        *index = this->__value;
+        return len;
+    }
+    // literal index - MSB first
+    if (this->__ptr >= this->__end) { this->__count = 0; return 0; }
+    uint8_t bits = this->__img->bits;
+    *index = (*this->__ptr >> (8 - bits - this->__bit)) & ((1 << bits) - 1);
+    this->__bit += bits;
+    this->__count--;
+    // next byte, or padding at the end of the literal run
+    if ((this->__bit == 8) || (this->__count == 0)) {
+        this->__bit = 0;
+        this->__ptr++;
+    }
+    return 1;
+}
+
+uint32_t    LCD_ImageDecoder::benchmark(const LCD_Image *img)
+{
+    LCD_ImageDecoder    dec(img);
+    uint8_t     index;
+    uint32_t    nb_pixels = 0;
+    uint16_t    len;
+    uint32_t    start = us_ticker_read();
+    while ((len = dec.next_run(&index, UINT16_MAX)) > 0) {
+        nb_pixels += len;
+    }
+    uint32_t    time = us_ticker_read() - start;
+    if (time == 0) { return 0; }
+    return (uint32_t)((uint64_t)nb_pixels * 1000000 / time);
+}
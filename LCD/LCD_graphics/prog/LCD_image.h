@@ -0,0 +1,104 @@
+/**
+ * FILENAME :        LCD_image.h
+ *
+ * DESCRIPTION :
+ *       Compressed images for LCD display - palette and RLE.
+ *       Images are converted on the computer by tools/image_convert.py
+ *      into a header file of constant arrays (in the flash memory) :
+ *          -> a palette of up to 256 colors in 16 bits mode (RGB565),
+ *              2 colors for a monochrome image
+ *          -> the indexes of the pixels, row after row, compressed by runs :
+ *              - control byte 1nnnnnnn : next byte repeated nnnnnnn+1 times
+ *              - control byte 0nnnnnnn : nnnnnnn+1 indexes of 'bits' bits,
+ *                  packed MSB first, padded to the next byte
+ *      LCD_ImageDecoder reads the runs one after the other, without a
+ *      decode buffer : the pixels go directly to the spans of the
+ *      LCD library (LCD_graphics::draw_image) or to its RAM write
+ *      (ST7735::draw_image).
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __LCD_IMAGE_H__
+#define __LCD_IMAGE_H__
+
+#include "mbed.h"
+#include <cstdint>
+
+/** Constant definition */
+/// Control byte of a run of the same index
+#define LCD_IMAGE_REPEAT    0x80
+#define LCD_IMAGE_COUNT     0x7F
+
+/**
+ * @struct LCD_Image
+ * @brief Compressed image - generated by tools/image_convert.py
+ */
+struct LCD_Image {
+    /// Size of the image in pixels
+    uint16_t        width;
+    uint16_t        height;
+    /// Number of bits of an index in the literal runs : 1, 2, 4 or 8
+    uint8_t         bits;
+    /// Palette - colors in 16 bits mode
+    uint16_t        nb_colors;
+    const uint16_t  *palette;
+    /// Compressed indexes
+    const uint8_t   *data;
+    uint32_t        size;
+};
+
+/**
+ * @class LCD_ImageDecoder
+ * @brief 	Streaming decoder of a compressed image
+ */
+class LCD_ImageDecoder {
+    private:
+        /// Image in progress
+        const LCD_Image *__img;
+        /// Next byte of the data
+        const uint8_t   *__ptr;
+        const uint8_t   *__end;
+        /// Run in progress : remaining indexes, repeated or literal
+        uint8_t     __count;
+        bool        __repeat;
+        uint8_t     __value;
+        /// Position of the next index in the byte of a literal run
+        uint8_t     __bit;
+
+    public:
+        /**
+		 * @brief    Simple constructor of the LCD_ImageDecoder class
+		 * @param img - const LCD_Image * - image to decode
+		 */
+        LCD_ImageDecoder(const LCD_Image *img);
+
+        /**
+		 * @brief    Go back to the first pixel of the image
+		 */
+        void        rewind(void);
+
+        /**
+		 * @brief    Read the next pixels of the same index
+		 * @param index - uint8_t * - index of the pixels in the palette
+		 * @param max - uint16_t - maximum number of pixels (end of the row...)
+         * @return  number of pixels, 0 at the end of the data
+		 */
+        uint16_t    next_run(uint8_t *index, uint16_t max);
+
+        /**
+		 * @brief    Decode the whole image without drawing it
+		 * @details  Throughput of the decoder on the target (on a computer :
+		 *      tests/main_golden.cpp).
+		 * @param img - const LCD_Image * - image to decode
+         * @return  number of decoded pixels per second
+		 */
+        static uint32_t benchmark(const LCD_Image *img);
+};
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * FILENAME :        LCD_widgets.cpp
+ *
+ * DESCRIPTION :
+ *       Retained-mode widgets for LCD display, over LCD_graphics.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "LCD_widgets.h"
+
+/**************************************************************
+ *	Widgets
+ **************************************************************/
+
+LCD_Widget::LCD_Widget(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    this->__x = x;
+    this->__y = y;
+    this->__w = w;
+    this->__h = h;
+    this->__color = color;
+    this->__visible = true;
+    this->__screen = NULL;
+    this->next = NULL;
+}
+
+void    LCD_Widget::invalidate(void)
+{
+    if (this->__screen) { this->__screen->invalidate(this->get_rect()); }
+}
+
+void    LCD_Widget::set_color(uint16_t color)
+{
+    if (color == this->__color) { return; }
+    this->__color = color;
+    this->invalidate();
+}
+
+void    LCD_Widget::set_visible(bool visible)
+{
+    if (visible == this->__visible) { return; }
+    this->__visible = visible;
+    this->invalidate();
+}
+
+LCD_Rect    LCD_Widget::get_rect(void)
+{
+    LCD_Rect    r = {this->__x, this->__y, (int16_t)(this->__x + this->__w - 1), (int16_t)(this->__y + this->__h - 1)};
+    return r;
+}
+
+/**************************************************************/
+LCD_Label::LCD_Label(int16_t x, int16_t y, uint8_t nb_chars, uint16_t color, enum Size size) :
+    LCD_Widget(x, y, nb_chars * (CHARS_COLS_LEN + 1) * size, CHARS_ROWS_LEN * size, color)
+{
+    this->__text[0] = '\0';
+    this->__size = size;
+}
+
+void    LCD_Label::set_text(const char *text)
+{
+    if (strncmp(this->__text, text, LCD_TEXT_MAX) == 0) { return; }
+    strncpy(this->__text, text, LCD_TEXT_MAX);
+    this->__text[LCD_TEXT_MAX] = '\0';
+    this->invalidate();
+}
+
+void    LCD_Label::paint(LCD_graphics *lcd)
+{
+    if (lcd->set_position(this->__x, this->__y)) {
+        lcd->draw_string(this->__text, this->__color, this->__size);
+    }
+}
+
+/**************************************************************/
+LCD_Number::LCD_Number(int16_t x, int16_t y, uint8_t nb_chars, uint16_t color, const char *format, enum Size size) :
+    LCD_Widget(x, y, nb_chars * (CHARS_COLS_LEN + 1) * size, CHARS_ROWS_LEN * size, color)
+{
+    this->__format = format;
+    this->__value = 0;
+    this->__valid = false;
+    this->__size = size;
+}
+
+void    LCD_Number::set_value(int32_t value)
+{
+    if (this->__valid && (value == this->__value)) { return; }
+    this->__value = value;
+    this->__valid = true;
+    this->invalidate();
+}
+
+void    LCD_Number::paint(LCD_graphics *lcd)
+{
+    char    str[LCD_TEXT_MAX + 1];
+    if (!this->__valid) { return; }
+    snprintf(str, sizeof(str), this->__format, (int)this->__value);
+    if (lcd->set_position(this->__x, this->__y)) {
+        lcd->draw_string(str, this->__color, this->__size);
+    }
+}
+
+/**************************************************************/
+LCD_Bar::LCD_Bar(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color, uint16_t max) :
+    LCD_Widget(x, y, w, h, color)
+{
+    this->__value = 0;
+    this->__max = (max > 0) ? max : 1;
+    this->__length = 0;
+}
+
+void    LCD_Bar::set_value(uint16_t value)
+{
+    if (value > this->__max) { value = this->__max; }
+    this->__value = value;
+    // inside the frame of 1 pixel
+    uint16_t length = (uint32_t)value * (this->__w - 2) / this->__max;
+    if (length == this->__length) { return; }
+    // part of the bar between the old and the new length
+    LCD_Rect    r;
+    r.x0 = this->__x + 1 + ((length < this->__length) ? length : this->__length);
+    r.x1 = this->__x + ((length > this->__length) ? length : this->__length);
+    r.y0 = this->__y + 1;
+    r.y1 = this->__y + this->__h - 2;
+    this->__length = length;
+    if (this->__screen) { this->__screen->invalidate(r); }
+}
+
+void    LCD_Bar::paint(LCD_graphics *lcd)
+{
+    lcd->draw_rect(this->__x, this->__y, this->__w - 1, this->__h - 1, this->__color);
+    if (this->__length > 0) {
+        lcd->fill_rect(this->__x + 1, this->__y + 1, this->__length, this->__h - 3, this->__color);
+    }
+}
+
+/**************************************************************/
+LCD_Icon::LCD_Icon(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color, const uint8_t *bitmap) :
+    LCD_Widget(x, y, w, h, color)
+{
+    this->__bitmap = bitmap;
+}
+
+void    LCD_Icon::set_bitmap(const uint8_t *bitmap)
+{
+    if (bitmap == this->__bitmap) { return; }
+    this->__bitmap = bitmap;
+    this->invalidate();
+}
+
+void    LCD_Icon::paint(LCD_graphics *lcd)
+{
+    if (this->__bitmap == NULL) { return; }
+    lcd->draw_bitmap(this->__x, this->__y, this->__w, this->__h, this->__bitmap, this->__color);
+}
+
+
+/**************************************************************
+ *	Screen
+ **************************************************************/
+
+/** Area of a rectangle */
+static int32_t  rect_area(const LCD_Rect &r)
+{
+    return (int32_t)(r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+}
+
+/** Smallest rectangle containing two rectangles */
+static LCD_Rect rect_union(const LCD_Rect &a, const LCD_Rect &b)
+{
+    LCD_Rect    r;
+    r.x0 = (a.x0 < b.x0) ? a.x0 : b.x0;
+    r.y0 = (a.y0 < b.y0) ? a.y0 : b.y0;
+    r.x1 = (a.x1 > b.x1) ? a.x1 : b.x1;
+    r.y1 = (a.y1 > b.y1) ? a.y1 : b.y1;
+    return r;
+}
+
+/** True if two rectangles overlap or touch */
+static bool     rect_touch(const LCD_Rect &a, const LCD_Rect &b)
+{
+    return ((a.x0 <= b.x1 + 1) && (b.x0 <= a.x1 + 1) && (a.y0 <= b.y1 + 1) && (b.y0 <= a.y1 + 1));
+}
+
+LCD_Screen::LCD_Screen(LCD_graphics *lcd, uint16_t bg_color)
+{
+    this->__lcd = lcd;
+    this->__bg_color = bg_color;
+    this->__first = NULL;
+    this->__last = NULL;
+    this->__nb_dirty = 0;
+}
+
+void    LCD_Screen::add(LCD_Widget *widget)
+{
+    widget->__screen = this;
+    widget->next = NULL;
+    if (this->__first == NULL) { this->__first = widget; }
+    else { this->__last->next = widget; }
+    this->__last = widget;
+    widget->invalidate();
+}
+
+void    LCD_Screen::invalidate(LCD_Rect rect)
+{
+    if ((rect.x1 < rect.x0) || (rect.y1 < rect.y0)) { return; }
+    if (this->__nb_dirty == LCD_DIRTY_MAX) {
+        // merged with the rectangle which grows the least
+        uint8_t     best = 0;
+        int32_t     best_growth = INT32_MAX;
+        for (uint8_t k = 0; k < this->__nb_dirty; k++) {
+            int32_t growth = rect_area(rect_union(this->__dirty[k], rect)) - rect_area(this->__dirty[k]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = k;
+            }
+        }
+        this->__dirty[best] = rect_union(this->__dirty[best], rect);
+    }
+    else {
+        this->__dirty[this->__nb_dirty++] = rect;
+    }
+    this->merge();
+}
+
+void    LCD_Screen::merge(void)
+{
+    bool    merged = true;
+    while (merged) {
+        merged = false;
+        for (uint8_t i = 0; i < this->__nb_dirty; i++) {
+            for (uint8_t j = i + 1; j < this->__nb_dirty; j++) {
+                LCD_Rect    u = rect_union(this->__dirty[i], this->__dirty[j]);
+                // overlapping, or no larger than the two rectangles
+                if (rect_touch(this->__dirty[i], this->__dirty[j]) ||
+                    (rect_area(u) <= rect_area(this->__dirty[i]) + rect_area(this->__dirty[j]))) {
+                    this->__dirty[i] = u;
+                    this->__dirty[j] = this->__dirty[--this->__nb_dirty];
+                    merged = true;
+                    break;
+                }
+            }
+            if (merged) { break; }
+        }
+    }
+}
+
+uint8_t LCD_Screen::refresh(void)
+{
+    uint8_t     nb = this->__nb_dirty;
+    for (uint8_t k = 0; k < nb; k++) {
+        LCD_Rect    *r = &this->__dirty[k];
+        // drawings limited to the rectangle
+        if (!this->__lcd->set_clip(r->x0, r->y0, r->x1, r->y1)) { continue; }
+        this->__lcd->fill_rect(r->x0, r->y0, r->x1 - r->x0 + 1, r->y1 - r->y0, this->__bg_color);
+        for (LCD_Widget *w = this->__first; w != NULL; w = w->next) {
+            if (!w->__visible) { continue; }
+            LCD_Rect    wr = w->get_rect();
+            if ((wr.x1 < r->x0) || (wr.x0 > r->x1) || (wr.y1 < r->y0) || (wr.y0 > r->y1)) { continue; }
+            w->paint(this->__lcd);
+        }
+    }
+    this->__lcd->reset_clip();
+    this->__nb_dirty = 0;
+    return nb;
+}
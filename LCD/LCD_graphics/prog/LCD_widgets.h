@@ -0,0 +1,253 @@
+/**
+ * FILENAME :        LCD_widgets.h
+ *
+ * DESCRIPTION :
+ *       Retained-mode widgets for LCD display, over LCD_graphics.
+ *       Widgets (labels, numbers, bars, icons) are added to a screen.
+ *      A widget is repainted only when its content changes :
+ *          -> setters invalidate the rectangle of the widget
+ *          -> overlapping rectangles are merged
+ *          -> refresh() fills each rectangle with the background and
+ *              repaints the widgets in it, clipped to the rectangle
+ *      The time of a refresh depends on the changed area only.
+ *      With a framebuffer (SSD1306), call display() when refresh()
+ *      returns a non-zero value.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __LCD_WIDGETS_H__
+#define __LCD_WIDGETS_H__
+
+#include "mbed.h"
+#include "LCD_graphics.h"
+
+/** Constant definition */
+/// Maximum number of invalidated rectangles before merging
+#define LCD_DIRTY_MAX       8
+/// Maximum length of the text of a label or a number
+#define LCD_TEXT_MAX        24
+
+class LCD_Screen;
+
+/**
+ * @struct LCD_Rect
+ * @brief Rectangle - inclusive coordinates
+ */
+struct LCD_Rect {
+    int16_t     x0, y0, x1, y1;
+};
+
+/**
+ * @class LCD_Widget
+ * @brief 	Base class of the widgets - position, size and colors
+ */
+class LCD_Widget {
+    protected:
+        /// Rectangle of the widget
+        int16_t     __x, __y;
+        uint16_t    __w, __h;
+        /// Color of the content
+        uint16_t    __color;
+        bool        __visible;
+        /// Screen of the widget - NULL if not added
+        LCD_Screen  *__screen;
+
+        /**
+        * @brief Invalidate the rectangle of the widget.
+        */
+        void        invalidate(void);
+
+        friend class LCD_Screen;
+
+    public:
+        /// Next widget of the screen
+        LCD_Widget  *next;
+
+        /**
+        * @brief Simple constructor of the LCD_Widget class.
+        * @param x - int16_t - x position of the top-left corner
+        * @param y - int16_t - y position of the top-left corner
+        * @param w - uint16_t - width of the widget
+        * @param h - uint16_t - height of the widget
+        * @param color - uint16_t - color of the content
+        */
+        LCD_Widget(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+        /**
+        * @brief Draw the content of the widget - background already filled.
+        * @param lcd - LCD_graphics * - LCD display, clipped to the repainted area
+        */
+        virtual void    paint(LCD_graphics *lcd) = 0;
+
+        /**
+        * @brief Change the color of the content.
+        */
+        void        set_color(uint16_t color);
+
+        /**
+        * @brief Show or hide the widget.
+        */
+        void        set_visible(bool visible);
+
+        /**
+        * @brief Return the rectangle of the widget.
+        */
+        LCD_Rect    get_rect(void);
+};
+
+/**
+ * @class LCD_Label
+ * @brief 	Text of one line
+ */
+class LCD_Label : public LCD_Widget {
+    private:
+        char        __text[LCD_TEXT_MAX + 1];
+        enum Size   __size;
+
+    public:
+        /**
+        * @brief Simple constructor of the LCD_Label class.
+        * @details The width of the widget is nb_chars characters.
+        */
+        LCD_Label(int16_t x, int16_t y, uint8_t nb_chars, uint16_t color, enum Size size = NORMAL);
+
+        /**
+        * @brief Change the text - repainted only if it is different.
+        */
+        void        set_text(const char *text);
+
+        void        paint(LCD_graphics *lcd);
+};
+
+/**
+ * @class LCD_Number
+ * @brief 	Integer value with a printf format
+ */
+class LCD_Number : public LCD_Widget {
+    private:
+        const char  *__format;
+        int32_t     __value;
+        bool        __valid;
+        enum Size   __size;
+
+    public:
+        /**
+        * @brief Simple constructor of the LCD_Number class.
+        * @param format - const char * - printf format of the value (%d, %5d...) - int value
+        */
+        LCD_Number(int16_t x, int16_t y, uint8_t nb_chars, uint16_t color, const char *format = "%d",
+                    enum Size size = NORMAL);
+
+        /**
+        * @brief Change the value - repainted only if it is different.
+        */
+        void        set_value(int32_t value);
+
+        void        paint(LCD_graphics *lcd);
+};
+
+/**
+ * @class LCD_Bar
+ * @brief 	Horizontal bar graph with a frame
+ */
+class LCD_Bar : public LCD_Widget {
+    private:
+        uint16_t    __value;
+        uint16_t    __max;
+        /// Width of the bar in pixels
+        uint16_t    __length;
+
+    public:
+        /**
+        * @brief Simple constructor of the LCD_Bar class.
+        * @param max - uint16_t - value of the full bar
+        */
+        LCD_Bar(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color, uint16_t max);
+
+        /**
+        * @brief Change the value - repainted only if the length of the bar changes.
+        * @details Only the part of the bar between the old and the new length is invalidated.
+        */
+        void        set_value(uint16_t value);
+
+        void        paint(LCD_graphics *lcd);
+};
+
+/**
+ * @class LCD_Icon
+ * @brief 	Bitmap of 1 bit per pixel (see LCD_graphics::draw_bitmap)
+ */
+class LCD_Icon : public LCD_Widget {
+    private:
+        const uint8_t   *__bitmap;
+
+    public:
+        /**
+        * @brief Simple constructor of the LCD_Icon class.
+        */
+        LCD_Icon(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color, const uint8_t *bitmap);
+
+        /**
+        * @brief Change the bitmap - repainted only if it is different.
+        */
+        void        set_bitmap(const uint8_t *bitmap);
+
+        void        paint(LCD_graphics *lcd);
+};
+
+/**
+ * @class LCD_Screen
+ * @brief 	Widgets of a screen and invalidated rectangles
+ */
+class LCD_Screen {
+    private:
+        /// LCD display
+        LCD_graphics    *__lcd;
+        /// Background color
+        uint16_t    __bg_color;
+        /// First and last widgets - painted in this order
+        LCD_Widget  *__first;
+        LCD_Widget  *__last;
+        /// Invalidated rectangles
+        LCD_Rect    __dirty[LCD_DIRTY_MAX];
+        uint8_t     __nb_dirty;
+
+        /**
+        * @brief Merge the invalidated rectangles which overlap.
+        */
+        void        merge(void);
+
+    public:
+        /**
+        * @brief Simple constructor of the LCD_Screen class.
+        * @param lcd - LCD_graphics * - LCD display
+        * @param bg_color - uint16_t - background color
+        */
+        LCD_Screen(LCD_graphics *lcd, uint16_t bg_color);
+
+        /**
+        * @brief Add a widget - painted at the next refresh.
+        */
+        void        add(LCD_Widget *widget);
+
+        /**
+        * @brief Invalidate a rectangle - repainted at the next refresh.
+        * @details Merged with an invalidated rectangle when they overlap,
+        *   or with the closest one when LCD_DIRTY_MAX rectangles are invalidated.
+        */
+        void        invalidate(LCD_Rect rect);
+
+        /**
+        * @brief Repaint the invalidated rectangles.
+        * @return number of repainted rectangles.
+        */
+        uint8_t     refresh(void);
+};
+
+#endif
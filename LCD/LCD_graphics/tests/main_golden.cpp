@@ -0,0 +1,575 @@
+/**
+ * FILENAME :        main_golden.cpp
+ *
+ * DESCRIPTION :
+ *       LCD_graphics / Golden images of the rasteriser, and rate of the
+ *  primitives in pixels/s, on a computer with a stand-in of MBED OS
+ *  (tests/mbed.h). The screens are the ones of tests/sim_screen.h.
+ *
+ *       This program does not depend on MBED OS (from the LCD_graphics directory) :
+ *          g++ -std=c++14 -O2 -Itests -Iprog -I../RB-TFT1.8/prog/libs -I../../SPI_Bus
+ *              tests/main_golden.cpp prog/LCD_graphics.cpp prog/LCD_image.cpp prog/font.cpp
+ *              ../RB-TFT1.8/prog/libs/st7735.cpp ../../SPI_Bus/SPI_Bus.cpp -o golden
+ *          ./golden            -> results, exit code 1 if a check fails
+ *          ./golden update     -> writes the golden images of tests/golden
+ *
+ *       Each scene is drawn in a framebuffer of SIM_WIDTH x SIM_HEIGHT
+ *  pixels and compared pixel by pixel with its golden image (one character
+ *  per pixel, see simColorChar) :
+ *          -> circles and ellipses, outlines and fills, out of the screen
+ *          -> lines in all directions, clipped by the screen and by a
+ *              clipping rectangle, rectangles
+ *          -> polygons and bitmaps
+ *          -> characters, scales 1 to 4 and 7, transparent and opaque,
+ *              on the edges of the clipping rectangle
+ *          -> compressed images (LCD_image.h) of 1, 2, 4 and 8 bits, on
+ *              each edge of the screen and of the clipping rectangle
+ *       The other checks do not need golden images :
+ *          -> a scene drawn with a clipping rectangle is the scene without
+ *              clipping, masked by the rectangle (except the lines and the
+ *              outlines of the polygons : the clipped line starts on the
+ *              edge of the rectangle)
+ *          -> LCD_graphics_t draws the same pixels as LCD_graphics
+ *          -> the ST7735 (characters on a background : blocks of pixels)
+ *              sends the same pixels as the framebuffer. A model of the
+ *              memory of the ST7735 receives the bytes of the SPI interface :
+ *              the bytes of an asynchronous transfer are read at the end of
+ *              the transfer.
+ *          -> LCD_ImageDecoder gives the indexes of images written by hand
+ *              (repeated and literal runs, padding, indexes out of the
+ *              palette) and of the test patterns of tests/sim_image.h, for
+ *              runs of any length, after rewind() and with truncated data
+ *          -> draw_image draws the pixels of these indexes, clipped, and
+ *              the ST7735 sends the same pixels : one window of its memory
+ *              for an image in the clipping rectangle (blocks of
+ *              ST7735_IMAGE_CHUNK pixels), spans for the other ones. The
+ *              indexes out of the palette are black in the window : the
+ *              images are drawn on a black background.
+ *
+ *       The rates are measured on the computer : the Nucleo L476RG (80 MHz)
+ *  is slower, but the ratio between the primitives is about the same.
+ *  The rate of LCD_ImageDecoder is the one of LCD_ImageDecoder::benchmark
+ *  on the target, for a whole screen of each number of bits.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <vector>
+#include <string>
+#include "mbed.h"
+#include "LCD_graphics.h"
+#include "LCD_graphics_t.h"
+#include "st7735.h"
+#include "sim_screen.h"
+#include "sim_image.h"
+
+/** Constant definition */
+/// Clipping rectangle of the clipped scenes
+#define SIM_CLIP_X0         13
+#define SIM_CLIP_Y0         9
+#define SIM_CLIP_X1         74
+#define SIM_CLIP_Y1         50
+
+/* Stand-in of MBED OS */
+int         stub_violations = 0;
+int         stub_pins[STUB_NB_PINS];
+EventQueue  stub_queue;
+
+void stubViolation(const char *what){
+    if(stub_violations < 10){ printf("  stand-in : %s\n", what); }
+    stub_violations++;
+}
+
+EventQueue  *mbed_event_queue(void){
+    return &stub_queue;
+}
+
+
+/**************************************************************
+ *	Scenes
+ **************************************************************/
+
+void sceneCircles(LCD_graphics *lcd){
+    lcd->draw_circle(20, 20, 15, SIM_WHITE);
+    lcd->fill_circle(20, 20, 9, SIM_RED);
+    lcd->fill_circle(20, 20, 0, SIM_GREEN);
+    lcd->fill_circle(55, 30, 1, SIM_WHITE);
+    lcd->fill_circle(70, 20, 2, SIM_WHITE);
+    lcd->draw_circle(48, 48, 3, SIM_BLUE);
+    // out of the screen
+    lcd->fill_circle(-5, 60, 12, SIM_BLUE);
+    lcd->fill_circle(90, 58, 20, SIM_GREEN);
+    lcd->draw_circle(80, 5, 12, SIM_WHITE);
+    lcd->fill_circle(200, 30, 10, SIM_WHITE);
+}
+
+void sceneEllipses(LCD_graphics *lcd){
+    lcd->draw_ellipse(30, 16, 25, 10, SIM_WHITE);
+    lcd->fill_ellipse(30, 16, 18, 5, SIM_RED);
+    lcd->fill_ellipse(75, 30, 6, 20, SIM_GREEN);
+    lcd->draw_ellipse(75, 30, 9, 24, SIM_WHITE);
+    // flat ellipses
+    lcd->fill_ellipse(30, 40, 20, 0, SIM_WHITE);
+    lcd->fill_ellipse(55, 40, 0, 8, SIM_WHITE);
+    lcd->draw_ellipse(20, 52, 3, 1, SIM_BLUE);
+    // out of the screen
+    lcd->fill_ellipse(10, 70, 30, 12, SIM_BLUE);
+    lcd->draw_ellipse(96, 0, 20, 12, SIM_RED);
+}
+
+void sceneLines(LCD_graphics *lcd){
+    // all the octants from the center
+    static const int16_t    ends[][2] = {{90, 35}, {90, 60}, {55, 63}, {40, 63}, {5, 60}, {0, 40},
+                                        {2, 25}, {5, 2}, {40, 0}, {55, 0}, {90, 5}, {95, 30}};
+    for(const int16_t *e : ends){ lcd->draw_line(48, 32, e[0], e[1], SIM_WHITE); }
+    lcd->draw_rect(2, 2, 20, 10, SIM_RED);
+    lcd->fill_rect(70, 50, 15, 8, SIM_GREEN);
+    lcd->draw_line(10, 45, 10, 45, SIM_BLUE);
+    // out of the screen
+    lcd->draw_line(-20, 10, 120, 50, SIM_BLUE);
+    lcd->draw_line(30, -10, 60, 100, SIM_GREEN);
+    lcd->draw_line(-10, 70, 100, -5, SIM_RED);
+    lcd->draw_line(-10, 5, -1, 60, SIM_RED);
+}
+
+void scenePolygons(LCD_graphics *lcd){
+    static const int16_t    triangle[] = {5, 5, 40, 12, 15, 35};
+    static const int16_t    star[] = {70, 2, 76, 20, 94, 20, 80, 31, 86, 50, 70, 39, 54, 50, 60, 31, 46, 20, 64, 20};
+    static const int16_t    outside[] = {-10, 40, 30, 55, 10, 80};
+    static const uint8_t    arrow[] = {0x18, 0x3C, 0x7E, 0xFF, 0x18, 0x18, 0x18, 0x18};
+    lcd->fill_polygon(triangle, 3, SIM_RED);
+    lcd->draw_polygon(triangle, 3, SIM_WHITE);
+    lcd->fill_polygon(star, 10, SIM_GREEN);
+    lcd->draw_polygon(star, 10, SIM_WHITE);
+    lcd->fill_polygon(outside, 3, SIM_BLUE);
+    lcd->draw_bitmap(40, 40, 8, 8, arrow, SIM_WHITE);
+    lcd->draw_bitmap(92, 56, 8, 8, arrow, SIM_WHITE);
+}
+
+void sceneGlyphs(LCD_graphics *lcd){
+    lcd->set_position(1, 1);
+    lcd->draw_string((char *)"Ab0;~", SIM_WHITE, NORMAL);
+    lcd->set_position(60, 0);
+    lcd->draw_string_scale("Xy", SIM_GREEN, 3);
+    lcd->set_position(1, 10);
+    lcd->draw_string((char *)"Gj%", SIM_RED, LARGE);
+    lcd->set_position(50, 26);
+    lcd->draw_string_scale("g", SIM_BLUE, 7);
+    // on a background - several blocks of pixels of the ST7735 for HUGE
+    lcd->set_text_background(SIM_BLUE);
+    lcd->set_position(2, 28);
+    lcd->draw_string((char *)"W8", SIM_WHITE, HUGE);
+    lcd->set_position(34, 10);
+    lcd->draw_string((char *)"Ok", SIM_WHITE, LARGE);
+    lcd->set_position(66, 56);
+    lcd->draw_string((char *)"#-", SIM_WHITE, NORMAL);
+    lcd->set_text_transparent();
+    // on the right edge of the screen
+    lcd->set_position(90, 56);
+    lcd->draw_string((char *)"E", SIM_RED, NORMAL);
+}
+
+
+/**************************************************************
+ *	Images
+ **************************************************************/
+
+/* Images of the format of LCD_image.h - runs written by hand */
+const uint16_t  sim_palette[] = {SIM_WHITE, SIM_RED, SIM_GREEN, SIM_BLUE, SIM_BLACK};
+/// 1 bit : repeated run of 128, literal runs padded, repeated run of 0
+const uint8_t   sim_data_1[] = {0xFF, 0x01, 0x09, 0xAA, 0x80, 0x82, 0x00, 0x08, 0xCC, 0x80};
+/// 2 bits : literal run of 5 (padded), repeated run of 11
+const uint8_t   sim_data_2[] = {0x04, 0x1B, 0x80, 0x8A, 0x01};
+/// 4 bits : literal runs of 3 and 1 (index 7 out of the palette), repeated runs
+const uint8_t   sim_data_4[] = {0x02, 0x12, 0x30, 0x83, 0x04, 0x00, 0x70, 0x89, 0x02};
+/// 8 bits : literal runs (index 9 and 17 out of the palette), repeated run
+const uint8_t   sim_data_8[] = {0x03, 0x04, 0x03, 0x02, 0x01, 0x84, 0x00, 0x05, 0x11, 0x01, 0x02, 0x09, 0x00, 0x03};
+
+const LCD_Image sim_img_1 = {10, 15, 1, 2, sim_palette, sim_data_1, sizeof(sim_data_1)};
+const LCD_Image sim_img_2 = {8, 2, 2, 4, sim_palette, sim_data_2, sizeof(sim_data_2)};
+const LCD_Image sim_img_4 = {6, 3, 4, 5, sim_palette, sim_data_4, sizeof(sim_data_4)};
+const LCD_Image sim_img_8 = {5, 3, 8, 5, sim_palette, sim_data_8, sizeof(sim_data_8)};
+
+/**
+ * @struct SimImageCase
+ * @brief Image written by hand and its indexes - one character per index ('0' + index)
+ */
+struct SimImageCase{
+    const char      *name;
+    const LCD_Image *img;
+    const char      *indexes;
+};
+
+const SimImageCase  sim_image_cases[] = {
+    {"1 bit",   &sim_img_1, "11111111111111111111111111111111" "11111111111111111111111111111111"
+                            "11111111111111111111111111111111" "11111111111111111111111111111111"
+                            "1010101010" "000" "110011001"},
+    {"2 bits",  &sim_img_2, "01232" "11111111111"},
+    {"4 bits",  &sim_img_4, "123" "4444" "7" "2222222222"},
+    {"8 bits",  &sim_img_8, "4321" "00000" "A12903"}
+};
+
+/* Test patterns of tools/image_convert.py - index 3 of the 2 bits pattern out of the palette */
+const std::vector<uint16_t>     sim_colors(sim_palette, sim_palette + 4);
+SimImage    sim_pattern_1(24, 16, 1, 2, sim_colors);
+SimImage    sim_pattern_2(40, 24, 2, 3, sim_colors);
+SimImage    sim_pattern_4(30, 20, 4, 16, sim_colors);
+SimImage    sim_pattern_8(20, 16, 8, 256, sim_colors);
+
+/**
+ * @struct SimPlacedImage
+ * @brief Image of the scene and its position
+ */
+struct SimPlacedImage{
+    const LCD_Image *img;
+    int16_t     x, y;
+};
+
+/// In the clipping rectangle, on each edge of the screen and of the clipping rectangle
+const SimPlacedImage    sim_placed[] = {
+    {&sim_pattern_2.img,    28, 20},
+    {&sim_img_8,            10, 48},
+    {&sim_img_1,            -3, -4},
+    {&sim_img_2,            91, 5},
+    {&sim_img_4,            45, 62},
+    {&sim_pattern_1.img,    -6, 30},
+    {&sim_pattern_4.img,    70, 46},
+    {&sim_pattern_8.img,    60, -5}
+};
+
+void sceneImages(LCD_graphics *lcd){
+    for(const SimPlacedImage &p : sim_placed){ lcd->draw_image(p.x, p.y, p.img); }
+    // out of the screen
+    lcd->draw_image(100, 10, &sim_img_4);
+}
+
+/**
+ * @brief Image drawn pixel by pixel from its indexes - in the clipping rectangle.
+ */
+void simDrawIndexes(std::vector<uint16_t> &pixels, const SimPlacedImage &p, const std::vector<uint8_t> &indexes,
+                    int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1){
+    for(size_t k = 0; k < indexes.size(); k++){
+        int16_t     x = p.x + k % p.img->width;
+        int16_t     y = p.y + k / p.img->width;
+        if((x < cx0) || (x > cx1) || (y < cy0) || (y > cy1) || (indexes[k] >= p.img->nb_colors)){ continue; }
+        pixels[y * SIM_WIDTH + x] = p.img->palette[indexes[k]];
+    }
+}
+
+/// Indexes of an image of the scene
+std::vector<uint8_t> simIndexes(const LCD_Image *img){
+    for(const SimImageCase &c : sim_image_cases){
+        if(c.img == img){
+            std::vector<uint8_t>    indexes;
+            for(const char *s = c.indexes; *s; s++){ indexes.push_back(*s - '0'); }
+            return indexes;
+        }
+    }
+    for(const SimImage *s : {&sim_pattern_1, &sim_pattern_2, &sim_pattern_4, &sim_pattern_8}){
+        if(&s->img == img){ return s->indexes; }
+    }
+    return std::vector<uint8_t>();
+}
+
+/**
+ * @brief Indexes of the decoder - images written by hand and test patterns.
+ * @return number of errors
+ */
+int simDecoder(void){
+    int     errors = 0;
+    const uint16_t  maxs[] = {UINT16_MAX, 1, 5};
+    for(const SimPlacedImage &p : sim_placed){
+        const LCD_Image     *img = p.img;
+        std::vector<uint8_t>    expected = simIndexes(img);
+        int     e = (expected.size() != (size_t)img->width * img->height);
+        // runs of any length, of the rows (draw_image) and short runs
+        for(uint16_t max : maxs){ e += (simDecode(img, max) != expected); }
+        e += (simDecode(img, img->width) != expected);
+        // same indexes after rewind()
+        LCD_ImageDecoder    dec(img);
+        uint8_t     index;
+        while(dec.next_run(&index, 7) > 0){}
+        dec.rewind();
+        uint16_t    len = dec.next_run(&index, UINT16_MAX);
+        e += (len == 0) || (index != expected[0]);
+        // truncated data : the first indexes only
+        LCD_Image   cut = *img;
+        cut.size--;
+        std::vector<uint8_t>    first = simDecode(&cut, UINT16_MAX);
+        e += (first.size() >= expected.size()) || !std::equal(first.begin(), first.end(), expected.begin());
+        // no pixel without data, and no run of 0
+        cut.size = 0;
+        e += !simDecode(&cut, UINT16_MAX).empty() || (LCD_ImageDecoder(img).next_run(&index, 0) != 0);
+        if(e){
+            printf("  LCD_ImageDecoder : %dx%d image, %d-bit indexes, %d errors\n", img->width, img->height, img->bits, e);
+        }
+        errors += e;
+    }
+    return errors;
+}
+
+/**
+ * @struct SimScene
+ * @brief Scene of the golden images
+ */
+struct SimScene{
+    const char  *name;
+    void        (*draw)(LCD_graphics *lcd);
+    /// The clipped scene is the masked scene
+    bool        masked;
+};
+
+const SimScene  sim_scenes[] = {
+    {"circles",     sceneCircles,   true},
+    {"ellipses",    sceneEllipses,  true},
+    {"lines",       sceneLines,     false},
+    {"polygons",    scenePolygons,  false},
+    {"glyphs",      sceneGlyphs,    true},
+    {"images",      sceneImages,    true}
+};
+
+/// Scene drawn in the clipping rectangle, on a background
+void simClipped(GoldenScreen *lcd, const SimScene *scene){
+    lcd->clear(SIM_BLACK);
+    lcd->set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+    scene->draw(lcd);
+    lcd->reset_clip();
+}
+
+
+/**************************************************************
+ *	LCD_graphics_t
+ **************************************************************/
+
+/// Same primitives with LCD_graphics and LCD_graphics_t - number of errors
+int simTemplate(void){
+    static const int16_t    lines[][4] = {{0, 0, 95, 63}, {95, 0, 0, 63}, {10, 60, 90, 2}, {48, 0, 50, 63},
+                                        {-30, 20, 130, 40}, {20, -5, 25, 80}, {0, 31, 95, 31}, {60, 5, 5, 5}};
+    static const char   *str = "LEnsE 2026!";
+    static const enum Size  sizes[] = {NORMAL, LARGE, HUGE};
+    GoldenScreen    a, b;
+    LCD_graphics_t<GoldenScreen>    gfx(&b);
+    int     errors = 0;
+    for(int clip = 0; clip < 2; clip++){
+        a.clear(SIM_BLACK);
+        b.clear(SIM_BLACK);
+        if(clip){
+            a.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+            gfx.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+        }
+        for(const int16_t *l : lines){
+            a.draw_line(l[0], l[1], l[2], l[3], SIM_WHITE);
+            gfx.draw_line(l[0], l[1], l[2], l[3], SIM_WHITE);
+        }
+        a.draw_rect(5, 40, 30, 15, SIM_RED);
+        gfx.draw_rect(5, 40, 30, 15, SIM_RED);
+        a.fill_rect(60, 40, 25, 10, SIM_GREEN);
+        gfx.fill_rect(60, 40, 25, 10, SIM_GREEN);
+        for(int16_t r = 0; r < 30; r += 7){
+            a.fill_circle(30 + r, 20, r, SIM_BLUE);
+            gfx.fill_circle(30 + r, 20, r, SIM_BLUE);
+        }
+        errors += simCompare(clip ? "LCD_graphics_t primitives, clipped" : "LCD_graphics_t primitives",
+                            b.pixels, a.pixels, SIM_WIDTH);
+        // characters - from the top and the bottom of the clipping rectangle
+        for(const enum Size s : sizes){
+            for(int16_t y = -2; y < SIM_HEIGHT; y += 17){
+                a.clear(SIM_BLACK);
+                b.clear(SIM_BLACK);
+                if(clip){
+                    a.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+                    gfx.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+                }
+                uint16_t    py = (y < 0) ? 0 : y;
+                a.set_position(SIM_CLIP_X0 - 3, py);
+                gfx.set_position(SIM_CLIP_X0 - 3, py);
+                a.draw_string((char *)str, SIM_WHITE, s);
+                gfx.draw_string(str, SIM_WHITE, s);
+                errors += simCompare("LCD_graphics_t characters", b.pixels, a.pixels, SIM_WIDTH);
+            }
+        }
+    }
+    return errors;
+}
+
+
+/**************************************************************
+ *	ST7735
+ **************************************************************/
+
+SimST7735   sim_ram;
+
+void stubSPIData(const char *data, int length, const int *pins){
+    if(pins[SIM_PIN_CS] != 0){ stubViolation("bytes without chip select"); return; }
+    sim_ram.write((const uint8_t *)data, length, pins[SIM_PIN_DC] != 0);
+}
+
+/* Static objects : the constructors of the drivers delete their previous interface (NULL) */
+SPI         my_spi(4, 5, 6);
+ST7735      my_lcd(&my_spi, SIM_PIN_CS, SIM_PIN_DC, SIM_PIN_RESET);
+
+
+/**************************************************************
+ *	Rates
+ **************************************************************/
+
+/// Pixels per second of a primitive, drawn during SIM_BENCH_TIME
+template <typename F>
+void simRate(const char *name, GoldenScreen *lcd, F draw){
+    uint32_t    nb_calls = 0;
+    lcd->clear(SIM_BLACK);
+    lcd->nb_pixels = 0;
+    auto    t0 = std::chrono::steady_clock::now();
+    double  t;
+    do{
+        for(int k = 0; k < 100; k++){ draw(nb_calls++); }
+    }while((t = simElapsed(t0)) < SIM_BENCH_TIME);
+    printf("  %-34s %8.2f Mpixels/s  %8.2f us/call\n", name,
+            lcd->nb_pixels / t * 1e-6, t / nb_calls * 1e6);
+}
+
+void simRates(void){
+    static GoldenScreen lcd;
+    static LCD_graphics_t<GoldenScreen>   gfx(&lcd);
+    static const int16_t    star[] = {70, 2, 76, 20, 94, 20, 80, 31, 86, 50, 70, 39, 54, 50, 60, 31, 46, 20, 64, 20};
+    printf("Rates of the primitives (framebuffer)\n");
+    simRate("fill_rect 40x30", &lcd, [](uint32_t k){ lcd.fill_rect(k % 50, 10, 40, 30, SIM_WHITE); });
+    simRate("fill_circle r=20", &lcd, [](uint32_t k){ lcd.fill_circle(30 + k % 30, 32, 20, SIM_WHITE); });
+    simRate("LCD_graphics_t fill_circle r=20", &lcd, [](uint32_t k){ gfx.fill_circle(30 + k % 30, 32, 20, SIM_WHITE); });
+    simRate("fill_ellipse 30x15", &lcd, [](uint32_t k){ lcd.fill_ellipse(35 + k % 20, 32, 30, 15, SIM_WHITE); });
+    simRate("fill_polygon star", &lcd, [](uint32_t k){ lcd.fill_polygon(star, 10, SIM_WHITE); });
+    simRate("draw_line diagonal", &lcd, [](uint32_t k){ lcd.draw_line(0, k % 64, 95, 63 - k % 64, SIM_WHITE); });
+    simRate("LCD_graphics_t draw_line diagonal", &lcd, [](uint32_t k){ gfx.draw_line(0, k % 64, 95, 63 - k % 64, SIM_WHITE); });
+    simRate("draw_string NORMAL", &lcd, [](uint32_t k){
+        lcd.set_position(0, k % 50); lcd.draw_string((char *)"0123456789", SIM_WHITE, NORMAL); });
+    simRate("LCD_graphics_t draw_string NORMAL", &lcd, [](uint32_t k){
+        gfx.set_position(0, k % 50); gfx.draw_string("0123456789", SIM_WHITE, NORMAL); });
+    simRate("draw_string HUGE", &lcd, [](uint32_t k){
+        lcd.set_position(0, k % 30); lcd.draw_string((char *)"0123", SIM_WHITE, HUGE); });
+    simRate("LCD_graphics_t draw_string HUGE", &lcd, [](uint32_t k){
+        gfx.set_position(0, k % 30); gfx.draw_string("0123", SIM_WHITE, HUGE); });
+    simRate("draw_string HUGE on a background", &lcd, [](uint32_t k){
+        lcd.set_text_background(SIM_BLUE); lcd.set_position(0, k % 30);
+        lcd.draw_string((char *)"0123", SIM_WHITE, HUGE); });
+    simRate("draw_image 40x24, 2 bits", &lcd, [](uint32_t k){ lcd.draw_image(k % 50, 20, &sim_pattern_2.img); });
+    simRate("draw_image 30x20, 4 bits", &lcd, [](uint32_t k){ lcd.draw_image(k % 60, 20, &sim_pattern_4.img); });
+
+    /// Decoder alone - whole screen, as LCD_ImageDecoder::benchmark on the target
+    printf("Rates of LCD_ImageDecoder (%dx%d test pattern)\n", SIM_WIDTH, SIM_HEIGHT);
+    const uint8_t   bits[] = {1, 2, 4, 8};
+    for(uint8_t b : bits){
+        SimImage    image(SIM_WIDTH, SIM_HEIGHT, b, 1 << b, sim_colors);
+        LCD_ImageDecoder    dec(&image.img);
+        uint8_t     index;
+        uint16_t    len;
+        uint64_t    nb_pixels = 0;
+        uint32_t    nb_images = 0;
+        char        name[48];
+        auto    t0 = std::chrono::steady_clock::now();
+        double  t;
+        do{
+            dec.rewind();
+            while((len = dec.next_run(&index, UINT16_MAX)) > 0){ nb_pixels += len; }
+            nb_images++;
+        }while((t = simElapsed(t0)) < SIM_BENCH_TIME);
+        snprintf(name, sizeof(name), "%d-bit indexes, %d bytes", b, (int)image.data.size());
+        printf("  %-34s %8.2f Mpixels/s  %8.2f us/image\n", name, nb_pixels / t * 1e-6, t / nb_images * 1e6);
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    bool    update = (argc > 1) && (std::string(argv[1]) == "update");
+    int     failed = 0;
+    for(int p = 0; p < STUB_NB_PINS; p++){ stub_pins[p] = 1; }
+    static GoldenScreen lcd, clipped;
+
+    /// Golden images and clipping
+    for(const SimScene &scene : sim_scenes){
+        int     errors = 0;
+        lcd.clear(SIM_BLACK);
+        scene.draw(&lcd);
+        errors += simGolden(scene.name, simImage(lcd.pixels, SIM_WIDTH, SIM_HEIGHT), update);
+        simClipped(&clipped, &scene);
+        std::string name = std::string(scene.name) + "_clipped";
+        errors += simGolden(name.c_str(), simImage(clipped.pixels, SIM_WIDTH, SIM_HEIGHT), update);
+        if(scene.masked){
+            std::vector<uint16_t>   masked(SIM_WIDTH * SIM_HEIGHT, SIM_BLACK);
+            for(int y = SIM_CLIP_Y0; y <= SIM_CLIP_Y1; y++){
+                for(int x = SIM_CLIP_X0; x <= SIM_CLIP_X1; x++){ masked[y * SIM_WIDTH + x] = lcd.pixels[y * SIM_WIDTH + x]; }
+            }
+            errors += simCompare(name.c_str(), clipped.pixels, masked, SIM_WIDTH);
+        }
+        printf("Scene %-10s : %s\n", scene.name, errors ? "FAILED" : "OK");
+        failed += (errors != 0);
+    }
+
+    /// LCD_graphics_t
+    int     errors = simTemplate();
+    printf("LCD_graphics_t    : %s\n", errors ? "FAILED" : "OK");
+    failed += (errors != 0);
+
+    /// ST7735 - characters on a background in blocks of pixels
+    my_lcd.set_screen_size(SIM_WIDTH, SIM_HEIGHT);
+    sceneGlyphs(&my_lcd);
+    my_lcd.wait_pixels();
+    lcd.clear(SIM_BLACK);
+    sceneGlyphs(&lcd);
+    errors = simCompare("ST7735", sim_ram.ram, lcd.pixels, SIM_WIDTH);
+    printf("ST7735 glyphs     : %s\n", errors ? "FAILED" : "OK");
+    failed += (errors != 0);
+
+    /// Images - decoder, then pixels of the indexes in the clipping rectangle
+    errors = simDecoder();
+    for(int clip = 0; clip < 2; clip++){
+        std::vector<uint16_t>   expected(SIM_WIDTH * SIM_HEIGHT, SIM_BLACK);
+        lcd.clear(SIM_BLACK);
+        if(clip){ lcd.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1); }
+        sceneImages(&lcd);
+        for(const SimPlacedImage &p : sim_placed){
+            if(clip){ simDrawIndexes(expected, p, simIndexes(p.img), SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1); }
+            else{ simDrawIndexes(expected, p, simIndexes(p.img), 0, 0, SIM_WIDTH - 1, SIM_HEIGHT - 1); }
+        }
+        errors += simCompare(clip ? "Images of the indexes, clipped" : "Images of the indexes", lcd.pixels, expected, SIM_WIDTH);
+    }
+    printf("Images            : %s\n", errors ? "FAILED" : "OK");
+    failed += (errors != 0);
+
+    /// ST7735 - one window of the memory for the images in the clipping rectangle, spans on the edges
+    errors = 0;
+    for(int clip = 0; clip < 2; clip++){
+        std::fill(sim_ram.ram.begin(), sim_ram.ram.end(), SIM_BLACK);
+        lcd.clear(SIM_BLACK);
+        if(clip){
+            my_lcd.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+            lcd.set_clip(SIM_CLIP_X0, SIM_CLIP_Y0, SIM_CLIP_X1, SIM_CLIP_Y1);
+        }
+        sceneImages(&my_lcd);
+        my_lcd.wait_pixels();
+        my_lcd.reset_clip();
+        sceneImages(&lcd);
+        errors += simCompare(clip ? "ST7735 images, clipped" : "ST7735 images", sim_ram.ram, lcd.pixels, SIM_WIDTH);
+    }
+    // blocks of ST7735_IMAGE_CHUNK pixels in the window of the image
+    const SimPlacedImage    &p = sim_placed[0];
+    my_lcd.draw_image(p.x, p.y, p.img);
+    my_lcd.wait_pixels();
+    errors += (sim_ram.x0 != p.x) || (sim_ram.x1 != p.x + p.img->width - 1) ||
+                (sim_ram.y0 != p.y) || (sim_ram.y1 != p.y + p.img->height - 1) ||
+                (sim_ram.x != sim_ram.x0) || (sim_ram.y != sim_ram.y0);
+    printf("ST7735 images     : %s\n", errors ? "FAILED" : "OK");
+    failed += (errors != 0);
+
+    simRates();
+
+    failed += (stub_violations != 0);
+    if(update){ printf("Golden images written in %s\n", SIM_GOLDEN_DIR); }
+    printf("%s\n", failed ? "FAILED" : "OK");
+    return failed ? 1 : 0;
+}
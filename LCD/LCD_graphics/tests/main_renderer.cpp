@@ -0,0 +1,172 @@
+/**
+ * FILENAME :        main_renderer.cpp
+ *
+ * DESCRIPTION :
+ *       LCD_graphics / Golden image and rate in pixels/s of the
+ *  ST7735_Renderer (RB-TFT1.8), on a computer with a stand-in of MBED OS
+ *  (tests/mbed.h). The screens are the ones of tests/sim_screen.h.
+ *
+ *       This program does not depend on MBED OS (from the LCD_graphics directory) :
+ *          g++ -std=c++14 -O2 -Itests -Iprog -I../RB-TFT1.8/prog/libs -I../../SPI_Bus
+ *              tests/main_renderer.cpp prog/LCD_graphics.cpp prog/LCD_image.cpp prog/font.cpp
+ *              ../RB-TFT1.8/prog/libs/st7735.cpp ../RB-TFT1.8/prog/libs/st7735_renderer.cpp
+ *              ../../SPI_Bus/SPI_Bus.cpp -o renderer
+ *          ./renderer          -> results, exit code 1 if a check fails
+ *          ./renderer update   -> writes the golden image of tests/golden
+ *
+ *       The same display list (rectangles, lines, pixels, characters of
+ *  each size) is rendered with bands of 1, SIM_BAND_LINES (the last band
+ *  partial), ST7735_BAND_LINES and SIM_HEIGHT lines. A model of the memory
+ *  of the ST7735 receives the bytes of the SPI interface : the bytes of an
+ *  asynchronous transfer are read at the end of the transfer, while the
+ *  next band is rasterised. For each size of band, the memory of the
+ *  ST7735 must be :
+ *          -> the golden image st7735_renderer
+ *          -> the framebuffer of the same primitives drawn by LCD_graphics
+ *       The rate of render() is given for each size of band : rasterisation
+ *  of the display list and bytes of the SPI stand-in, for the whole screen.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <vector>
+#include <string>
+#include "mbed.h"
+#include "LCD_graphics.h"
+#include "st7735.h"
+#include "st7735_renderer.h"
+#include "sim_screen.h"
+
+/** Constant definition */
+#define SIM_BAND_LINES      5
+/// Sizes of band
+#define SIM_NB_BANDS        4
+/// Color of the memory of the ST7735 before render() - not in the golden images
+#define SIM_UNWRITTEN       0x1234
+
+/* Stand-in of MBED OS */
+int         stub_violations = 0;
+int         stub_pins[STUB_NB_PINS];
+EventQueue  stub_queue;
+
+void stubViolation(const char *what){
+    if(stub_violations < 10){ printf("  stand-in : %s\n", what); }
+    stub_violations++;
+}
+
+EventQueue  *mbed_event_queue(void){
+    return &stub_queue;
+}
+
+SimST7735   sim_ram;
+
+void stubSPIData(const char *data, int length, const int *pins){
+    if(pins[SIM_PIN_CS] != 0){ stubViolation("bytes without chip select"); return; }
+    sim_ram.write((const uint8_t *)data, length, pins[SIM_PIN_DC] != 0);
+}
+
+/* Static objects : the constructors of the drivers delete their previous interface (NULL) */
+SPI         my_spi(4, 5, 6);
+ST7735      my_lcd(&my_spi, SIM_PIN_CS, SIM_PIN_DC, SIM_PIN_RESET);
+ST7735_Renderer     my_renderers[SIM_NB_BANDS] = {
+    ST7735_Renderer(&my_lcd, SIM_WIDTH, SIM_HEIGHT, 1),
+    ST7735_Renderer(&my_lcd, SIM_WIDTH, SIM_HEIGHT, SIM_BAND_LINES),
+    ST7735_Renderer(&my_lcd, SIM_WIDTH, SIM_HEIGHT, ST7735_BAND_LINES),
+    ST7735_Renderer(&my_lcd, SIM_WIDTH, SIM_HEIGHT, SIM_HEIGHT)
+};
+const uint16_t  sim_bands[SIM_NB_BANDS] = {1, SIM_BAND_LINES, ST7735_BAND_LINES, SIM_HEIGHT};
+
+
+/**************************************************************
+ *	Display list
+ **************************************************************/
+
+/// Display list of the renderer - the same primitives are drawn on lcd if not NULL
+void simDisplayList(ST7735_Renderer *renderer, GoldenScreen *lcd){
+    static char     title[] = "Band 5";
+    static char     value[] = "-12.7";
+    static char     big[] = "H";
+    renderer->clear(SIM_BLUE);
+    renderer->add_fill_rect(4, 3, 40, 20, SIM_RED);
+    renderer->add_rect(0, 0, SIM_WIDTH - 1, SIM_HEIGHT - 1, SIM_WHITE);
+    renderer->add_line(2, 62, 93, 9, SIM_GREEN);
+    renderer->add_line(50, 1, 55, 62, SIM_WHITE);
+    renderer->add_pixel(94, 62, SIM_RED);
+    renderer->add_text(6, 6, title, SIM_WHITE, NORMAL);
+    renderer->add_text(40, 27, value, SIM_WHITE, LARGE);
+    renderer->add_text(8, 30, big, SIM_GREEN, HUGE);
+    if(lcd){
+        lcd->clear(SIM_BLUE);
+        lcd->fill_rect(4, 3, 40, 20, SIM_RED);
+        lcd->draw_rect(0, 0, SIM_WIDTH - 1, SIM_HEIGHT - 1, SIM_WHITE);
+        lcd->draw_line(2, 62, 93, 9, SIM_GREEN);
+        lcd->draw_line(50, 1, 55, 62, SIM_WHITE);
+        lcd->draw_pixel(94, 62, SIM_RED);
+        lcd->set_position(6, 6);
+        lcd->draw_string(title, SIM_WHITE, NORMAL);
+        lcd->set_position(40, 27);
+        lcd->draw_string(value, SIM_WHITE, LARGE);
+        lcd->set_position(8, 30);
+        lcd->draw_string(big, SIM_GREEN, HUGE);
+    }
+}
+
+
+/**************************************************************
+ *	Rates
+ **************************************************************/
+
+/// Pixels per second of render(), for each size of band
+void simRates(void){
+    printf("Rates of ST7735_Renderer render() (whole screen)\n");
+    for(int b = 0; b < SIM_NB_BANDS; b++){
+        uint32_t    nb_frames = 0;
+        char        name[48];
+        simDisplayList(&my_renderers[b], NULL);
+        auto    t0 = std::chrono::steady_clock::now();
+        double  t;
+        do{
+            my_renderers[b].render();
+            nb_frames++;
+        }while((t = simElapsed(t0)) < SIM_BENCH_TIME);
+        snprintf(name, sizeof(name), "bands of %d lines", sim_bands[b]);
+        printf("  %-34s %8.2f Mpixels/s  %8.2f us/frame\n", name,
+                (double)nb_frames * SIM_WIDTH * SIM_HEIGHT / t * 1e-6, t / nb_frames * 1e6);
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    bool    update = (argc > 1) && (std::string(argv[1]) == "update");
+    int     failed = 0;
+    for(int p = 0; p < STUB_NB_PINS; p++){ stub_pins[p] = 1; }
+    static GoldenScreen lcd;
+    my_lcd.set_screen_size(SIM_WIDTH, SIM_HEIGHT);
+
+    /// Same image for each size of band
+    for(int b = 0; b < SIM_NB_BANDS; b++){
+        char    name[48];
+        std::fill(sim_ram.ram.begin(), sim_ram.ram.end(), SIM_UNWRITTEN);
+        simDisplayList(&my_renderers[b], &lcd);
+        int     errors = !my_renderers[b].render();
+        // the golden image is written once
+        errors += simGolden("st7735_renderer", simImage(sim_ram.ram, SIM_WIDTH, SIM_HEIGHT), update && (b == 0));
+        snprintf(name, sizeof(name), "Bands of %d lines", sim_bands[b]);
+        errors += simCompare(name, sim_ram.ram, lcd.pixels, SIM_WIDTH);
+        printf("%-20s : %s\n", name, errors ? "FAILED" : "OK");
+        failed += (errors != 0);
+    }
+
+    simRates();
+
+    failed += (stub_violations != 0);
+    if(update){ printf("Golden image written in %s\n", SIM_GOLDEN_DIR); }
+    printf("%s\n", failed ? "FAILED" : "OK");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * FILENAME :        mbed.h
+ *
+ * DESCRIPTION :
+ *       LCD_graphics / Host stand-in of MBED OS for main_golden.cpp.
+ *
+ *       Only the parts of MBED OS used by LCD_graphics, ST7735,
+ *  ST7735_Renderer and SPI_Bus :
+ *          -> SPI gives the written bytes to stubSPIData() of the program,
+ *              with the level of the pins when the bytes are sent
+ *          -> an asynchronous transfer stays in progress until stub_run()
+ *              (end of transfer interrupt) : its bytes are read at the end,
+ *              as the DMA of the board does
+ *          -> the shared event queue stores the calls until stub_run()
+ *          -> Semaphore and EventFlags call stub_run() while they wait :
+ *              the single thread of the program runs the bus
+ *          -> no wait : wait_us and thread_sleep_for return at once
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __MBED_HOST_STUB_H__
+#define __MBED_HOST_STUB_H__
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+/** Constant definition */
+#define     SPI_EVENT_ERROR         (1 << 1)
+#define     SPI_EVENT_COMPLETE      (1 << 2)
+#define     SPI_EVENT_RX_OVERFLOW   (1 << 3)
+#define     SPI_EVENT_ALL           (SPI_EVENT_ERROR | SPI_EVENT_COMPLETE | SPI_EVENT_RX_OVERFLOW)
+/// Number of pins of the stand-in
+#define     STUB_NB_PINS            32
+/// Calls of stub_run() before a blocking wait is a dead-lock
+#define     STUB_WAIT_MAX           100000
+
+typedef int PinName;
+const PinName   NC = -1;
+enum DMAUsage { DMA_USAGE_NEVER, DMA_USAGE_OPPORTUNISTIC };
+
+/// Violation of the rules of the stand-in - counted
+extern int  stub_violations;
+void stubViolation(const char *what);
+
+/// Level of the pins - 1 after reset
+extern int  stub_pins[STUB_NB_PINS];
+
+/**
+ * @brief Bytes written on the SPI bus - defined by the program.
+ * @param pins int * - level of the pins when the bytes were sent
+ */
+void stubSPIData(const char *data, int length, const int *pins);
+
+/**
+ * @brief End of the asynchronous transfers in progress, then calls of the event queue.
+ * @return false if there is nothing to run
+ */
+inline bool stub_run(void);
+
+inline void wait_us(int us){}
+inline void thread_sleep_for(uint32_t ms){}
+inline uint32_t us_ticker_read(void){
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**************************************************************
+ *	Callbacks and event queue
+ **************************************************************/
+
+template <typename F> class Callback;
+
+template <typename R, typename... A>
+class Callback<R(A...)>{
+    public:
+        std::function<R(A...)>  f;
+        Callback(void){}
+        Callback(std::nullptr_t){}
+        Callback(R (*func)(A...)) : f(func){}
+        template <typename T, typename M>
+        Callback(T *obj, M method){ f = [obj, method](A... a){ return (obj->*method)(a...); }; }
+        R operator()(A... a) const { return f(a...); }
+        explicit operator bool() const { return (bool)f; }
+};
+
+template <typename R, typename... A>
+Callback<R(A...)> callback(R (*func)(A...)){ return Callback<R(A...)>(func); }
+template <typename T, typename R, typename... A>
+Callback<R(A...)> callback(T *obj, R (T::*method)(A...)){ return Callback<R(A...)>(obj, method); }
+
+typedef Callback<void(int)>     event_callback_t;
+
+class EventQueue{
+    public:
+        std::deque<std::function<void()>>   calls;
+        int     id = 0;
+
+        template <typename F, typename... A>
+        int     call(F f, A... a){
+            this->calls.push_back([=](){ f(a...); });
+            return ++this->id;
+        }
+        /// Run the oldest call - false if the queue is empty
+        bool    dispatch_one(void){
+            if(this->calls.empty()){ return false; }
+            std::function<void()> c = this->calls.front();
+            this->calls.pop_front();
+            c();
+            return true;
+        }
+};
+EventQueue  *mbed_event_queue(void);
+
+class CriticalSectionLock{
+    public:
+        CriticalSectionLock(void){}
+        ~CriticalSectionLock(void){}
+};
+
+class Semaphore{
+    public:
+        int     count;
+        Semaphore(int c = 0) : count(c){}
+        bool    try_acquire(void){
+            if(this->count == 0){ return false; }
+            this->count--;
+            return true;
+        }
+        bool    try_acquire_for(std::chrono::milliseconds t){
+            for(int n = 0; (this->count == 0) && (n < STUB_WAIT_MAX) && stub_run(); n++){}
+            return this->try_acquire();
+        }
+        void    acquire(void){
+            if(!this->try_acquire_for(0ms)){ stubViolation("Semaphore::acquire without token (dead-lock)"); }
+        }
+        void    release(void){ this->count++; }
+};
+
+class EventFlags{
+    public:
+        uint32_t    flags = 0;
+        uint32_t    set(uint32_t f){ this->flags |= f; return this->flags; }
+        uint32_t    clear(uint32_t f){ this->flags &= ~f; return this->flags; }
+        uint32_t    wait_any(uint32_t f){
+            for(int n = 0; !(this->flags & f) && (n < STUB_WAIT_MAX) && stub_run(); n++){}
+            if(!(this->flags & f)){ stubViolation("EventFlags::wait_any without flag (dead-lock)"); }
+            uint32_t    r = this->flags;
+            this->flags &= ~f;
+            return r;
+        }
+};
+
+/**************************************************************
+ *	Pins and SPI
+ **************************************************************/
+
+class DigitalOut{
+    public:
+        PinName     pin;
+        DigitalOut(PinName p, int value = 0) : pin(p){ this->write(value); }
+        void    write(int value){ if(this->pin >= 0){ stub_pins[this->pin] = value; } }
+        int     read(void){ return (this->pin >= 0) ? stub_pins[this->pin] : 0; }
+        DigitalOut &operator=(int value){ this->write(value); return *this; }
+};
+
+class SPI{
+    public:
+        int     bits, mode, hz;
+        /// Asynchronous transfer in progress - ended by stub_run()
+        bool    busy;
+        const char  *tx;
+        int     tx_length;
+        int     pins[STUB_NB_PINS];
+        event_callback_t    cb;
+
+        SPI(PinName mosi, PinName miso, PinName sclk){
+            this->bits = 8; this->mode = 0; this->hz = 1000000;
+            this->busy = false; this->tx = NULL; this->tx_length = 0;
+            SPI::all().push_back(this);
+        }
+        ~SPI(void){
+            SPI::all().erase(std::remove(SPI::all().begin(), SPI::all().end(), this), SPI::all().end());
+        }
+        /// Interfaces of the program
+        static std::vector<SPI *>   &all(void){
+            static std::vector<SPI *>   interfaces;
+            return interfaces;
+        }
+        void    set_dma_usage(DMAUsage d){}
+        void    format(int b, int m){ this->bits = b; this->mode = m; }
+        void    frequency(int f){ this->hz = f; }
+        int     write(int value){
+            char    c = (char)value;
+            if(this->busy){ stubViolation("SPI used during an asynchronous transfer"); }
+            stubSPIData(&c, 1, stub_pins);
+            return 0xFF;
+        }
+        int     write(const char *tx, int tx_length, char *rx, int rx_length){
+            if(this->busy){ stubViolation("SPI used during an asynchronous transfer"); }
+            if(tx && tx_length){ stubSPIData(tx, tx_length, stub_pins); }
+            for(int k = 0; k < rx_length; k++){ rx[k] = (char)0xFF; }
+            return (tx_length > rx_length) ? tx_length : rx_length;
+        }
+        int     transfer(const char *tx, int tx_length, char *rx, int rx_length,
+                        const event_callback_t &cb, int event){
+            if(this->busy){ stubViolation("SPI used during an asynchronous transfer"); }
+            this->busy = true;
+            this->tx = tx;
+            this->tx_length = tx_length;
+            memcpy(this->pins, stub_pins, sizeof(this->pins));
+            this->cb = cb;
+            for(int k = 0; k < rx_length; k++){ rx[k] = (char)0xFF; }
+            return 0;
+        }
+        void    abort_transfer(void){ this->busy = false; }
+        /// End of the asynchronous transfer - interrupt
+        bool    complete(void){
+            if(!this->busy){ return false; }
+            this->busy = false;
+            if(this->tx && this->tx_length){ stubSPIData(this->tx, this->tx_length, this->pins); }
+            this->cb(SPI_EVENT_COMPLETE);
+            return true;
+        }
+};
+
+inline bool stub_run(void){
+    bool    run = false;
+    for(SPI *spi : SPI::all()){ run |= spi->complete(); }
+    while(mbed_event_queue()->dispatch_one()){ run = true; }
+    return run;
+}
+
+#endif
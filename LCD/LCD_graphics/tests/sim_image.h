@@ -0,0 +1,120 @@
+/**
+ * FILENAME :        sim_image.h
+ *
+ * DESCRIPTION :
+ *       LCD_graphics / Compressed images of the host tests (main_golden.cpp
+ *  and OLED-0.96 main_ssd1306_bench.cpp) :
+ *          -> simPattern : indexes of a test image - constant rows (repeated
+ *              runs longer than 128 pixels), blocks (repeated runs) and
+ *              rows of noise (literal runs longer than 128 indexes)
+ *          -> simEncode : encoder of tools/image_convert.py, byte by byte
+ *          -> SimImage : indexes, palette, data and LCD_Image of a pattern
+ *          -> simDecode : indexes given by LCD_ImageDecoder::next_run
+ *
+ *       This file does not include the stand-in of MBED OS : each program
+ *  gives its own (tests/mbed.h).
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __SIM_IMAGE_H__
+#define __SIM_IMAGE_H__
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "LCD_image.h"
+
+/** Constant definition */
+/// Longest run - repeated or literal (control byte)
+#define SIM_RUN_MAX         128
+/// Shortest run of the same index coded as a repeated run
+#define SIM_REPEAT_MIN      3
+
+/// Index of the pixel (x, y) of the test pattern - indexes of 'bits' bits
+inline uint8_t simPattern(uint16_t x, uint16_t y, uint8_t bits){
+    uint16_t    n = 1 << bits;
+    if(y < 3){ return 0; }
+    if((y / 4) % 2){ return (x * 7 + y * 3) % n; }
+    return (x / 6 + y / 8) % n;
+}
+
+/**
+ * @brief Compressed indexes - encoder of tools/image_convert.py.
+ */
+inline std::vector<uint8_t> simEncode(const std::vector<uint8_t> &indexes, uint8_t bits){
+    std::vector<uint8_t>    out;
+    std::vector<uint8_t>    literal;
+    auto    flush = [&](){
+        for(size_t k = 0; k < literal.size(); k += SIM_RUN_MAX){
+            size_t  n = std::min(literal.size() - k, (size_t)SIM_RUN_MAX);
+            out.push_back(n - 1);
+            // MSB first, padded to the next byte
+            int     pos = 0;
+            for(size_t i = 0; i < n; i++){
+                if(pos == 0){ out.push_back(0); }
+                out.back() |= literal[k + i] << (8 - bits - pos);
+                pos = (pos + bits) % 8;
+            }
+        }
+        literal.clear();
+    };
+    size_t  i = 0;
+    while(i < indexes.size()){
+        size_t  j = i;
+        while((j < indexes.size()) && (indexes[j] == indexes[i]) && (j - i < SIM_RUN_MAX)){ j++; }
+        if(j - i >= SIM_REPEAT_MIN){
+            flush();
+            out.push_back(LCD_IMAGE_REPEAT | (j - i - 1));
+            out.push_back(indexes[i]);
+        }
+        else{ literal.insert(literal.end(), indexes.begin() + i, indexes.begin() + j); }
+        i = j;
+    }
+    flush();
+    return out;
+}
+
+/**
+ * @class SimImage
+ * @brief Compressed test pattern - the colors of the palette are repeated
+ */
+class SimImage{
+    public:
+        std::vector<uint8_t>    indexes;
+        std::vector<uint16_t>   palette;
+        std::vector<uint8_t>    data;
+        LCD_Image   img;
+
+        SimImage(uint16_t w, uint16_t h, uint8_t bits, uint16_t nb_colors, const std::vector<uint16_t> &colors){
+            for(uint16_t y = 0; y < h; y++){
+                for(uint16_t x = 0; x < w; x++){ this->indexes.push_back(simPattern(x, y, bits)); }
+            }
+            for(uint16_t k = 0; k < nb_colors; k++){ this->palette.push_back(colors[k % colors.size()]); }
+            this->data = simEncode(this->indexes, bits);
+            this->img = {w, h, bits, nb_colors, this->palette.data(), this->data.data(), (uint32_t)this->data.size()};
+        }
+        /// The LCD_Image points to the vectors
+        SimImage(const SimImage &) = delete;
+        SimImage &operator=(const SimImage &) = delete;
+};
+
+/// Indexes given by the decoder, runs of max pixels at most
+inline std::vector<uint8_t> simDecode(const LCD_Image *img, uint16_t max){
+    std::vector<uint8_t>    indexes;
+    LCD_ImageDecoder    dec(img);
+    uint8_t     index;
+    uint16_t    len;
+    while((len = dec.next_run(&index, max)) > 0){
+        if(len > max){ break; }
+        indexes.insert(indexes.end(), len, index);
+    }
+    return indexes;
+}
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * FILENAME :        sim_screen.h
+ *
+ * DESCRIPTION :
+ *       LCD_graphics / Screens of the host tests (main_golden.cpp and
+ *  main_renderer.cpp) :
+ *          -> GoldenScreen : framebuffer of 16 bits pixels, LCD library of
+ *              LCD_graphics and of LCD_graphics_t
+ *          -> golden images : one character per pixel (simColorChar),
+ *              compared with the files of SIM_GOLDEN_DIR
+ *          -> SimST7735 : memory of the ST7735, written by the bytes of
+ *              the SPI interface (window commands and pixels)
+ *
+ *       The stand-in of MBED OS (tests/mbed.h) and its objects are
+ *  defined by each program.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __SIM_SCREEN_H__
+#define __SIM_SCREEN_H__
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include "mbed.h"
+#include "LCD_graphics.h"
+#include "st7735.h"
+
+/** Constant definition */
+#define SIM_WIDTH           96
+#define SIM_HEIGHT          64
+#define SIM_GOLDEN_DIR      "tests/golden/"
+/// Pins of the ST7735
+#define SIM_PIN_CS          1
+#define SIM_PIN_DC          2
+#define SIM_PIN_RESET       3
+/// Duration of each rate measurement (s)
+#define SIM_BENCH_TIME      0.2
+/// Colors - the ones of the ST7735
+#define SIM_BLACK           ST7735_BLACK
+#define SIM_WHITE           ST7735_WHITE
+#define SIM_BLUE            ST7735_BLUE
+#define SIM_GREEN           ST7735_GREEN
+#define SIM_RED             ST7735_RED
+
+
+/**************************************************************
+ *	Framebuffer and golden images
+ **************************************************************/
+
+/**
+ * @class GoldenScreen
+ * @brief Framebuffer of 16 bits pixels - LCD library of LCD_graphics and LCD_graphics_t
+ */
+class GoldenScreen : public LCD_graphics {
+    public:
+        uint16_t    w, h;
+        std::vector<uint16_t>   pixels;
+        /// Pixels written by the primitives
+        uint32_t    nb_pixels;
+
+        GoldenScreen(uint16_t width = SIM_WIDTH, uint16_t height = SIM_HEIGHT) :
+                w(width), h(height), pixels(width * height, SIM_BLACK){
+            this->nb_pixels = 0;
+            this->set_screen(width, height);
+        }
+        void    clear(uint16_t color){
+            std::fill(this->pixels.begin(), this->pixels.end(), color);
+            this->set_text_transparent();
+            this->reset_clip();
+        }
+        /// Same range as the drivers : the size is included
+        bool    check_range(uint16_t x, uint16_t y){
+            return (x <= this->w) && (y <= this->h);
+        }
+        bool    draw_pixel(uint16_t x, uint16_t y, uint16_t color){
+            if(!this->check_range(x, y)){ return LCD_ERROR; }
+            if((x < this->w) && (y < this->h)){ this->put_pixel(x, y, color); }
+            return LCD_SUCCESS;
+        }
+        /// LCD library of LCD_graphics_t
+        inline uint16_t get_width(void){ return this->w; }
+        inline uint16_t get_height(void){ return this->h; }
+        inline void put_pixel(uint16_t x, uint16_t y, uint16_t color){
+            if((x >= this->w) || (y >= this->h)){ stubViolation("pixel out of the screen"); return; }
+            this->pixels[y * this->w + x] = color;
+            this->nb_pixels++;
+        }
+        inline void put_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color){
+            if((x1 >= this->w) || (y >= this->h) || (x0 > x1)){ stubViolation("span out of the screen"); return; }
+            std::fill(&this->pixels[y * this->w + x0], &this->pixels[y * this->w + x1] + 1, color);
+            this->nb_pixels += x1 - x0 + 1;
+        }
+
+    protected:
+        void    write_pixel(uint16_t x, uint16_t y, uint16_t color){ this->put_pixel(x, y, color); }
+        void    write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color){ this->put_span(x0, x1, y, color); }
+};
+
+/// Character of a color in the golden images
+inline char simColorChar(uint16_t color){
+    switch(color){
+        case SIM_BLACK:     return '.';
+        case SIM_WHITE:     return '#';
+        case SIM_BLUE:      return 'b';
+        case SIM_GREEN:     return 'g';
+        case SIM_RED:       return 'r';
+        default:            return '?';
+    }
+}
+
+/// Golden image of a framebuffer - "width height", then one line per row
+inline std::string simImage(const std::vector<uint16_t> &pixels, uint16_t w, uint16_t h){
+    std::string img = std::to_string(w) + " " + std::to_string(h) + "\n";
+    for(uint16_t y = 0; y < h; y++){
+        for(uint16_t x = 0; x < w; x++){ img += simColorChar(pixels[y * w + x]); }
+        img += '\n';
+    }
+    return img;
+}
+
+/// Number of different pixels of two framebuffers - first difference printed
+inline int simCompare(const char *name, const std::vector<uint16_t> &a, const std::vector<uint16_t> &b, uint16_t w){
+    int     errors = 0;
+    for(size_t k = 0; k < a.size(); k++){
+        if(a[k] == b[k]){ continue; }
+        if(errors == 0){
+            printf("  %s : pixel (%d, %d) is 0x%04X instead of 0x%04X\n",
+                    name, (int)(k % w), (int)(k / w), a[k], b[k]);
+        }
+        errors++;
+    }
+    return errors;
+}
+
+
+/**
+ * @brief Compare the image with its golden image - or write the golden image.
+ * @return number of errors
+ */
+inline int simGolden(const char *name, const std::string &img, bool update){
+    std::string path = std::string(SIM_GOLDEN_DIR) + name + ".txt";
+    if(update){
+        FILE    *f = fopen(path.c_str(), "w");
+        if(!f){ printf("  %s : can not write %s\n", name, path.c_str()); return 1; }
+        fwrite(img.data(), 1, img.size(), f);
+        fclose(f);
+        return 0;
+    }
+    FILE    *f = fopen(path.c_str(), "r");
+    if(!f){ printf("  %s : no golden image %s (update argument)\n", name, path.c_str()); return 1; }
+    std::string golden;
+    char    buf[256];
+    size_t  n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0){ golden.append(buf, n); }
+    fclose(f);
+    if(golden == img){ return 0; }
+    // first different row
+    size_t  k = 0;
+    while((k < golden.size()) && (k < img.size()) && (golden[k] == img[k])){ k++; }
+    int     row = (int)std::count(img.begin(), img.begin() + k, '\n') - 1;
+    printf("  %s : different from %s at row %d\n", name, path.c_str(), row);
+    return 1;
+}
+
+
+
+
+/**************************************************************
+ *	ST7735
+ **************************************************************/
+
+/**
+ * @class SimST7735
+ * @brief Memory of the ST7735 - window commands and pixels, MSB first
+ */
+class SimST7735{
+    public:
+        std::vector<uint16_t>   ram;
+        uint16_t    x0, x1, y0, y1, x, y;
+        /// Command in progress and index of its argument
+        uint8_t     cmd;
+        int         arg;
+        uint8_t     args[4];
+        /// First byte of a pixel
+        int         msb;
+
+        SimST7735(void) : ram(SIM_WIDTH * SIM_HEIGHT, SIM_BLACK){
+            x0 = x = 0; x1 = SIM_WIDTH - 1; y0 = y = 0; y1 = SIM_HEIGHT - 1;
+            cmd = 0; arg = 0; msb = -1;
+        }
+
+        void    write(const uint8_t *data, int length, bool dc){
+            for(int k = 0; k < length; k++){
+                if(!dc){
+                    // command
+                    this->cmd = data[k];
+                    this->arg = 0;
+                    this->msb = -1;
+                    if(this->cmd == RAMWR){ this->x = this->x0; this->y = this->y0; }
+                    continue;
+                }
+                if((this->cmd == CASET) || (this->cmd == RASET)){
+                    if(this->arg < 4){ this->args[this->arg++] = data[k]; }
+                    if(this->arg == 4){
+                        uint16_t    a = (this->args[0] << 8) | this->args[1];
+                        uint16_t    b = (this->args[2] << 8) | this->args[3];
+                        if(this->cmd == CASET){ this->x0 = a; this->x1 = b; }
+                        else{ this->y0 = a; this->y1 = b; }
+                    }
+                }
+                else if(this->cmd == RAMWR){
+                    if(this->msb < 0){ this->msb = data[k]; continue; }
+                    uint16_t    color = (this->msb << 8) | data[k];
+                    this->msb = -1;
+                    if((this->x < SIM_WIDTH) && (this->y < SIM_HEIGHT)){ this->ram[this->y * SIM_WIDTH + this->x] = color; }
+                    else{ stubViolation("ST7735 window out of the screen"); }
+                    if(this->x++ == this->x1){
+                        this->x = this->x0;
+                        this->y = (this->y == this->y1) ? this->y0 : this->y + 1;
+                    }
+                }
+            }
+        }
+};
+
+inline double simElapsed(std::chrono::steady_clock::time_point t0){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+#endif
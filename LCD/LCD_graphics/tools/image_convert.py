@@ -0,0 +1,167 @@
+# -*- coding: utf-8 -*-
+"""
+FILENAME :        image_convert.py
+
+DESCRIPTION :
+      LCD_graphics / Converter of images to the compressed format of LCD_image.h.
+
+      Reads an image (Pillow), reduces it to a palette of colors and
+  writes a header file with the palette (RGB565), the indexes compressed
+  by runs and the LCD_Image structure :
+      python image_convert.py logo.png logo              -> logo.h, 16 colors
+      python image_convert.py logo.png logo --colors 4
+      python image_convert.py logo.png logo --mono       -> 1 bit per pixel (SSD1306)
+      python image_convert.py logo.png logo --check      -> decodes the data and
+                                                            compares each pixel
+
+      The decoder of --check is the one of LCD_ImageDecoder in Python : the
+  C++ decoder and the drawing of the images are checked on a computer by
+  tests/main_golden.cpp.
+
+NOTES :
+      Developped by Villou / LEnsE
+
+AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+
+      LEnsE / Institut d'Optique Graduate School
+"""
+
+import sys
+
+LCD_IMAGE_REPEAT = 0x80
+LCD_IMAGE_RUN_MAX = 128
+# Shortest run of the same index coded as a repeated run
+LCD_IMAGE_REPEAT_MIN = 3
+
+
+def rgb565(r, g, b):
+    """Return the 16 bits color of a RGB color."""
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def index_bits(nb_colors):
+    """Return the number of bits of an index : 1, 2, 4 or 8."""
+    for bits in (1, 2, 4, 8):
+        if nb_colors <= (1 << bits):
+            return bits
+    raise ValueError('more than 256 colors')
+
+
+def pack(indexes, bits):
+    """Pack the indexes of a literal run, MSB first, padded to a byte."""
+    out = bytearray()
+    byte, pos = 0, 0
+    for index in indexes:
+        byte |= index << (8 - bits - pos)
+        pos += bits
+        if pos == 8:
+            out.append(byte)
+            byte, pos = 0, 0
+    if pos > 0:
+        out.append(byte)
+    return out
+
+
+def encode(indexes, bits):
+    """Compress a list of indexes (row after row). Return the data bytes."""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            group = literal[:LCD_IMAGE_RUN_MAX]
+            del literal[:LCD_IMAGE_RUN_MAX]
+            out.append(len(group) - 1)
+            out.extend(pack(group, bits))
+
+    i = 0
+    while i < len(indexes):
+        j = i
+        while j < len(indexes) and indexes[j] == indexes[i] and j - i < LCD_IMAGE_RUN_MAX:
+            j += 1
+        if j - i >= LCD_IMAGE_REPEAT_MIN:
+            flush_literal()
+            out.append(LCD_IMAGE_REPEAT | (j - i - 1))
+            out.append(indexes[i])
+        else:
+            literal.extend(indexes[i:j])
+        i = j
+    flush_literal()
+    return bytes(out)
+
+
+def decode(data, bits, nb_pixels):
+    """Decode the data bytes as LCD_ImageDecoder does. Return the list of indexes."""
+    indexes = []
+    mask = (1 << bits) - 1
+    i = 0
+    while i < len(data) and len(indexes) < nb_pixels:
+        ctrl = data[i]
+        count = (ctrl & 0x7F) + 1
+        i += 1
+        if ctrl & LCD_IMAGE_REPEAT:
+            indexes.extend([data[i]] * count)
+            i += 1
+            continue
+        pos = 0
+        for k in range(count):
+            indexes.append((data[i] >> (8 - bits - pos)) & mask)
+            pos += bits
+            if pos == 8 or k == count - 1:
+                pos = 0
+                i += 1
+    return indexes[:nb_pixels]
+
+
+def load(filename, nb_colors, mono):
+    """Return (width, height, palette, indexes) of an image file."""
+    from PIL import Image
+    img = Image.open(filename).convert('RGB')
+    if mono:
+        pixels = img.convert('1').getdata()
+        return img.width, img.height, [0x0000, 0xFFFF], [1 if p else 0 for p in pixels]
+    img = img.quantize(colors=nb_colors)
+    rgb = img.getpalette()
+    used = sorted(set(img.getdata()))
+    remap = {old: new for new, old in enumerate(used)}
+    palette = [rgb565(*rgb[3 * k:3 * k + 3]) for k in used]
+    return img.width, img.height, palette, [remap[p] for p in img.getdata()]
+
+
+def write_header(name, width, height, palette, bits, data):
+    """Write name.h - constant arrays and LCD_Image structure."""
+    lines = ['/**',
+             ' * Image %s - %d x %d pixels, %d colors' % (name, width, height, len(palette)),
+             ' * Generated by image_convert.py - %d bytes (%d uncompressed)'
+             % (len(data), (width * height * bits + 7) // 8),
+             ' */',
+             '#include "LCD_image.h"', '',
+             'const uint16_t %s_palette[%d] = {' % (name, len(palette))]
+    for k in range(0, len(palette), 8):
+        lines.append('    ' + ', '.join('0x%04X' % c for c in palette[k:k + 8]) + ',')
+    lines += ['};', '', 'const uint8_t %s_data[%d] = {' % (name, len(data))]
+    for k in range(0, len(data), 16):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in data[k:k + 16]) + ',')
+    lines += ['};', '',
+              'const LCD_Image %s = {%d, %d, %d, %d, %s_palette, %s_data, %d};'
+              % (name, width, height, bits, len(palette), name, name, len(data)), '']
+    with open(name + '.h', 'w') as f:
+        f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+    filename, name = sys.argv[1], sys.argv[2]
+    nb_colors = int(sys.argv[sys.argv.index('--colors') + 1]) if '--colors' in sys.argv else 16
+    width, height, palette, indexes = load(filename, nb_colors, '--mono' in sys.argv)
+    bits = index_bits(len(palette))
+    data = encode(indexes, bits)
+    write_header(name, width, height, palette, bits, data)
+    print('%s.h : %d x %d, %d colors, %d bits, %d bytes' % (name, width, height, len(palette), bits, len(data)))
+    if '--check' in sys.argv:
+        if decode(data, bits, width * height) != indexes:
+            print('check : ERROR - decoded pixels differ from the image')
+            sys.exit(1)
+        print('check : OK - %d pixels' % (width * height))
@@ -17,18 +17,68 @@
 #include "font.h"
 #include "ssd1306.h"
 #include "ssd1306_constants.h"
+#include <cstring>
+
+
+/* Thresholds of the ordered dithering - 8x8 Bayer matrix, luminance 0-255 */
+static constexpr uint8_t    ssd1306_bayer[8][8] = {
+    {  2, 130,  34, 162,  10, 138,  42, 170},
+    {194,  66, 226,  98, 202,  74, 234, 106},
+    { 50, 178,  18, 146,  58, 186,  26, 154},
+    {242, 114, 210,  82, 250, 122, 218,  90},
+    { 14, 142,  46, 174,   6, 134,  38, 166},
+    {206,  78, 238, 110, 198,  70, 230, 102},
+    { 62, 190,  30, 158,  54, 182,  22, 150},
+    {254, 126, 222,  94, 246, 118, 214,  86}
+};
+
+/* Luminance (0-255) of a 16 bits color */
+static inline uint8_t   ssd1306_luminance(uint16_t color)
+{
+    uint16_t    r = (color >> 8) & 0xF8;
+    uint16_t    g = (color >> 3) & 0xFC;
+    uint16_t    b = (color << 3) & 0xF8;
+    r |= r >> 5;
+    g |= g >> 6;
+    b |= b >> 5;
+    return (r * 77 + g * 150 + b * 29) >> 8;
+}
 
+SSD1306::SSD1306(I2C *i2c, uint16_t width, uint16_t height):
+    __link(i2c)
+{
+	this->__width = width;
+	this->__height = height;
+    /// Set the good size for the data buffer
+    this->__buff_size = this->__height * this->__width / 8;
+    this->__buffer.resize(this->__buff_size);
+	/// Clipping rectangle of the graphics primitives
+	this->set_screen(width, height);
+	/// Dithering of the 16 bits images - one page of luminance
+	this->__dither = DITHER_BAYER;
+	this->__band.resize(8 * width);
+	this->__error.resize(2 * (width + 2));
+    this->__flushing = false;
+    this->__flush_ack = true;
+	wait_us(1000);
+}
 
-SSD1306::SSD1306(I2C *i2c, uint16_t width, uint16_t height){
+SSD1306::SSD1306(I2C_Bus *bus, uint16_t width, uint16_t height):
+    __link(bus)
+{
 	this->__width = width;
 	this->__height = height;
     /// Set the good size for the data buffer
     this->__buff_size = this->__height * this->__width / 8;
     this->__buffer.resize(this->__buff_size);
-	/// Initialization of the SPI interface
-	if(i2c){delete this->__i2c;}
-	this->__i2c = i2c;
-	this->__i2c->frequency(SSD_I2C_FREQ);
+	/// Clipping rectangle of the graphics primitives
+	this->set_screen(width, height);
+	/// Dithering of the 16 bits images - one page of luminance
+	this->__dither = DITHER_BAYER;
+	this->__band.resize(8 * width);
+	this->__error.resize(2 * (width + 2));
+	/// Shared I2C bus - frequency is set for each transaction
+    this->init_flush();
 	wait_us(1000);
 }
 
@@ -38,48 +88,9 @@ SSD1306::SSD1306(I2C *i2c, uint16_t width, uint16_t height){
  **************************************************************/
 
 bool	SSD1306::init(void){
-
-    bool ack = true;
-    ack = ack && this->send_command(SSD1306_DISPLAYOFF);
-    ack = ack && this->send_command(SSD1306_SETDISPLAYCLOCKDIV);
-    ack = ack && this->send_command(0x80);  // the suggested ratio 0x80
-
-    ack = ack && this->send_command(SSD1306_SETMULTIPLEX);
-    ack = ack && this->send_command(this->__height-1);
-
-    // No Offset
-    ack = ack && this->send_command(SSD1306_SETDISPLAYOFFSET);
-    ack = ack && this->send_command(0x00);   // no offset
-
-    // Start Line - 0 
-    ack = ack && this->send_command(SSD1306_SETSTARTLINE | 0x0);
-
-    // External Power VCC
-    ack = ack && this->send_command(SSD1306_CHARGEPUMP);
-    ack = ack && this->send_command(0x14);   // or 0x14 ??
-
-    ack = ack && this->send_command(SSD1306_SEGREMAP | 0x1); 
-    ack = ack && this->send_command(SSD1306_COMSCANDEC); 
-
-    ack = ack && this->send_command(SSD1306_SETCOMPINS); 
-    ack = ack && this->send_command(0x12);  
-        // 0x12 if 64pix height or 0x02 if 32pix
-
-    ack = ack && this->send_command(SSD1306_SETCONTRAST); 
-    ack = ack && this->send_command(0xCF);  // 0x8F if 32 pix
-
-    ack = ack && this->send_command(SSD1306_SETPRECHARGE); 
-    ack = ack && this->send_command(0xF1);  
-
-    ack = ack && this->send_command(SSD1306_SETVCOMDETECT); 
-    ack = ack && this->send_command(0x40);  
-
-    ack = ack && this->send_command(SSD1306_DISPLAYALLON_RESUME); 
-    
-    ack = ack && this->send_command(SSD1306_NORMALDISPLAY); 
-    
-    ack = ack && this->send_command(SSD1306_DISPLAYON);  
-    return ack;
+    // Commands depending on the size of the screen - same stream as SSD1306_Panel
+    SSD1306_Stream  init = ssd1306_init_stream(this->__height);
+    return this->__link.send_commands(init.cmds, init.size);
 }
 
 void SSD1306::clear_screen(void)
@@ -97,61 +108,104 @@ void SSD1306::clear_screen(void)
 
 void 	SSD1306::display_on(void)
 {
-    this->send_command(SSD1306_DISPLAYON); 
+    this->__link.send_command(SSD1306_DISPLAYON);
 }
 
 void 	SSD1306::display_off(void)
 {
-    this->send_command(SSD1306_DISPLAYOFF); 
+    this->__link.send_command(SSD1306_DISPLAYOFF);
 }
 
 void    SSD1306::invertDisplay(bool i)
 {
-    this->send_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY); 
+    this->__link.send_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
 }
 
 /**************************************************************
  *	Commands and data transmission
  **************************************************************/
 
-bool 	SSD1306::send_command (uint8_t cmd)
-{
-    char buff[2];
-    int ack;
-	buff[0] = 0; // Command Mode
-	buff[1] = cmd;
-	ack = this->__i2c->write(SSD_I2C_ADDRESS, buff, sizeof(buff));
-    return  (ack == 0) ? SSD1306_SUCCESS : SSD1306_ERROR;
+bool    SSD1306::display(){
+    if(this->__link.get_bus()){
+        /// Background flush of the front buffer
+        this->wait_flush();
+        // one copy per block - the Data Mode bytes are set by init_flush
+        for(int k = 0, i = 0; i < this->__buff_size; k++, i += SSD_I2C_DATA_BLOCK){
+            int len = (this->__buff_size - i > SSD_I2C_DATA_BLOCK) ? SSD_I2C_DATA_BLOCK : this->__buff_size - i;
+            memcpy(&this->__front[k * (SSD_I2C_DATA_BLOCK+1) + 1], &this->__buffer[i], len);
+        }
+        this->__flushing = true;
+        this->__flush_ack = true;
+        this->__flush_end.clear(SSD_FLUSH_END);
+        for(uint16_t k = 0; k < this->__flush.size(); k++){
+            this->__link.get_bus()->submit(&this->__flush[k]);
+        }
+        return  SSD1306_SUCCESS;
+    }
+    /// Horizontal addressing mode, on the whole screen
+    return  this->__link.send_pages(this->__buffer.data(), this->__width, 0, this->__height / 8 - 1);
 }
 
-bool 	SSD1306::send_data (std::vector<uint8_t> data, uint16_t size)
-{
-    char *buff = new char[size+1];
-    int ack;
-	buff[0] = 0x40; // Data Mode
-    for(int i = 0; i < size; i++)
-        buff[i+1] = data[i];
-	ack = this->__i2c->write(SSD_I2C_ADDRESS, buff, size+1);
-    return  (ack == 0) ? SSD1306_SUCCESS : SSD1306_ERROR;
+bool    SSD1306::display_page(uint8_t page){
+    if(page >= this->__height / 8){ return SSD1306_ERROR; }
+    /// Commands and data of the page after the previous frame
+    this->wait_flush();
+    return  this->__link.send_pages(this->__buffer.data(), this->__width, page, page);
 }
 
-bool    SSD1306::display(){
-    bool ack = true;
-    /// Set memory addressing mode
-    ack = ack && this->send_command(SSD1306_MEMORYMODE);  
-    // Horizontal addressing mode
-    ack = ack && this->send_command(SSD1306_SETLOWCOLUMN | 0x0);
-    // Set column start and end addresses
-    ack = ack && this->send_command(SSD1306_MEMORYMODE | 0x1);
-    ack = ack && this->send_command(0x0);
-    ack = ack && this->send_command(this->__width-1);
-    // Set page start and end addresses
-    ack = ack && this->send_command(SSD1306_MEMORYMODE | 0x2);
-    ack = ack && this->send_command(0x0);
-    ack = ack && this->send_command(0x7);
-    
-    this->send_data(this->__buffer, this->__buff_size);
-    return  ack;
+bool    SSD1306::set_start_line(uint8_t line){
+    this->wait_flush();
+    return this->__link.send_command(SSD1306_SETSTARTLINE | (line & 0x3F));
+}
+
+bool    SSD1306::wait_flush(void){
+    if(this->__flushing){
+        this->__flush_end.wait_any(SSD_FLUSH_END);
+    }
+    return this->__flush_ack;
+}
+
+bool    SSD1306::is_flushing(void){
+    return this->__flushing;
+}
+
+void    SSD1306::init_flush(void){
+    this->__flushing = false;
+    this->__flush_ack = true;
+    /// Addressing commands of the whole screen - after a Command Mode byte
+    SSD1306_Stream  window = ssd1306_window_stream(this->__width, 0, this->__height / 8 - 1);
+    this->__flush_cmds[0] = 0x00;
+    memcpy(&this->__flush_cmds[1], window.cmds, window.size);
+    /// Front buffer : a Data Mode byte before each block
+    uint16_t nb_blocks = (this->__buff_size + SSD_I2C_DATA_BLOCK - 1) / SSD_I2C_DATA_BLOCK;
+    this->__front.resize(this->__buff_size + nb_blocks);
+    for(uint16_t k = 0; k < nb_blocks; k++){
+        this->__front[k * (SSD_I2C_DATA_BLOCK+1)] = 0x40;    // Data Mode
+    }
+    this->__flush.resize(nb_blocks + 1);
+    for(uint16_t k = 0; k <= nb_blocks; k++){
+        I2C_Transaction *t = &this->__flush[k];
+        t->setDevice(SSD_I2C_ADDRESS, SSD_I2C_FREQ, I2C_BUS_PRIORITY_LOW);
+        t->done = callback(this, &SSD1306::flush_done);
+        if(k == 0){
+            t->setData(this->__flush_cmds, sizeof(this->__flush_cmds));
+        }
+        else{
+            int offset = (k - 1) * (SSD_I2C_DATA_BLOCK+1);
+            int len = this->__front.size() - offset;
+            if(len > SSD_I2C_DATA_BLOCK+1){ len = SSD_I2C_DATA_BLOCK+1; }
+            t->setData(&this->__front[offset], len);
+        }
+    }
+}
+
+void    SSD1306::flush_done(I2C_Transaction *t){
+    if(t->result != I2C_BUS_OK){ this->__flush_ack = false; }
+    // transactions of the same priority are sent in order
+    if(t == &this->__flush.back()){
+        this->__flushing = false;
+        this->__flush_end.set(SSD_FLUSH_END);
+    }
 }
 
 std::vector<uint8_t> SSD1306::get_buffer(void){
@@ -186,19 +240,142 @@ bool    SSD1306::check_value_range(uint16_t val, uint16_t min, uint16_t max)
  *	Drawings
  **************************************************************/
 
+void 	SSD1306::write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+{
+	this->put_span(x0, x1, y, color);
+}
+
+void 	SSD1306::write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+							uint16_t color, bool opaque, uint16_t bg)
+{
+	ssd1306_put_glyph(this->__buffer.data(), this->__width, x, y, columns, scale, color, opaque, bg);
+}
+
 bool 	SSD1306::draw_pixel (uint16_t x, uint16_t y, uint16_t color)
 {
-    // check if coordinates is out of range
-    if (!this->check_range(x, y)) { return SSD1306_ERROR; }
+    // check if coordinates is out of range - check_range includes the size (end of a rectangle)
+    if ((x >= this->__width) || (y >= this->__height)) { return SSD1306_ERROR; }
 
     // x is which column
-    if (color == SSD1306_WHITE) 
-        this->__buffer[x+ (y/8) * this->__width] |= (1 << (y%8));  
-    else // else black
-        this->__buffer[x+ (y/8) * this->__width] &= (0 << (y%8));
+    this->put_pixel(x, y, color);
 
 	return SSD1306_SUCCESS;
 }
 
 
 
+
+
+/**************************************************************
+ *	Dithering of the 16 bits images
+ **************************************************************/
+
+void    SSD1306::set_dither(enum Dither mode)
+{
+    this->__dither = mode;
+}
+
+bool    SSD1306::dither_start(int16_t x, int16_t y, uint16_t w, uint16_t h)
+{
+    int16_t     cx0, cy0, cx1, cy1;
+    this->get_clip(cx0, cy0, cx1, cy1);
+    // visible part of the image
+    int16_t     x0 = (x > cx0) ? x : cx0;
+    int16_t     x1 = (x + w - 1 < cx1) ? x + w - 1 : cx1;
+    this->__dy0 = (y > cy0) ? y : cy0;
+    this->__dy1 = (y + h - 1 < cy1) ? y + h - 1 : cy1;
+    if ((x1 < x0) || (this->__dy1 < this->__dy0)) { return SSD1306_ERROR; }
+    this->__dx0 = x0;
+    this->__dw = x1 - x0 + 1;
+    std::fill(this->__error.begin(), this->__error.end(), 0);
+    return SSD1306_SUCCESS;
+}
+
+uint8_t *SSD1306::dither_band(int16_t y)
+{
+    return &this->__band[(y%8) * this->__width];
+}
+
+void    SSD1306::dither_row(int16_t y)
+{
+    if (this->__dither == DITHER_FLOYD) {
+        uint8_t     *row = this->dither_band(y);
+        // errors of this row and of the next row - one pixel of margin on each side
+        int16_t     *err = &this->__error[((y - this->__dy0) & 1) * (this->__width + 2) + 1];
+        int16_t     *next = &this->__error[((y - this->__dy0 + 1) & 1) * (this->__width + 2) + 1];
+        std::fill(next - 1, next + this->__dw + 1, 0);
+        for (uint16_t i = 0; i < this->__dw; i++) {
+            int16_t v = row[i] + err[i];
+            row[i] = (v >= SSD_DITHER_THRESHOLD) ? 255 : 0;
+            int16_t e = v - row[i];
+            err[i+1] += e * 7 / 16;
+            next[i-1] += e * 3 / 16;
+            next[i] += e * 5 / 16;
+            next[i+1] += e / 16;
+        }
+    }
+    // last row of the page or of the image
+    if (((y%8) == 7) || (y == this->__dy1)) { this->dither_page(y); }
+}
+
+void    SSD1306::dither_page(int16_t y)
+{
+    // rows of the page in the image
+    int16_t     y0 = y - (y%8);
+    if (y0 < this->__dy0) { y0 = this->__dy0; }
+    uint8_t     mask = (0xFF << (y0%8)) & (0xFF >> (7 - (y%8)));
+    uint8_t     *page = &this->__buffer[(y/8) * this->__width + this->__dx0];
+    for (uint16_t i = 0; i < this->__dw; i++) {
+        const uint8_t   *bayer = ssd1306_bayer[(this->__dx0 + i) & 7];
+        uint8_t     bits = 0;
+        // 0 or 255 after error diffusion - always above or under the thresholds
+        for (int16_t k = y0%8; k <= y%8; k++) {
+            if (this->__band[k * this->__width + i] > bayer[k]) { bits |= (1 << k); }
+        }
+        page[i] = (page[i] & ~mask) | bits;
+    }
+}
+
+bool    SSD1306::draw_rgb565(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels)
+{
+    if (!this->dither_start(x, y, w, h)) { return SSD1306_ERROR; }
+    for (int16_t sy = this->__dy0; sy <= this->__dy1; sy++) {
+        uint8_t     *row = this->dither_band(sy);
+        const uint16_t  *src = &pixels[(sy - y) * w + (this->__dx0 - x)];
+        for (uint16_t i = 0; i < this->__dw; i++) { row[i] = ssd1306_luminance(src[i]); }
+        this->dither_row(sy);
+    }
+    return SSD1306_SUCCESS;
+}
+
+bool    SSD1306::draw_image(int16_t x, int16_t y, const LCD_Image *img)
+{
+    if (!this->dither_start(x, y, img->width, img->height)) { return SSD1306_ERROR; }
+    // luminance of the colors of the palette
+    uint8_t     lum[256];
+    for (uint16_t k = 0; (k < img->nb_colors) && (k < 256); k++) { lum[k] = ssd1306_luminance(img->palette[k]); }
+    LCD_ImageDecoder    dec(img);
+    uint8_t     index;
+    // visible columns in the image
+    uint16_t    c0 = this->__dx0 - x;
+    uint16_t    c1 = c0 + this->__dw;
+    for (int16_t sy = y; sy <= this->__dy1; sy++) {
+        bool        visible = (sy >= this->__dy0);
+        uint8_t     *row = this->dither_band(sy);
+        uint16_t    i = 0;
+        while (i < img->width) {
+            uint16_t    len = dec.next_run(&index, img->width - i);
+            uint8_t     value = ((len > 0) && (index < img->nb_colors)) ? lum[index] : 0;
+            // missing data - black up to the end of the image
+            if (len == 0) { len = img->width - i; }
+            if (visible) {
+                uint16_t    a = (i > c0) ? i : c0;
+                uint16_t    b = (i + len < c1) ? i + len : c1;
+                for (uint16_t k = a; k < b; k++) { row[k - c0] = value; }
+            }
+            i += len;
+        }
+        if (visible) { this->dither_row(sy); }
+    }
+    return SSD1306_SUCCESS;
+}
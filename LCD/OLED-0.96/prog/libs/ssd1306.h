@@ -18,9 +18,20 @@
 
 #include "mbed.h"
 #include "ssd1306_constants.h"
+#include "ssd1306_core.h"
 #include "LCD_graphics.h"
+#include "I2C_Bus.h"
 #include <vector>
 
+/**
+ * @enum Dither
+ * @brief Conversion of 16 bits colors (RGB565) to black and white pixels
+ */
+enum Dither {
+    DITHER_BAYER,       ///< ordered dithering - 8x8 Bayer matrix
+    DITHER_FLOYD        ///< error diffusion - Floyd-Steinberg
+};
+
 /**
  * @class SSD1306
  * @brief 	Class to control a LCD display driven by a SSD1306 device
@@ -34,30 +45,44 @@ class SSD1306 : public LCD_graphics {
 	    std::vector<uint8_t> __buffer;
         uint16_t    __buff_size;
 
-        /// I2C interface 
-        I2C			*__i2c;
+        /// I2C interface or shared I2C bus
+        SSD1306_Link    __link;
 		
 		/// Width and Height of the screen
 		uint16_t		__width;
 		uint16_t		__height;
-		
-        
-		
+
+        /// Front buffer - blocks of data sent in background (shared bus only)
+        std::vector<char>   __front;
+        /// Addressing commands of the flush
+        char        __flush_cmds[SSD_WINDOW_STREAM_LEN+1];
+        /// Transactions of the flush : addressing commands, then blocks of data
+        std::vector<I2C_Transaction>    __flush;
+        /// End of the flush
+        EventFlags  __flush_end;
+        volatile bool   __flushing;
+        volatile bool   __flush_ack;
+
+        /// Dithering of the 16 bits images
+        enum Dither     __dither;
+        /// Luminance of the rows of the page in progress - 8 rows of width pixels
+        std::vector<uint8_t>    __band;
+        /// Errors of the current and of the next rows (Floyd-Steinberg)
+        std::vector<int16_t>    __error;
+        /// Visible part of the image in progress
+        int16_t     __dx0, __dy0, __dy1;
+        uint16_t    __dw;
+
         /**
-        * @brief Send a command of 8 bits to the driver.
-        * @param cmd uint8_t - Command to send, 1 byte.
-        * @return bool - True if acknowledgement is done.
+        * @brief Prepare the transactions of the flush (shared bus only).
 		*/
-		bool 	send_command(uint8_t cmd);
+        void    init_flush(void);
 
         /**
-        * @brief Send a data of 8 bits to the driver.
-        * @param data std::vector<uint8_t> - Data to send, 1 byte.
-        * @param size uint16_t - Number of data to send.
-        * @return bool - True if acknowledgement is done.
-		*/		
-		bool	send_data(std::vector<uint8_t> data, uint16_t size);
-				
+        * @brief End of a transaction of the flush - in the event queue.
+		*/
+        void    flush_done(I2C_Transaction *t);
+		
 		/**
         * @brief Check if the coordinates are in the range of the screen size
 		* @param x  uint16_t - coordinate on X axis
@@ -74,6 +99,39 @@ class SSD1306 : public LCD_graphics {
 		* @return true if is in the range 
 		*/			
 		bool    check_value_range(uint16_t val, uint16_t min, uint16_t max);
+
+        /**
+        * @brief Start the dithering of an image - visible part in the clipping rectangle.
+        * @return bool - False if the image is out of the clipping rectangle.
+		*/
+        bool    dither_start(int16_t x, int16_t y, uint16_t w, uint16_t h);
+
+        /**
+        * @brief Return the row of luminance (0-255) of a row of the screen.
+        * @details Visible columns only, from __dx0.
+		*/
+        uint8_t *dither_band(int16_t y);
+
+        /**
+        * @brief Dither a row of luminance, then the page after its last row.
+		*/
+        void    dither_row(int16_t y);
+
+        /**
+        * @brief Write the rows of the page of y to the buffer - one byte per column.
+		*/
+        void    dither_page(int16_t y);
+
+		/**
+        * @brief Write a horizontal span of pixels - one bit of each column of the page
+		*/
+		void    write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color);
+
+		/**
+        * @brief Write a scaled character - bytes of the expanded columns in the pages
+		*/
+		void    write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+                            uint16_t color, bool opaque, uint16_t bg);
 		
 
     public:
@@ -86,6 +144,15 @@ class SSD1306 : public LCD_graphics {
         */
         SSD1306(I2C *i2C, uint16_t width, uint16_t height);
 
+        /**
+        * @brief Constructor of the SSD1306 class on a shared I2C bus.
+        * @details Transactions are sent with a low priority, at SSD_I2C_FREQ.
+        * @param bus I2C_Bus - shared I2C bus.
+		* @param width  uint16_t - width of the screen in pixels.
+		* @param height uint16_t - height of the screen in pixels.
+        */
+        SSD1306(I2C_Bus *bus, uint16_t width, uint16_t height);
+
 		/**
         * @brief Initialization of the display.
         * @return bool - True if aknowledgement is done.
@@ -114,9 +181,49 @@ class SSD1306 : public LCD_graphics {
 		
 		/**
         * @brief Update the buffer to the display.
-        * @return bool - True if aknowledgement is done.
+        * @details On a shared I2C bus, the buffer is copied in the front
+        *   buffer and sent in background : the next frame can be drawn
+        *   during the transfer. If the previous flush is not ended,
+        *   wait for its end first. Not from an interrupt routine or from
+        *   the shared event queue.
+        *   The buffer is copied (one memcpy per block of data) and not
+        *   swapped with the front buffer : the next frame is drawn over
+        *   the displayed one (console, widgets). The copy of 1 KB
+        *   (128x64) takes a few us, the transfer about 95 ms at
+        *   SSD_I2C_FREQ (see tests/main_ssd1306_bench.cpp).
+        * @return bool - True if aknowledgement is done (I2C interface), 
+        *   true if the flush is started (shared bus).
 		*/
         bool    display(void);
+
+		/**
+        * @brief Wait for the end of the background flush.
+        * @return bool - True if aknowledgement is done for the whole flush.
+		*/
+        bool    wait_flush(void);
+
+		/**
+        * @brief Return true if a background flush is in progress.
+		*/
+        bool    is_flushing(void);
+
+		/**
+        * @brief Update one page (8 rows) of the buffer to the display.
+        * @details Blocking transfer of one page - after the end of the
+        *   background flush (shared bus).
+        * @param page uint8_t - Index of the page, 0 to height/8-1.
+        * @return bool - True if aknowledgement is done.
+		*/
+        bool    display_page(uint8_t page);
+
+		/**
+        * @brief Set the first row of the memory displayed at the top of the screen.
+        * @details Hardware vertical scrolling : the rows of the memory are
+        *   displayed from this row, then from row 0 after the last one.
+        * @param line uint8_t - Row of the memory, 0 to 63.
+        * @return bool - True if aknowledgement is done.
+		*/
+        bool    set_start_line(uint8_t line);
 		
 		/**
 		 * @brief    Draw a pixel at a specific position
@@ -127,10 +234,65 @@ class SSD1306 : public LCD_graphics {
 		 */
 		bool	draw_pixel (uint16_t x, uint16_t y, uint16_t color);
 
+		/**
+		 * @brief    Select the dithering of the 16 bits images
+		 * @param mode - enum Dither - DITHER_BAYER (default) or DITHER_FLOYD
+		 */
+        void    set_dither(enum Dither mode);
+
+		/**
+		 * @brief    Draw an image of 16 bits colors (RGB565) - dithered
+		 * @details  Shared assets of the ST7735. The pixels are written to
+		 *  the buffer by pages : one byte for 8 rows of a column.
+		 * @param x - int16_t - x position of the top-left corner
+		 * @param y - int16_t - y position of the top-left corner
+		 * @param w - uint16_t - width of the image
+		 * @param h - uint16_t - height of the image
+		 * @param pixels - const uint16_t * - colors, row after row
+         * @return  false if the image is out of the clipping rectangle
+		 */
+        bool    draw_rgb565(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels);
+
+		/**
+		 * @brief    Draw a compressed image (see LCD_image.h) - dithered
+		 * @details  Colors of the palette are converted to luminance once.
+		 * @param x - int16_t - x position of the top-left corner
+		 * @param y - int16_t - y position of the top-left corner
+		 * @param img - const LCD_Image * - image
+         * @return  false if the image is out of the clipping rectangle
+		 */
+        bool    draw_image(int16_t x, int16_t y, const LCD_Image *img);
+
         /**
 		 * @brief    Return the buffer of the screen
          */
         std::vector<uint8_t> get_buffer(void);
+
+        /**
+		 * @brief    Return the width of the screen in pixels
+         */
+        inline uint16_t get_width(void) { return this->__width; }
+
+        /**
+		 * @brief    Return the height of the screen in pixels
+         */
+        inline uint16_t get_height(void) { return this->__height; }
+
+        /**
+		 * @brief    Write a pixel to the buffer - no range check (see LCD_graphics_t)
+         */
+        inline void put_pixel(uint16_t x, uint16_t y, uint16_t color)
+        {
+            ssd1306_put_pixel(this->__buffer.data(), this->__width, x, y, color);
+        }
+
+        /**
+		 * @brief    Write a horizontal span to the buffer - no range check (see LCD_graphics_t)
+         */
+        inline void put_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+        {
+            ssd1306_put_span(this->__buffer.data(), this->__width, x0, x1, y, color);
+        }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * FILENAME :        ssd1306_console.cpp
+ *
+ * DESCRIPTION :
+ *       OLED 0.96' SSD1306 - Text console with hardware scrolling
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "ssd1306_console.h"
+
+SSD1306_Console::SSD1306_Console(SSD1306 *lcd, uint16_t width, uint16_t height)
+{
+	this->__lcd = lcd;
+	this->__width = width;
+	this->__height = height;
+	this->__top = 0;
+}
+
+void 	SSD1306_Console::clear(void)
+{
+	this->__top = 0;
+	this->__lcd->clear_screen();
+	this->__lcd->set_start_line(0);
+}
+
+bool 	SSD1306_Console::print_line(char *str)
+{
+	uint8_t		page = this->__top;
+	char		line[MAX_X / (CHARS_COLS_LEN + 1) + 1];
+	uint8_t		nb_chars = this->__width / (CHARS_COLS_LEN + 1);
+	// characters of the line only
+	uint8_t		k = 0;
+	while((k < nb_chars) && (k < sizeof(line) - 1) && (str[k] != '\0')){
+		line[k] = str[k];
+		k++;
+	}
+	line[k] = '\0';
+	// new line in the page at the top of the screen
+	this->__lcd->fill_rect(0, page * 8, this->__width, 7, SSD1306_BLACK);
+	if(this->__lcd->set_position(0, page * 8)){
+		this->__lcd->draw_string(line, SSD1306_WHITE, NORMAL);
+	}
+	bool ack = this->__lcd->display_page(page);
+	// this page goes to the bottom of the screen
+	this->__top = (page + 1) % (this->__height / 8);
+	ack = ack && this->__lcd->set_start_line(this->__top * 8);
+	return ack;
+}
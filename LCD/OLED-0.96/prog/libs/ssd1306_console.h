@@ -0,0 +1,67 @@
+/**
+ * FILENAME :        ssd1306_console.h
+ *
+ * DESCRIPTION :
+ *       OLED 0.96' SSD1306 - Text console with hardware scrolling
+ *
+ *       One line of text is one page (8 rows) of the memory. A new line
+ *  is drawn in the page displayed at the top of the screen, then the
+ *  start line of the driver moves down by 8 rows : the new line appears
+ *  at the bottom and the other lines move up. Only one page and one
+ *  command are sent for each line, without redrawing the screen.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __SSD1306_CONSOLE_H__
+#define __SSD1306_CONSOLE_H__
+
+#include "mbed.h"
+#include "ssd1306.h"
+
+/**
+ * @class SSD1306_Console
+ * @brief 	Text console on a SSD1306 display - hardware scrolling
+ * @details The console uses the whole memory of the display : the
+ *  memory rows are not the screen rows while the console is scrolled.
+ *  clear() goes back to the normal display.
+ */
+class SSD1306_Console {
+    private:
+        /// LCD display
+        SSD1306     *__lcd;
+        /// Width and Height of the screen
+        uint16_t    __width;
+        uint16_t    __height;
+        /// Page of the memory displayed at the top of the screen
+        uint8_t     __top;
+
+    public:
+        /**
+        * @brief Simple constructor of the SSD1306_Console class.
+        * @param lcd SSD1306 - initialized LCD display
+        * @param width uint16_t - width of the screen
+        * @param height uint16_t - height of the screen
+        */
+        SSD1306_Console(SSD1306 *lcd, uint16_t width = MAX_X, uint16_t height = MAX_Y);
+
+        /**
+        * @brief Clear the screen and the scrolling.
+        */
+        void    clear(void);
+
+        /**
+        * @brief Add a line of text at the bottom of the screen.
+        * @details The characters after the end of the line are not displayed.
+        * @param str char * - line of text
+        * @return false if the page or the start line can not be sent.
+        */
+        bool    print_line(char *str);
+};
+
+#endif
@@ -24,6 +24,12 @@
 #define 	SSD_I2C_FREQ		100000
 
 #define     SSD_I2C_ADDRESS     0x78
+// Size of the blocks of data (one page of a 128 pixels wide screen)
+#define     SSD_I2C_DATA_BLOCK  128
+// Maximum number of bytes of a stream of commands
+#define     SSD_CMD_STREAM_MAX  32
+// Event flag of the end of a background flush
+#define     SSD_FLUSH_END       0x01
 
 
   // Colors
@@ -31,6 +37,11 @@
   #define SSD1306_BLACK         0
   #define SSD1306_WHITE         1
 
+  // Dithering of the 16 bits colors
+  // -----------------------------------
+  // Luminance threshold of the error diffusion (Floyd-Steinberg)
+  #define SSD_DITHER_THRESHOLD  128
+
   // AREA definition
   // -----------------------------------
   #define MAX_X                 128               // max columns / MV = 0 in MADCTL
@@ -58,6 +69,8 @@
 #define SSD1306_SETHIGHCOLUMN       0x10
 #define SSD1306_SETSTARTLINE        0x40
 #define SSD1306_MEMORYMODE          0x20
+#define SSD1306_COLUMNADDR          0x21
+#define SSD1306_PAGEADDR            0x22
 #define SSD1306_COMSCANINC          0xC0
 #define SSD1306_COMSCANDEC          0xC8
 #define SSD1306_SEGREMAP            0xA0
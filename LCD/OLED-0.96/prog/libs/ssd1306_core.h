@@ -0,0 +1,260 @@
+/**
+ * FILENAME :        ssd1306_core.h
+ *
+ * DESCRIPTION :
+ *       LCD Joy-It OLED-0.96 - Parts of the SSD1306 driver common to
+ *      SSD1306 (size known at runtime) and SSD1306_Panel (size known
+ *      at compile time) :
+ *          -> streams of the initialization and of the address window
+ *          -> link to the driver : I2C interface or shared I2C bus,
+ *              streams of commands and blocks of data
+ *          -> pixels, spans and scaled characters in a buffer of pages
+ *              (one byte for 8 rows of a column)
+ *       All the functions are inline : with the width of a
+ *      SSD1306_Panel, the addressing of the pixels is folded at
+ *      compile time.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __SSD1306_CORE_H__
+#define __SSD1306_CORE_H__
+
+#include "mbed.h"
+#include "ssd1306_constants.h"
+#include "font.h"
+#include "I2C_Bus.h"
+#include <cstring>
+
+/** Constant definition */
+/// Number of bytes of the initialization stream
+#define     SSD_INIT_STREAM_LEN     23
+/// Number of bytes of the address window stream
+#define     SSD_WINDOW_STREAM_LEN   8
+
+static_assert(SSD_INIT_STREAM_LEN <= SSD_CMD_STREAM_MAX, "SSD1306 init stream");
+
+/**
+ * @struct SSD1306_Stream
+ * @brief Stream of commands and arguments - sent after a single control byte
+ */
+struct SSD1306_Stream{
+    uint8_t     cmds[SSD_INIT_STREAM_LEN];
+    uint8_t     size;
+};
+
+/**
+ * @brief Initialization stream of a screen of height rows.
+ * @details Multiplex ratio, COM pins and contrast depend on the height.
+ */
+constexpr SSD1306_Stream    ssd1306_init_stream(uint16_t height)
+{
+    return {{
+        SSD1306_DISPLAYOFF,
+        SSD1306_SETDISPLAYCLOCKDIV,     0x80,   // the suggested ratio 0x80
+        SSD1306_SETDISPLAYOFFSET,       0x00,   // no offset
+        SSD1306_SETSTARTLINE | 0x0,             // Start Line - 0
+        SSD1306_CHARGEPUMP,             0x14,   // Internal charge pump
+        SSD1306_SEGREMAP | 0x1,
+        SSD1306_COMSCANDEC,
+        SSD1306_SETCONTRAST,            (uint8_t)((height > 32) ? 0xCF : 0x8F),
+        SSD1306_SETPRECHARGE,           0xF1,
+        SSD1306_SETVCOMDETECT,          0x40,
+        SSD1306_DISPLAYALLON_RESUME,
+        SSD1306_NORMALDISPLAY,
+        SSD1306_SETMULTIPLEX,           (uint8_t)(height - 1),
+        SSD1306_SETCOMPINS,             (uint8_t)((height > 32) ? 0x12 : 0x02),
+        SSD1306_DISPLAYON
+    }, SSD_INIT_STREAM_LEN};
+}
+
+/**
+ * @brief Address window of the pages page0 to page1 - horizontal addressing mode.
+ */
+constexpr SSD1306_Stream    ssd1306_window_stream(uint16_t width, uint8_t page0, uint8_t page1)
+{
+    return {{
+        SSD1306_MEMORYMODE,     0x00,
+        SSD1306_COLUMNADDR,     0x00,   (uint8_t)(width - 1),
+        SSD1306_PAGEADDR,       page0,  page1
+    }, SSD_WINDOW_STREAM_LEN};
+}
+
+/**
+ * @brief    Write a pixel to a buffer of pages - no range check
+ */
+inline void ssd1306_put_pixel(uint8_t *buffer, uint16_t width, uint16_t x, uint16_t y, uint16_t color)
+{
+    if (color != SSD1306_BLACK) { buffer[x + (y/8) * width] |= (1 << (y%8)); }
+    else { buffer[x + (y/8) * width] &= ~(1 << (y%8)); }
+}
+
+/**
+ * @brief    Write a horizontal span to a buffer of pages - no range check
+ */
+inline void ssd1306_put_span(uint8_t *buffer, uint16_t width, uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+{
+    uint8_t     *page = &buffer[(y/8) * width];
+    uint8_t     mask = 1 << (y%8);
+    // any color but black is white (RGB565 palette of an image)
+    if (color != SSD1306_BLACK) {
+        for (uint16_t x = x0; x <= x1; x++) { page[x] |= mask; }
+    }
+    else {
+        for (uint16_t x = x0; x <= x1; x++) { page[x] &= ~mask; }
+    }
+}
+
+/* 8 bits of a column from the row o of the cell - o < 0 above the cell */
+inline uint8_t  ssd1306_column_byte(uint64_t column, int16_t o)
+{
+    if (o >= 64) { return 0; }
+    return (o >= 0) ? (uint8_t)(column >> o) : (uint8_t)(column << -o);
+}
+
+/**
+ * @brief    Write a scaled character to a buffer of pages - no range check
+ * @details  One byte of the expanded column per page, the same byte in
+ *      the scale columns of the pixel (see LCD_graphics::write_glyph).
+ */
+inline void ssd1306_put_glyph(uint8_t *buffer, uint16_t width, uint16_t x, uint16_t y,
+                            const uint64_t *columns, uint8_t scale, uint16_t color, bool opaque, uint16_t bg)
+{
+    uint8_t     h = CHARS_ROWS_LEN * scale;
+    uint64_t    cell = (h == 64) ? ~0ULL : ((1ULL << h) - 1);
+    for (uint8_t c = 0; c <= CHARS_COLS_LEN; c++) {
+        // transparent : nothing in the space between the characters
+        if (!opaque && (columns[c] == 0)) { continue; }
+        for (uint16_t p = y/8; p <= (y + h - 1)/8; p++) {
+            int16_t     o = p*8 - y;
+            uint8_t     bits = ssd1306_column_byte(columns[c], o);
+            uint8_t     mask = opaque ? ssd1306_column_byte(cell, o) : bits;
+            uint8_t     value = ((color != SSD1306_BLACK) ? bits : 0) | ((bg != SSD1306_BLACK) ? ~bits : 0);
+            // same byte in the scale columns
+            uint8_t     *page = &buffer[p * width + x + c * scale];
+            for (uint8_t k = 0; k < scale; k++) {
+                page[k] = (page[k] & ~mask) | (value & mask);
+            }
+        }
+    }
+}
+
+/**
+ * @class SSD1306_Link
+ * @brief 	Blocking transfers to a SSD1306 driver - I2C interface or shared I2C bus
+ * @details  On a shared bus, transactions are sent with a low priority,
+ *      at SSD_I2C_FREQ.
+ */
+class SSD1306_Link {
+    private:
+        /// I2C interface
+        I2C         *__i2c;
+        /// Shared I2C bus - NULL if the I2C interface is used
+        I2C_Bus     *__bus;
+
+    public:
+        /**
+        * @brief Link on an I2C interface - set to SSD_I2C_FREQ.
+        */
+        SSD1306_Link(I2C *i2c)
+        {
+            this->__i2c = i2c;
+            this->__i2c->frequency(SSD_I2C_FREQ);
+            this->__bus = NULL;
+        }
+
+        /**
+        * @brief Link on a shared I2C bus - frequency is set for each transaction.
+        */
+        SSD1306_Link(I2C_Bus *bus)
+        {
+            this->__i2c = NULL;
+            this->__bus = bus;
+        }
+
+        /**
+        * @brief Return the shared I2C bus - NULL if the I2C interface is used.
+        */
+        inline I2C_Bus  *get_bus(void) { return this->__bus; }
+
+        /**
+        * @brief Write a buffer to the driver, on the I2C interface or on the bus.
+        * @return bool - True if acknowledgement is done.
+		*/
+        bool    write(const char *buff, int size)
+        {
+            int ack;
+            if (this->__bus) {
+                ack = this->__bus->write(SSD_I2C_ADDRESS, buff, size, SSD_I2C_FREQ, I2C_BUS_PRIORITY_LOW);
+            }
+            else {
+                ack = this->__i2c->write(SSD_I2C_ADDRESS, buff, size);
+            }
+            return (ack == 0) ? SSD1306_SUCCESS : SSD1306_ERROR;
+        }
+
+        /**
+        * @brief Send a stream of commands (and arguments) to the driver.
+        * @details A single control byte (0x00) is followed by the commands :
+        *   one I2C transaction for up to SSD_CMD_STREAM_MAX bytes.
+        * @return bool - True if acknowledgement is done.
+		*/
+        bool    send_commands(const uint8_t *cmds, uint8_t size)
+        {
+            char buff[SSD_CMD_STREAM_MAX+1];
+            bool ack = true;
+            buff[0] = 0;    // Command Mode - Co = 0 : only commands follow
+            for (int k = 0; (k < size) && ack; k += SSD_CMD_STREAM_MAX) {
+                int len = (size - k > SSD_CMD_STREAM_MAX) ? SSD_CMD_STREAM_MAX : size - k;
+                memcpy(&buff[1], &cmds[k], len);
+                ack = this->write(buff, len+1);
+            }
+            return ack;
+        }
+
+        /**
+        * @brief Send a command of 8 bits to the driver.
+        * @return bool - True if acknowledgement is done.
+		*/
+        inline bool send_command(uint8_t cmd) { return this->send_commands(&cmd, 1); }
+
+        /**
+        * @brief Send data - blocks of SSD_I2C_DATA_BLOCK bytes.
+        * @details On a shared bus, transactions of other devices can be
+        *   interleaved between two blocks : the address pointer of the
+        *   driver goes on from one block to the next.
+        * @return bool - True if acknowledgement is done.
+		*/
+        bool    send_data(const uint8_t *data, uint16_t size)
+        {
+            char buff[SSD_I2C_DATA_BLOCK+1];
+            bool ack = true;
+            buff[0] = 0x40; // Data Mode
+            for (int k = 0; (k < size) && ack; k += SSD_I2C_DATA_BLOCK) {
+                int len = (size - k > SSD_I2C_DATA_BLOCK) ? SSD_I2C_DATA_BLOCK : size - k;
+                memcpy(&buff[1], &data[k], len);
+                ack = this->write(buff, len+1);
+            }
+            return ack;
+        }
+
+        /**
+        * @brief Send the pages page0 to page1 of a buffer of pages - address window, then data.
+        * @param buffer const uint8_t * - buffer of the whole screen.
+        * @param width uint16_t - width of the screen.
+        * @return bool - True if acknowledgement is done.
+		*/
+        bool    send_pages(const uint8_t *buffer, uint16_t width, uint8_t page0, uint8_t page1)
+        {
+            SSD1306_Stream  window = ssd1306_window_stream(width, page0, page1);
+            bool ack = this->send_commands(window.cmds, window.size);
+            return ack && this->send_data(&buffer[page0 * width], (page1 - page0 + 1) * width);
+        }
+};
+
+#endif
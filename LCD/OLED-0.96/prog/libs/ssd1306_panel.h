@@ -0,0 +1,224 @@
+/**
+ * FILENAME :        ssd1306_panel.h
+ *
+ * DESCRIPTION :
+ *       LCD Joy-It OLED-0.96 - SSD1306 panel of compile-time size.
+ *       The width and the height are template parameters :
+ *          -> the buffer is a std::array (no heap, static allocation
+ *              for a global object)
+ *          -> the initialization stream is built at compile time
+ *              (multiplex ratio, COM pins, contrast)
+ *          -> the addressing of the pixels is folded to shifts and masks
+ *       A 128x32 panel uses half of the RAM and of the transfer time
+ *      of a 128x64 panel.
+ *
+ *       I2C             my_i2c(D14, D15);
+ *       SSD1306_128x32  my_lcd(&my_i2c);
+ *
+ *       SSD1306 is still available for a runtime size, a background
+ *      flush on a shared bus or the dithering of 16 bits images.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __SSD1306_PANEL_H__
+#define __SSD1306_PANEL_H__
+
+#include "mbed.h"
+#include "ssd1306_constants.h"
+#include "ssd1306_core.h"
+#include "LCD_graphics.h"
+#include "I2C_Bus.h"
+#include <array>
+
+/**
+ * @class SSD1306_Panel
+ * @brief 	SSD1306 display of W x H pixels - sizes known at compile time
+ * @details  Pixels can also be drawn by LCD_graphics_t<SSD1306_Panel<W, H>>.
+ *      The streams and the transfers are the ones of SSD1306 (ssd1306_core.h).
+ */
+template <uint16_t W, uint16_t H>
+class SSD1306_Panel : public LCD_graphics {
+    static_assert((W > 0) && (W <= 128), "SSD1306 : 1 to 128 columns");
+    static_assert((H == 16) || (H == 32) || (H == 64), "SSD1306 : 16, 32 or 64 rows");
+
+    public:
+        /// Size of the buffer - one byte for 8 rows of a column
+        static constexpr uint16_t   BUFF_SIZE = W * H / 8;
+        /// Initialization - commands and arguments, sent in a single stream
+        static constexpr SSD1306_Stream init_stream = ssd1306_init_stream(H);
+
+    private:
+        /// The memory buffer for the LCD
+        std::array<uint8_t, BUFF_SIZE>  __buffer;
+        /// I2C interface or shared I2C bus
+        SSD1306_Link    __link;
+
+    public:
+        /**
+        * @brief Simple constructor of the SSD1306_Panel class.
+        * @param i2c I2C - I2C interface.
+        */
+        SSD1306_Panel(I2C *i2c) : __link(i2c)
+        {
+            this->__buffer.fill(0);
+            this->set_screen(W, H);
+        }
+
+        /**
+        * @brief Constructor of the SSD1306_Panel class on a shared I2C bus.
+        * @details Transactions are sent with a low priority, at SSD_I2C_FREQ.
+        * @param bus I2C_Bus - shared I2C bus.
+        */
+        SSD1306_Panel(I2C_Bus *bus) : __link(bus)
+        {
+            this->__buffer.fill(0);
+            this->set_screen(W, H);
+        }
+
+		/**
+        * @brief Initialization of the display.
+        * @return bool - True if aknowledgement is done.
+		*/
+        bool    init(void)
+        {
+            return this->__link.send_commands(init_stream.cmds, init_stream.size);
+        }
+
+		/**
+        * @brief Switch on the screen.
+		*/
+        void    display_on(void)
+        {
+            this->__link.send_command(SSD1306_DISPLAYON);
+        }
+
+		/**
+        * @brief Switch off the screen.
+		*/
+        void    display_off(void)
+        {
+            this->__link.send_command(SSD1306_DISPLAYOFF);
+        }
+
+		/**
+        * @brief Invert the color of the screen.
+		*/
+        void    invertDisplay(bool i)
+        {
+            this->__link.send_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+        }
+
+		/**
+        * @brief Clear the screen.
+		*/
+        void    clear_screen(void)
+        {
+            this->__buffer.fill(0);
+            this->display();
+        }
+
+		/**
+        * @brief Update the buffer to the display - blocking transfer of BUFF_SIZE bytes.
+        * @return bool - True if aknowledgement is done.
+		*/
+        bool    display(void)
+        {
+            return this->__link.send_pages(this->__buffer.data(), W, 0, H / 8 - 1);
+        }
+
+		/**
+        * @brief Update one page (8 rows) of the buffer to the display.
+        * @param page uint8_t - Index of the page, 0 to H/8-1.
+        * @return bool - True if aknowledgement is done.
+		*/
+        bool    display_page(uint8_t page)
+        {
+            if (page >= H / 8) { return SSD1306_ERROR; }
+            return this->__link.send_pages(this->__buffer.data(), W, page, page);
+        }
+
+		/**
+        * @brief Set the first row of the memory displayed at the top of the screen.
+        * @param line uint8_t - Row of the memory, 0 to 63.
+        * @return bool - True if aknowledgement is done.
+		*/
+        bool    set_start_line(uint8_t line)
+        {
+            return this->__link.send_command(SSD1306_SETSTARTLINE | (line & 0x3F));
+        }
+
+        /**
+		 * @brief    Return the buffer of the screen
+         */
+        const std::array<uint8_t, BUFF_SIZE> &get_buffer(void) { return this->__buffer; }
+
+        /**
+		 * @brief    Return the size of the screen in pixels
+         */
+        static constexpr uint16_t get_width(void) { return W; }
+        static constexpr uint16_t get_height(void) { return H; }
+
+        /**
+		 * @brief    Write a pixel to the buffer - no range check (see LCD_graphics_t)
+         */
+        inline void put_pixel(uint16_t x, uint16_t y, uint16_t color)
+        {
+            ssd1306_put_pixel(this->__buffer.data(), W, x, y, color);
+        }
+
+        /**
+		 * @brief    Write a horizontal span to the buffer - no range check (see LCD_graphics_t)
+         */
+        inline void put_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+        {
+            ssd1306_put_span(this->__buffer.data(), W, x0, x1, y, color);
+        }
+
+		/**
+        * @brief Check if the coordinates are in the range of the screen size
+		*/
+        bool    check_range(uint16_t x, uint16_t y)
+        {
+            return ((x <= W) && (y <= H));
+        }
+
+		/**
+		 * @brief    Draw a pixel at a specific position
+         * @return  false if x and y are out of range
+		 */
+        bool    draw_pixel(uint16_t x, uint16_t y, uint16_t color)
+        {
+            if ((x >= W) || (y >= H)) { return SSD1306_ERROR; }
+            this->put_pixel(x, y, color);
+            return SSD1306_SUCCESS;
+        }
+
+    protected:
+        void    write_pixel(uint16_t x, uint16_t y, uint16_t color) { this->put_pixel(x, y, color); }
+        void    write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color) { this->put_span(x0, x1, y, color); }
+
+		/**
+        * @brief Write a scaled character - bytes of the expanded columns in the pages
+		*/
+        void    write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+                            uint16_t color, bool opaque, uint16_t bg)
+        {
+            ssd1306_put_glyph(this->__buffer.data(), W, x, y, columns, scale, color, opaque, bg);
+        }
+};
+
+/* Definition of the constant stream (C++14) */
+template <uint16_t W, uint16_t H>
+constexpr SSD1306_Stream    SSD1306_Panel<W, H>::init_stream;
+
+/** Joy-It OLED-0.96 and 0.91' panels */
+typedef SSD1306_Panel<128, 64>  SSD1306_128x64;
+typedef SSD1306_Panel<128, 32>  SSD1306_128x32;
+
+#endif
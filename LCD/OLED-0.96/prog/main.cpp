@@ -16,6 +16,7 @@
 #include "mbed.h"
 #include "ssd1306.h"
 #include "ssd1306_constants.h"
+#include "LCD_graphics_t.h"
 
 
 /// Inputs/outputs declaration 
@@ -25,6 +26,11 @@ InterruptIn     mode_change(BUTTON1);
 
 I2C         my_i2c(D14, D15);
 SSD1306     my_lcd(&my_i2c, MAX_X, MAX_Y);
+/// Same screen, primitives inlined in the SSD1306 library
+LCD_graphics_t<SSD1306>     my_gfx(&my_lcd);
+
+/// Number of primitives of each benchmark
+#define     BENCH_NB        1000
 
 
 /* Methods */
@@ -43,6 +49,12 @@ void ISR_change_mode(void);
 /// Internal boolean print function
 void printbool(bool v, char* name);
 
+/**
+ * Benchmark of the primitives - virtual (LCD_graphics) and template (LCD_graphics_t)
+ * Prints the number of primitives per second, in the buffer only
+ */
+void bench_primitives(void);
+
 // 
 int	cpt = 0;
 
@@ -71,6 +83,13 @@ int main()
     my_lcd.draw_line(30, 50, 60, 40, SSD1306_WHITE);
     my_lcd.display();
 
+    bench_primitives();
+    my_lcd.clear_screen();
+    my_gfx.set_position(10, 10);
+    my_gfx.draw_string("LCD_graphics_t", SSD1306_WHITE, NORMAL);
+    my_gfx.fill_circle(64, 44, 15, SSD1306_WHITE);
+    my_lcd.display();
+
     // Initialization of interrupt on falling edge of the push button
     mode_change.fall(&ISR_change_mode);
 
@@ -102,6 +121,37 @@ void ISR_change_mode(void){
 }
 
 
+/* */
+void bench_primitives(void){
+    Timer   t;
+    int     time_v, time_g;
+    printf("Primitives per second : virtual / template\r\n");
+    // lines
+    t.reset(); t.start();
+    for(int k = 0; k < BENCH_NB; k++){ my_lcd.draw_line(k % 128, 0, 127 - k % 128, 63, SSD1306_WHITE); }
+    time_v = t.read_us();
+    t.reset();
+    for(int k = 0; k < BENCH_NB; k++){ my_gfx.draw_line(k % 128, 0, 127 - k % 128, 63, SSD1306_WHITE); }
+    time_g = t.read_us();
+    printf("\tdraw_line   %d / %d\r\n", BENCH_NB * 1000 / (time_v / 1000 + 1), BENCH_NB * 1000 / (time_g / 1000 + 1));
+    // filled rectangles
+    t.reset();
+    for(int k = 0; k < BENCH_NB; k++){ my_lcd.fill_rect(k % 64, k % 32, 60, 30, k & 1); }
+    time_v = t.read_us();
+    t.reset();
+    for(int k = 0; k < BENCH_NB; k++){ my_gfx.fill_rect(k % 64, k % 32, 60, 30, k & 1); }
+    time_g = t.read_us();
+    printf("\tfill_rect   %d / %d\r\n", BENCH_NB * 1000 / (time_v / 1000 + 1), BENCH_NB * 1000 / (time_g / 1000 + 1));
+    // characters
+    t.reset();
+    for(int k = 0; k < BENCH_NB; k++){ my_lcd.set_position(0, 0); my_lcd.draw_char('A' + k % 26, SSD1306_WHITE, NORMAL); }
+    time_v = t.read_us();
+    t.reset();
+    for(int k = 0; k < BENCH_NB; k++){ my_gfx.set_position(0, 0); my_gfx.draw_char('A' + k % 26, SSD1306_WHITE, NORMAL); }
+    time_g = t.read_us();
+    printf("\tdraw_char   %d / %d\r\n", BENCH_NB * 1000 / (time_v / 1000 + 1), BENCH_NB * 1000 / (time_g / 1000 + 1));
+}
+
 /// Internal boolean print function
 void printbool(bool v, char* name){
     if(v == true)
@@ -0,0 +1,345 @@
+/**
+ * FILENAME :        main_ssd1306_bench.cpp
+ *
+ * DESCRIPTION :
+ *       OLED-0.96 / Frame rate and CPU load of the SSD1306 on a computer,
+ *  with a stand-in of the I2C interface (tests/mbed.h).
+ *
+ *       This program does not depend on MBED OS (from the prog directory) :
+ *          g++ -std=c++14 -O2 -Itests -Ilibs -I../../LCD_graphics/prog -I../../../I2C_Bus
+ *              -I../../LCD_graphics/tests tests/main_ssd1306_bench.cpp libs/ssd1306.cpp ../../LCD_graphics/prog/LCD_graphics.cpp
+ *              ../../LCD_graphics/prog/LCD_image.cpp ../../LCD_graphics/prog/font.cpp
+ *              ../../../I2C_Bus/I2C_Bus.cpp -o ssd1306_bench
+ *          ./ssd1306_bench         -> results, exit code 1 if a check fails
+ *
+ *       The same animation is drawn on a SSD1306 on an I2C interface
+ *  (blocking display) and on a shared I2C bus (background flush) :
+ *          -> times of the drawing, of display() (copy of the buffer and
+ *              submit of the flush) and of the calls of the event queue,
+ *              measured on the computer
+ *          -> time of the bytes on the bus at SSD_I2C_FREQ (virtual time)
+ *          -> frame rate and CPU load of the display : the drawing of the
+ *              next frame runs during the background flush
+ *       A model of the memory of the SSD1306 receives the commands and
+ *  the data : after each frame, it must be equal to the buffer.
+ *       The same frames are drawn on a SSD1306_128x64 (ssd1306_panel.h) :
+ *  its initialization stream, its buffer and the memory of the SSD1306
+ *  must be the ones of the SSD1306 object. Both write the characters by
+ *  bytes of the pages : their buffers must also be the one of the spans
+ *  of LCD_graphics (SimPages). Both refuse the pixels out of the buffer
+ *  (x = width or y = height).
+ *       Black and white images of 1 and 4 bits (test patterns of
+ *  LCD_graphics/tests/sim_image.h) are exact after dithering : the buffer
+ *  of SSD1306::draw_image, with each mode of dithering, must be the one
+ *  of the spans of the SSD1306_Panel and of SimPages, on each edge of the
+ *  screen and of a clipping rectangle.
+ *
+ *       The times of the computer are shorter than the times of the
+ *  Nucleo L476RG (80 MHz) : the CPU load of the board is higher, but the
+ *  bus time (about 95 ms for 128x64 at 100 kHz) is the same.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <vector>
+#include "mbed.h"
+#include "ssd1306.h"
+#include "ssd1306_panel.h"
+#include "ssd1306_constants.h"
+#include "sim_image.h"
+
+/** Constant definition */
+#define SIM_NB_FRAMES       200
+#define SIM_WIDTH           128
+#define SIM_HEIGHT          64
+
+/* Stand-in of MBED OS */
+int         stub_violations = 0;
+double      stub_bus_time = 0;
+double      stub_queue_time = 0;
+EventQueue  stub_queue;
+
+void stubViolation(const char *what){
+    if(stub_violations < 10){ printf("  stand-in : %s\n", what); }
+    stub_violations++;
+}
+
+EventQueue  *mbed_event_queue(void){
+    return &stub_queue;
+}
+
+/**
+ * @class SimRam
+ * @brief Memory of the SSD1306 - commands of the address window and data
+ */
+class SimRam{
+    public:
+        std::vector<uint8_t>    ram;
+        uint8_t     col0, col1, page0, page1, col, page;
+
+        SimRam(void) : ram(SIM_WIDTH * SIM_HEIGHT / 8, 0){
+            col0 = 0; col1 = SIM_WIDTH - 1; page0 = 0; page1 = SIM_HEIGHT / 8 - 1;
+            col = 0; page = 0;
+        }
+
+        /// Number of arguments of a command
+        static int  nb_args(uint8_t cmd){
+            switch(cmd){
+                case SSD1306_COLUMNADDR:
+                case SSD1306_PAGEADDR:
+                    return 2;
+                case SSD1306_MEMORYMODE:
+                case SSD1306_SETDISPLAYCLOCKDIV:
+                case SSD1306_SETDISPLAYOFFSET:
+                case SSD1306_CHARGEPUMP:
+                case SSD1306_SETCONTRAST:
+                case SSD1306_SETPRECHARGE:
+                case SSD1306_SETVCOMDETECT:
+                case SSD1306_SETMULTIPLEX:
+                case SSD1306_SETCOMPINS:
+                    return 1;
+                default:
+                    return 0;
+            }
+        }
+
+        void    write(const uint8_t *data, int length){
+            if(length < 1){ return; }
+            if(data[0] == 0x40){
+                // horizontal addressing mode
+                for(int k = 1; k < length; k++){
+                    this->ram[this->page * SIM_WIDTH + this->col] = data[k];
+                    if(this->col++ == this->col1){
+                        this->col = this->col0;
+                        this->page = (this->page == this->page1) ? this->page0 : this->page + 1;
+                    }
+                }
+                return;
+            }
+            for(int k = 1; k < length; k += 1 + nb_args(data[k])){
+                if((data[k] == SSD1306_COLUMNADDR) && (k + 2 < length)){
+                    this->col = this->col0 = data[k+1];
+                    this->col1 = data[k+2];
+                }
+                if((data[k] == SSD1306_PAGEADDR) && (k + 2 < length)){
+                    this->page = this->page0 = data[k+1];
+                    this->page1 = data[k+2];
+                }
+            }
+        }
+};
+
+SimRam      sim_ram;
+/// Streams of commands sent to the SSD1306
+std::vector<uint8_t>    sim_cmds;
+
+void stubI2CData(int address, const char *data, int length){
+    if(address != SSD_I2C_ADDRESS){ return; }
+    sim_ram.write((const uint8_t *)data, length);
+    if((length > 0) && (data[0] == 0x00)){ sim_cmds.insert(sim_cmds.end(), data, data + length); }
+}
+
+/**
+ * @struct SimResult
+ * @brief Times of a mode - mean of a frame (s)
+ */
+struct SimResult{
+    double  draw, display, queue, bus;
+    int     errors;
+};
+
+double simElapsed(std::chrono::steady_clock::time_point t0){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/// One frame of the animation
+void drawFrame(LCD_graphics *lcd, int f){
+    char    str[20];
+    lcd->fill_rect(0, 0, SIM_WIDTH, SIM_HEIGHT - 1, SSD1306_BLACK);
+    lcd->draw_rect(0, 0, SIM_WIDTH - 1, SIM_HEIGHT - 1, SSD1306_WHITE);
+    lcd->fill_circle(10 + f % (SIM_WIDTH - 20), 32, 9, SSD1306_WHITE);
+    lcd->draw_circle(SIM_WIDTH - 1 - f % SIM_WIDTH, 20, 14, SSD1306_WHITE);
+    lcd->draw_line(0, f % SIM_HEIGHT, SIM_WIDTH - 1, SIM_HEIGHT - 1 - f % SIM_HEIGHT, SSD1306_WHITE);
+    snprintf(str, sizeof(str), "FRAME %d", f);
+    lcd->set_position(4, 50);
+    lcd->draw_string(str, SSD1306_WHITE, NORMAL);
+    // characters across the pages, on a background
+    lcd->set_position(70, 3 + f % 5);
+    lcd->draw_string_scale("Ab", SSD1306_WHITE, 3);
+    lcd->set_text_background(SSD1306_WHITE);
+    lcd->set_position(90, 40 + f % 3);
+    lcd->draw_string((char *)"ok", SSD1306_BLACK, LARGE);
+    lcd->set_text_transparent();
+}
+
+/**
+ * @class SimPages
+ * @brief Buffer of pages written by spans only - characters drawn by LCD_graphics
+ */
+class SimPages : public LCD_graphics {
+    public:
+        std::vector<uint8_t>    buffer;
+
+        SimPages(void) : buffer(SIM_WIDTH * SIM_HEIGHT / 8, 0){
+            this->set_screen(SIM_WIDTH, SIM_HEIGHT);
+        }
+        bool    check_range(uint16_t x, uint16_t y){
+            return (x <= SIM_WIDTH) && (y <= SIM_HEIGHT);
+        }
+        bool    draw_pixel(uint16_t x, uint16_t y, uint16_t color){
+            if((x >= SIM_WIDTH) || (y >= SIM_HEIGHT)){ return false; }
+            ssd1306_put_pixel(this->buffer.data(), SIM_WIDTH, x, y, color);
+            return true;
+        }
+
+    protected:
+        void    write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color){
+            ssd1306_put_span(this->buffer.data(), SIM_WIDTH, x0, x1, y, color);
+        }
+};
+
+SimResult runFrames(SSD1306 *lcd, bool background){
+    SimResult   r = {0, 0, 0, 0, 0};
+    double      bus0 = stub_bus_time, queue0 = stub_queue_time;
+    std::vector<uint8_t>    sent;
+    for(int f = 0; f < SIM_NB_FRAMES; f++){
+        auto    t0 = std::chrono::steady_clock::now();
+        drawFrame(lcd, f);
+        r.draw += simElapsed(t0);
+        // end of the previous flush - the bus runs during the drawing
+        if(background){
+            lcd->wait_flush();
+            r.errors += (f > 0) && (sim_ram.ram != sent);
+        }
+        t0 = std::chrono::steady_clock::now();
+        lcd->display();
+        r.display += simElapsed(t0);
+        sent = lcd->get_buffer();
+        if(!background){ r.errors += (sim_ram.ram != sent); }
+    }
+    if(background){
+        lcd->wait_flush();
+        r.errors += (sim_ram.ram != sent);
+    }
+    r.draw /= SIM_NB_FRAMES;
+    r.display /= SIM_NB_FRAMES;
+    r.queue = (stub_queue_time - queue0) / SIM_NB_FRAMES;
+    r.bus = (stub_bus_time - bus0) / SIM_NB_FRAMES;
+    return r;
+}
+
+void printResult(const char *name, SimResult &r, bool background){
+    // the drawing runs during the background flush
+    double  cpu = r.draw + r.display + r.queue;
+    double  period = background ? ((cpu > r.bus) ? cpu : r.bus) : cpu + r.bus;
+    double  load = background ? (r.display + r.queue) / period : (r.display + r.bus) / period;
+    printf("%s\n", name);
+    printf("  drawing %.1f us, display() %.1f us, event queue %.1f us, bus %.2f ms\n",
+            r.draw * 1e6, r.display * 1e6, r.queue * 1e6, r.bus * 1e3);
+    printf("  %.1f frames/s, CPU load of the display %.3f %%, memory errors %d\n",
+            1 / period, 100 * load, r.errors);
+}
+
+/* Static objects : the constructors of the drivers delete their previous interface (NULL) */
+I2C     my_i2c(1, 2);
+SSD1306 lcd_i2c(&my_i2c, SIM_WIDTH, SIM_HEIGHT);
+I2C_Bus my_bus(3, 4);
+SSD1306 lcd_bus(&my_bus, SIM_WIDTH, SIM_HEIGHT);
+I2C     my_panel_i2c(5, 6);
+SSD1306_Panel<SIM_WIDTH, SIM_HEIGHT>    lcd_panel(&my_panel_i2c);
+SimPages    sim_pages;
+
+/// Same frames on the SSD1306 and on the SSD1306_Panel - number of errors
+int runPanel(void){
+    int     errors = 0;
+    sim_ram = SimRam();
+    sim_cmds.clear();
+    lcd_i2c.init();
+    std::vector<uint8_t>    cmds = sim_cmds;
+    sim_cmds.clear();
+    lcd_panel.init();
+    errors += (sim_cmds != cmds);
+    for(int f = 0; f < SIM_NB_FRAMES; f++){
+        drawFrame(&lcd_i2c, f);
+        drawFrame(&lcd_panel, f);
+        drawFrame(&sim_pages, f);
+        lcd_panel.display();
+        std::vector<uint8_t>    sent(lcd_panel.get_buffer().begin(), lcd_panel.get_buffer().end());
+        errors += (sim_ram.ram != sent) || (sent != lcd_i2c.get_buffer()) || (sent != sim_pages.buffer);
+    }
+    // last pixel of the screen, then pixels out of the buffer
+    errors += !lcd_i2c.draw_pixel(SIM_WIDTH - 1, SIM_HEIGHT - 1, SSD1306_WHITE);
+    errors += !lcd_panel.draw_pixel(SIM_WIDTH - 1, SIM_HEIGHT - 1, SSD1306_WHITE);
+    errors += lcd_i2c.draw_pixel(SIM_WIDTH, 0, SSD1306_WHITE) || lcd_i2c.draw_pixel(0, SIM_HEIGHT, SSD1306_WHITE);
+    errors += lcd_panel.draw_pixel(SIM_WIDTH, 0, SSD1306_WHITE) || lcd_panel.draw_pixel(0, SIM_HEIGHT, SSD1306_WHITE);
+    std::vector<uint8_t>    last(lcd_panel.get_buffer().begin(), lcd_panel.get_buffer().end());
+    errors += (last != lcd_i2c.get_buffer());
+    return errors;
+}
+
+/// Black and white images - exact after dithering
+const std::vector<uint16_t>     sim_colors = {0x0000, 0xFFFF};
+SimImage    sim_image_1(40, 24, 1, 2, sim_colors);
+SimImage    sim_image_4(36, 20, 4, 16, sim_colors);
+
+/// Images dithered by the SSD1306, spans of the SSD1306_Panel and of LCD_graphics - number of errors
+int runImages(void){
+    int     errors = 0;
+    // in the screen, on each edge of the screen and of the clipping rectangle
+    static const int16_t    places[][2] = {{44, 20}, {-10, -6}, {100, 50}, {-5, 44}, {90, -3}, {20, 2}};
+    const enum Dither   modes[] = {DITHER_BAYER, DITHER_FLOYD};
+    for(const enum Dither mode : modes){
+        lcd_i2c.set_dither(mode);
+        for(int clip = 0; clip < 2; clip++){
+            for(const SimImage *image : {&sim_image_1, &sim_image_4}){
+                for(const int16_t *p : places){
+                    LCD_graphics    *screens[] = {&lcd_i2c, &lcd_panel, &sim_pages};
+                    for(LCD_graphics *lcd : screens){
+                        lcd->fill_rect(0, 0, SIM_WIDTH, SIM_HEIGHT - 1, SSD1306_BLACK);
+                        if(clip){ lcd->set_clip(12, 8, 107, 55); }
+                        lcd->draw_image(p[0], p[1], &image->img);
+                        lcd->reset_clip();
+                    }
+                    std::vector<uint8_t>    spans(lcd_panel.get_buffer().begin(), lcd_panel.get_buffer().end());
+                    errors += (spans != lcd_i2c.get_buffer()) || (spans != sim_pages.buffer);
+                }
+            }
+        }
+    }
+    lcd_i2c.set_dither(DITHER_BAYER);
+    return errors;
+}
+
+int main()
+{
+    int     failed = 0;
+    /// Blocking display on an I2C interface
+    lcd_i2c.init();
+    SimResult   r_i2c = runFrames(&lcd_i2c, false);
+    printResult("I2C interface - blocking display()", r_i2c, false);
+
+    /// Background flush on a shared bus
+    sim_ram = SimRam();
+    lcd_bus.init();
+    SimResult   r_bus = runFrames(&lcd_bus, true);
+    printResult("Shared I2C bus - background flush", r_bus, true);
+
+    // flush : addressing commands (9 bytes), then one block of 129 bytes per page
+    double  expected = ((9 + 1) * 9 + STUB_I2C_FRAME_CLOCKS
+                + (SIM_HEIGHT / 8) * ((SSD_I2C_DATA_BLOCK + 2) * 9 + STUB_I2C_FRAME_CLOCKS)) / (double)SSD_I2C_FREQ;
+    printf("Bus time of a frame : %.2f ms (expected %.2f ms)\n", r_bus.bus * 1e3, expected * 1e3);
+    /// Compile-time size
+    int     e_panel = runPanel();
+    printf("SSD1306_Panel<%d, %d> - same stream, frames and characters : %d errors\n", SIM_WIDTH, SIM_HEIGHT, e_panel);
+    int     e_images = runImages();
+    printf("Black and white images - dithered and spans, clipped : %d errors\n", e_images);
+    failed += (r_i2c.errors != 0) || (r_bus.errors != 0) || (e_panel != 0) || (e_images != 0) || (stub_violations != 0);
+    failed += (r_bus.bus > 1.01 * expected) || (r_bus.bus < 0.99 * expected);
+    printf("%s\n", failed ? "FAILED" : "OK");
+    return failed ? 1 : 0;
+}
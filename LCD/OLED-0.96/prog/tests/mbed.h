@@ -0,0 +1,231 @@
+/**
+ * FILENAME :        mbed.h
+ *
+ * DESCRIPTION :
+ *       OLED-0.96 / Host stand-in of MBED OS for main_ssd1306_bench.cpp.
+ *
+ *       Only the parts of MBED OS used by SSD1306, LCD_graphics and I2C_Bus :
+ *          -> I2C counts the time of the bytes on the bus (9 clocks per
+ *              byte, address byte included) - virtual time, no wait
+ *          -> an asynchronous transfer stays in progress until stub_run()
+ *              (end of transfer interrupt)
+ *          -> the shared event queue stores the calls until stub_run(),
+ *              and measures the time of the calls on the computer
+ *          -> Semaphore and EventFlags call stub_run() while they wait :
+ *              the single thread of the program runs the bus
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __MBED_HOST_STUB_H__
+#define __MBED_HOST_STUB_H__
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <deque>
+#include <functional>
+
+using namespace std::chrono_literals;
+
+/** Constant definition */
+#define     I2C_EVENT_ERROR                 (1 << 1)
+#define     I2C_EVENT_ERROR_NO_SLAVE        (1 << 2)
+#define     I2C_EVENT_TRANSFER_COMPLETE     (1 << 3)
+#define     I2C_EVENT_TRANSFER_EARLY_NACK   (1 << 4)
+#define     I2C_EVENT_ALL                   (I2C_EVENT_ERROR | I2C_EVENT_TRANSFER_COMPLETE | I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)
+/// Clocks of the start and stop conditions of a transfer
+#define     STUB_I2C_FRAME_CLOCKS           2
+/// Calls of stub_run() before a blocking wait is a dead-lock
+#define     STUB_WAIT_MAX                   100000
+
+typedef int PinName;
+const PinName   NC = -1;
+
+/// Violation of the rules of the stand-in - counted
+extern int  stub_violations;
+void stubViolation(const char *what);
+
+/// Data written on the I2C bus - defined by the program
+void stubI2CData(int address, const char *data, int length);
+
+/// Time of the bytes on the bus (s) - virtual time
+extern double   stub_bus_time;
+/// Time of the calls of the event queue on the computer (s)
+extern double   stub_queue_time;
+
+/**
+ * @brief End of the asynchronous transfers in progress, then calls of the event queue.
+ * @return false if there is nothing to run
+ */
+inline bool stub_run(void);
+
+inline void wait_us(int us){}
+inline uint32_t us_ticker_read(void){
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**************************************************************
+ *	Callbacks and event queue
+ **************************************************************/
+
+template <typename F> class Callback;
+
+template <typename R, typename... A>
+class Callback<R(A...)>{
+    public:
+        std::function<R(A...)>  f;
+        Callback(void){}
+        Callback(std::nullptr_t){}
+        Callback(R (*func)(A...)) : f(func){}
+        template <typename T, typename M>
+        Callback(T *obj, M method){ f = [obj, method](A... a){ return (obj->*method)(a...); }; }
+        R operator()(A... a) const { return f(a...); }
+        explicit operator bool() const { return (bool)f; }
+};
+
+template <typename R, typename... A>
+Callback<R(A...)> callback(R (*func)(A...)){ return Callback<R(A...)>(func); }
+template <typename T, typename R, typename... A>
+Callback<R(A...)> callback(T *obj, R (T::*method)(A...)){ return Callback<R(A...)>(obj, method); }
+
+typedef Callback<void(int)>     event_callback_t;
+
+class EventQueue{
+    public:
+        std::deque<std::function<void()>>   calls;
+        int     id = 0;
+
+        template <typename F, typename... A>
+        int     call(F f, A... a){
+            this->calls.push_back([=](){ f(a...); });
+            return ++this->id;
+        }
+        /// Run the oldest call - false if the queue is empty
+        bool    dispatch_one(void){
+            if(this->calls.empty()){ return false; }
+            std::function<void()> c = this->calls.front();
+            this->calls.pop_front();
+            auto    t0 = std::chrono::steady_clock::now();
+            c();
+            stub_queue_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            return true;
+        }
+};
+EventQueue  *mbed_event_queue(void);
+
+class CriticalSectionLock{
+    public:
+        CriticalSectionLock(void){}
+        ~CriticalSectionLock(void){}
+};
+
+class Semaphore{
+    public:
+        int     count;
+        Semaphore(int c = 0) : count(c){}
+        bool    try_acquire(void){
+            if(this->count == 0){ return false; }
+            this->count--;
+            return true;
+        }
+        bool    try_acquire_for(std::chrono::milliseconds t){
+            for(int n = 0; (this->count == 0) && (n < STUB_WAIT_MAX) && stub_run(); n++){}
+            return this->try_acquire();
+        }
+        void    acquire(void){
+            if(!this->try_acquire_for(0ms)){ stubViolation("Semaphore::acquire without token (dead-lock)"); }
+        }
+        void    release(void){ this->count++; }
+};
+
+class EventFlags{
+    public:
+        uint32_t    flags = 0;
+        uint32_t    set(uint32_t f){ this->flags |= f; return this->flags; }
+        uint32_t    clear(uint32_t f){ this->flags &= ~f; return this->flags; }
+        uint32_t    wait_any(uint32_t f){
+            for(int n = 0; !(this->flags & f) && (n < STUB_WAIT_MAX) && stub_run(); n++){}
+            if(!(this->flags & f)){ stubViolation("EventFlags::wait_any without flag (dead-lock)"); }
+            uint32_t    r = this->flags;
+            this->flags &= ~f;
+            return r;
+        }
+};
+
+/**************************************************************
+ *	I2C
+ **************************************************************/
+
+class I2C{
+    public:
+        int     hz;
+        /// Asynchronous transfer in progress - ended by stub_run()
+        bool    busy;
+        double  duration;
+        event_callback_t    cb;
+        /// Bytes written on the bus
+        uint32_t    nb_bytes;
+
+        I2C(PinName sda, PinName scl){
+            this->hz = 100000; this->busy = false; this->duration = 0; this->nb_bytes = 0;
+            I2C::all().push_back(this);
+        }
+        ~I2C(void){
+            for(auto it = I2C::all().begin(); it != I2C::all().end(); it++){
+                if(*it == this){ I2C::all().erase(it); break; }
+            }
+        }
+        /// Interfaces of the program
+        static std::deque<I2C *>    &all(void){
+            static std::deque<I2C *>    interfaces;
+            return interfaces;
+        }
+        void    frequency(int f){ this->hz = f; }
+        /// Time of a transfer of length bytes - address byte included
+        double  time(int length){
+            return ((length + 1) * 9 + STUB_I2C_FRAME_CLOCKS) / (double)this->hz;
+        }
+        int     write(int address, const char *data, int length, bool repeated = false){
+            if(this->busy){ stubViolation("I2C used during an asynchronous transfer"); }
+            stub_bus_time += this->time(length);
+            this->nb_bytes += length;
+            stubI2CData(address, data, length);
+            return 0;
+        }
+        int     transfer(int address, const char *tx, int tx_length, char *rx, int rx_length,
+                        const event_callback_t &cb, int event, bool repeated = false){
+            if(this->busy){ stubViolation("I2C used during an asynchronous transfer"); }
+            this->busy = true;
+            this->duration = this->time(tx_length) + ((rx_length > 0) ? this->time(rx_length) : 0);
+            this->nb_bytes += tx_length + rx_length;
+            this->cb = cb;
+            stubI2CData(address, tx, tx_length);
+            return 0;
+        }
+        void    abort_transfer(void){ this->busy = false; }
+        /// End of the asynchronous transfer - interrupt
+        bool    complete(void){
+            if(!this->busy){ return false; }
+            this->busy = false;
+            stub_bus_time += this->duration;
+            this->cb(I2C_EVENT_TRANSFER_COMPLETE);
+            return true;
+        }
+};
+
+inline bool stub_run(void){
+    bool    run = false;
+    for(I2C *i2c : I2C::all()){ run |= i2c->complete(); }
+    while(mbed_event_queue()->dispatch_one()){ run = true; }
+    return run;
+}
+
+#endif
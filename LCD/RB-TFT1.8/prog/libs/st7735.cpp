@@ -22,6 +22,47 @@
 #include <cstdint>
 
 
+/* Initialization sequence - see send_commands for the format */
+static constexpr uint8_t	st7735_init_cmds[] = {
+	5,								// number of commands
+	// Software reset - no arguments
+	SWRESET,	DELAY,			150,
+	// Out of sleep mode - no arguments
+	SLPOUT,		DELAY,			200,
+	// Set color mode - 1 argument - 16 bits per pixel
+	COLMOD,		1 | DELAY,		0x05,	10,
+	// D7  D6  D5  D4  D3  D2  D1  D0
+	// MY  MX  MV  ML RGB  MH   -   -
+	// ------------------------------
+	// ------------------------------
+	// MV  MX  MY -> {MV (row / column exchange) MX (column address order), MY (row address order)}
+	// ------------------------------
+	//  0   0   0 -> begin left-up corner, end right-down corner / left-right (normal view) 
+	//  0   0   1 -> begin left-down corner, end right-up corner / left-right (Y-mirror)
+	//  0   1   0 -> begin right-up corner, end left-down corner / right-left (X-mirror)
+	//  0   1   1 -> begin right-down corner, end left-up corner / right-left (X-mirror, Y-mirror)
+	//  1   0   0 -> begin left-up corner, end right-down corner / up-down (X-Y exchange)  
+	//  1   0   1 -> begin left-down corner, end right-up corner / down-up (X-Y exchange, Y-mirror)
+	//  1   1   0 -> begin right-up corner, end left-down corner / up-down (X-Y exchange, X-mirror)  
+	//  1   1   1 -> begin right-down corner, end left-up corner / down-up (X-Y exchange, X-mirror, Y-mirror)
+	// ------------------------------
+	//  ML: vertical refresh order 
+	//      0 -> refresh top to bottom 
+	//      1 -> refresh bottom to top
+	// ------------------------------
+	// RGB: filter panel
+	//      0 -> RGB 
+	//      1 -> BGR        
+	// ------------------------------ 
+	//  MH: horizontal refresh order 
+	//      0 -> refresh left to right 
+	//      1 -> refresh right to left
+	// 0xA0 = 1010 0000
+	MADCTL,		1,				0xA0,
+	// Main screen turn on
+	DISPON,		DELAY,			200
+};
+
 ST7735::ST7735(SPI *spi, PinName cs, PinName rs_dc, PinName reset):
 	__cs(cs), __rs_dc(rs_dc), __reset(reset)
 {
@@ -32,6 +73,23 @@ ST7735::ST7735(SPI *spi, PinName cs, PinName rs_dc, PinName reset):
 	this->__spi = spi;
 	this->__spi->frequency(ST7735_SPI_FREQ);
     this->__spi->format(8, 0);
+	this->__dev = NULL;
+	this->__pixels_busy = false;
+	wait_us(1000);
+	/// Background color
+	this->__bg_color = ST7735_BLACK;
+}
+
+ST7735::ST7735(SPI_Device *dev, PinName rs_dc, PinName reset):
+	__cs(NC), __rs_dc(rs_dc), __reset(reset)
+{
+	/// CS pin is driven by the device of the shared bus
+	this->__spi = NULL;
+	this->__dev = dev;
+	this->__dev->setFormat(8, 0, ST7735_SPI_FREQ);
+	this->__pixels_busy = false;
+	this->__pixels_t.start = callback(this, &ST7735::pixels_start);
+	this->__pixels_t.done = callback(this, &ST7735::pixels_done);
 	wait_us(1000);
 	/// Background color
 	this->__bg_color = ST7735_BLACK;
@@ -55,53 +113,8 @@ void 	ST7735::reset(void)
 void	ST7735::init(void){
 	/// Hardware Reset
 	this->reset();
-	
-	// Software reset - no arguments
-	this->send_command(SWRESET);
-	wait_us(150000);	// 150 ms
-	
-	// Out of sleep mode - no arguments
-	this->send_command(SLPOUT);
-	wait_us(200000);	// 200 ms
-	
-	
-	// Set color mode - 1 argument
-	this->send_command(COLMOD);
-	this->send_data_8bits(0x05);
-	wait_us(10000);		// 10 ms
-		
-	// D7  D6  D5  D4  D3  D2  D1  D0
-	// MY  MX  MV  ML RGB  MH   -   -
-	// ------------------------------
-	// ------------------------------
-	// MV  MX  MY -> {MV (row / column exchange) MX (column address order), MY (row address order)}
-	// ------------------------------
-	//  0   0   0 -> begin left-up corner, end right-down corner / left-right (normal view) 
-	//  0   0   1 -> begin left-down corner, end right-up corner / left-right (Y-mirror)
-	//  0   1   0 -> begin right-up corner, end left-down corner / right-left (X-mirror)
-	//  0   1   1 -> begin right-down corner, end left-up corner / right-left (X-mirror, Y-mirror)
-	//  1   0   0 -> begin left-up corner, end right-down corner / up-down (X-Y exchange)  
-	//  1   0   1 -> begin left-down corner, end right-up corner / down-up (X-Y exchange, Y-mirror)
-	//  1   1   0 -> begin right-up corner, end left-down corner / up-down (X-Y exchange, X-mirror)  
-	//  1   1   1 -> begin right-down corner, end left-up corner / down-up (X-Y exchange, X-mirror, Y-mirror)
-	// ------------------------------
-	//  ML: vertical refresh order 
-	//      0 -> refresh top to bottom 
-	//      1 -> refresh bottom to top
-	// ------------------------------
-	// RGB: filter panel
-	//      0 -> RGB 
-	//      1 -> BGR        
-	// ------------------------------ 
-	//  MH: horizontal refresh order 
-	//      0 -> refresh left to right 
-	//      1 -> refresh right to left
-	// 0xA0 = 1010 0000
-	this->send_command(MADCTL);
-	this->send_data_8bits(0xA0);	
-	// Main screen turn on
-	this->send_command(DISPON);
-	wait_us(200000);	// 200 ms
+	/// Initialization sequence
+	this->send_commands(st7735_init_cmds);
 	// Clear screen
 	this->clear_screen(this->__bg_color);
 }
@@ -138,48 +151,99 @@ void 	ST7735::display_off(void)
  *	Commands and data transmission
  **************************************************************/
 
-void 	ST7735::send_command (uint8_t cmd)
+void 	ST7735::select(void)
 {
+	// the last block of pixels must be sent
+	this->wait_pixels();
 	// chip enable - active low
-	this->__cs = 0;
+	if(this->__dev){ this->__dev->select(); }
+	else{ this->__cs = 0; }
+}
+
+void 	ST7735::deselect(void)
+{
+	// chip disable - idle high
+	if(this->__dev){ this->__dev->deselect(); }
+	else{ this->__cs = 1; }
+}
+
+void 	ST7735::write(uint8_t data)
+{
+	if(this->__dev){ this->__dev->write(data); }
+	else{ this->__spi->write(data); }
+}
+
+void 	ST7735::send_command (uint8_t cmd)
+{
+	this->select();
 	// command (active low)
 	this->__rs_dc = 0;
 	// transmitting data
-	this->__spi->write(cmd);
-	// chip disable - idle high
-	this->__cs = 1;
+	this->write(cmd);
+	this->deselect();
 	return;
 }
 
 void 	ST7735::send_data_8bits (uint8_t data)
 {
-	// chip enable - active low
-	this->__cs = 0;
+	this->select();
 	// data (active high)
 	this->__rs_dc = 1;
 	// transmitting data
-	this->__spi->write(data);
-	// chip disable - idle high
-	this->__cs = 1;
+	this->write(data);
+	this->deselect();
 	return;
 }
 
 
 void 	ST7735::send_data_16bits (uint16_t data)
 {
-	// chip enable - active low
-	this->__cs = 0;
+	this->select();
 	// data (active high)
 	this->__rs_dc = 1;
 	// transmitting data
-	this->__spi->write(data >> 8);
-	this->__spi->write(data);
-	// chip disable - idle high
-	this->__cs = 1;
+	this->write(data >> 8);
+	this->write(data);
+	this->deselect();
 	return;
 }
 
 
+void 	ST7735::write_block(const uint8_t *data, uint16_t size)
+{
+	if(this->__dev){ this->__dev->write((const char *)data, size, NULL, 0); }
+	else{ this->__spi->write((const char *)data, size, NULL, 0); }
+}
+
+void 	ST7735::send_commands(const uint8_t *cmds)
+{
+	uint8_t nb_cmds = *cmds++;
+	this->select();
+	while(nb_cmds--){
+		// command (active low)
+		this->__rs_dc = 0;
+		this->write(*cmds++);
+		uint8_t nb_args = *cmds & ~DELAY;
+		bool	delay = (*cmds++ & DELAY);
+		// arguments (active high)
+		if(nb_args){
+			this->__rs_dc = 1;
+			this->write_block(cmds, nb_args);
+			cmds += nb_args;
+		}
+		if(delay){
+			uint16_t ms = *cmds++;
+			if(ms == 255){ ms = 500; }
+			// the driver is deselected (and the bus released) during the delay
+			this->deselect();
+			thread_sleep_for(ms);
+			this->select();
+		}
+	}
+	this->deselect();
+}
+
+
 /**************************************************************
  *	Windows and position
  **************************************************************/
@@ -192,19 +256,19 @@ bool 	ST7735::set_window(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1){
     if (!this->check_range(x0, y0)) { return ST7735_ERROR; } 
     // check if coordinates is out of range
     if (!this->check_range(x1, y1)) { return ST7735_ERROR; } 
-	// column address set
-	this->send_command(CASET);
-	// send start x position
-	this->send_data_16bits(0x0000 | x0);
-	// send end x position
-	this->send_data_16bits(0x0000 | x1);
-	
-	// row address set
-	this->send_command(RASET);
-	// send start y position
-	this->send_data_16bits(0x0000 | y0);
-	// send end y position
-	this->send_data_16bits(0x0000 | y1);
+	// column and row address set - in one selection
+	const uint8_t	caset[4] = {(uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1};
+	const uint8_t	raset[4] = {(uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1};
+	this->select();
+	this->__rs_dc = 0;
+	this->write(CASET);
+	this->__rs_dc = 1;
+	this->write_block(caset, 4);
+	this->__rs_dc = 0;
+	this->write(RASET);
+	this->__rs_dc = 1;
+	this->write_block(raset, 4);
+	this->deselect();
 
 	// success
 	return ST7735_SUCCESS;
@@ -214,6 +278,8 @@ bool 	ST7735::set_window(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1){
 void 	ST7735::set_screen_size(uint16_t width, uint16_t height){
 	this->__width = width;
 	this->__height = height;
+	// clipping rectangle of the graphics primitives
+	this->set_screen(width, height);
 }
 
 bool    ST7735::check_range(uint16_t x, uint16_t y)
@@ -251,6 +317,43 @@ void 	ST7735::set_color(uint16_t color, uint16_t nb_pixels)
 	}
 }
 
+void 	ST7735::write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+{
+	this->put_span(x0, x1, y, color);
+}
+
+void 	ST7735::write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+							uint16_t color, bool opaque, uint16_t bg)
+{
+	// transparent : spans of the pixels of the character only
+	if(!opaque){
+		LCD_graphics::write_glyph(x, y, columns, scale, color, opaque, bg);
+		return;
+	}
+	uint16_t	w = (CHARS_COLS_LEN + 1) * scale;
+	uint16_t	h = CHARS_ROWS_LEN * scale;
+	if(!this->start_ram_write(x, x + w - 1, y, y + h - 1)){ return; }
+	uint16_t	fg = (color >> 8) | (color << 8);
+	bg = (bg >> 8) | (bg << 8);
+	uint8_t		idx = 0;
+	uint16_t	k = 0;
+	// rows of the cell, from left to right
+	for(uint16_t row = 0; row < h; row++){
+		for(uint8_t c = 0; c <= CHARS_COLS_LEN; c++){
+			uint16_t	value = ((columns[c] >> row) & 1) ? fg : bg;
+			for(uint8_t i = 0; i < scale; i++){
+				this->__image_buf[idx][k++] = value;
+				if(k == ST7735_IMAGE_CHUNK){
+					this->send_pixels(this->__image_buf[idx], k);
+					idx ^= 1;
+					k = 0;
+				}
+			}
+		}
+	}
+	if(k > 0){ this->send_pixels(this->__image_buf[idx], k); }
+}
+
 bool 	ST7735::draw_pixel (uint16_t x, uint16_t y, uint16_t color)
 {
     // check if coordinates is out of range
@@ -263,4 +366,131 @@ bool 	ST7735::draw_pixel (uint16_t x, uint16_t y, uint16_t color)
 }
 
 
+/**************************************************************
+ *	Blocks of pixels
+ **************************************************************/
+
+bool 	ST7735::start_ram_write(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1)
+{
+	if(!this->set_window(x0, x1, y0, y1)){ return ST7735_ERROR; }
+	// access to RAM
+	this->send_command(RAMWR);
+	return ST7735_SUCCESS;
+}
+
+bool 	ST7735::send_pixels(const uint16_t *pixels, uint32_t nb_pixels)
+{
+	this->wait_pixels();
+	this->__pixels_end.clear(ST7735_PIXELS_END);
+	this->__pixels_busy = true;
+	if(this->__dev){
+		// shared bus - RS/DC pin is set when the transfer starts
+		this->__pixels_t.setData(this->__dev, (const char *)pixels, 2 * nb_pixels);
+		if(this->__dev->getBus()->submit(&this->__pixels_t)){ return ST7735_SUCCESS; }
+	}
+	else{
+		// chip enable - active low / data (active high)
+		this->__cs = 0;
+		this->__rs_dc = 1;
+		if(this->__spi->transfer((const char *)pixels, 2 * nb_pixels, (char *)NULL, 0,
+				callback(this, &ST7735::ISR_pixels), SPI_EVENT_COMPLETE) == 0){
+			return ST7735_SUCCESS;
+		}
+		this->__cs = 1;
+	}
+	this->__pixels_busy = false;
+	return ST7735_ERROR;
+}
+
+void 	ST7735::wait_pixels(void)
+{
+	if(this->__pixels_busy){
+		this->__pixels_end.wait_any(ST7735_PIXELS_END);
+	}
+}
+
+bool 	ST7735::draw_image(int16_t x, int16_t y, const LCD_Image *img)
+{
+	if(!this->is_inside(x, y, x + img->width - 1, y + img->height - 1)){
+		return LCD_graphics::draw_image(x, y, img);
+	}
+	if(!this->start_ram_write(x, x + img->width - 1, y, y + img->height - 1)){ return ST7735_ERROR; }
+	LCD_ImageDecoder	dec(img);
+	uint8_t		index;
+	uint16_t	len;
+	uint32_t	nb_pixels = (uint32_t)img->width * img->height;
+	uint8_t		idx = 0;
+	uint16_t	k = 0;
+	// the buffer is free : its previous transfer ended before the start of the last one
+	while((nb_pixels > 0) && ((len = dec.next_run(&index, ST7735_IMAGE_CHUNK - k)) > 0)){
+		uint16_t	color = (index < img->nb_colors) ? img->palette[index] : 0;
+		color = (color >> 8) | (color << 8);
+		if(len > nb_pixels){ len = nb_pixels; }
+		nb_pixels -= len;
+		for(uint16_t i = 0; i < len; i++){
+			this->__image_buf[idx][k++] = color;
+		}
+		if((k == ST7735_IMAGE_CHUNK) || (nb_pixels == 0)){
+			this->send_pixels(this->__image_buf[idx], k);
+			idx ^= 1;
+			k = 0;
+		}
+	}
+	if(k > 0){ this->send_pixels(this->__image_buf[idx], k); }
+	return ST7735_SUCCESS;
+}
+
+void 	ST7735::pixels_start(SPI_Transfer *t)
+{
+	// data (active high)
+	this->__rs_dc = 1;
+}
+
+void 	ST7735::pixels_done(SPI_Transfer *t)
+{
+	this->__pixels_busy = false;
+	this->__pixels_end.set(ST7735_PIXELS_END);
+}
+
+void 	ST7735::ISR_pixels(int event)
+{
+	// chip disable - idle high
+	this->__cs = 1;
+	this->__pixels_busy = false;
+	this->__pixels_end.set(ST7735_PIXELS_END);
+}
+
 
+/**************************************************************
+ *	Vertical scrolling
+ **************************************************************/
+
+bool 	ST7735::set_scroll_area(uint16_t top, uint16_t lines, uint16_t bottom)
+{
+	if(top + lines + bottom != SCROLL_LINES){ return ST7735_ERROR; }
+	const uint8_t	args[6] = {(uint8_t)(top >> 8), (uint8_t)top, (uint8_t)(lines >> 8), (uint8_t)lines,
+								(uint8_t)(bottom >> 8), (uint8_t)bottom};
+	this->select();
+	this->__rs_dc = 0;
+	this->write(VSCRDEF);
+	this->__rs_dc = 1;
+	this->write_block(args, 6);
+	this->deselect();
+	return ST7735_SUCCESS;
+}
+
+void 	ST7735::set_scroll_start(uint16_t line)
+{
+	const uint8_t	args[2] = {(uint8_t)(line >> 8), (uint8_t)line};
+	this->select();
+	this->__rs_dc = 0;
+	this->write(VSCRSADD);
+	this->__rs_dc = 1;
+	this->write_block(args, 2);
+	this->deselect();
+}
+
+void 	ST7735::scroll_off(void)
+{
+	this->send_command(NORON);
+}
@@ -22,6 +22,7 @@
 #include "mbed.h"
 #include "st7735_constants.h"
 #include "LCD_graphics.h"
+#include "SPI_Bus.h"
 
 /**
  * @class ST7735
@@ -33,6 +34,8 @@ class ST7735 : public LCD_graphics {
     private:
         /// SPI interface 
         SPI 			*__spi;
+		/// Device on a shared SPI bus - NULL if the SPI interface is used
+		SPI_Device		*__dev;
 		/// CS pin of the ST7735 driver
 		DigitalOut		__cs;
 		/// RS/DC pin of the ST7735 driver
@@ -46,7 +49,61 @@ class ST7735 : public LCD_graphics {
 		
 		/// Background color
 		uint16_t		__bg_color;
+
+		/// Asynchronous transfer of pixels (shared bus)
+		SPI_Transfer	__pixels_t;
+		/// End of the asynchronous transfer of pixels
+		EventFlags		__pixels_end;
+		volatile bool	__pixels_busy;
+		/// Blocks of a compressed image - one filled during the transfer of the other
+		uint16_t		__image_buf[2][ST7735_IMAGE_CHUNK];
+
+		/**
+        * @brief Set the RS/DC pin before the transfer of pixels (shared bus).
+		*/
+		void 	pixels_start(SPI_Transfer *t);
+
+		/**
+        * @brief End of the transfer of pixels (shared bus) - in the event queue.
+		*/
+		void 	pixels_done(SPI_Transfer *t);
+
+		/**
+        * @brief End of the transfer of pixels (SPI interface) - from interrupt.
+		*/
+		void 	ISR_pixels(int event);
 		
+        /**
+        * @brief Select the driver (and take the shared bus).
+		*/
+		void 	select(void);
+
+        /**
+        * @brief Deselect the driver (and release the shared bus).
+		*/
+		void 	deselect(void);
+
+        /**
+        * @brief Write a byte to the selected driver.
+		*/
+		void 	write(uint8_t data);
+
+        /**
+        * @brief Write a block of bytes to the selected driver.
+		*/
+		void 	write_block(const uint8_t *data, uint16_t size);
+
+        /**
+        * @brief Send a sequence of commands, with their arguments, in one selection.
+        * @details Format of the sequence :
+        *	number of commands, then for each command :
+        *	command, number of arguments (| DELAY if a delay follows),
+        *	arguments, delay in ms (255 : 500 ms).
+        *	The driver is deselected during the delays.
+        * @param cmds const uint8_t * - sequence of commands.
+		*/
+		void 	send_commands(const uint8_t *cmds);
+
         /**
         * @brief Send a command of 8 bits to the driver.
         * @param cmd uint8_t - Command to send, 1 byte.
@@ -81,6 +138,17 @@ class ST7735 : public LCD_graphics {
 		* @return true if is in the range 
 		*/			
 		bool    check_value_range(uint16_t val, uint16_t min, uint16_t max);
+
+		/**
+        * @brief Write a horizontal span of pixels - one window, one RAM write
+		*/
+		void    write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color);
+
+		/**
+        * @brief Write a scaled character - one window and blocks of pixels if opaque
+		*/
+		void    write_glyph(uint16_t x, uint16_t y, const uint64_t *columns, uint8_t scale,
+							uint16_t color, bool opaque, uint16_t bg);
 		
 
     public:
@@ -93,6 +161,17 @@ class ST7735 : public LCD_graphics {
         * @param reset PinName - Reset pin of the ST7735 driver
         */
         ST7735(SPI *spi, PinName cs, PinName rs_dc, PinName reset);
+
+        /**
+        * @brief Constructor of the ST7735 class on a shared SPI bus.
+        * @details The format of the device is set to 8 bits, mode 0,
+        *	ST7735_SPI_FREQ. The bus applies it only when another device
+        *	used the bus before.
+        * @param dev SPI_Device - device on a shared SPI bus (with the CS pin)
+        * @param rs_dc PinName - RS/DC pin of the ST7735 driver
+        * @param reset PinName - Reset pin of the ST7735 driver
+        */
+        ST7735(SPI_Device *dev, PinName rs_dc, PinName reset);
 		
 		/**
         * @brief Hardware reset of the display.
@@ -152,6 +231,96 @@ class ST7735 : public LCD_graphics {
          * @return  false if x and y are out of range
 		 */
 		bool	draw_pixel (uint16_t x, uint16_t y, uint16_t color);
+
+		/**
+		 * @brief    Return the width of the screen in pixels
+		 */
+		inline uint16_t get_width(void){ return this->__width; }
+
+		/**
+		 * @brief    Return the height of the screen in pixels
+		 */
+		inline uint16_t get_height(void){ return this->__height; }
+
+		/**
+		 * @brief    Write a pixel - no range check (see LCD_graphics_t)
+		 */
+		inline void put_pixel(uint16_t x, uint16_t y, uint16_t color){
+			this->set_window(x, x, y, y);
+			this->set_color(color, 1);
+		}
+
+		/**
+		 * @brief    Write a horizontal span - no range check (see LCD_graphics_t)
+		 */
+		inline void put_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color){
+			this->set_window(x0, x1, y, y);
+			this->set_color(color, x1 - x0 + 1);
+		}
+
+		/**
+		 * @brief    Set a window and start to write in the memory of the driver
+		 * @details  The pixels are then sent by send_pixels, from left to
+		 *	right and from top to bottom of the window.
+		 * @param x0  uint16_t - start position on X axis
+		 * @param x1  uint16_t - end position on X axis
+		 * @param y0  uint16_t - start position on Y axis
+		 * @param y1  uint16_t - end position on Y axis
+		 * @return false if the positions are out of range of the screen
+		 */
+		bool 	start_ram_write(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1);
+
+		/**
+		 * @brief    Send a block of pixels - asynchronous transfer (DMA)
+		 * @details  Wait for the end of the previous block, then start the
+		 *	transfer and return : the next block can be prepared during
+		 *	the transfer. The buffer must not be changed before the end
+		 *	of the transfer (see wait_pixels).
+		 * @param pixels - const uint16_t * - Colors in 16 bits mode, MSB first in memory
+		 * @param nb_pixels - uint32_t - Number of pixels
+		 * @return false if the transfer can not be started
+		 */
+		bool 	send_pixels(const uint16_t *pixels, uint32_t nb_pixels);
+
+		/**
+		 * @brief    Wait for the end of the last block of pixels
+		 */
+		void 	wait_pixels(void);
+
+		/**
+		 * @brief    Draw a compressed image - streamed to the memory of the driver
+		 * @details  One window for the whole image, blocks of ST7735_IMAGE_CHUNK
+		 *	pixels decoded during the transfer of the previous block.
+		 *	An image crossing the clipping rectangle is drawn by spans.
+		 * @param x - int16_t - x position of the top-left corner
+		 * @param y - int16_t - y position of the top-left corner
+		 * @param img - const LCD_Image * - image (see LCD_image.h)
+		 * @return false if the image is out of the clipping rectangle
+		 */
+		bool 	draw_image(int16_t x, int16_t y, const LCD_Image *img);
+
+		/**
+		 * @brief    Define the vertical scrolling area
+		 * @details  The scrolling moves the lines of the driver : the
+		 *	columns of the screen with MV = 1 in MADCTL (landscape).
+		 *	top + lines + bottom must be SCROLL_LINES.
+		 * @param top  uint16_t - number of fixed lines before the area
+		 * @param lines  uint16_t - number of lines of the area
+		 * @param bottom  uint16_t - number of fixed lines after the area
+		 * @return false if the sum is not SCROLL_LINES
+		 */
+		bool 	set_scroll_area(uint16_t top, uint16_t lines, uint16_t bottom);
+
+		/**
+		 * @brief    Set the first line of the memory displayed in the scrolling area
+		 * @param line  uint16_t - line of the memory
+		 */
+		void 	set_scroll_start(uint16_t line);
+
+		/**
+		 * @brief    Stop the vertical scrolling - normal display mode
+		 */
+		void 	scroll_off(void);
 };
 
 #endif
\ No newline at end of file
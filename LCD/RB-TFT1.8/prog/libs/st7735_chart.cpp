@@ -0,0 +1,82 @@
+/**
+ * FILENAME :        st7735_chart.cpp
+ *
+ * DESCRIPTION :
+ *       TFT Joy-It RB-TFT1.8 - Strip chart with hardware scrolling
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "st7735_chart.h"
+
+ST7735_Chart::ST7735_Chart(ST7735 *lcd, int16_t min, int16_t max, uint16_t color,
+							uint16_t bg_color, uint16_t height)
+{
+	this->__lcd = lcd;
+	this->__min = min;
+	this->__max = (max > min) ? max : min + 1;
+	this->__color = color;
+	this->__bg_color = bg_color;
+	this->__height = height;
+	this->__pos = 0;
+	this->__last_y = -1;
+	this->__column[0].resize(height);
+	this->__column[1].resize(height);
+	this->__column_idx = 0;
+}
+
+void 	ST7735_Chart::send_column(uint16_t x)
+{
+	// waits for the previous column (the other buffer)
+	this->__lcd->start_ram_write(x, x, 0, this->__height - 1);
+	this->__lcd->send_pixels(this->__column[this->__column_idx].data(), this->__height);
+	this->__column_idx ^= 1;
+}
+
+void 	ST7735_Chart::clear(void)
+{
+	// all the lines of the scrolling area
+	uint16_t	value = (this->__bg_color >> 8) | (this->__bg_color << 8);
+	for(uint16_t x = 0; x < SCROLL_LINES; x++){
+		std::fill(this->__column[this->__column_idx].begin(), this->__column[this->__column_idx].end(), value);
+		this->send_column(x);
+	}
+	this->__pos = 0;
+	this->__last_y = -1;
+	this->__lcd->set_scroll_area(0, SCROLL_LINES, 0);
+	this->__lcd->set_scroll_start(0);
+}
+
+void 	ST7735_Chart::add_sample(int16_t value)
+{
+	if(value < this->__min){ value = this->__min; }
+	if(value > this->__max){ value = this->__max; }
+	// row of the sample - top of the chart for max
+	int16_t		y = (this->__height - 1) - (int32_t)(value - this->__min) * (this->__height - 1) / (this->__max - this->__min);
+	// vertical segment from the previous sample
+	int16_t		y0 = (this->__last_y < 0) ? y : this->__last_y;
+	int16_t		y1 = y;
+	if(y0 > y1){ int16_t t = y0; y0 = y1; y1 = t; }
+	uint16_t	bg = (this->__bg_color >> 8) | (this->__bg_color << 8);
+	uint16_t	fg = (this->__color >> 8) | (this->__color << 8);
+	uint16_t	*column = this->__column[this->__column_idx].data();
+	for(int16_t k = 0; k < this->__height; k++){
+		column[k] = ((k >= y0) && (k <= y1)) ? fg : bg;
+	}
+	this->send_column(this->__pos);
+	this->__last_y = y;
+	// the new column is the last one of the scrolling area
+	this->__pos = (this->__pos + 1) % SCROLL_LINES;
+	this->__lcd->set_scroll_start(this->__pos);
+}
+
+void 	ST7735_Chart::stop(void)
+{
+	this->__lcd->wait_pixels();
+	this->__lcd->scroll_off();
+}
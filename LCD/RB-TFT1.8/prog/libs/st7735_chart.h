@@ -0,0 +1,92 @@
+/**
+ * FILENAME :        st7735_chart.h
+ *
+ * DESCRIPTION :
+ *       TFT Joy-It RB-TFT1.8 - Strip chart with hardware scrolling
+ *
+ *       With MV = 1 in MADCTL (landscape), the vertical scrolling of the
+ *  ST7735 driver moves the columns of the screen. Each new sample is
+ *  drawn in one column of the memory (one window, one transfer of
+ *  MAX_Y pixels), then the scrolling start moves by one column : the
+ *  new column appears on the right and the chart moves to the left,
+ *  without redrawing the screen.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __ST7735_CHART_H__
+#define __ST7735_CHART_H__
+
+#include "mbed.h"
+#include <vector>
+#include "st7735.h"
+
+/**
+ * @class ST7735_Chart
+ * @brief 	Strip chart on a ST7735 display - hardware scrolling
+ * @details The chart uses the whole screen (SCROLL_LINES columns of the
+ *  memory). clear() starts a new chart, stop() goes back to the normal
+ *  display.
+ */
+class ST7735_Chart {
+    private:
+        /// LCD display
+        ST7735      *__lcd;
+        /// Height of the chart
+        uint16_t    __height;
+        /// Range of the values
+        int16_t     __min;
+        int16_t     __max;
+        /// Colors of the curve and of the background
+        uint16_t    __color;
+        uint16_t    __bg_color;
+        /// Column of the memory of the next sample
+        uint16_t    __pos;
+        /// Row of the last sample - -1 if none
+        int16_t     __last_y;
+        /// Columns of pixels - MSB first in memory, one sent while the other is drawn
+        std::vector<uint16_t>   __column[2];
+        uint8_t     __column_idx;
+
+        /**
+        * @brief Send the column in progress to a column of the memory.
+        */
+        void        send_column(uint16_t x);
+
+    public:
+        /**
+        * @brief Simple constructor of the ST7735_Chart class.
+        * @param lcd ST7735 - initialized LCD display
+        * @param min int16_t - value at the bottom of the chart
+        * @param max int16_t - value at the top of the chart
+        * @param color uint16_t - color of the curve
+        * @param bg_color uint16_t - color of the background
+        * @param height uint16_t - height of the chart
+        */
+        ST7735_Chart(ST7735 *lcd, int16_t min, int16_t max, uint16_t color = ST7735_WHITE,
+                    uint16_t bg_color = ST7735_BLACK, uint16_t height = MAX_Y);
+
+        /**
+        * @brief Clear the chart and start the scrolling.
+        */
+        void        clear(void);
+
+        /**
+        * @brief Add a sample on the right of the chart.
+        * @details One column of pixels and one scrolling command.
+        * @param value int16_t - value of the sample, limited to the range.
+        */
+        void        add_sample(int16_t value);
+
+        /**
+        * @brief Stop the scrolling - normal display.
+        */
+        void        stop(void);
+};
+
+#endif
@@ -25,6 +25,10 @@
   #define ST7735_ERROR          false
 
 #define 	ST7735_SPI_FREQ		2000000
+// Event flag of the end of a transfer of pixels
+#define 	ST7735_PIXELS_END	0x01
+// Number of pixels of a block of a compressed image
+#define 	ST7735_IMAGE_CHUNK	256
 
   // Command definition
   // -----------------------------------
@@ -50,6 +54,8 @@
   #define RAMWR                 0x2C
 
   #define PTLAR                 0x30
+  #define VSCRDEF               0x33
+  #define VSCRSADD              0x37
   #define MADCTL                0x36
   #define COLMOD                0x3A
 
@@ -92,6 +98,7 @@
   #define SIZE_X                MAX_X - 1         // columns max counter
   #define SIZE_Y                MAX_Y - 1         // rows max counter
   #define CACHE_SIZE_MEM        (MAX_X * MAX_Y)   // whole pixels
+  #define SCROLL_LINES          162               // lines of the vertical scrolling / columns when MV = 1
 
 
 #endif
\ No newline at end of file
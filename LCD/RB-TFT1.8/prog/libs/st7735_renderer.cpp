@@ -0,0 +1,198 @@
+/**
+ * FILENAME :        st7735_renderer.cpp
+ *
+ * DESCRIPTION :
+ *       TFT Joy-It RB-TFT1.8 - Line-buffered renderer for the ST7735 driver
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "st7735_renderer.h"
+
+ST7735_Renderer::ST7735_Renderer(ST7735 *lcd, uint16_t width, uint16_t height, uint16_t band_lines)
+{
+	this->__lcd = lcd;
+	this->__width = width;
+	this->__height = height;
+	this->__band_lines = band_lines;
+	this->__band[0].resize(width * band_lines);
+	this->__band[1].resize(width * band_lines);
+	this->__band_y = 0;
+	this->__band_idx = 0;
+	this->__bg_color = ST7735_BLACK;
+	this->__nb_items = 0;
+	this->__render_time = 0;
+	this->set_screen(width, height);
+}
+
+
+/**************************************************************
+ *	Display list
+ **************************************************************/
+
+void 	ST7735_Renderer::clear(uint16_t color)
+{
+	this->__bg_color = color;
+	this->__nb_items = 0;
+}
+
+bool 	ST7735_Renderer::add_item(uint8_t type, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+								uint16_t color, int16_t y_min, int16_t y_max)
+{
+	if(this->__nb_items >= ST7735_LIST_SIZE){ return LCD_ERROR; }
+	ST7735_Item	*item = &this->__list[this->__nb_items++];
+	item->type = type;
+	item->x0 = x0;
+	item->y0 = y0;
+	item->x1 = x1;
+	item->y1 = y1;
+	item->color = color;
+	item->str = NULL;
+	item->size = NORMAL;
+	item->y_min = y_min;
+	item->y_max = y_max;
+	return LCD_SUCCESS;
+}
+
+bool 	ST7735_Renderer::add_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+	return this->add_item(ST7735_ITEM_PIXEL, x, y, x, y, color, y, y);
+}
+
+bool 	ST7735_Renderer::add_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)
+{
+	return this->add_item(ST7735_ITEM_LINE, x0, y0, x1, y1, color,
+			(y0 < y1) ? y0 : y1, (y0 < y1) ? y1 : y0);
+}
+
+bool 	ST7735_Renderer::add_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+	return this->add_item(ST7735_ITEM_RECT, x, y, w, h, color, y, y + h);
+}
+
+bool 	ST7735_Renderer::add_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+	return this->add_item(ST7735_ITEM_FILL_RECT, x, y, w, h, color, y, y + h);
+}
+
+bool 	ST7735_Renderer::add_text(uint16_t x, uint16_t y, char *str, uint16_t color, enum Size size)
+{
+	if(!this->add_item(ST7735_ITEM_TEXT, x, y, x, y, color, y, y + CHARS_ROWS_LEN * size - 1)){
+		return LCD_ERROR;
+	}
+	this->__list[this->__nb_items - 1].str = str;
+	this->__list[this->__nb_items - 1].size = size;
+	return LCD_SUCCESS;
+}
+
+
+/**************************************************************
+ *	Rasterisation
+ **************************************************************/
+
+bool    ST7735_Renderer::check_range(uint16_t x, uint16_t y)
+{
+	// same range as the ST7735 driver
+	if ((x > this->__width) || (y > this->__height)){
+		return LCD_ERROR;
+	}
+	return LCD_SUCCESS;
+}
+
+bool 	ST7735_Renderer::draw_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+	// check if coordinates is out of range
+	if (!this->check_range(x, y)) { return LCD_ERROR; }
+	// only the pixels of the band in progress
+	if ((x < this->__width) && (y >= this->__band_y) && (y < this->__band_y + this->__band_lines)){
+		// MSB first for the SPI transfer
+		this->__band[this->__band_idx][(y - this->__band_y) * this->__width + x] = (color >> 8) | (color << 8);
+	}
+	return LCD_SUCCESS;
+}
+
+void 	ST7735_Renderer::write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color)
+{
+	// only the rows of the band in progress - x0 and x1 are clipped
+	if ((y < this->__band_y) || (y >= this->__band_y + this->__band_lines)){ return; }
+	uint16_t	value = (color >> 8) | (color << 8);
+	uint16_t	*line = &this->__band[this->__band_idx][(y - this->__band_y) * this->__width];
+	for(uint16_t k = x0; k <= x1; k++){
+		line[k] = value;
+	}
+}
+
+void 	ST7735_Renderer::draw_item(ST7735_Item *item)
+{
+	switch(item->type){
+		case ST7735_ITEM_PIXEL:
+			this->draw_pixel(item->x0, item->y0, item->color);
+			break;
+		case ST7735_ITEM_LINE:
+			this->draw_line(item->x0, item->y0, item->x1, item->y1, item->color);
+			break;
+		case ST7735_ITEM_RECT:
+			this->draw_rect(item->x0, item->y0, item->x1, item->y1, item->color);
+			break;
+		case ST7735_ITEM_FILL_RECT:
+			this->fill_rect(item->x0, item->y0, item->x1, item->y1, item->color);
+			break;
+		case ST7735_ITEM_TEXT:
+			if(this->set_position(item->x0, item->y0)){
+				this->draw_string(item->str, item->color, item->size);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+bool 	ST7735_Renderer::render(void)
+{
+	uint32_t	start = us_ticker_read();
+	// one window for the whole screen
+	if(!this->__lcd->start_ram_write(0, this->__width - 1, 0, this->__height - 1)){
+		return LCD_ERROR;
+	}
+	this->__band_idx = 0;
+	for(this->__band_y = 0; this->__band_y < this->__height; this->__band_y += this->__band_lines){
+		uint16_t	lines = this->__height - this->__band_y;
+		if(lines > this->__band_lines){ lines = this->__band_lines; }
+		// background
+		uint16_t	value = (this->__bg_color >> 8) | (this->__bg_color << 8);
+		std::fill(this->__band[this->__band_idx].begin(), this->__band[this->__band_idx].end(), value);
+		// primitives of the band
+		for(uint8_t i = 0; i < this->__nb_items; i++){
+			ST7735_Item	*item = &this->__list[i];
+			if((item->y_max < this->__band_y) || (item->y_min >= this->__band_y + lines)){ continue; }
+			this->draw_item(item);
+		}
+		// waits for the previous band (the other buffer) only
+		this->__lcd->send_pixels(this->__band[this->__band_idx].data(), this->__width * lines);
+		this->__band_idx ^= 1;
+	}
+	this->__lcd->wait_pixels();
+	this->__render_time = us_ticker_read() - start;
+	return LCD_SUCCESS;
+}
+
+
+/**************************************************************
+ *	Benchmark
+ **************************************************************/
+
+uint32_t 	ST7735_Renderer::get_render_time(void)
+{
+	return this->__render_time;
+}
+
+uint32_t 	ST7735_Renderer::get_pixel_rate(void)
+{
+	if(this->__render_time == 0){ return 0; }
+	return (uint32_t)((uint64_t)this->__width * this->__height * 1000000 / this->__render_time);
+}
@@ -0,0 +1,193 @@
+/**
+ * FILENAME :        st7735_renderer.h
+ *
+ * DESCRIPTION :
+ *       TFT Joy-It RB-TFT1.8 - Line-buffered renderer for the ST7735 driver
+ *
+ *       The primitives (pixels, lines, rectangles, text) are added to a
+ *  display list. render() rasterises the list into a band of a few lines
+ *  of the screen, sends this band by an asynchronous transfer (DMA when
+ *  the target supports it) and fills the second band during the transfer.
+ *  The screen is refreshed in one window, without a full framebuffer
+ *  (2 x 161 x 8 pixels instead of 161 x 130).
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __ST7735_RENDERER_H__
+#define __ST7735_RENDERER_H__
+
+#include "mbed.h"
+#include <vector>
+#include "st7735.h"
+
+/** Constant definition */
+/// Number of lines of a band
+#define     ST7735_BAND_LINES       8
+/// Maximum number of primitives in the display list
+#define     ST7735_LIST_SIZE        32
+/// Types of primitives
+#define     ST7735_ITEM_PIXEL       0
+#define     ST7735_ITEM_LINE        1
+#define     ST7735_ITEM_RECT        2
+#define     ST7735_ITEM_FILL_RECT   3
+#define     ST7735_ITEM_TEXT        4
+
+/**
+ * @struct ST7735_Item
+ * @brief Primitive of the display list
+ */
+struct ST7735_Item{
+    uint8_t     type;
+    /// Coordinates - (x0, y0) and (x1, y1) or (x, y) and (w, h)
+    int16_t     x0, y0, x1, y1;
+    uint16_t    color;
+    /// Text and its size
+    char        *str;
+    enum Size   size;
+    /// First and last lines of the primitive
+    int16_t     y_min, y_max;
+};
+
+/**
+ * @class ST7735_Renderer
+ * @brief 	Line-buffered renderer of a display list for the ST7735 driver
+ * @details The rasterisation of the primitives is the one of LCD_graphics :
+ *  the result is the same as drawing them directly on the ST7735 object.
+ *  The strings of the text primitives must remain valid until render().
+ *  render() must not be called from the shared event queue (end of the
+ *  transfers on a shared SPI bus).
+ */
+class ST7735_Renderer : public LCD_graphics {
+    private:
+        /// LCD display
+        ST7735      *__lcd;
+        /// Width and Height of the screen
+        uint16_t    __width;
+        uint16_t    __height;
+        /// Bands of pixels - MSB first in memory
+        std::vector<uint16_t>   __band[2];
+        uint16_t    __band_lines;
+        /// First line of the band in progress
+        int16_t     __band_y;
+        /// Index of the band in progress
+        uint8_t     __band_idx;
+        /// Background color
+        uint16_t    __bg_color;
+        /// Display list
+        ST7735_Item __list[ST7735_LIST_SIZE];
+        uint8_t     __nb_items;
+        /// Duration of the last rendering in us
+        uint32_t    __render_time;
+
+        /**
+        * @brief Add a primitive to the display list.
+        * @return false if the display list is full
+        */
+        bool        add_item(uint8_t type, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                            uint16_t color, int16_t y_min, int16_t y_max);
+
+        /**
+        * @brief Draw a primitive in the band in progress.
+        */
+        void        draw_item(ST7735_Item *item);
+
+        /**
+        * @brief Write the part of a horizontal span in the band in progress.
+        */
+        void        write_span(uint16_t x0, uint16_t x1, uint16_t y, uint16_t color);
+
+    public:
+        /**
+        * @brief Simple constructor of the ST7735_Renderer class.
+        * @param lcd ST7735 - initialized LCD display
+        * @param width uint16_t - width of the screen
+        * @param height uint16_t - height of the screen
+        * @param band_lines uint16_t - number of lines of a band
+        */
+        ST7735_Renderer(ST7735 *lcd, uint16_t width = MAX_X, uint16_t height = MAX_Y,
+                        uint16_t band_lines = ST7735_BAND_LINES);
+
+		/**
+		 * @brief    Draw a pixel in the band in progress
+		 * @details  Called by the primitives of LCD_graphics during render().
+		 * @param x - uint16_t - x position
+		 * @param y - uint16_t - y position
+		 * @param color - uint16_t - Color in 16 bits mode
+         * @return  false if x and y are out of range
+		 */
+        bool        draw_pixel(uint16_t x, uint16_t y, uint16_t color);
+
+		/**
+        * @brief Check if the coordinates are in the range of the screen size
+		* @param x  uint16_t - coordinate on X axis
+		* @param y 	uint16_t - coordinate on Y axis
+		* @return true if is in the range of the screen size
+		*/
+        bool        check_range(uint16_t x, uint16_t y);
+
+        /**
+        * @brief Empty the display list and set the background color.
+        * @param color uint16_t - background color
+        */
+        void        clear(uint16_t color);
+
+        /**
+        * @brief Add a pixel to the display list.
+        * @return false if the display list is full
+        */
+        bool        add_pixel(uint16_t x, uint16_t y, uint16_t color);
+
+        /**
+        * @brief Add a line to the display list.
+        * @return false if the display list is full
+        */
+        bool        add_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+
+        /**
+        * @brief Add a rectangle to the display list.
+        * @return false if the display list is full
+        */
+        bool        add_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+        /**
+        * @brief Add a filled rectangle to the display list.
+        * @return false if the display list is full
+        */
+        bool        add_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+        /**
+        * @brief Add a string of characters to the display list.
+        * @param x uint16_t - x position of the string
+        * @param y uint16_t - y position of the string
+        * @param str char * - string - not copied
+        * @param color uint16_t - color of the string
+        * @param size enum Size - (NORMAL, LARGE, HUGE)
+        * @return false if the display list is full
+        */
+        bool        add_text(uint16_t x, uint16_t y, char *str, uint16_t color, enum Size size);
+
+        /**
+        * @brief Rasterise the display list and send it to the screen.
+        * @details Blocking until the last band is sent.
+        * @return false if the window can not be set
+        */
+        bool        render(void);
+
+        /**
+        * @brief Return the duration of the last rendering in us.
+        */
+        uint32_t    get_render_time(void);
+
+        /**
+        * @brief Return the number of pixels per second of the last rendering.
+        */
+        uint32_t    get_pixel_rate(void);
+};
+
+#endif
@@ -20,17 +20,39 @@ TCS34725::TCS34725(I2C *_i2c){
     if (_i2c){ delete this->__i2c; }
     this->__i2c=_i2c;
     this->__i2c->frequency(TCS34725_FREQ);
+    this->__bus = NULL;
+    this->_tcs34725Initialised = false;
     wait_us(100);
 }
 
+TCS34725::TCS34725(I2C_Bus *_bus){
+    /* Shared I2C bus - frequency set by each transaction */
+    this->__i2c = NULL;
+    this->__bus = _bus;
+    this->_tcs34725Initialised = false;
+    wait_us(100);
+}
+
+int TCS34725::write(const char *buff, int size){
+    if(this->__bus){
+        return this->__bus->write(TCS34725_ADD << 1, buff, size, TCS34725_FREQ);
+    }
+    return this->__i2c->write(TCS34725_ADD << 1, buff, size);
+}
+
+int TCS34725::readRegister(char reg, char *buff, int size){
+    if(this->__bus){
+        return this->__bus->readRegister(TCS34725_ADD << 1, reg, buff, size, TCS34725_FREQ);
+    }
+    int ack = this->__i2c->write(TCS34725_ADD << 1, &reg, 1, true);
+    return ack + this->__i2c->read(TCS34725_ADD << 1, buff, size);
+}
+
 bool TCS34725::init(void){
     char cmd[2];
 
     // Init TCS
-    cmd[0] =    TCS34725_CMD_BIT | TCS34725_ID;
-    int ack = this->__i2c->write(TCS34725_ADD << 1, cmd, 1, true);
-    if(DEBUG_TCS)   printf("A_ID = %d\r\n", ack);
-    ack = this->__i2c->read(TCS34725_ADD << 1, cmd, 1);
+    int ack = this->readRegister(TCS34725_CMD_BIT | TCS34725_ID, cmd, 1);
     if(DEBUG_TCS)   printf("A_ID_read = %d / Val = %d\r\n", ack, cmd[0]);
     if(cmd[0] == 0x44){
         this->_tcs34725Initialised = true;
@@ -48,7 +70,7 @@ bool TCS34725::setIntegrationTime(uint8_t it){
     cmd[0] =    TCS34725_CMD_BIT | TCS34725_ATIME;
     cmd[1] =    it;
     this->_tcs34725IntegrationTime = it;
-    int ack = this->__i2c->write(TCS34725_ADD << 1, cmd, 2);
+    int ack = this->write(cmd, 2);
     if(ack == 0)
         return true;
     else
@@ -62,7 +84,7 @@ bool TCS34725::setGain(tcs34725Gain_t gain){
     cmd[0] =    TCS34725_CMD_BIT | TCS34725_CONTROL;
     cmd[1] =    gain;
     this->_tcs34725Gain = gain;
-    int ack = this->__i2c->write(TCS34725_ADD << 1, cmd, 2);
+    int ack = this->write(cmd, 2);
     if(ack == 0)
         return true;
     else
@@ -75,11 +97,11 @@ bool TCS34725::enable(){
     char cmd[2];
     cmd[0] =    TCS34725_CMD_BIT | TCS34725_ENABLE;
     cmd[1] =    TCS34725_ENABLE_PON;
-    int ack = this->__i2c->write(TCS34725_ADD << 1, cmd, 2);
+    int ack = this->write(cmd, 2);
     wait_us(30000);
     cmd[0] =    TCS34725_CMD_BIT | TCS34725_ENABLE;
     cmd[1] =    TCS34725_ENABLE_PON | TCS34725_ENABLE_AEN;
-    ack += this->__i2c->write(TCS34725_ADD << 1, cmd, 2);
+    ack += this->write(cmd, 2);
     if(ack == 0)
         return true;
     else
@@ -89,14 +111,12 @@ bool TCS34725::enable(){
 bool TCS34725::disable(){
     /* Turn the device off to save power */
     char cmd[2];
-    cmd[0] =    TCS34725_CMD_BIT | TCS34725_ENABLE;
-    int ack = this->__i2c->write(TCS34725_ADD << 1, cmd, 1, true);
-    ack += this->__i2c->read(TCS34725_ADD << 1, cmd, 1);
+    int ack = this->readRegister(TCS34725_CMD_BIT | TCS34725_ENABLE, cmd, 1);
     char reg = cmd[0];
     
     cmd[0] =    TCS34725_CMD_BIT | TCS34725_ENABLE;
     cmd[1] =    reg &  ~(TCS34725_ENABLE_PON | TCS34725_ENABLE_AEN);
-    ack += this->__i2c->read(TCS34725_ADD << 1, cmd, 1);
+    ack += this->write(cmd, 2);
     if(ack == 0)
         return true;
     else
@@ -109,24 +129,16 @@ bool TCS34725::getRawData(uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c) {
         return false;
     char cmd[2];
     /// Collect Clear value
-    cmd[0] =    TCS34725_CMD_BIT | TCS34725_CDATAL;
-    int ack = this->__i2c->write(TCS34725_ADD << 1, cmd, 1, true);
-    ack += this->__i2c->read(TCS34725_ADD << 1, cmd, 2);
+    int ack = this->readRegister(TCS34725_CMD_BIT | TCS34725_CDATAL, cmd, 2);
     *c = (uint16_t(cmd[1]) << 8) | (uint16_t(cmd[0]) & 0xFF);
     /// Collect Red Value
-    cmd[0] =    TCS34725_CMD_BIT | TCS34725_RDATAL;
-    ack += this->__i2c->write(TCS34725_ADD << 1, cmd, 1, true);
-    ack += this->__i2c->read(TCS34725_ADD << 1, cmd, 2);
+    ack += this->readRegister(TCS34725_CMD_BIT | TCS34725_RDATAL, cmd, 2);
     *r = (uint16_t(cmd[1]) << 8) | (uint16_t(cmd[0]) & 0xFF);
     /// Collect Blue Value
-    cmd[0] =    TCS34725_CMD_BIT | TCS34725_BDATAL;
-    ack += this->__i2c->write(TCS34725_ADD << 1, cmd, 1, true);
-    ack += this->__i2c->read(TCS34725_ADD << 1, cmd, 2);
+    ack += this->readRegister(TCS34725_CMD_BIT | TCS34725_BDATAL, cmd, 2);
     *b = (uint16_t(cmd[1]) << 8) | (uint16_t(cmd[0]) & 0xFF);
     /// Collect Green Value
-    cmd[0] =    TCS34725_CMD_BIT | TCS34725_GDATAL;
-    ack += this->__i2c->write(TCS34725_ADD << 1, cmd, 1, true);
-    ack += this->__i2c->read(TCS34725_ADD << 1, cmd, 2);
+    ack += this->readRegister(TCS34725_CMD_BIT | TCS34725_GDATAL, cmd, 2);
     *g = (uint16_t(cmd[1]) << 8) | (uint16_t(cmd[0]) & 0xFF);
 
     if(ack == 0)
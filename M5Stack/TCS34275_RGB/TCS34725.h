@@ -20,6 +20,7 @@
 #define __TCS34725_H__
 
 #include    "mbed.h"
+#include    "I2C_Bus.h"
 
 #define DEBUG_TCS       true
 
@@ -188,6 +189,13 @@ class TCS34725 {
         */
         TCS34725(I2C *_i2c);
 
+        /**
+        * @brief Constructor of the TCS34275 class on a shared I2C bus.
+        * @details Transactions are sent at TCS34725_FREQ
+        * @param _bus shared I2C bus
+        */
+        TCS34725(I2C_Bus *_bus);
+
         /**
         * @brief Initialization of the Sensor.
         * @return   true if TCS34275 is recognized (ID = 0x44)
@@ -247,6 +255,20 @@ class TCS34725 {
     private:
         /// I2C interface 
         I2C *__i2c;
+        /// Shared I2C bus - NULL if the I2C interface is used
+        I2C_Bus *__bus;
+
+        /**
+        * @brief Write data to the sensor, on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int write(const char *buff, int size);
+
+        /**
+        * @brief Read registers of the sensor (repeated start), on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int readRegister(char reg, char *buff, int size);
         bool _tcs34725Initialised;
         tcs34725Gain_t _tcs34725Gain;
         uint8_t _tcs34725IntegrationTime;
@@ -15,127 +15,231 @@
 
 #include "MP3_DFMiniPlayer.h"
 #include <cstdint>
+#include "TimingProbe_config.h"
+
+TIMING_PROBE(probe_mp3_data, "MP3_DFMiniPlayer::ISR_MP3_data");
+
+/* Frames of the commands without parameter - built at compile time */
+static constexpr DFPlayer_Frame     frame_reset = DFPlayer_makeFrame(CMD_RESET);
+static constexpr DFPlayer_Frame     frame_play = DFPlayer_makeFrame(CMD_PLAY);
+static constexpr DFPlayer_Frame     frame_pause = DFPlayer_makeFrame(CMD_PAUSE);
+static constexpr DFPlayer_Frame     frame_next = DFPlayer_makeFrame(CMD_NEXT);
+static constexpr DFPlayer_Frame     frame_prev = DFPlayer_makeFrame(CMD_PREV);
+/* Frames of the commands with a parameter - parameter is patched at runtime */
+static constexpr DFPlayer_Frame     frame_volume = DFPlayer_makeFrame(CMD_VOLUME);
+static constexpr DFPlayer_Frame     frame_play_tr_dir = DFPlayer_makeFrame(CMD_PLAY_TR_DIR);
 
 MP3_DFMiniPlayer::MP3_DFMiniPlayer(UnbufferedSerial *link){
     this->_receivedIndex = 0;
     this->_dataIsReady = false;
     this->_dataCnt = 0;
+    this->_errorCnt = 0;
+    this->_overflowCnt = 0;
     this->_playerReady = false;
+    this->_device = 0;
+    this->_sending = false;
+    this->_txIndex = DFPLAYER_FRAME_SIZE;
+    this->_debug = NULL;
 
     /* Initialisation of enable output */
     if (link){ delete this->_serial; }
     this->_serial = link;
     this->_serial->baud(9600);      // 9600 bauds default value
     this->_serial->attach(callback(this, &MP3_DFMiniPlayer::ISR_MP3_data), UnbufferedSerial::RxIrq);
-
-    /* Initialization of the sending buffer */
-    this->_sendingBuffer[0] = START_BYTE;
-    this->_sendingBuffer[1] = VERSION_BYTE;
-    this->_sendingBuffer[2] = LENGTH_BYTE;
-    this->_sendingBuffer[9] = END_BYTE;
-
 }
 
 void MP3_DFMiniPlayer::ISR_MP3_data(void){
+    TIMING_PROBE_START(probe_mp3_data);
     uint8_t data = 0;
     this->_serial->read(&data, 1);
 
     // echo mode - DEBUG
-    this->_debug->write(&data, 1);
-
-    if(data == START_BYTE){ this->_receivedIndex = 0;   }
-    else{   this->_receivedIndex++; }
-    this->_receivedBuffer[this->_receivedIndex] = data;
-    if((data == END_BYTE) && (this->_receivedIndex == 9)){
-        this->_dataIsReady = true;
-        this->_dataCnt++;
+    if(this->_debug){ this->_debug->write(&data, 1); }
+
+    // resynchronization on the start byte and the version byte
+    if((this->_receivedIndex == 0) && (data != START_BYTE)){
+        TIMING_PROBE_STOP(probe_mp3_data);
+        return;
+    }
+    if((this->_receivedIndex == 1) && (data != VERSION_BYTE)){
+        this->_receivedIndex = (data == START_BYTE) ? 1 : 0;
+        this->_errorCnt++;
+        TIMING_PROBE_STOP(probe_mp3_data);
+        return;
+    }
+    this->_receivedBuffer[this->_receivedIndex++] = data;
+
+    if(this->_receivedIndex == BUFFER_SIZE){
+        this->_receivedIndex = 0;
+        if(DFPlayer_checkFrame(this->_receivedBuffer)){
+            MP3_Frame   frame;
+            frame.cmd = this->_receivedBuffer[3];
+            frame.param = (this->_receivedBuffer[5] << 8) + this->_receivedBuffer[6];
+            this->_dataCnt++;
+            // a push on a full buffer would overwrite the oldest frame
+            if(this->_receivedFrames.full()){
+                this->_overflowCnt++;
+            }
+            else{
+                this->_receivedFrames.push(frame);
+                this->_dataIsReady = true;
+                mbed_event_queue()->call(callback(this, &MP3_DFMiniPlayer::dispatchFrames));
+            }
+        }
+        else{
+            this->_errorCnt++;
+        }
+    }
+    TIMING_PROBE_STOP(probe_mp3_data);
+}
+
+/*
+* @return  1 if USB, 2 if SD Card, 3 if both, 4 if computer, -1 if not ready
+*/
+int8_t    MP3_DFMiniPlayer::waitAvailable(void){
+    if(this->_playerReady){
+        return this->_device;
     }
+    return -1;
 }
 
-uint16_t    MP3_DFMiniPlayer::calculateCheckSum(uint8_t *buffer){
-    uint16_t sum = 0;
-    for (int i = START_CHKSUM; i <=  END_CHKSUM; i++) {
-        sum += buffer[i];
+void    MP3_DFMiniPlayer::dispatchFrames(void){
+    MP3_Frame   frame;
+    while(this->_receivedFrames.pop(frame)){
+        switch(frame.cmd){
+            case QUERY_ONLINE:
+                this->_device = frame.param & 0xFF;
+                this->_playerReady = true;
+                if(this->_deviceCb){ this->_deviceCb(frame.cmd, frame.param & 0xFF); }
+                break;
+            case FB_USB_INSERTED:
+            case FB_USB_REMOVED:
+                if(this->_deviceCb){ this->_deviceCb(frame.cmd, frame.param & 0xFF); }
+                break;
+            case FB_FINISHED_USB:
+            case FB_FINISHED_SD:
+            case FB_FINISHED_FL:
+                if(this->_finishedCb){ this->_finishedCb(frame.cmd, frame.param); }
+                break;
+            case FB_ERROR:
+                if(this->_errorCb){ this->_errorCb(frame.param & 0xFF); }
+                break;
+            case FB_ACK:
+                break;
+            default:
+                if(this->_responseCb){ this->_responseCb(frame.cmd, frame.param); }
+                break;
+        }
     }
-    return -sum;
 }
 
+/// COMMANDS SECTION
 
-bool        MP3_DFMiniPlayer::checkCheckSum(uint8_t *buffer){
-    uint16_t chS = calculateCheckSum(buffer);
-    uint16_t chSR = (buffer[7] << 8) + buffer[8];
-    return (chS == chSR);
+bool    MP3_DFMiniPlayer::sendCommand(uint8_t cmd, uint16_t param){
+    DFPlayer_Frame  frame = DFPlayer_makeFrame(0);
+    DFPlayer_setByte(frame.bytes, DFPLAYER_FRAME_CMD, cmd);
+    DFPlayer_setParam(frame.bytes, param);
+    return this->queueFrame(frame);
 }
 
+bool    MP3_DFMiniPlayer::queueFrame(const DFPlayer_Frame &frame){
+    CriticalSectionLock lock;
+    if(this->_commands.full()){ return false; }
+    this->_commands.push(frame);
+    if(!this->_sending){
+        this->_sending = (mbed_event_queue()->call(callback(this, &MP3_DFMiniPlayer::sendNext)) != 0);
+    }
+    return true;
+}
 
-/*
-* @return  1 if USB, 2 if SD Card, 3 if both, 4 if computer
-*/
-int8_t    MP3_DFMiniPlayer::waitAvailable(void){
-    if((this->_dataIsReady) && (this->_dataCnt == 1)){
-        if(checkCheckSum(this->_receivedBuffer)){
-            if(this->_receivedBuffer[3] == QUERY_ONLINE){
-                this->_playerReady = true;
-                return this->_receivedBuffer[6];
-            }
-            else{
-                return -1;
-            }
+void    MP3_DFMiniPlayer::sendNext(void){
+    {
+        CriticalSectionLock lock;
+        if(!this->_commands.pop(this->_txFrame)){
+            this->_sending = false;
+            return;
         }
-        return -2;
     }
-    return -3;
+    // bytes written by ISR_MP3_tx - the spacing (from the start of the frame)
+    // is longer than the frame (10 ms at 9600 bauds)
+    this->_txIndex = 0;
+    this->_serial->attach(callback(this, &MP3_DFMiniPlayer::ISR_MP3_tx), UnbufferedSerial::TxIrq);
+
+    if(this->_txFrame.bytes[DFPLAYER_FRAME_CMD] == CMD_RESET){
+        this->_playerReady = false;
+        mbed_event_queue()->call_in(MP3_RESET_SPACING, callback(this, &MP3_DFMiniPlayer::sendNext));
+    }
+    else{
+        mbed_event_queue()->call_in(MP3_CMD_SPACING, callback(this, &MP3_DFMiniPlayer::sendNext));
+    }
+}
+
+void    MP3_DFMiniPlayer::ISR_MP3_tx(void){
+    if(this->_txIndex < DFPLAYER_FRAME_SIZE){
+        // transmit register empty : this write does not wait
+        this->_serial->write(&this->_txFrame.bytes[this->_txIndex], 1);
+        this->_txIndex++;
+    }
+    if(this->_txIndex >= DFPLAYER_FRAME_SIZE){
+        this->_serial->attach(nullptr, UnbufferedSerial::TxIrq);
+    }
 }
 
+int     MP3_DFMiniPlayer::getPendingCmd(void){
+    return this->_commands.size();
+}
 
-void 	MP3_DFMiniPlayer::reset(void){
-    // Specify playback of track 100 in the folder 11 // 7E FF 06 0F 00 0B 64 xx xx EF
-    this->_sendingBuffer[3] = CMD_RESET;
-    this->_sendingBuffer[4] = 0;
-    this->_sendingBuffer[5] = 0;
-    this->_sendingBuffer[6] = 0;
-    uint16_t chSum = this->calculateCheckSum(this->_sendingBuffer);
-    this->_sendingBuffer[7] = (chSum >> 8) & 0xFF;
-    this->_sendingBuffer[8] = chSum & 0xFF;
-    this->_serial->write(this->_sendingBuffer, BUFFER_SIZE);
+bool 	MP3_DFMiniPlayer::reset(void){
+    return this->queueFrame(frame_reset);
 }
 
-void 	MP3_DFMiniPlayer::playTrack(uint16_t track, uint16_t dir){
+bool 	MP3_DFMiniPlayer::playTrack(uint16_t track, uint16_t dir){
     // Specify playback of track 100 in the folder 11 // 7E FF 06 0F 00 0B 64 xx xx EF
-    this->_sendingBuffer[3] = CMD_PLAY_TR_DIR;
-    this->_sendingBuffer[4] = 0;
-    this->_sendingBuffer[5] = dir & 0xFF;
-    this->_sendingBuffer[6] = track & 0xFF;
-    uint16_t chSum = this->calculateCheckSum(this->_sendingBuffer);
-    this->_sendingBuffer[7] = (chSum >> 8) & 0xFF;
-    this->_sendingBuffer[8] = chSum & 0xFF;
-    this->_serial->write(this->_sendingBuffer, BUFFER_SIZE);
+    DFPlayer_Frame  frame = frame_play_tr_dir;
+    DFPlayer_setParam(frame.bytes, ((dir & 0xFF) << 8) + (track & 0xFF));
+    return this->queueFrame(frame);
 }
 
+bool    MP3_DFMiniPlayer::playCmd(void){
+    return this->queueFrame(frame_play);
+}
 
-void    MP3_DFMiniPlayer::playCmd(void){
-    this->_sendingBuffer[3] = CMD_PLAY;
-    this->_sendingBuffer[4] = 0;
-    this->_sendingBuffer[5] = 0;
-    this->_sendingBuffer[6] = 0;
-    uint16_t chSum = this->calculateCheckSum(this->_sendingBuffer);
-    this->_sendingBuffer[7] = (chSum >> 8) & 0xFF;
-    this->_sendingBuffer[8] = chSum & 0xFF;
-    this->_serial->write(this->_sendingBuffer, BUFFER_SIZE);
+bool    MP3_DFMiniPlayer::pauseCmd(void){
+    return this->queueFrame(frame_pause);
 }
 
+bool    MP3_DFMiniPlayer::nextCmd(void){
+    return this->queueFrame(frame_next);
+}
 
-void    MP3_DFMiniPlayer::pauseCmd(void){
-    this->_sendingBuffer[3] = CMD_PAUSE;
-    this->_sendingBuffer[4] = 0;
-    this->_sendingBuffer[5] = 0;
-    this->_sendingBuffer[6] = 0;
-    uint16_t chSum = this->calculateCheckSum(this->_sendingBuffer);
-    this->_sendingBuffer[7] = (chSum >> 8) & 0xFF;
-    this->_sendingBuffer[8] = chSum & 0xFF;
-    this->_serial->write(this->_sendingBuffer, BUFFER_SIZE);
+bool    MP3_DFMiniPlayer::prevCmd(void){
+    return this->queueFrame(frame_prev);
 }
 
+bool    MP3_DFMiniPlayer::setVolume(uint8_t volume){
+    if(volume > 30){ volume = 30; }
+    DFPlayer_Frame  frame = frame_volume;
+    DFPlayer_setParam(frame.bytes, volume);
+    return this->queueFrame(frame);
+}
+
+/// CALLBACKS SECTION
+
+void    MP3_DFMiniPlayer::attachTrackFinished(Callback<void(uint8_t device, uint16_t track)> cb){
+    this->_finishedCb = cb;
+}
+
+void    MP3_DFMiniPlayer::attachDeviceEvent(Callback<void(uint8_t event, uint8_t device)> cb){
+    this->_deviceCb = cb;
+}
+
+void    MP3_DFMiniPlayer::attachError(Callback<void(uint8_t error)> cb){
+    this->_errorCb = cb;
+}
+
+void    MP3_DFMiniPlayer::attachResponse(Callback<void(uint8_t cmd, uint16_t param)> cb){
+    this->_responseCb = cb;
+}
 
 /// DEBUGGING SECTION
 
@@ -149,4 +253,12 @@ void    MP3_DFMiniPlayer::setDebugSerial(UnbufferedSerial *debug){
 
 int     MP3_DFMiniPlayer::getDataCnt(void){
     return this->_dataCnt;
+}
+
+int     MP3_DFMiniPlayer::getErrorCnt(void){
+    return this->_errorCnt;
+}
+
+int     MP3_DFMiniPlayer::getOverflowCnt(void){
+    return this->_overflowCnt;
 }
\ No newline at end of file
@@ -24,7 +24,7 @@
             Check_MSB   Most significant byte of checksum
             Check_LSB   Least significant byte of checksum
             $O          End byte 0xEF
-        Trame Example : 7E FF 06 09 00 00 02 FF F0 EF  (play back on SD Card)
+        Trame Example : 7E FF 06 09 00 00 02 FE F0 EF  (play back on SD Card)
 
         Chechsum : (2 bytes) = 0xFFFF–(Ver.+Length+CMD+Feedback+Para_MSB+Para_LSB)+1
  */
@@ -35,6 +35,7 @@
 
 #include <cstdint>
 #include <mbed.h>
+#include "arduino/DFPlayer_Frame.h"
  
 /** Constant definition */
 #define     DEBUG_MODE                  1
@@ -52,34 +53,103 @@
 #define     CMD_PREV        0x02
 #define     CMD_INC_V       0x04
 #define     CMD_DEC_V       0x05
+#define     CMD_VOLUME      0x06
 #define     CMD_RESET       0x0C
 #define     CMD_PLAY        0x0D
 #define     CMD_PAUSE       0x0E
 #define     CMD_PLAY_TR_DIR 0x0F
-#define     QUERY_ONLINE    0x3F
 
+/* Feedback of the module */
+#define     FB_USB_INSERTED 0x3A    // param : 1 USB, 2 SD card
+#define     FB_USB_REMOVED  0x3B
+#define     FB_FINISHED_USB 0x3C    // param : track number
+#define     FB_FINISHED_SD  0x3D
+#define     FB_FINISHED_FL  0x3E
+#define     QUERY_ONLINE    0x3F    // param : 1 USB, 2 SD card, 3 both, 4 computer
+#define     FB_ERROR        0x40    // param : error code
+#define     FB_ACK          0x41
 
+/* Command queue */
+#define     MP3_QUEUE_SIZE      16
+/// Delay between two commands - the module drops commands sent too fast
+#define     MP3_CMD_SPACING     100ms
+/// Delay after a reset - initialization of the storage devices
+#define     MP3_RESET_SPACING   1500ms
+/// Number of received frames waiting for the callbacks
+#define     MP3_RX_QUEUE_SIZE   8
+
+/**
+ * @struct MP3_Frame
+ * @brief Command or feedback of the module
+ */
+struct MP3_Frame{
+    uint8_t     cmd;
+    uint16_t    param;
+};
 
 /**
  * @class MP3_DFMiniPlayer
  * @brief Take control of a MP3 Player - DF Mini
+ * @details     Commands are stored in a queue and scheduled by the shared
+ *  event queue of MBED OS, with MP3_CMD_SPACING between two commands.
+ *  The bytes of a frame are written by the TX interrupt, one byte each
+ *  time the transmit register is empty : the shared event queue is not
+ *  blocked during the 10 ms of a frame at 9600 bauds.
+ *  Command functions never block and can be called from an interrupt.
+ *      Received bytes are parsed by the RX interrupt (frames with
+ *  a wrong length, end byte or checksum are dropped). Valid frames
+ *  are routed to the callbacks from the shared event queue. When
+ *  MP3_RX_QUEUE_SIZE frames are already waiting, the new frame is
+ *  dropped and counted (see getOverflowCnt).
  */
 class MP3_DFMiniPlayer{
     private:
         UnbufferedSerial    *_serial;
 
         bool        _playerReady;
+        uint8_t     _device;
 
         uint8_t     _receivedBuffer[BUFFER_SIZE];
         uint8_t     _receivedIndex;
         bool        _dataIsReady;
         int         _dataCnt;
+        int         _errorCnt;
+        int         _overflowCnt;
+        CircularBuffer<MP3_Frame, MP3_RX_QUEUE_SIZE>    _receivedFrames;
+
+        /// Frames waiting to be sent (see arduino/DFPlayer_Frame.h)
+        CircularBuffer<DFPlayer_Frame, MP3_QUEUE_SIZE>  _commands;
+        /// The sending of the commands is scheduled
+        bool        _sending;
+        /// Frame written by the TX interrupt
+        DFPlayer_Frame      _txFrame;
+        volatile uint8_t    _txIndex;
+
+        /**
+        * @brief Add a complete frame to the queue.
+        * @return false if the queue is full
+        */
+        bool        queueFrame(const DFPlayer_Frame &frame);
+
+        /**
+        * @brief Start the sending of the next command of the queue - from the event queue.
+        */
+        void        sendNext(void);
 
-        uint8_t     _sendingBuffer[BUFFER_SIZE];
+        /**
+        * @brief Interrupt routine when the transmit register is empty - next byte of the frame
+        */
+        void        ISR_MP3_tx(void);
 
-        uint16_t    calculateCheckSum(uint8_t *buffer);
-        bool        checkCheckSum(uint8_t *buffer);
+        /**
+        * @brief Route the received frames to the callbacks - from the event queue.
+        */
+        void        dispatchFrames(void);
 
+        Callback<void(uint8_t device, uint16_t track)>  _finishedCb;
+        Callback<void(uint8_t event, uint8_t device)>   _deviceCb;
+        Callback<void(uint8_t error)>                   _errorCb;
+        Callback<void(uint8_t cmd, uint16_t param)>     _responseCb;
 
         UnbufferedSerial    *_debug;
         char        chStr[64];
@@ -98,36 +168,102 @@ class MP3_DFMiniPlayer{
 
         /**
         * @brief Send the type of device connected after reset
-        * @return  1 if USB, 2 if SD Card, 3 if both, 4 if computer
+        * @return  1 if USB, 2 if SD Card, 3 if both, 4 if computer, -1 if not ready
         */
         int8_t    waitAvailable(void);
 
         /**
+        * @brief Add a command to the queue
+        * @param cmd command code
+        * @param param parameter of the command
+        * @return false if the queue is full
+        */
+        bool    sendCommand(uint8_t cmd, uint16_t param = 0);
+
+        /**
+        * @brief Reset the module
+        * @return false if the queue is full
         */
-        void    reset(void);
+        bool    reset(void);
 
         /**
         * @brief Play the indexed track in a specific directory
         * @param track number of the track
 		* @param dir number of the directory (if 0, root directory)
+        * @return false if the queue is full
         */		
-		void 	playTrack(uint16_t track, uint16_t dir);
+		bool 	playTrack(uint16_t track, uint16_t dir);
 
         /**
         * @brief Start playing a track
+        * @return false if the queue is full
         */	
-        void    playCmd(void);
+        bool    playCmd(void);
 
         /**
         * @brief Pause a track
+        * @return false if the queue is full
         */	
-        void    pauseCmd(void);
+        bool    pauseCmd(void);
 
+        /**
+        * @brief Play the next track
+        * @return false if the queue is full
+        */	
+        bool    nextCmd(void);
 
-        void    setDebugSerial(UnbufferedSerial *debug);
-        int     getDataCnt(void);
+        /**
+        * @brief Play the previous track
+        * @return false if the queue is full
+        */	
+        bool    prevCmd(void);
 
+        /**
+        * @brief Set the volume
+        * @param volume volume from 0 to 30
+        * @return false if the queue is full
+        */	
+        bool    setVolume(uint8_t volume);
+
+        /**
+        * @brief Return the number of commands waiting in the queue
+        */	
+        int     getPendingCmd(void);
+
+        /**
+        * @brief Attach a function called at the end of a track
+        * @param cb function (device : FB_FINISHED_xx code, track : number of the track)
+        */	
+        void    attachTrackFinished(Callback<void(uint8_t device, uint16_t track)> cb);
+
+        /**
+        * @brief Attach a function called when a storage device is inserted, removed or online
+        * @param cb function (event : FB_USB_INSERTED, FB_USB_REMOVED or QUERY_ONLINE, device : parameter)
+        */	
+        void    attachDeviceEvent(Callback<void(uint8_t event, uint8_t device)> cb);
 
+        /**
+        * @brief Attach a function called when the module returns an error
+        * @param cb function (error : error code of the module)
+        */	
+        void    attachError(Callback<void(uint8_t error)> cb);
+
+        /**
+        * @brief Attach a function called for the other frames (answers to queries)
+        * @param cb function (cmd : code of the frame, param : parameter)
+        */	
+        void    attachResponse(Callback<void(uint8_t cmd, uint16_t param)> cb);
+
+        void    setDebugSerial(UnbufferedSerial *debug);
+        int     getDataCnt(void);
+        /**
+        * @brief Return the number of dropped frames (wrong length, end byte or checksum)
+        */	
+        int     getErrorCnt(void);
+        /**
+        * @brief Return the number of valid frames dropped because the receive queue was full
+        */	
+        int     getOverflowCnt(void);
 };
 
 #endif
\ No newline at end of file
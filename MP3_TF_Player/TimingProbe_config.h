@@ -0,0 +1,33 @@
+/**
+ * FILENAME :        TimingProbe_config.h
+ *
+ * DESCRIPTION :
+ *       TimingProbe / Probe macros for the other libraries.
+ *
+ *       A library includes this file instead of TimingProbe.h : its
+ *  probes are compiled only if the TIMING_PROBE_ENABLED macro is
+ *  defined (in mbed_app.json). Otherwise the macros are empty and
+ *  the TimingProbe library is not needed.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __TIMINGPROBE_CONFIG_H__
+#define __TIMINGPROBE_CONFIG_H__
+
+#ifdef TIMING_PROBE_ENABLED
+#include "TimingProbe.h"
+#else
+#define     TIMING_PROBE(var, label)
+#define     TIMING_PROBE_MEMBER(var)
+#define     TIMING_PROBE_NAME(var, label)
+#define     TIMING_PROBE_START(var)
+#define     TIMING_PROBE_STOP(var)
+#endif
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * FILENAME :        DFPlayer_Frame.h
+ *
+ * DESCRIPTION :
+ *       Command frames of the DFPlayer protocol (MP3-TF-16P / FN-M16P).
+ *
+ *       Frames of fixed commands are built at compile time
+ *  (constexpr). For a runtime parameter, only the parameter bytes
+ *  are written and the checksum is corrected by the difference
+ *  of the parameter bytes : no loop over the header.
+ *
+ *       This file does not depend on MBED OS or Arduino (C++11) :
+ *  it is shared by the Arduino library (this directory, copied as
+ *  is in the Arduino libraries folder) and by MP3_DFMiniPlayer, which
+ *  includes it from the parent directory. The static_assert at the end check
+ *  the frames against reference frames of the protocol at each build ;
+ *  tests/main_DFPlayer_Frame.cpp checks the runtime functions.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://github.com/DFRobot/DFRobotDFPlayerMini/blob/master/doc/FN-M16P%2BEmbedded%2BMP3%2BAudio%2BModule%2BDatasheet.pdf
+ */
+
+#ifndef __DFPLAYER_FRAME_HEADER_H__
+#define __DFPLAYER_FRAME_HEADER_H__
+
+#include <stdint.h>
+
+/** Constant definition */
+#define     DFPLAYER_FRAME_SIZE         10
+#define     DFPLAYER_FRAME_START        0x7E
+#define     DFPLAYER_FRAME_VERSION      0xFF
+#define     DFPLAYER_FRAME_LENGTH       0x06
+#define     DFPLAYER_FRAME_END          0xEF
+/* Index of the fields */
+#define     DFPLAYER_FRAME_CMD          3
+#define     DFPLAYER_FRAME_FEEDBACK     4
+#define     DFPLAYER_FRAME_PARAM        5
+#define     DFPLAYER_FRAME_CHECKSUM     7
+
+/**
+ * @struct DFPlayer_Frame
+ * @brief Complete frame sent to the module
+ */
+struct DFPlayer_Frame{
+    uint8_t     bytes[DFPLAYER_FRAME_SIZE];
+};
+
+/**
+ * @brief Checksum of a frame : 0 - (version + length + cmd + feedback + param bytes).
+ * @param cmd command code
+ * @param param parameter of the command
+ * @param feedback 1 to request an acknowledge
+ */
+constexpr uint16_t DFPlayer_checkSum(uint8_t cmd, uint16_t param = 0, uint8_t feedback = 0){
+    return (uint16_t)(0 - (DFPLAYER_FRAME_VERSION + DFPLAYER_FRAME_LENGTH + cmd + feedback
+                            + (param >> 8) + (param & 0xFF)));
+}
+
+/**
+ * @brief Build a complete frame - at compile time with constant arguments.
+ * @param cmd command code
+ * @param param parameter of the command
+ * @param feedback 1 to request an acknowledge
+ */
+constexpr DFPlayer_Frame DFPlayer_makeFrame(uint8_t cmd, uint16_t param = 0, uint8_t feedback = 0){
+    return DFPlayer_Frame{{
+        DFPLAYER_FRAME_START, DFPLAYER_FRAME_VERSION, DFPLAYER_FRAME_LENGTH,
+        cmd, feedback, (uint8_t)(param >> 8), (uint8_t)(param & 0xFF),
+        (uint8_t)(DFPlayer_checkSum(cmd, param, feedback) >> 8),
+        (uint8_t)(DFPlayer_checkSum(cmd, param, feedback) & 0xFF),
+        DFPLAYER_FRAME_END }};
+}
+
+/**
+ * @brief Change a byte of a frame and correct its checksum.
+ * @param frame frame with a valid checksum
+ * @param index index of the byte (command, feedback or parameter)
+ * @param value new value of the byte
+ */
+inline void DFPlayer_setByte(uint8_t *frame, uint8_t index, uint8_t value){
+    uint16_t    checksum = (frame[DFPLAYER_FRAME_CHECKSUM] << 8) | frame[DFPLAYER_FRAME_CHECKSUM + 1];
+    checksum += frame[index] - value;
+    frame[index] = value;
+    frame[DFPLAYER_FRAME_CHECKSUM] = (uint8_t)(checksum >> 8);
+    frame[DFPLAYER_FRAME_CHECKSUM + 1] = (uint8_t)(checksum & 0xFF);
+}
+
+/**
+ * @brief Change the parameter of a frame and correct its checksum.
+ * @param frame frame with a valid checksum
+ * @param param new parameter
+ */
+inline void DFPlayer_setParam(uint8_t *frame, uint16_t param){
+    uint16_t    checksum = (frame[DFPLAYER_FRAME_CHECKSUM] << 8) | frame[DFPLAYER_FRAME_CHECKSUM + 1];
+    checksum += frame[DFPLAYER_FRAME_PARAM] + frame[DFPLAYER_FRAME_PARAM + 1];
+    checksum -= (param >> 8) + (param & 0xFF);
+    frame[DFPLAYER_FRAME_PARAM] = (uint8_t)(param >> 8);
+    frame[DFPLAYER_FRAME_PARAM + 1] = (uint8_t)(param & 0xFF);
+    frame[DFPLAYER_FRAME_CHECKSUM] = (uint8_t)(checksum >> 8);
+    frame[DFPLAYER_FRAME_CHECKSUM + 1] = (uint8_t)(checksum & 0xFF);
+}
+
+/**
+ * @brief Check a received frame : start, version, length and end bytes, then checksum.
+ * @param frame received frame (DFPLAYER_FRAME_SIZE bytes)
+ */
+inline bool DFPlayer_checkFrame(const uint8_t *frame){
+    if((frame[0] != DFPLAYER_FRAME_START) || (frame[1] != DFPLAYER_FRAME_VERSION)
+            || (frame[2] != DFPLAYER_FRAME_LENGTH) || (frame[DFPLAYER_FRAME_SIZE - 1] != DFPLAYER_FRAME_END)){
+        return false;
+    }
+    uint16_t    checksum = (frame[DFPLAYER_FRAME_CHECKSUM] << 8) | frame[DFPLAYER_FRAME_CHECKSUM + 1];
+    uint16_t    sum = 0;
+    for(int i = 1; i < DFPLAYER_FRAME_CHECKSUM; i++){
+        sum += frame[i];
+    }
+    return ((uint16_t)(sum + checksum) == 0);
+}
+
+/* Reference frames */
+// Play track 1 : 7E FF 06 03 00 00 01 FE F7 EF
+static_assert(DFPlayer_makeFrame(0x03, 1).bytes[7] == 0xFE, "DFPlayer checksum");
+static_assert(DFPlayer_makeFrame(0x03, 1).bytes[8] == 0xF7, "DFPlayer checksum");
+// Select the SD card : 7E FF 06 09 00 00 02 FE F0 EF
+static_assert(DFPlayer_makeFrame(0x09, 2).bytes[6] == 0x02, "DFPlayer parameter");
+static_assert(DFPlayer_makeFrame(0x09, 2).bytes[7] == 0xFE, "DFPlayer checksum");
+static_assert(DFPlayer_makeFrame(0x09, 2).bytes[8] == 0xF0, "DFPlayer checksum");
+// Track 100 of folder 11 : 7E FF 06 0F 00 0B 64 FE 7D EF
+static_assert(DFPlayer_makeFrame(0x0F, 0x0B64).bytes[5] == 0x0B, "DFPlayer parameter");
+static_assert(DFPlayer_checkSum(0x0F, 0x0B64) == 0xFE7D, "DFPlayer checksum");
+// Feedback requested
+static_assert(DFPlayer_checkSum(0x00, 0, 1) == 0xFEFA, "DFPlayer checksum");
+static_assert(DFPlayer_makeFrame(0x0D).bytes[0] == DFPLAYER_FRAME_START
+        && DFPlayer_makeFrame(0x0D).bytes[9] == DFPLAYER_FRAME_END, "DFPlayer frame");
+
+#endif
@@ -13,6 +13,8 @@
 
 #include "DFRobotDFPlayerMini.h"
 
+static_assert(DFPlayer_checkSum(0x00, 0, 1) == 0xFEFA, "initial checksum of _sending");
+
 void DFRobotDFPlayerMini::setTimeOut(unsigned long timeOutDuration){
   _timeOutDuration = timeOutDuration;
 }
@@ -61,9 +63,8 @@ void DFRobotDFPlayerMini::sendStack(uint8_t command){
 }
 
 void DFRobotDFPlayerMini::sendStack(uint8_t command, uint16_t argument){
-  _sending[Stack_Command] = command;
-  uint16ToArray(argument, _sending+Stack_Parameter);
-  uint16ToArray(calculateCheckSum(_sending), _sending+Stack_CheckSum);
+  DFPlayer_setByte(_sending, Stack_Command, command);
+  DFPlayer_setParam(_sending, argument);
   sendStack();
 }
 
@@ -74,11 +75,11 @@ void DFRobotDFPlayerMini::sendStack(uint8_t command, uint8_t argumentHigh, uint8
 }
 
 void DFRobotDFPlayerMini::enableACK(){
-  _sending[Stack_ACK] = 0x01;
+  DFPlayer_setByte(_sending, Stack_ACK, 0x01);
 }
 
 void DFRobotDFPlayerMini::disableACK(){
-  _sending[Stack_ACK] = 0x00;
+  DFPlayer_setByte(_sending, Stack_ACK, 0x00);
 }
 
 bool DFRobotDFPlayerMini::waitAvailable(unsigned long duration){
@@ -222,7 +223,7 @@ uint16_t DFRobotDFPlayerMini::arrayToUint16(uint8_t *array){
 }
 
 bool DFRobotDFPlayerMini::validateStack(){
-  return calculateCheckSum(_received) == arrayToUint16(_received+Stack_CheckSum);
+  return DFPlayer_checkFrame(_received);
 }
 
 bool DFRobotDFPlayerMini::available(){
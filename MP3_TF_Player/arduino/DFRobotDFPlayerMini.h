@@ -12,6 +12,7 @@
  */
 
 #include "Arduino.h"
+#include "DFPlayer_Frame.h"
 
 #ifndef DFRobotDFPlayerMini_cpp
     #define DFRobotDFPlayerMini_cpp
@@ -72,7 +73,8 @@ class DFRobotDFPlayerMini {
   unsigned long _timeOutDuration = 500;
   
   uint8_t _received[DFPLAYER_RECEIVED_LENGTH];
-  uint8_t _sending[DFPLAYER_SEND_LENGTH] = {0x7E, 0xFF, 06, 00, 01, 00, 00, 00, 00, 0xEF};
+  // valid checksum : only the changed bytes are patched (see DFPlayer_Frame.h)
+  uint8_t _sending[DFPLAYER_SEND_LENGTH] = {0x7E, 0xFF, 06, 00, 01, 00, 00, 0xFE, 0xFA, 0xEF};
   
   uint8_t _receivedIndex=0;
 
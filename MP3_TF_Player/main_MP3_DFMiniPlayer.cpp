@@ -27,6 +27,11 @@ void ISR_playpause(void){
     }
 }
 
+// Called by the player at the end of a track
+void track_finished(uint8_t device, uint16_t track){
+    my_player.nextCmd();
+}
+
 //////////// MAIN
 int main()
 {
@@ -34,6 +39,7 @@ int main()
     my_player.setDebugSerial(&my_pc);
 
     playpauseBtn.fall(&ISR_playpause);
+    my_player.attachTrackFinished(&track_finished);
 	
 	sprintf(chStr, "Mbed OS %d.%d.%d.\n", MBED_MAJOR_VERSION, MBED_MINOR_VERSION, MBED_PATCH_VERSION);
 	my_pc.write(chStr, strlen(chStr));
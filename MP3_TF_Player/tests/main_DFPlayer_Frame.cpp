@@ -0,0 +1,170 @@
+/**
+ * FILENAME :        main_DFPlayer_Frame.cpp
+ *
+ * DESCRIPTION :
+ *       MP3_TF_Player / Runtime functions of DFPlayer_Frame.h, on a computer.
+ *
+ *       This program does not depend on MBED OS or Arduino :
+ *          g++ -O2 -Iarduino tests/main_DFPlayer_Frame.cpp -o dfplayer_frame
+ *          ./dfplayer_frame    -> checks, exit code 1 if one fails
+ *
+ *       The frames are compared with frames of the datasheet and with
+ *  the checksum of the protocol, computed here byte by byte
+ *  (0 - sum of the bytes from the version to the parameter) :
+ *          -> DFPlayer_setByte and DFPlayer_setParam on a constant frame,
+ *              for each command, feedback and parameter, then patched again
+ *              from the previous parameter (difference of the checksum)
+ *          -> DFPlayer_checkFrame on frames sent by the module, and on
+ *              frames with a wrong checksum, parameter, start, version,
+ *              length or end byte
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include    <cstdio>
+#include    <cstring>
+#include    "DFPlayer_Frame.h"
+
+/**
+ * @struct SimFrame
+ * @brief Frame of the datasheet
+ */
+struct SimFrame{
+    const char  *name;
+    uint8_t     bytes[DFPLAYER_FRAME_SIZE];
+};
+
+/* Frames sent to the module */
+const SimFrame  sim_sent[] = {
+    {"Play track 1",                {0x7E, 0xFF, 0x06, 0x03, 0x00, 0x00, 0x01, 0xFE, 0xF7, 0xEF}},
+    {"Volume 15",                   {0x7E, 0xFF, 0x06, 0x06, 0x00, 0x00, 0x0F, 0xFE, 0xE6, 0xEF}},
+    {"Select the SD card",          {0x7E, 0xFF, 0x06, 0x09, 0x00, 0x00, 0x02, 0xFE, 0xF0, 0xEF}},
+    {"Track 1 of folder 1",         {0x7E, 0xFF, 0x06, 0x0F, 0x00, 0x01, 0x01, 0xFE, 0xEA, 0xEF}},
+    {"Track 100 of folder 11",      {0x7E, 0xFF, 0x06, 0x0F, 0x00, 0x0B, 0x64, 0xFE, 0x7D, 0xEF}}
+};
+/* Frames sent by the module */
+const SimFrame  sim_received[] = {
+    {"SD card online",              {0x7E, 0xFF, 0x06, 0x3F, 0x00, 0x00, 0x02, 0xFE, 0xBA, 0xEF}},
+    {"End of track 1 of SD card",   {0x7E, 0xFF, 0x06, 0x3D, 0x00, 0x00, 0x01, 0xFE, 0xBD, 0xEF}},
+    {"Error 3",                     {0x7E, 0xFF, 0x06, 0x40, 0x00, 0x00, 0x03, 0xFE, 0xB8, 0xEF}},
+    {"Acknowledge",                 {0x7E, 0xFF, 0x06, 0x41, 0x00, 0x00, 0x00, 0xFE, 0xBA, 0xEF}}
+};
+
+int         sim_failed = 0;
+
+void check(const char *name, bool ok, const char *format, int a, int b){
+    char    values[64];
+    snprintf(values, sizeof(values), format, a, b);
+    printf("%-48s %-28s %s\n", name, values, ok ? "OK" : "FAILED");
+    if(!ok){ sim_failed++; }
+}
+
+/**
+ * @brief Checksum of the protocol - byte by byte.
+ */
+uint16_t simCheckSum(const uint8_t *frame){
+    uint16_t    sum = 0;
+    for(int i = 1; i < DFPLAYER_FRAME_CHECKSUM; i++){
+        sum += frame[i];
+    }
+    return (uint16_t)(0 - sum);
+}
+
+/**
+ * @brief Frame of the protocol - byte by byte.
+ */
+void simFrame(uint8_t *frame, uint8_t cmd, uint16_t param, uint8_t feedback){
+    uint8_t     header[] = {DFPLAYER_FRAME_START, DFPLAYER_FRAME_VERSION, DFPLAYER_FRAME_LENGTH,
+                            cmd, feedback, (uint8_t)(param >> 8), (uint8_t)(param & 0xFF)};
+    memcpy(frame, header, sizeof(header));
+    uint16_t    checksum = simCheckSum(frame);
+    frame[DFPLAYER_FRAME_CHECKSUM] = (uint8_t)(checksum >> 8);
+    frame[DFPLAYER_FRAME_CHECKSUM + 1] = (uint8_t)(checksum & 0xFF);
+    frame[DFPLAYER_FRAME_SIZE - 1] = DFPLAYER_FRAME_END;
+}
+
+int main(void)
+{
+    char    name[64];
+
+    /* Frames of the datasheet - command and parameter patched at runtime */
+    for(const SimFrame &f : sim_sent){
+        DFPlayer_Frame  frame = DFPlayer_makeFrame(0);
+        DFPlayer_setByte(frame.bytes, DFPLAYER_FRAME_CMD, f.bytes[DFPLAYER_FRAME_CMD]);
+        DFPlayer_setParam(frame.bytes, (f.bytes[DFPLAYER_FRAME_PARAM] << 8) | f.bytes[DFPLAYER_FRAME_PARAM + 1]);
+        snprintf(name, sizeof(name), "Patched frame : %s", f.name);
+        check(name, memcmp(frame.bytes, f.bytes, DFPLAYER_FRAME_SIZE) == 0 && DFPlayer_checkFrame(frame.bytes),
+                "checksum %04X", (frame.bytes[7] << 8) | frame.bytes[8], 0);
+    }
+
+    /* Each command, feedback and parameter - patched from the previous parameter */
+    const uint8_t   cmds[] = {0x01, 0x03, 0x06, 0x0F, 0x12, 0x3F, 0xFF};
+    int     errors = 0;
+    int     nb = 0;
+    for(uint8_t cmd : cmds){
+        for(uint8_t feedback = 0; feedback <= 1; feedback++){
+            DFPlayer_Frame  frame = DFPlayer_makeFrame(cmd, 0, feedback);
+            for(uint32_t param = 0; param <= 0xFFFF; param++){
+                uint8_t     ref[DFPLAYER_FRAME_SIZE];
+                simFrame(ref, cmd, (uint16_t)param, feedback);
+                DFPlayer_setParam(frame.bytes, (uint16_t)param);
+                errors += (memcmp(frame.bytes, ref, DFPLAYER_FRAME_SIZE) != 0) || !DFPlayer_checkFrame(frame.bytes);
+                nb++;
+            }
+        }
+    }
+    check("DFPlayer_setParam : frames, errors", errors == 0, "%d, %d", nb, errors);
+
+    /* Feedback and command patched on a frame with a parameter */
+    errors = 0;
+    for(int cmd = 0; cmd <= 0xFF; cmd++){
+        uint8_t     ref[DFPLAYER_FRAME_SIZE];
+        DFPlayer_Frame  frame = DFPlayer_makeFrame(0x0F, 0x0B64);
+        DFPlayer_setByte(frame.bytes, DFPLAYER_FRAME_CMD, (uint8_t)cmd);
+        DFPlayer_setByte(frame.bytes, DFPLAYER_FRAME_FEEDBACK, 1);
+        simFrame(ref, (uint8_t)cmd, 0x0B64, 1);
+        errors += (memcmp(frame.bytes, ref, DFPLAYER_FRAME_SIZE) != 0);
+    }
+    check("DFPlayer_setByte : command and feedback, errors", errors == 0, "%d, %d", 256, errors);
+
+    /* Frames of the module */
+    for(const SimFrame &f : sim_received){
+        snprintf(name, sizeof(name), "Received frame : %s", f.name);
+        check(name, DFPlayer_checkFrame(f.bytes) && (simCheckSum(f.bytes) == ((f.bytes[7] << 8) | f.bytes[8])),
+                "checksum %04X", simCheckSum(f.bytes), 0);
+    }
+
+    /* Wrong frames - each bit of the checksum and of the parameter, framing bytes */
+    int     rejected = 0;
+    nb = 0;
+    for(const SimFrame &f : sim_received){
+        for(int i = DFPLAYER_FRAME_PARAM; i < DFPLAYER_FRAME_CHECKSUM + 2; i++){
+            for(int bit = 0; bit < 8; bit++){
+                uint8_t     wrong[DFPLAYER_FRAME_SIZE];
+                memcpy(wrong, f.bytes, DFPLAYER_FRAME_SIZE);
+                wrong[i] ^= (1 << bit);
+                rejected += !DFPlayer_checkFrame(wrong);
+                nb++;
+            }
+        }
+    }
+    check("Wrong checksum or parameter : frames, rejected", rejected == nb, "%d, %d", nb, rejected);
+
+    const int       fields[] = {0, 1, 2, DFPLAYER_FRAME_SIZE - 1};
+    const char      *field_names[] = {"start", "version", "length", "end"};
+    for(int k = 0; k < 4; k++){
+        uint8_t     wrong[DFPLAYER_FRAME_SIZE];
+        memcpy(wrong, sim_received[0].bytes, DFPLAYER_FRAME_SIZE);
+        wrong[fields[k]] = 0x00;
+        snprintf(name, sizeof(name), "Wrong %s byte : rejected", field_names[k]);
+        check(name, !DFPlayer_checkFrame(wrong), "byte %d = %02X", fields[k], wrong[fields[k]]);
+    }
+
+    printf("%d failed test(s)\n", sim_failed);
+    return sim_failed ? 1 : 0;
+}
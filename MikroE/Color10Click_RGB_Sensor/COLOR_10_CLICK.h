@@ -21,11 +21,13 @@
 
 #include <mbed.h>
 #include "WS2812.h"
+#include "I2C_Bus.h"
  
 /** Constant definition */
 #define     DEBUG_MODE                  1
 
 #define     COLOR_10_CLICK_ADD          0x10
+#define     COLOR_10_CLICK_FREQ         400000
 #define     COLOR_10_CLICK_COMMAND      0x00
 #define     COLOR_10_CLICK_PART_ID      0x0C
 #define     COLOR_10_CLICK_CLEAR_CHAN   0x04
@@ -67,11 +69,30 @@ class Color_10_Click{
         
         /// I2C interface pins 
         I2C             *__i2c = NULL;
+        /// Shared I2C bus - NULL if the I2C interface is used
+        I2C_Bus         *__bus = NULL;
         /// digital output to control the WS2812 RGB Led
         DigitalOut      *__led_data = NULL;
         /// WS2812 led
         WS2812          *__led;
 
+        /**
+        * @brief Initialization of the WS2812 RGB Led (switched off)
+        */
+        void initLed(DigitalOut *_led_data);
+
+        /**
+        * @brief Write data to the sensor, on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int writeData(const char *buff, int size);
+
+        /**
+        * @brief Read a register of the sensor (repeated start), on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int readRegister(char reg, char *buff, int size);
+
     public:
         /**
         * @brief Simple constructor of the Color_10_Click class.
@@ -83,6 +104,14 @@ class Color_10_Click{
         */
         Color_10_Click(I2C *_i2c, DigitalOut *_led_data);
 
+        /**
+        * @brief Constructor of the Color_10_Click class on a shared I2C bus.
+        * @details Transactions are sent at COLOR_10_CLICK_FREQ
+        * @param _bus shared I2C bus
+        * @param _led_data digital output to control the WS2812 RGB Led 
+        */
+        Color_10_Click(I2C_Bus *_bus, DigitalOut *_led_data);
+
         /**
         * @brief Initiatlization of the sensor
         * @details Initialize the sensor
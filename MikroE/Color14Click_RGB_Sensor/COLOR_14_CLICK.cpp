@@ -27,14 +27,38 @@ Color_14_Click::Color_14_Click(I2C *_i2c, InterruptIn *_int){
     /* Initialisation of i2c module */
     if (_i2c){ delete __i2c; }
     __i2c=_i2c;
-    __i2c->frequency(400000);   // Frequency of 400kHz
+    __i2c->frequency(COLOR_14_CLICK_FREQ);   // Frequency of 400kHz
     thread_sleep_for(10);      // 10 ms
 }
 
+Color_14_Click::Color_14_Click(I2C_Bus *_bus, InterruptIn *_int){
+    /* Initialisation of interrupt input */
+    if (_int){ delete __int; }
+    __int=_int;
+    /* Shared I2C bus - frequency set by each transaction */
+    __bus = _bus;
+    thread_sleep_for(10);      // 10 ms
+}
+
+int Color_14_Click::writeData(const char *buff, int size){
+    if(__bus){
+        return __bus->write(COLOR_14_CLICK_ADD << 1, buff, size, COLOR_14_CLICK_FREQ);
+    }
+    return __i2c->write(COLOR_14_CLICK_ADD << 1, buff, size);
+}
+
+int Color_14_Click::readRegister(char reg, char *buff, int size){
+    if(__bus){
+        return __bus->readRegister(COLOR_14_CLICK_ADD << 1, reg, buff, size, COLOR_14_CLICK_FREQ);
+    }
+    int ack = __i2c->write(COLOR_14_CLICK_ADD << 1, &reg, 1, true);
+    return ack + __i2c->read(COLOR_14_CLICK_ADD << 1, buff, size);
+}
+
 void Color_14_Click::powerUp(void){
     cmd[0] = COLOR_14_CLICK_MAIN_CTRL;
     cmd[1] = 0b00000100;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 2);
+    ack1 = writeData(cmd, 2);
     if(DEBUG_MODE) printf("Init Acq = %d\r\n", ack1);
     wait_us(1000);
 }
@@ -42,74 +66,56 @@ void Color_14_Click::powerUp(void){
 void Color_14_Click::initRGBSensor(void){
     cmd[0] = COLOR_14_CLICK_MAIN_CTRL;
     cmd[1] = 0b00000110;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 2);
+    ack1 = writeData(cmd, 2);
     if(DEBUG_MODE) printf("Init Acq = %d\r\n", ack1);
     wait_us(1000);
 }
 
 int Color_14_Click::getPartID(void){
     // Part ID Status
-    cmd[0] = COLOR_14_CLICK_PART_ID;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 1, true);
-    ack2 = __i2c->read(COLOR_14_CLICK_ADD << 1, data, 1);
-    if(DEBUG_MODE)  printf("Part ID Acq (W) = %d\r\n", ack1);
-    if(DEBUG_MODE)  printf("Part ID Acq (R) = %d\r\n", ack2);
+    ack1 = readRegister(COLOR_14_CLICK_PART_ID, data, 1);
+    if(DEBUG_MODE)  printf("Part ID Acq (W/R) = %d\r\n", ack1);
     return data[0];
 }
 
 int Color_14_Click::getMainStatus(void){
-    cmd[0] = COLOR_14_CLICK_MAIN_STAT;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 1, true);
-    ack2 = __i2c->read(COLOR_14_CLICK_ADD << 1, data, 1);
-    if(DEBUG_MODE)  printf("Main Status Acq (W) = %d\r\n", ack1);
-    if(DEBUG_MODE)  printf("Main Status Acq (R) = %d\r\n", ack2);
+    ack1 = readRegister(COLOR_14_CLICK_MAIN_STAT, data, 1);
+    if(DEBUG_MODE)  printf("Main Status Acq (W/R) = %d\r\n", ack1);
     return data[0];
 }
 
 void Color_14_Click::setGainRGB(int val){
     cmd[0] = COLOR_14_CLICK_LS_GAIN;
     cmd[1] = val;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 2);
+    ack1 = writeData(cmd, 2);
     if(DEBUG_MODE)  printf("Gain Acq (W) = %d\r\n", ack1); 
 }
 
 int Color_14_Click::readRedValue(void){
-    cmd[0] = COLOR_14_CLICK_RED_CHAN;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 1, true);
-    ack2 = __i2c->read(COLOR_14_CLICK_ADD << 1, data, 3);
-    if(DEBUG_MODE)  printf("Red Chan Acq (W) = %d\r\n", ack1);
-    if(DEBUG_MODE)  printf("Red Chan Acq (R) = %d\r\n", ack2);
+    ack1 = readRegister(COLOR_14_CLICK_RED_CHAN, data, 3);
+    if(DEBUG_MODE)  printf("Red Chan Acq (W/R) = %d\r\n", ack1);
     Red_color = (data[2] << 16) + (data[1] << 8) + data[0];
     return Red_color;
 }
 
 int Color_14_Click::readGreenValue(void){
-    cmd[0] = COLOR_14_CLICK_GREEN_CHAN;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 1, true);
-    ack2 = __i2c->read(COLOR_14_CLICK_ADD << 1, data, 3);
-    if(DEBUG_MODE)  printf("Green Chan Acq (W) = %d\r\n", ack1);
-    if(DEBUG_MODE)  printf("Green Chan Acq (R) = %d\r\n", ack2);
+    ack1 = readRegister(COLOR_14_CLICK_GREEN_CHAN, data, 3);
+    if(DEBUG_MODE)  printf("Green Chan Acq (W/R) = %d\r\n", ack1);
     Green_color = (data[2] << 16) + (data[1] << 8) + data[0];
     return Green_color;
 }
 
 int Color_14_Click::readBlueValue(void){
-    cmd[0] = COLOR_14_CLICK_BLUE_CHAN;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 1, true);
-    ack2 = __i2c->read(COLOR_14_CLICK_ADD << 1, data, 3);
-    if(DEBUG_MODE)  printf("Blue Chan Acq (W) = %d\r\n", ack1);
-    if(DEBUG_MODE)  printf("Blue Chan Acq (R) = %d\r\n", ack2);
+    ack1 = readRegister(COLOR_14_CLICK_BLUE_CHAN, data, 3);
+    if(DEBUG_MODE)  printf("Blue Chan Acq (W/R) = %d\r\n", ack1);
     Blue_color = (data[2] << 16) + (data[1] << 8) + data[0];
     return Blue_color;
 }
 
 
 int Color_14_Click::readIRValue(void){
-    cmd[0] = COLOR_14_CLICK_IR_CHAN;
-    ack1 = __i2c->write(COLOR_14_CLICK_ADD << 1, cmd, 1, true);
-    ack2 = __i2c->read(COLOR_14_CLICK_ADD << 1, data, 3);
-    if(DEBUG_MODE)  printf("IR Chan Acq (W) = %d\r\n", ack1);
-    if(DEBUG_MODE)  printf("IR Chan Acq (R) = %d\r\n", ack2);
+    ack1 = readRegister(COLOR_14_CLICK_IR_CHAN, data, 3);
+    if(DEBUG_MODE)  printf("IR Chan Acq (W/R) = %d\r\n", ack1);
     IR_color = (data[2] << 16) + (data[1] << 8) + data[0];
     return IR_color;
 }
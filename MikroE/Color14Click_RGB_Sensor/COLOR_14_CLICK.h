@@ -19,11 +19,13 @@
 #define __COLOR_14_CLICK_HEADER_H__
 
 #include <mbed.h>
+#include "I2C_Bus.h"
  
 /** Constant definition */
 #define     DEBUG_MODE                  1
 
 #define     COLOR_14_CLICK_ADD          0x52
+#define     COLOR_14_CLICK_FREQ         400000
 #define     COLOR_14_CLICK_MAIN_CTRL    0x00
 #define     COLOR_14_CLICK_PART_ID      0x06
 #define     COLOR_14_CLICK_MAIN_STAT    0x07
@@ -66,9 +68,23 @@ class Color_14_Click{
         
         /// I2C interface pins 
         I2C             *__i2c = NULL;
+        /// Shared I2C bus - NULL if the I2C interface is used
+        I2C_Bus         *__bus = NULL;
         /// interrupt Input pin
         InterruptIn     *__int = NULL;
 
+        /**
+        * @brief Write data to the sensor, on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int writeData(const char *buff, int size);
+
+        /**
+        * @brief Read a register of the sensor (repeated start), on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int readRegister(char reg, char *buff, int size);
+
     public:
         /**
         * @brief Simple constructor of the Color_14_Click class.
@@ -80,6 +96,14 @@ class Color_14_Click{
         */
         Color_14_Click(I2C *_i2c, InterruptIn *_int);
 
+        /**
+        * @brief Constructor of the Color_14_Click class on a shared I2C bus.
+        * @details Transactions are sent at COLOR_14_CLICK_FREQ
+        * @param _bus shared I2C bus
+        * @param _int interrupt Input 
+        */
+        Color_14_Click(I2C_Bus *_bus, InterruptIn *_int);
+
         /**
         * @brief Initiatlization of the sensor
         * @details Initialize the sensor
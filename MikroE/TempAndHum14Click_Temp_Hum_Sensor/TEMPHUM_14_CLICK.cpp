@@ -27,13 +27,36 @@ TempHum_14_Click::TempHum_14_Click(I2C *_i2c, DigitalOut *_rst){
     /* Initialisation of i2c module */
     if (_i2c){ delete __i2c; }
     __i2c=_i2c;
-    __i2c->frequency(400000);   // Frequency of 400kHz
+    __i2c->frequency(TEMPHUM_14_CLICK_FREQ);   // Frequency of 400kHz
     thread_sleep_for(10);      // 10 ms
 }
 
+TempHum_14_Click::TempHum_14_Click(I2C_Bus *_bus, DigitalOut *_rst){
+    /* Initialisation of interrupt input */
+    if (_rst){ delete __reset; }
+    __reset=_rst;
+    /* Shared I2C bus - frequency set by each transaction */
+    __bus = _bus;
+    thread_sleep_for(10);      // 10 ms
+}
+
+int TempHum_14_Click::writeData(const char *buff, int size){
+    if(__bus){
+        return __bus->write(TEMPHUM_14_CLICK_ADD << 1, buff, size, TEMPHUM_14_CLICK_FREQ);
+    }
+    return __i2c->write(TEMPHUM_14_CLICK_ADD << 1, buff, size);
+}
+
+int TempHum_14_Click::readData(char *buff, int size){
+    if(__bus){
+        return __bus->read(TEMPHUM_14_CLICK_ADD << 1, buff, size, TEMPHUM_14_CLICK_FREQ);
+    }
+    return __i2c->read(TEMPHUM_14_CLICK_ADD << 1, buff, size);
+}
+
 void TempHum_14_Click::resetSensor(void){
     cmd[0] = TEMPHUM_14_CLICK_RESET;
-    ack1 = __i2c->write(TEMPHUM_14_CLICK_ADD << 1, cmd, 1);
+    ack1 = writeData(cmd, 1);
     if(DEBUG_MODE) printf("Reset Acq = %d\r\n", ack1);
     thread_sleep_for(20);    // 20 ms
 }
@@ -41,8 +64,8 @@ void TempHum_14_Click::resetSensor(void){
 int TempHum_14_Click::getPartID(void){
     // Part ID Status / 4 bytes
     cmd[0] = TEMPHUM_14_CLICK_PART_ID;
-    ack1 = __i2c->write(TEMPHUM_14_CLICK_ADD << 1, cmd, 1);
-    ack2 = __i2c->read(TEMPHUM_14_CLICK_ADD << 1, data, 4);
+    ack1 = writeData(cmd, 1);
+    ack2 = readData(data, 4);
     if(DEBUG_MODE)  printf("Part ID Acq (W) = %d\r\n", ack1);
     if(DEBUG_MODE)  printf("Part ID Acq (R) = %d\r\n", ack2);
     return (data[2] << 16) + (data[0] << 8) + (data[0]);
@@ -51,8 +74,8 @@ int TempHum_14_Click::getPartID(void){
 int TempHum_14_Click::getDiag(void){
     // Diagnostic Register / 1 byte
     cmd[0] = TEMPHUM_14_CLICK_DIAG;
-    ack1 = __i2c->write(TEMPHUM_14_CLICK_ADD << 1, cmd, 1);
-    ack2 = __i2c->read(TEMPHUM_14_CLICK_ADD << 1, data, 1);
+    ack1 = writeData(cmd, 1);
+    ack2 = readData(data, 1);
     if(DEBUG_MODE)  printf("Diag Acq (W) = %d\r\n", ack1);
     if(DEBUG_MODE)  printf("Diag Acq (R) = %d\r\n", ack2);
     return data[0];
@@ -61,13 +84,13 @@ int TempHum_14_Click::getDiag(void){
 void TempHum_14_Click::readTRH(float *temp, float *hum){
     // Conversion in fast mode    
     cmd[0] = TEMPHUM_14_CLICK_CONV;
-    ack1 = __i2c->write(TEMPHUM_14_CLICK_ADD << 1, cmd, 1);
+    ack1 = writeData(cmd, 1);
     if(DEBUG_MODE)  printf("Conv Acq (W) = %d\r\n", ack1);
     thread_sleep_for(3);    // 3 ms   
     // Read data    
     cmd[0] = TEMPHUM_14_CLICK_READ_T_RH;
-    ack1 = __i2c->write(TEMPHUM_14_CLICK_ADD << 1, cmd, 1);
-    ack2 = __i2c->read(TEMPHUM_14_CLICK_ADD << 1, data, 6);
+    ack1 = writeData(cmd, 1);
+    ack2 = readData(data, 6);
     int tEmp = (data[0] << 8) + (data[1]);
     int hUm = (data[0] << 8) + (data[1]);
     _temperature = -40.0 + 165.0 * tEmp / 65535;
@@ -20,54 +20,121 @@ PMod_TC1::PMod_TC1(SPI *_spi, DigitalOut _cs): __cs(_cs){
     temperature_final = 0;
     temperature_thermo = 0;
     temperature_internal = 0;
+    faults = TC1_FAULT_NONE;
+    fault_cnt = 0;
+    __sampling = false;
     /* Initialisation of spi module */
     if (__spi){ delete _spi; }
     __spi=_spi;
-    __spi->format(8,3);    // 32 bits are collected
-    __spi->frequency(100000);   // Frequency of 100kHz
-    thread_sleep_for(500);      // 500 ms
+    // SPI format is applied before each frame, the bus can be shared
+    // No waiting time : first conversion is ready after TC1_CONVERSION_TIME
+}
+
+PMod_TC1::PMod_TC1(SPI_Device *_dev): __cs(NC){
+    temperature_final = 0;
+    temperature_thermo = 0;
+    temperature_internal = 0;
+    faults = TC1_FAULT_NONE;
+    fault_cnt = 0;
+    __sampling = false;
+    /* Slave Select pin is driven by the device */
+    __dev = _dev;
+    __dev->setFormat(8, 0, TC1_SPI_FREQ);
 }
 
 
 double PMod_TC1::readTemperature(void){
-    temperature_final = 0;
-    int k = readRawData();
-    // internal value of temperature
-    temperature_internal = ((k >> 4) & 0x0FFF) / 16.0;
-    // sign of the temperature   
-    if( (k & 0x00008000) == 0x00008000  )  temperature_internal = -temperature_internal;
-    // thermocouple value of temperature
-    temperature_thermo = ((k >> 17) & 0x3FFF) / 4.0;
-    // sign of the temperature   
-    if( (k & 0x80000000) == 0x80000000  )  temperature_thermo = -temperature_thermo; 
+    if(!__sampling){
+        readFrame();
+    }
+    CriticalSectionLock lock;
+    return temperature_final;
+}
+
+bool PMod_TC1::readFrame(void){
+    TC1_Frame frame;
+    bool valid = TC1_decodeFrame(readRawData(), &frame);
+    CriticalSectionLock lock;
+    faults = frame.faults;
+    if(!valid){
+        fault_cnt++;
+        return false;
+    }
+    temperature_internal = frame.internal;
+    temperature_thermo = __filter.update(frame.thermo);
     // global value of the temperature
     temperature_final = temperature_thermo - temperature_internal;
-    return temperature_final;
+    return true;
 }
 
 int PMod_TC1::readRawData(void){
-    int k = 0;
-    short k1, k2, k3, k4;
-    __cs = 0;
-    k1 = __spi->write(0);
-    k2 = __spi->write(0);
-    k3 = __spi->write(0);
-    k4 = __spi->write(0);
-    __cs = 1;
-    k = (k1 << 24) + (k2 << 16) + (k3 << 8) + k4;
-    return k;
+    char rx[4] = {0};
+    if(__dev){
+        // shared bus - the format is applied only if another device used the bus
+        __dev->transfer(NULL, 0, rx, 4);    // 32 bits are collected
+    }
+    else{
+        // the sampling engine and the main code can share the module
+        __spi->lock();
+        __spi->format(8,0);         // MAX31855 - data valid on rising edge
+        __spi->frequency(TC1_SPI_FREQ); // Frequency of 100kHz
+        __cs = 0;
+        __spi->write(NULL, 0, rx, 4);   // 32 bits are collected
+        __cs = 1;
+        __spi->unlock();
+    }
+    return ((uint32_t)(uint8_t)rx[0] << 24) | ((uint32_t)(uint8_t)rx[1] << 16) |
+            ((uint32_t)(uint8_t)rx[2] << 8) | (uint32_t)(uint8_t)rx[3];
 }
 
 double PMod_TC1::getInternalTemperature(void){
-    int k = readRawData();
-    double t = ((k >> 4) & 0x0FFF);
-    if( (k & 0x00008000) == 0x00008000  )  t = -t;  // sign of the temperature
-    return t / 16.0;
+    if(!__sampling){
+        readFrame();
+    }
+    CriticalSectionLock lock;
+    return temperature_internal;
 }
 
 double PMod_TC1::getThermoTemperature(void){
-    int k = readRawData();
-    double t = ((k >> 17) & 0x3FFF);
-    if( (k & 0x80000000) == 0x80000000  )  t = -t;  // sign of the temperature
-    return t / 4.0;
-}
\ No newline at end of file
+    if(!__sampling){
+        readFrame();
+    }
+    CriticalSectionLock lock;
+    return temperature_thermo;
+}
+
+uint8_t PMod_TC1::getFaults(void){
+    return faults;
+}
+
+int PMod_TC1::getFaultCnt(void){
+    return fault_cnt;
+}
+
+TC1_Filter *PMod_TC1::getFilter(void){
+    return &__filter;
+}
+
+/****************************************************************/
+void PMod_TC1::startSampling(std::chrono::microseconds period){
+    if(period < TC1_CONVERSION_TIME){ period = TC1_CONVERSION_TIME; }
+    fault_cnt = 0;
+    __filter.reset();
+    __sampling = true;
+    __sampling_tik.attach(callback(this, &PMod_TC1::ISR_sampling), period);
+}
+
+void PMod_TC1::stopSampling(void){
+    __sampling_tik.detach();
+    __sampling = false;
+}
+
+void PMod_TC1::ISR_sampling(void){
+    mbed_event_queue()->call(callback(this, &PMod_TC1::sampleFrame));
+}
+
+void PMod_TC1::sampleFrame(void){
+    if(__sampling){
+        readFrame();
+    }
+}
@@ -20,6 +20,14 @@
 #define __PMOD_TC1_HEADER_H__
 
 #include <mbed.h>
+#include "PMod_TC1_filter.h"
+#include "SPI_Bus.h"
+
+/** Constant definition */
+/// Conversion time of the MAX31855 - 100 ms max
+#define     TC1_CONVERSION_TIME     100ms
+/// SPI frequency
+#define     TC1_SPI_FREQ            100000
 
 /**
  * @class PMod_TC1
@@ -38,11 +46,36 @@ class PMod_TC1{
         double temperature_internal;
         /// Final temperature 
         double temperature_final;
+        /// Fault bits of the last frame
+        uint8_t faults;
+        /// Number of frames with a fault
+        int fault_cnt;
         
         /// SPI interface pins 
         SPI *__spi = NULL;
         /// Slave Select pin
         DigitalOut __cs;
+        /// Device on a shared SPI bus - NULL if the SPI interface is used
+        SPI_Device *__dev = NULL;
+
+        /// Filter of the thermocouple temperature
+        TC1_Filter __filter;
+        /// Ticker of the sampling engine
+        Ticker __sampling_tik;
+        /// Sampling engine is running
+        bool __sampling;
+
+        /**
+        * @brief Interrupt routine of the sampling engine.
+        * @details SPI can not be used in interrupt context,
+        *   the reading of the frame is deferred to the shared event queue.
+        */
+        void ISR_sampling(void);
+
+        /**
+        * @brief Read one frame and update the cached values.
+        */
+        void sampleFrame(void);
 
 
     public:
@@ -50,21 +83,42 @@ class PMod_TC1{
         * @brief Simple constructor of the PMod_TC1 class.
         * @details Create a PMod_TC1 object with
         *    an SPI interface and a Slave Select pin
-        *    SPI communication will be initialized at 100kHz
+        *    SPI communication is done at 100kHz, mode 0. The format
+        *    is applied before each frame, the bus can be shared.
         * @param _spi SPI interface not initialized
         * @param _cs Slave Select pin connected to the module
         */
         PMod_TC1(SPI *_spi, DigitalOut _cs);
 
+        /**
+        * @brief Constructor of the PMod_TC1 class on a shared SPI bus.
+        * @details The format of the device is set to 8 bits, mode 0,
+        *    TC1_SPI_FREQ. The bus applies it only when another device
+        *    used the bus before.
+        * @param _dev device on a shared SPI bus (with its Slave Select pin)
+        */
+        PMod_TC1(SPI_Device *_dev);
+
         /**
         * @brief Read the data from the PMod_TC1 module
         * @details Read the data from the PMod_TC1 module
         *   and update the member value of the object - 
+        *   If the sampling engine is running, return the last cached value.
         *
         * @return the final temperature.
         */
         double readTemperature(void);
 
+        /**
+        * @brief Read and decode one frame from the PMod_TC1 module
+        * @details Thermocouple, internal and final temperatures
+        *   and fault bits are updated from the same frame.
+        *   Frames with a fault do not update the temperatures.
+        *
+        * @return true if the frame does not report any fault.
+        */
+        bool readFrame(void);
+
         /**
         * @brief Read the raw data from the PMod_TC1 module
         *
@@ -74,6 +128,7 @@ class PMod_TC1{
 
         /**
         * @brief Get the internal temperature of the module
+        * @details  If the sampling engine is running, return the last cached value.
         *
         * @return the internal temperature of the module.
         */
@@ -81,10 +136,46 @@ class PMod_TC1{
 
         /**
         * @brief Get the thermocouple temperature of the module
+        * @details  If the sampling engine is running, return the last cached
+        *   (and filtered) value.
         *
         * @return the thermocouple temperature of the module.
         */
         double getThermoTemperature(void);
+
+        /**
+        * @brief Get the fault bits of the last frame
+        *
+        * @return TC1_FAULT_NONE or a combination of TC1_FAULT_OC, TC1_FAULT_SCG, TC1_FAULT_SCV.
+        */
+        uint8_t getFaults(void);
+
+        /**
+        * @brief Get the number of frames with a fault since the start of the sampling
+        */
+        int getFaultCnt(void);
+
+        /**
+        * @brief Get the filter applied to the thermocouple temperature
+        * @details  Use setMovingAverage, setMedian or setIIR on the returned
+        *   filter to configure it (before starting the sampling engine).
+        *
+        * @return pointer to the filter.
+        */
+        TC1_Filter *getFilter(void);
+
+        /**
+        * @brief Start the sampling engine
+        * @details A frame is read at each period and feeds the filter.
+        *   The period can not be shorter than the conversion time of the MAX31855.
+        * @param period sampling period - default TC1_CONVERSION_TIME
+        */
+        void startSampling(std::chrono::microseconds period = TC1_CONVERSION_TIME);
+
+        /**
+        * @brief Stop the sampling engine
+        */
+        void stopSampling(void);
 };
 
 
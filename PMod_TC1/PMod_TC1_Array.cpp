@@ -0,0 +1,133 @@
+/**
+ * FILENAME :        PMod_TC1_Array.cpp
+ *
+ * DESCRIPTION :
+ *       PMod_TC1_Array / Multi-channel thermocouple scanner.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <mbed.h>
+#include "PMod_TC1_Array.h"
+
+/// Build the 32-bit frame from the received bytes (MSB first)
+static uint32_t bytesToFrame(const char rx[4]){
+    return ((uint32_t)(uint8_t)rx[0] << 24) | ((uint32_t)(uint8_t)rx[1] << 16) |
+            ((uint32_t)(uint8_t)rx[2] << 8) | (uint32_t)(uint8_t)rx[3];
+}
+
+PMod_TC1_Array::PMod_TC1_Array(SPI *spi, const PinName cs[], uint8_t nb_channels, int freq){
+    if(nb_channels > TC1_ARRAY_MAX_CHANNELS){ nb_channels = TC1_ARRAY_MAX_CHANNELS; }
+    this->__nb_channels = nb_channels;
+    this->__frequency = freq;
+    this->__scanning = false;
+    /* Initialisation of the Slave Select pins - idle high */
+    for(int i = 0; i < this->__nb_channels; i++){
+        this->__cs[i] = new DigitalOut(cs[i], 1);
+    }
+    /* Initialisation of the scan */
+    this->__scan.timestamp_ms = 0;
+    this->__scan.temperatures.assign(this->__nb_channels, 0);
+    this->__scan.internal.assign(this->__nb_channels, 0);
+    this->__scan.faults.assign(this->__nb_channels, TC1_FAULT_NONE);
+    /* Initialisation of spi module */
+    this->__spi = spi;
+}
+
+PMod_TC1_Array::~PMod_TC1_Array(void){
+    this->stopScanning();
+    for(int i = 0; i < this->__nb_channels; i++){
+        delete this->__cs[i];
+    }
+}
+
+uint8_t PMod_TC1_Array::getNbChannels(void){
+    return this->__nb_channels;
+}
+
+uint32_t PMod_TC1_Array::readRawData(uint8_t channel){
+    char rx[4] = {0};
+    if(channel >= this->__nb_channels){ return 0; }
+    this->__spi->lock();
+    this->__spi->format(8, 0);
+    this->__spi->frequency(this->__frequency);
+    *(this->__cs[channel]) = 0;
+    this->__spi->write(NULL, 0, rx, 4);    // 32 bits are collected
+    *(this->__cs[channel]) = 1;
+    this->__spi->unlock();
+    return bytesToFrame(rx);
+}
+
+TC1_Scan PMod_TC1_Array::scan(void){
+    char        rx[TC1_ARRAY_MAX_CHANNELS][4];
+    TC1_Frame   frame;
+
+    /* All the channels are read back to back, the bus is locked once */
+    this->__spi->lock();
+    this->__spi->format(8, 0);
+    this->__spi->frequency(this->__frequency);
+    for(int i = 0; i < this->__nb_channels; i++){
+        *(this->__cs[i]) = 0;
+        this->__spi->write(NULL, 0, rx[i], 4);
+        *(this->__cs[i]) = 1;
+    }
+    this->__spi->unlock();
+    uint64_t timestamp = Kernel::get_ms_count();
+
+    /* Decoding outside of the bus access */
+    this->__scan_mutex.lock();
+    this->__scan.timestamp_ms = timestamp;
+    for(int i = 0; i < this->__nb_channels; i++){
+        uint32_t raw = bytesToFrame(rx[i]);
+        if(TC1_decodeFrame(raw, &frame)){
+            this->__scan.internal[i] = frame.internal;
+            this->__scan.temperatures[i] = frame.thermo - frame.internal;
+        }
+        this->__scan.faults[i] = frame.faults;
+    }
+    TC1_Scan copy = this->__scan;
+    this->__scan_mutex.unlock();
+    return copy;
+}
+
+TC1_Scan PMod_TC1_Array::getLastScan(void){
+    this->__scan_mutex.lock();
+    TC1_Scan copy = this->__scan;
+    this->__scan_mutex.unlock();
+    return copy;
+}
+
+void PMod_TC1_Array::attach(Callback<void(const TC1_Scan &)> on_scan){
+    this->__on_scan = on_scan;
+}
+
+/****************************************************************/
+void PMod_TC1_Array::startScanning(std::chrono::microseconds period){
+    if(period < TC1_CONVERSION_TIME){ period = TC1_CONVERSION_TIME; }
+    this->__scanning = true;
+    this->__scanning_tik.attach(callback(this, &PMod_TC1_Array::ISR_scanning), period);
+}
+
+void PMod_TC1_Array::stopScanning(void){
+    this->__scanning_tik.detach();
+    this->__scanning = false;
+}
+
+void PMod_TC1_Array::ISR_scanning(void){
+    mbed_event_queue()->call(callback(this, &PMod_TC1_Array::scanAndPublish));
+}
+
+void PMod_TC1_Array::scanAndPublish(void){
+    if(!this->__scanning){ return; }
+    this->scan();
+    if(this->__on_scan){
+        this->__scan_mutex.lock();
+        this->__on_scan(this->__scan);
+        this->__scan_mutex.unlock();
+    }
+}
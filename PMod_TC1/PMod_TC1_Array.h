@@ -0,0 +1,157 @@
+/**
+ * FILENAME :        PMod_TC1_Array.h
+ *
+ * DESCRIPTION :
+ *       PMod_TC1_Array / Multi-channel thermocouple scanner.
+ *
+ *       This module allows to read several PMod_TC1 modules
+ *  sharing the same SPI bus (one Slave Select pin per module).
+ *       More informations : https://digilent.com/reference/_media/reference/pmod/pmodtc1/pmodtc1_rm.pdf
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __PMOD_TC1_ARRAY_HEADER_H__
+#define __PMOD_TC1_ARRAY_HEADER_H__
+
+#include <mbed.h>
+#include <vector>
+#include "PMod_TC1.h"
+#include "PMod_TC1_filter.h"
+
+/** Constant definition */
+#define     TC1_ARRAY_MAX_CHANNELS      16
+/// MAX31855 maximum SPI clock is 5 MHz
+#define     TC1_ARRAY_SPI_FREQ          4000000
+
+/**
+ * @struct TC1_Scan
+ * @brief Temperatures of all the channels, collected during the same scan
+ */
+struct TC1_Scan{
+    /// Time of the scan in ms (since the start of the kernel)
+    uint64_t                timestamp_ms;
+    /// Final temperatures, as PMod_TC1::readTemperature
+    std::vector<double>     temperatures;
+    /// Internal temperatures of the modules
+    std::vector<double>     internal;
+    /// Fault bits of each channel (TC1_FAULT_NONE if valid)
+    std::vector<uint8_t>    faults;
+};
+
+/**
+ * @class PMod_TC1_Array
+ * @brief Read N PMod_TC1 modules on the same SPI bus
+ * @details     Each channel is read by a single 32-bit block transfer.
+ *      No waiting time is required in the constructor : the first
+ *  conversion of the MAX31855 is ready TC1_CONVERSION_TIME after power up,
+ *  that is before the first period of the scanning engine.
+ */
+class PMod_TC1_Array{
+    private:
+        /// SPI interface shared by all the channels
+        SPI         *__spi;
+        /// SPI frequency
+        int         __frequency;
+        /// Slave Select pins
+        DigitalOut  *__cs[TC1_ARRAY_MAX_CHANNELS];
+        /// Number of channels
+        uint8_t     __nb_channels;
+
+        /// Last scan
+        TC1_Scan    __scan;
+        /// Protection of the last scan
+        Mutex       __scan_mutex;
+        /// Function called after each scan
+        Callback<void(const TC1_Scan &)>  __on_scan;
+
+        /// Ticker of the scanning engine
+        Ticker      __scanning_tik;
+        /// Scanning engine is running
+        bool        __scanning;
+
+        /**
+        * @brief Interrupt routine of the scanning engine.
+        * @details SPI can not be used in interrupt context,
+        *   the scan is deferred to the shared event queue.
+        */
+        void ISR_scanning(void);
+
+        /**
+        * @brief Scan all the channels and call the scan callback.
+        */
+        void scanAndPublish(void);
+
+    public:
+        /**
+        * @brief Simple constructor of the PMod_TC1_Array class.
+        * @details Create a PMod_TC1_Array object with
+        *    an SPI interface and one Slave Select pin per channel.
+        *    SPI format is 8 bits, mode 0. The format is applied before
+        *    each scan, the bus can be shared with other devices.
+        * @param spi SPI interface not initialized
+        * @param cs array of Slave Select pins connected to the modules
+        * @param nb_channels number of channels - up to TC1_ARRAY_MAX_CHANNELS
+        * @param freq SPI frequency - default TC1_ARRAY_SPI_FREQ
+        */
+        PMod_TC1_Array(SPI *spi, const PinName cs[], uint8_t nb_channels, int freq = TC1_ARRAY_SPI_FREQ);
+
+        /**
+        * @brief Destructor - release the Slave Select pins.
+        */
+        ~PMod_TC1_Array(void);
+
+        /**
+        * @brief Return the number of channels.
+        */
+        uint8_t getNbChannels(void);
+
+        /**
+        * @brief Read the raw data of one channel
+        * @param channel index of the channel, from 0
+        * @return the raw 32-bit frame of the MAX31855.
+        */
+        uint32_t readRawData(uint8_t channel);
+
+        /**
+        * @brief Read all the channels back to back
+        * @details  Update the last scan and return a copy of it, taken
+        *   before the scanning engine can update it again.
+        * @return the last scan.
+        */
+        TC1_Scan scan(void);
+
+        /**
+        * @brief Return the last scan.
+        * @details  The returned copy is consistent, even if the scanning
+        *   engine is running.
+        */
+        TC1_Scan getLastScan(void);
+
+        /**
+        * @brief Set the function to call after each scan of the scanning engine.
+        * @details The function is called from the shared event queue thread.
+        * @param on_scan function to call
+        */
+        void attach(Callback<void(const TC1_Scan &)> on_scan);
+
+        /**
+        * @brief Start the scanning engine
+        * @details All the channels are read at each period.
+        *   The period can not be shorter than the conversion time of the MAX31855.
+        * @param period scanning period - default TC1_CONVERSION_TIME
+        */
+        void startScanning(std::chrono::microseconds period = TC1_CONVERSION_TIME);
+
+        /**
+        * @brief Stop the scanning engine
+        */
+        void stopScanning(void);
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * FILENAME :        PMod_TC1_filter.cpp
+ *
+ * DESCRIPTION :
+ *       PMod_TC1 / MAX31855 frame decoding and digital filtering routines.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "PMod_TC1_filter.h"
+
+bool    TC1_decodeFrame(uint32_t raw, TC1_Frame *frame){
+    // thermocouple value of temperature - 14-bit signed, 0.25 deg / LSB
+    int16_t thermo = (int16_t)((raw >> 16) & 0xFFFC) >> 2;
+    // internal value of temperature - 12-bit signed, 0.0625 deg / LSB
+    int16_t internal = (int16_t)(raw & 0xFFF0) >> 4;
+    frame->thermo = thermo / 4.0;
+    frame->internal = internal / 16.0;
+    frame->faults = raw & TC1_FAULT_MASK;
+    if(raw & TC1_FAULT_FLAG){
+        // fault flag without detail : report an open circuit
+        if(frame->faults == TC1_FAULT_NONE){ frame->faults = TC1_FAULT_OC; }
+    }
+    return (frame->faults == TC1_FAULT_NONE);
+}
+
+
+TC1_Filter::TC1_Filter(void){
+    this->__mode = TC1_FILTER_NONE;
+    this->__size = 1;
+    this->__alpha = 1.0;
+    this->reset();
+}
+
+void    TC1_Filter::setNone(void){
+    this->__mode = TC1_FILTER_NONE;
+    this->__size = 1;
+    this->reset();
+}
+
+bool    TC1_Filter::setMovingAverage(uint8_t size){
+    if((size < 1) || (size > TC1_FILTER_MAX_SIZE)){
+        return false;
+    }
+    this->__mode = TC1_FILTER_MOVING_AVERAGE;
+    this->__size = size;
+    this->reset();
+    return true;
+}
+
+bool    TC1_Filter::setMedian(uint8_t size){
+    if((size < 1) || (size > TC1_FILTER_MAX_SIZE)){
+        return false;
+    }
+    this->__mode = TC1_FILTER_MEDIAN;
+    this->__size = size;
+    this->reset();
+    return true;
+}
+
+bool    TC1_Filter::setIIR(double alpha){
+    if((alpha <= 0) || (alpha > 1)){
+        return false;
+    }
+    this->__mode = TC1_FILTER_IIR;
+    this->__alpha = alpha;
+    this->reset();
+    return true;
+}
+
+TC1_FilterMode  TC1_Filter::getMode(void){
+    return this->__mode;
+}
+
+void    TC1_Filter::reset(void){
+    for(int i = 0; i < TC1_FILTER_MAX_SIZE; i++){
+        this->__samples[i] = 0;
+    }
+    this->__index = 0;
+    this->__count = 0;
+    this->__sum = 0;
+    this->__output = 0;
+}
+
+double  TC1_Filter::update(double sample){
+    switch(this->__mode){
+        case TC1_FILTER_MOVING_AVERAGE:
+            // remove the oldest sample from the running sum
+            if(this->__count == this->__size){
+                this->__sum -= this->__samples[this->__index];
+            }
+            else{
+                this->__count++;
+            }
+            this->__samples[this->__index] = sample;
+            this->__sum += sample;
+            this->__index = (this->__index + 1) % this->__size;
+            this->__output = this->__sum / this->__count;
+            break;
+
+        case TC1_FILTER_MEDIAN:
+            if(this->__count < this->__size){
+                this->__count++;
+            }
+            this->__samples[this->__index] = sample;
+            this->__index = (this->__index + 1) % this->__size;
+            this->__output = this->median();
+            break;
+
+        case TC1_FILTER_IIR:
+            // first sample initializes the filter
+            if(this->__count == 0){
+                this->__count = 1;
+                this->__output = sample;
+            }
+            else{
+                this->__output += this->__alpha * (sample - this->__output);
+            }
+            break;
+
+        case TC1_FILTER_NONE:
+        default:
+            this->__output = sample;
+            break;
+    }
+    return this->__output;
+}
+
+double  TC1_Filter::getValue(void){
+    return this->__output;
+}
+
+double  TC1_Filter::median(void){
+    double  sorted[TC1_FILTER_MAX_SIZE];
+    // insertion sort of the valid samples
+    for(int i = 0; i < this->__count; i++){
+        double  val = this->__samples[i];
+        int     j = i;
+        while((j > 0) && (sorted[j-1] > val)){
+            sorted[j] = sorted[j-1];
+            j--;
+        }
+        sorted[j] = val;
+    }
+    if(this->__count % 2 == 1){
+        return sorted[this->__count / 2];
+    }
+    return (sorted[this->__count / 2 - 1] + sorted[this->__count / 2]) / 2.0;
+}
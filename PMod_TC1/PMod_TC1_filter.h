@@ -0,0 +1,163 @@
+/**
+ * FILENAME :        PMod_TC1_filter.h
+ *
+ * DESCRIPTION :
+ *       PMod_TC1 / MAX31855 frame decoding and digital filtering routines.
+ *
+ *       This file does not depend on MBED OS. It can be compiled
+ *  on a computer to check the decoding and the filters
+ *  with raw frames recorded from the module.
+ *       More informations : https://www.analog.com/media/en/technical-documentation/data-sheets/MAX31855.pdf
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __PMOD_TC1_FILTER_HEADER_H__
+#define __PMOD_TC1_FILTER_HEADER_H__
+
+#include <cstdint>
+
+/** Constant definition */
+/// Fault bits of the MAX31855 frame
+#define     TC1_FAULT_NONE          0x00
+#define     TC1_FAULT_OC            0x01    // Open circuit
+#define     TC1_FAULT_SCG           0x02    // Short-circuit to GND
+#define     TC1_FAULT_SCV           0x04    // Short-circuit to VCC
+#define     TC1_FAULT_MASK          0x07
+/// Bit 16 is set when any of the fault bits is set
+#define     TC1_FAULT_FLAG          0x00010000
+
+/// Maximum number of samples of the moving average and median filters
+#define     TC1_FILTER_MAX_SIZE     16
+
+/**
+ * @struct TC1_Frame
+ * @brief Decoded content of a 32-bit MAX31855 frame
+ */
+struct TC1_Frame{
+    /// Thermocouple temperature (0.25 deg resolution)
+    double      thermo;
+    /// Internal (cold junction) temperature (0.0625 deg resolution)
+    double      internal;
+    /// Fault bits - TC1_FAULT_OC, TC1_FAULT_SCG, TC1_FAULT_SCV
+    uint8_t     faults;
+};
+
+/**
+* @brief Decode a raw 32-bit frame of the MAX31855
+* @details  D31-D18 : 14-bit signed thermocouple temperature
+*           D16     : fault flag
+*           D15-D4  : 12-bit signed internal temperature
+*           D2-D0   : SCV, SCG and OC fault bits
+* @param raw 32-bit raw frame (first received byte in the MSB)
+* @param frame Pointer to the decoded frame
+* @return true if the frame does not report any fault.
+*/
+bool    TC1_decodeFrame(uint32_t raw, TC1_Frame *frame);
+
+/** @enum TC1_FilterMode */
+enum TC1_FilterMode {
+    /// No filtering, last sample is returned
+    TC1_FILTER_NONE = 0,
+    /// Mean of the last N samples
+    TC1_FILTER_MOVING_AVERAGE,
+    /// Median of the last N samples - removes spikes
+    TC1_FILTER_MEDIAN,
+    /// First order IIR filter : y = y + alpha * (x - y)
+    TC1_FILTER_IIR
+};
+
+/**
+ * @class TC1_Filter
+ * @brief Digital filter for temperature samples
+ * @details     Moving average, median or first order IIR filter.
+ *      Samples are stored in a fixed size array
+ *  (TC1_FILTER_MAX_SIZE), no dynamic allocation is done.
+ */
+class TC1_Filter{
+    private:
+        /// Mode of the filter
+        TC1_FilterMode  __mode;
+        /// Number of samples used by the moving average and the median
+        uint8_t     __size;
+        /// Smoothing factor of the IIR filter (0 < alpha <= 1)
+        double      __alpha;
+
+        /// Last samples (circular buffer)
+        double      __samples[TC1_FILTER_MAX_SIZE];
+        /// Index of the next sample to write
+        uint8_t     __index;
+        /// Number of valid samples in the buffer
+        uint8_t     __count;
+        /// Running sum for the moving average
+        double      __sum;
+        /// Last output of the filter
+        double      __output;
+
+        /**
+        * @brief Median of the valid samples.
+        */
+        double  median(void);
+
+    public:
+        /**
+        * @brief Simple constructor of the TC1_Filter class.
+        * @details No filtering by default.
+        */
+        TC1_Filter(void);
+
+        /**
+        * @brief Disable the filter.
+        */
+        void    setNone(void);
+
+        /**
+        * @brief Use a moving average on the last samples.
+        * @param size number of samples, between 1 and TC1_FILTER_MAX_SIZE
+        * @return true if the size is in the good range.
+        */
+        bool    setMovingAverage(uint8_t size);
+
+        /**
+        * @brief Use a median on the last samples.
+        * @param size number of samples, between 1 and TC1_FILTER_MAX_SIZE
+        * @return true if the size is in the good range.
+        */
+        bool    setMedian(uint8_t size);
+
+        /**
+        * @brief Use a first order IIR filter.
+        * @param alpha smoothing factor, between 0 (excluded) and 1
+        * @return true if alpha is in the good range.
+        */
+        bool    setIIR(double alpha);
+
+        /**
+        * @brief Return the mode of the filter.
+        */
+        TC1_FilterMode  getMode(void);
+
+        /**
+        * @brief Clear the samples and the output of the filter.
+        */
+        void    reset(void);
+
+        /**
+        * @brief Add a new sample to the filter.
+        * @param sample new value
+        * @return the new output of the filter.
+        */
+        double  update(double sample);
+
+        /**
+        * @brief Return the last output of the filter.
+        */
+        double  getValue(void);
+};
+
+#endif
@@ -32,12 +32,19 @@ int main()
     printf("\tPmod_TC1 functions test\r\n");
     printf("\tby LEnsE / Villou\r\n");
 
+    // Median filter on the 5 last samples, one frame every conversion
+    module.getFilter()->setMedian(5);
+    module.startSampling();
+
     while (true)
     {
         printf("\tTint = %lf\r\n", module.getInternalTemperature());
         printf("\tTthe = %lf\r\n", module.getThermoTemperature());
         printf("\tTraw = %x\r\n", module.readRawData());
         printf("Tfinal = %lf\r\n", module.readTemperature());
+        if(module.getFaults() != TC1_FAULT_NONE){
+            printf("\tFault = %x\r\n", module.getFaults());
+        }
         thread_sleep_for(WAIT_TIME_MS);
     }
 }
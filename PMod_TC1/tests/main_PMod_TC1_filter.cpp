@@ -0,0 +1,150 @@
+/**
+ * FILENAME :        main_PMod_TC1_filter.cpp
+ *
+ * DESCRIPTION :
+ *       PMod_TC1 / Decoding of MAX31855 frames and digital filters,
+ *  on a computer.
+ *
+ *       This program does not depend on MBED OS :
+ *          g++ -O2 -I. tests/main_PMod_TC1_filter.cpp PMod_TC1_filter.cpp -o tc1_filter
+ *          ./tc1_filter    -> checks, exit code 1 if one fails
+ *
+ *       The raw frames are built from the codes of the tables of the
+ *  datasheet (thermocouple temperature on 14 bits, internal temperature
+ *  on 12 bits, 2's complement) :
+ *          -> positive and negative temperatures of the thermocouple
+ *              and of the cold junction
+ *          -> fault bits : open circuit, short-circuit to GND and to VCC,
+ *              fault flag (D16) without detail
+ *          -> a recorded sequence with a spike, through each mode of
+ *              TC1_Filter (none, moving average, median, IIR)
+ *          -> range of the parameters of the filters
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include    <cstdio>
+#include    <cmath>
+#include    "PMod_TC1_filter.h"
+
+/** Constant definition */
+/// Tolerance of the comparisons of temperatures
+#define     SIM_EPSILON         1e-9
+/// Number of samples of the recorded sequence
+#define     SIM_NB_SAMPLES      6
+
+/**
+ * @brief Raw frame of the MAX31855 - first received byte in the MSB.
+ * @param tc 14-bit code of the thermocouple temperature (D31-D18)
+ * @param internal 12-bit code of the internal temperature (D15-D4)
+ * @param faults SCV, SCG and OC bits (D2-D0) - sets the fault flag (D16)
+ */
+uint32_t simFrame(uint16_t tc, uint16_t internal, uint8_t faults){
+    uint32_t    raw = ((uint32_t)(tc & 0x3FFF) << 18) | ((uint32_t)(internal & 0x0FFF) << 4) | faults;
+    if(faults){ raw |= TC1_FAULT_FLAG; }
+    return raw;
+}
+
+/**
+ * @struct SimDecode
+ * @brief Frame and expected decoded values - codes of the datasheet
+ */
+struct SimDecode{
+    const char  *name;
+    uint32_t    raw;
+    double      thermo;
+    double      internal;
+    uint8_t     faults;
+};
+
+int         sim_failed = 0;
+
+void check(const char *name, bool ok, const char *format, double a, double b){
+    char    values[64];
+    snprintf(values, sizeof(values), format, a, b);
+    printf("%-48s %-28s %s\n", name, values, ok ? "OK" : "FAILED");
+    if(!ok){ sim_failed++; }
+}
+
+/**
+ * @brief Feed the recorded sequence to a filter and compare each output.
+ */
+void checkFilter(const char *name, TC1_Filter &filter, const double *samples, const double *expected){
+    bool    ok = true;
+    double  out = 0;
+    int     k;
+    for(k = 0; (k < SIM_NB_SAMPLES) && ok; k++){
+        out = filter.update(samples[k]);
+        ok = (fabs(out - expected[k]) < SIM_EPSILON) && (filter.getValue() == out);
+    }
+    check(name, ok, "sample %.0f : %.6f", k - 1, out);
+}
+
+int main(void)
+{
+    /* Decoding - codes of the tables of the datasheet */
+    const SimDecode     decode[] = {
+        {"+1600.00 / +127.0000",    simFrame(0x1900, 0x7F0, 0),   1600.00,    127.0,      TC1_FAULT_NONE},
+        {"+1000.00 / +100.5625",    simFrame(0x0FA0, 0x649, 0),   1000.00,    100.5625,   TC1_FAULT_NONE},
+        {"+100.75 / +25.0000",      simFrame(0x0193, 0x190, 0),   100.75,     25.0,       TC1_FAULT_NONE},
+        {"+25.00 / 0.0000",         simFrame(0x0064, 0x000, 0),   25.00,      0.0,        TC1_FAULT_NONE},
+        {"0.00 / -0.0625",          simFrame(0x0000, 0xFFF, 0),   0.00,       -0.0625,    TC1_FAULT_NONE},
+        {"-0.25 / -1.0000",         simFrame(0x3FFF, 0xFF0, 0),   -0.25,      -1.0,       TC1_FAULT_NONE},
+        {"-1.00 / -20.0000",        simFrame(0x3FFC, 0xEC0, 0),   -1.00,      -20.0,      TC1_FAULT_NONE},
+        {"-250.00 / -55.0000",      simFrame(0x3C18, 0xC90, 0),   -250.00,    -55.0,      TC1_FAULT_NONE},
+        {"Open circuit",            simFrame(0x0000, 0x190, TC1_FAULT_OC),  0.00,   25.0,   TC1_FAULT_OC},
+        {"Short-circuit to GND",    simFrame(0x0000, 0x190, TC1_FAULT_SCG), 0.00,   25.0,   TC1_FAULT_SCG},
+        {"Short-circuit to VCC",    simFrame(0x0000, 0x190, TC1_FAULT_SCV), 0.00,   25.0,   TC1_FAULT_SCV},
+        {"Fault flag without detail", simFrame(0x0000, 0x190, 0) | TC1_FAULT_FLAG, 0.00, 25.0, TC1_FAULT_OC}
+    };
+    for(const SimDecode &d : decode){
+        TC1_Frame   frame;
+        char        name[64];
+        bool        valid = TC1_decodeFrame(d.raw, &frame);
+        snprintf(name, sizeof(name), "Decode 0x%08X %s", (unsigned)d.raw, d.name);
+        check(name, (fabs(frame.thermo - d.thermo) < SIM_EPSILON) &&
+                (fabs(frame.internal - d.internal) < SIM_EPSILON) &&
+                (frame.faults == d.faults) && (valid == (d.faults == TC1_FAULT_NONE)),
+                "%.4f, %.4f", frame.thermo, frame.internal);
+    }
+
+    /* Filters - recorded sequence of the thermocouple with a spike */
+    const double    samples[SIM_NB_SAMPLES] = {25.00, 25.25, 25.50, 80.00, 25.75, 26.00};
+    const double    none[SIM_NB_SAMPLES] = {25.00, 25.25, 25.50, 80.00, 25.75, 26.00};
+    const double    average[SIM_NB_SAMPLES] = {25.00, 25.125, 25.25, 38.9375, 39.125, 39.3125};
+    const double    median[SIM_NB_SAMPLES] = {25.00, 25.125, 25.25, 25.50, 25.75, 26.00};
+    const double    iir[SIM_NB_SAMPLES] = {25.00, 25.125, 25.3125, 52.65625, 39.203125, 32.6015625};
+    TC1_Filter      filter;
+
+    checkFilter("No filter", filter, samples, none);
+    filter.setMovingAverage(4);
+    checkFilter("Moving average of 4 samples", filter, samples, average);
+    filter.setMedian(3);
+    checkFilter("Median of 3 samples - spike removed", filter, samples, median);
+    filter.setIIR(0.5);
+    checkFilter("IIR filter, alpha = 0.5", filter, samples, iir);
+
+    /* Negative temperatures - median of an even number of samples */
+    const double    negative[SIM_NB_SAMPLES] = {-250.00, -1.00, -0.25, -20.00, -55.00, -100.00};
+    const double    negative_median[SIM_NB_SAMPLES] = {-250.00, -125.50, -1.00, -10.50, -10.50, -37.50};
+    filter.setMedian(4);
+    checkFilter("Median of 4 samples - negative", filter, negative, negative_median);
+
+    /* Range of the parameters - the mode is not changed */
+    filter.setMovingAverage(2);
+    bool    refused = !filter.setMovingAverage(0) && !filter.setMovingAverage(TC1_FILTER_MAX_SIZE + 1) &&
+                        !filter.setMedian(0) && !filter.setIIR(0) && !filter.setIIR(1.5);
+    check("Parameters out of range : refused, mode", refused && (filter.getMode() == TC1_FILTER_MOVING_AVERAGE),
+            "%.0f, %.0f", refused, filter.getMode());
+    filter.update(10.0);
+    filter.reset();
+    check("Reset : output", filter.getValue() == 0, "%.4f", filter.getValue(), 0);
+
+    printf("%d failed test(s)\n", sim_failed);
+    return sim_failed ? 1 : 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * FILENAME :        SPI_Bus.cpp
+ *
+ * DESCRIPTION :
+ *       SPI_Bus / Shared SPI bus with per-device format and a queue
+ *  of asynchronous block transfers.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "SPI_Bus.h"
+
+/**************************************************************
+ *	Devices
+ **************************************************************/
+
+SPI_Device::SPI_Device(SPI_Bus *bus, PinName cs, int bits, int mode, int frequency) : __cs(cs, 1){
+    this->__bus = bus;
+    this->__bits = bits;
+    this->__mode = mode;
+    this->__frequency = frequency;
+}
+
+void        SPI_Device::setFormat(int bits, int mode, int frequency){
+    CriticalSectionLock lock;
+    this->__bits = bits;
+    this->__mode = mode;
+    this->__frequency = frequency;
+    // applied at the next selection
+    if(this->__bus->__owner == this){ this->__bus->__owner = NULL; }
+}
+
+void        SPI_Device::select(void){
+    this->__bus->acquire(this);
+    this->__cs = 0;
+}
+
+void        SPI_Device::deselect(void){
+    this->__cs = 1;
+    this->__bus->release();
+}
+
+int         SPI_Device::write(int value){
+    return this->__bus->__spi.write(value);
+}
+
+int         SPI_Device::write(const char *tx_data, int tx_length, char *rx_data, int rx_length){
+    return this->__bus->__spi.write(tx_data, tx_length, rx_data, rx_length);
+}
+
+int         SPI_Device::transfer(const char *tx_data, int tx_length, char *rx_data, int rx_length){
+    this->select();
+    int ret = this->write(tx_data, tx_length, rx_data, rx_length);
+    this->deselect();
+    return ret;
+}
+
+SPI_Bus     *SPI_Device::getBus(void){
+    return this->__bus;
+}
+
+/**************************************************************
+ *	Transfers
+ **************************************************************/
+
+SPI_Transfer::SPI_Transfer(void){
+    this->device = NULL;
+    this->tx_data = NULL;
+    this->tx_length = 0;
+    this->rx_data = NULL;
+    this->rx_length = 0;
+    this->context = NULL;
+    this->result = SPI_BUS_OK;
+    this->next = NULL;
+}
+
+void        SPI_Transfer::setData(SPI_Device *device, const char *tx_data, int tx_length, char *rx_data, int rx_length){
+    this->device = device;
+    this->tx_data = tx_data;
+    this->tx_length = tx_length;
+    this->rx_data = rx_data;
+    this->rx_length = rx_length;
+}
+
+bool        SPI_Transfer::isPending(void){
+    return (this->result == SPI_BUS_PENDING);
+}
+
+/**************************************************************
+ *	Bus
+ **************************************************************/
+
+SPI_Bus::SPI_Bus(PinName mosi, PinName miso, PinName sclk) : __spi(mosi, miso, sclk), __access(1){
+    this->__owner = NULL;
+    this->__first = NULL;
+    this->__last = NULL;
+    this->__current = NULL;
+    this->__scheduled = false;
+    this->__reconfig = 0;
+    this->__errors = 0;
+    this->__spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+}
+
+void        SPI_Bus::acquire(SPI_Device *device){
+    this->__access.acquire();
+    this->configure(device);
+}
+
+void        SPI_Bus::release(void){
+    this->__access.release();
+    CriticalSectionLock lock;
+    if((this->__first != NULL) && !this->__scheduled){
+        this->__scheduled = (mbed_event_queue()->call(callback(this, &SPI_Bus::startNext)) != 0);
+    }
+}
+
+void        SPI_Bus::configure(SPI_Device *device){
+    // same device : the peripheral is already programmed
+    if(device == this->__owner){ return; }
+    this->__spi.format(device->__bits, device->__mode);
+    this->__spi.frequency(device->__frequency);
+    this->__owner = device;
+    this->__reconfig++;
+}
+
+bool        SPI_Bus::submit(SPI_Transfer *t){
+    CriticalSectionLock lock;
+    if(t->result == SPI_BUS_PENDING){ return false; }
+    t->result = SPI_BUS_PENDING;
+    t->next = NULL;
+    if(this->__first == NULL){ this->__first = t; }
+    else{ this->__last->next = t; }
+    this->__last = t;
+    if(!this->__scheduled){
+        this->__scheduled = (mbed_event_queue()->call(callback(this, &SPI_Bus::startNext)) != 0);
+    }
+    return true;
+}
+
+int         SPI_Bus::getPending(void){
+    CriticalSectionLock lock;
+    int cnt = 0;
+    for(SPI_Transfer *t = this->__first; t != NULL; t = t->next){
+        cnt++;
+    }
+    return cnt;
+}
+
+uint32_t    SPI_Bus::getReconfigurations(void){
+    return this->__reconfig;
+}
+
+uint32_t    SPI_Bus::getErrors(void){
+    return this->__errors;
+}
+
+void        SPI_Bus::startNext(void){
+    SPI_Transfer    *t;
+    {
+        CriticalSectionLock lock;
+        this->__scheduled = false;
+        if(this->__first == NULL){ return; }
+    }
+    // bus used by a thread : release() schedules startNext again
+    if(!this->__access.try_acquire()){ return; }
+    {
+        CriticalSectionLock lock;
+        t = this->__first;
+        this->__first = t->next;
+        if(this->__first == NULL){ this->__last = NULL; }
+        t->next = NULL;
+    }
+    this->__current = t;
+    this->configure(t->device);
+    t->device->__cs = 0;
+    if(t->start){ t->start(t); }
+    int ret = this->__spi.transfer(t->tx_data, t->tx_length, t->rx_data, t->rx_length,
+            callback(this, &SPI_Bus::ISR_transfer), SPI_EVENT_ALL);
+    if(ret != 0){
+        this->ISR_transfer(SPI_EVENT_ERROR);
+    }
+}
+
+void        SPI_Bus::ISR_transfer(int event){
+    SPI_Transfer    *t = this->__current;
+    this->__current = NULL;
+    t->device->__cs = 1;
+    this->__access.release();
+    mbed_event_queue()->call(callback(this, &SPI_Bus::endTransfer), t, event);
+}
+
+void        SPI_Bus::endTransfer(SPI_Transfer *t, int event){
+    if(event & (SPI_EVENT_ERROR | SPI_EVENT_RX_OVERFLOW)){
+        this->__errors++;
+        t->result = SPI_BUS_ERROR;
+    }
+    else{
+        t->result = SPI_BUS_OK;
+    }
+    // t can be submitted again by its done function
+    Callback<void(SPI_Transfer *t)>  done = t->done;
+    if(done){ done(t); }
+    this->startNext();
+}
@@ -0,0 +1,264 @@
+/**
+ * FILENAME :        SPI_Bus.h
+ *
+ * DESCRIPTION :
+ *       SPI_Bus / Shared SPI bus with per-device format and a queue
+ *  of asynchronous block transfers.
+ *
+ *       The bus owns the SPI peripheral. Each device (display, radio,
+ *  thermocouple...) stores its own format (bits, mode), frequency and
+ *  Chip Select pin. The peripheral is reprogrammed only when the
+ *  selected device is not the previous one : each device runs at its
+ *  own full speed, without corrupting the settings of the others.
+ *
+ *       Two ways to access the bus :
+ *          - blocking : select() / write() / deselect() of a device,
+ *            for short command sequences
+ *          - asynchronous : block transfers (DMA when the target
+ *            supports it) added to a queue with submit()
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __SPI_BUS_HEADER_H__
+#define __SPI_BUS_HEADER_H__
+
+#include <cstdint>
+#include <mbed.h>
+
+/** Constant definition */
+/// Default frequency of a device
+#define     SPI_BUS_FREQ                1000000
+/// Result of a transfer
+#define     SPI_BUS_OK                  0
+#define     SPI_BUS_PENDING             -1
+#define     SPI_BUS_ERROR               -2
+
+class SPI_Bus;
+
+/**
+ * @class SPI_Device
+ * @brief Device on a shared SPI bus - format, frequency and Chip Select
+ */
+class SPI_Device{
+    private:
+        /// Shared bus
+        SPI_Bus     *__bus;
+        /// Chip Select pin - active low
+        DigitalOut  __cs;
+        /// Format of the device
+        int         __bits;
+        int         __mode;
+        int         __frequency;
+
+        friend class SPI_Bus;
+
+    public:
+        /**
+        * @brief Simple constructor of the SPI_Device class.
+        * @param bus shared SPI bus
+        * @param cs Chip Select pin of the device
+        * @param bits number of bits per frame
+        * @param mode clock polarity and phase (0 to 3)
+        * @param frequency clock frequency of the device
+        */
+        SPI_Device(SPI_Bus *bus, PinName cs, int bits = 8, int mode = 0, int frequency = SPI_BUS_FREQ);
+
+        /**
+        * @brief Change the format of the device.
+        * @details Applied at the next selection of the device.
+        * @param bits number of bits per frame
+        * @param mode clock polarity and phase (0 to 3)
+        * @param frequency clock frequency of the device
+        */
+        void        setFormat(int bits, int mode, int frequency);
+
+        /**
+        * @brief Take the bus and select the device - blocking.
+        * @details Wait for the end of the asynchronous transfer in progress,
+        *   then apply the format of the device if it changed.
+        *   Not from an interrupt routine.
+        */
+        void        select(void);
+
+        /**
+        * @brief Deselect the device and release the bus.
+        */
+        void        deselect(void);
+
+        /**
+        * @brief Write a frame and return the received frame.
+        * @details Between select() and deselect().
+        */
+        int         write(int value);
+
+        /**
+        * @brief Write and read a block of data.
+        * @details Between select() and deselect().
+        * @param tx_data data to write - NULL to write 0xFF
+        * @param tx_length number of bytes to write
+        * @param rx_data buffer for the read data - NULL if none
+        * @param rx_length number of bytes to read
+        * @return number of bytes written and read.
+        */
+        int         write(const char *tx_data, int tx_length, char *rx_data, int rx_length);
+
+        /**
+        * @brief Select the device, write and read a block, deselect the device.
+        */
+        int         transfer(const char *tx_data, int tx_length, char *rx_data, int rx_length);
+
+        /**
+        * @brief Return the shared bus of the device.
+        */
+        SPI_Bus     *getBus(void);
+};
+
+/**
+ * @class SPI_Transfer
+ * @brief Asynchronous block transfer - owned by the driver
+ * @details The object and its buffers must remain valid until the end
+ *  of the transfer (usually a member of the driver class).
+ */
+class SPI_Transfer{
+    public:
+        /// Device of the transfer
+        SPI_Device  *device;
+        /// Data to write - NULL to write 0xFF
+        const char  *tx_data;
+        int         tx_length;
+        /// Buffer for the read data - NULL if none
+        char        *rx_data;
+        int         rx_length;
+        /// Function called after the selection, before the transfer (D/C pin...) - thread context
+        Callback<void(SPI_Transfer *t)>     start;
+        /// Function called at the end of the transfer - in the event queue
+        Callback<void(SPI_Transfer *t)>     done;
+        /// Data of the driver, for the start and done functions
+        void        *context;
+        /// Result : SPI_BUS_OK, SPI_BUS_PENDING or SPI_BUS_ERROR
+        volatile int    result;
+        /// Next transfer in the queue
+        SPI_Transfer    *next;
+
+        /**
+        * @brief Simple constructor of the SPI_Transfer class.
+        */
+        SPI_Transfer(void);
+
+        /**
+        * @brief Set the device and the data of the transfer.
+        * @param device device of the transfer
+        * @param tx_data data to write - NULL to write 0xFF
+        * @param tx_length number of bytes to write
+        * @param rx_data buffer for the read data - NULL if none
+        * @param rx_length number of bytes to read
+        */
+        void        setData(SPI_Device *device, const char *tx_data, int tx_length,
+                            char *rx_data = NULL, int rx_length = 0);
+
+        /**
+        * @brief Return true if the transfer is waiting or in progress.
+        */
+        bool        isPending(void);
+};
+
+/**
+ * @class SPI_Bus
+ * @brief Shared SPI bus - arbitration between devices
+ * @details     A semaphore gives the bus to one user at a time : a thread
+ *  between select() and deselect(), or the asynchronous transfer in
+ *  progress. It is released by the end of transfer interrupt, so a
+ *  blocking selection from the event queue can not dead-lock.
+ */
+class SPI_Bus{
+    private:
+        /// SPI interface
+        SPI         __spi;
+        /// Access to the bus
+        Semaphore   __access;
+        /// Device of the last applied format - NULL if none
+        SPI_Device  *__owner;
+        /// First and last transfers of the queue
+        SPI_Transfer    *__first;
+        SPI_Transfer    *__last;
+        /// Transfer in progress - NULL if none
+        SPI_Transfer    *volatile __current;
+        /// True when startNext is waiting in the event queue
+        volatile bool   __scheduled;
+        /// Number of changes of format
+        volatile uint32_t   __reconfig;
+        /// Number of transfers ended with an error
+        volatile uint32_t   __errors;
+
+        friend class SPI_Device;
+
+        /**
+        * @brief Take the bus and apply the format of a device - blocking.
+        */
+        void        acquire(SPI_Device *device);
+
+        /**
+        * @brief Release the bus and start the waiting transfers.
+        */
+        void        release(void);
+
+        /**
+        * @brief Apply the format of a device if it changed.
+        */
+        void        configure(SPI_Device *device);
+
+        /**
+        * @brief Start the first transfer of the queue - in the event queue.
+        */
+        void        startNext(void);
+
+        /**
+        * @brief End of transfer event - from interrupt.
+        */
+        void        ISR_transfer(int event);
+
+        /**
+        * @brief End of a transfer - in the event queue.
+        */
+        void        endTransfer(SPI_Transfer *t, int event);
+
+    public:
+        /**
+        * @brief Simple constructor of the SPI_Bus class.
+        * @param mosi MOSI pin of the bus
+        * @param miso MISO pin of the bus
+        * @param sclk SCLK pin of the bus
+        */
+        SPI_Bus(PinName mosi, PinName miso, PinName sclk);
+
+        /**
+        * @brief Add a block transfer to the queue.
+        * @details Can be called from an interrupt routine.
+        * @param t transfer to add
+        * @return false if the transfer is already in the queue.
+        */
+        bool        submit(SPI_Transfer *t);
+
+        /**
+        * @brief Return the number of transfers waiting in the queue.
+        */
+        int         getPending(void);
+
+        /**
+        * @brief Return the number of changes of format of the peripheral.
+        */
+        uint32_t    getReconfigurations(void);
+
+        /**
+        * @brief Return the number of transfers ended with an error.
+        */
+        uint32_t    getErrors(void);
+};
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * FILENAME :        main_SPI_Bus.cpp
+ *
+ * DESCRIPTION :
+ *       SPI_Bus / Program for testing the shared SPI bus.
+ *
+ *       A ST7735 TFT display (2 MHz, mode 0) and a PMod_TC1 thermocouple
+ *  module (100 kHz, mode 0) share the same SPI bus. The main thread
+ *  draws on the display while the raw frame of the thermocouple is read
+ *  every 100 ms by an asynchronous transfer submitted from a Ticker
+ *  interrupt. The number of changes of format of the peripheral is
+ *  displayed : it is incremented only when the other device takes the bus.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "mbed.h"
+#include "SPI_Bus.h"
+#include "st7735.h"
+#include "PMod_TC1.h"
+
+#define     WAIT_TIME_MS    500
+
+/// Shared bus : Mosi, Miso, Sclk
+SPI_Bus     my_bus(D11, D12, D13);
+/// Devices of the bus : one Chip Select pin per device
+SPI_Device  lcd_dev(&my_bus, D8);
+SPI_Device  tc1_dev(&my_bus, D7);
+
+ST7735      my_lcd(&lcd_dev, D10, D9);
+PMod_TC1    my_tc1(&tc1_dev);
+Ticker      my_tik;
+
+/// Asynchronous reading of the thermocouple
+SPI_Transfer    tc1_transfer;
+char            tc1_data[4];
+volatile int    tc1_raw = 0;
+
+// End of the transfer - in the event queue
+void tc1_done(SPI_Transfer *t){
+    if(t->result == SPI_BUS_OK){
+        tc1_raw = (tc1_data[0] << 24) + (tc1_data[1] << 16) + (tc1_data[2] << 8) + tc1_data[3];
+    }
+}
+
+void ISR_tik(void){
+    // false if the previous transfer is not ended
+    my_bus.submit(&tc1_transfer);
+}
+
+int main()
+{
+    uint16_t    color = ST7735_BLACK;
+    printf("\tSPI_Bus test\r\n");
+    my_lcd.init();
+    my_lcd.clear_screen(ST7735_BLACK);
+
+    tc1_transfer.setData(&tc1_dev, NULL, 0, tc1_data, 4);
+    tc1_transfer.done = callback(&tc1_done);
+    my_tik.attach(&ISR_tik, 100ms);
+
+    while (true)
+    {
+        // blocking accesses of the display, interleaved with the transfers
+        color = ~color;
+        my_lcd.set_window(0, 127, 80, 89);
+        my_lcd.set_color(color, 128 * 10);
+
+        printf("T = %f / Raw = %08X / Reconfigurations = %d / Errors = %d\r\n",
+                my_tc1.readTemperature(), tc1_raw, (int)my_bus.getReconfigurations(),
+                (int)my_bus.getErrors());
+        thread_sleep_for(WAIT_TIME_MS);
+    }
+}
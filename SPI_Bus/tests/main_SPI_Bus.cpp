@@ -0,0 +1,338 @@
+/**
+ * FILENAME :        main_SPI_Bus.cpp
+ *
+ * DESCRIPTION :
+ *       SPI_Bus / Interleaving of the queue and of the blocking selections
+ *  on a computer, with a stand-in of the SPI peripheral (tests/mbed.h).
+ *
+ *       This program does not depend on MBED OS :
+ *          g++ -std=c++14 -O2 -Itests -I. tests/main_SPI_Bus.cpp SPI_Bus.cpp -o spi_bus
+ *          ./spi_bus       -> checks, exit code 1 if one fails
+ *
+ *       Four devices share the bus, with the formats of LCD_EA_DOG
+ *  (mode 3, 100 kHz), nRF24L01P (mode 0, 2 MHz), PMod_TC1 (mode 0,
+ *  100 kHz) and a 16 bits device. Random sequences of asynchronous
+ *  transfers, end of transfer interrupts, calls of the event queue,
+ *  blocking selections (select / write / deselect) and changes of
+ *  format check that :
+ *          -> each frame is sent with one Chip Select and the format of its device
+ *          -> the peripheral is reprogrammed only when the device changes
+ *              (or when the format of the last device changes)
+ *          -> the transfers start in the order of submission, never during
+ *              a blocking selection, and all of them end (no dead-lock)
+ *          -> the result of each transfer and the number of errors
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <vector>
+#include "mbed.h"
+#include "SPI_Bus.h"
+
+/** Constant definition */
+#define SIM_NB_DEVICES      4
+#define SIM_TRANSFERS       2
+#define SIM_NB_STEPS        200000
+#define SIM_RX_LENGTH       4
+
+/* Stand-in of MBED OS */
+int         stub_violations = 0;
+int         stub_pins[STUB_NB_PINS];
+EventQueue  stub_queue;
+
+void stubViolation(const char *what){
+    if(stub_violations < 10){ printf("  stand-in : %s\n", what); }
+    stub_violations++;
+}
+
+EventQueue  *mbed_event_queue(void){
+    return &stub_queue;
+}
+
+/// Pseudo-random sequence - same sequence on each run
+static uint32_t sim_seed = 12345;
+uint32_t simRandom(uint32_t range){
+    sim_seed = sim_seed * 1103515245 + 12345;
+    return (sim_seed >> 8) % range;
+}
+
+/**
+ * @struct SimFormat
+ * @brief Format of a device
+ */
+struct SimFormat{
+    int     bits, mode, frequency;
+};
+
+/**
+ * @class SimBus
+ * @brief Bus, devices and model of the expected behaviour
+ */
+class SimBus{
+    public:
+        SPI_Bus     bus;
+        SPI_Device  *dev[SIM_NB_DEVICES];
+        SimFormat   format[SIM_NB_DEVICES];
+        SPI_Transfer    transfers[SIM_NB_DEVICES * SIM_TRANSFERS];
+        char        tx[SIM_NB_DEVICES * SIM_TRANSFERS][2];
+        char        rx[SIM_NB_DEVICES * SIM_TRANSFERS][SIM_RX_LENGTH];
+        /// Submitted transfers, in the order of submission
+        std::deque<SPI_Transfer *>  queue;
+        /// Event of the end of the transfer in progress
+        int         end_event[SIM_NB_DEVICES * SIM_TRANSFERS];
+        int         nb_done[SIM_NB_DEVICES * SIM_TRANSFERS];
+        /// Last started transfer
+        int         current;
+        /// Device of the last applied format - -1 if none
+        int         last;
+        uint32_t    expected_reconfig;
+        uint32_t    expected_errors;
+        /// Blocking selection in progress
+        bool        thread_selected;
+        size_t      checked_frames;
+        int         errors;
+        /// Statistics
+        uint32_t    nb_started, nb_thread, nb_waiting;
+
+        SimBus(void) : bus(1, 2, 3){
+            const SimFormat f[SIM_NB_DEVICES] = {
+                {8, 3, 100000},     // LCD_EA_DOG
+                {8, 0, 2000000},    // nRF24L01P
+                {8, 0, 100000},     // PMod_TC1
+                {16, 1, 4000000}
+            };
+            for(int d = 0; d < SIM_NB_DEVICES; d++){
+                this->format[d] = f[d];
+                // Chip Select pins : 4 to 7
+                this->dev[d] = new SPI_Device(&this->bus, 4 + d, f[d].bits, f[d].mode, f[d].frequency);
+            }
+            for(int k = 0; k < SIM_NB_DEVICES * SIM_TRANSFERS; k++){
+                SPI_Transfer *t = &this->transfers[k];
+                this->tx[k][0] = (char)(0x10 * (k / SIM_TRANSFERS) + k % SIM_TRANSFERS);
+                this->tx[k][1] = 0;
+                t->setData(this->dev[k / SIM_TRANSFERS], this->tx[k], 2, this->rx[k], SIM_RX_LENGTH);
+                t->context = this;
+                t->start = callback(&SimBus::startCb);
+                t->done = callback(&SimBus::doneCb);
+                this->nb_done[k] = 0;
+            }
+            this->current = -1;
+            this->last = -1;
+            this->expected_reconfig = 0;
+            this->expected_errors = 0;
+            this->thread_selected = false;
+            this->checked_frames = 0;
+            this->errors = 0;
+            this->nb_started = 0;
+            this->nb_thread = 0;
+            this->nb_waiting = 0;
+        }
+
+        SPI     *spi(void){
+            // the peripheral is the first member of SPI_Bus
+            return (SPI *)&this->bus;
+        }
+
+        int     index(SPI_Transfer *t){ return t - this->transfers; }
+        int     device(SPI_Transfer *t){ return this->index(t) / SIM_TRANSFERS; }
+
+        void    error(const char *what, int value){
+            if(this->errors < 10){ printf("  %s (%d)\n", what, value); }
+            this->errors++;
+        }
+
+        /// Selection of a device - reprogramming expected if it changed
+        void    selection(int d){
+            if(d != this->last){ this->expected_reconfig++; }
+            this->last = d;
+        }
+
+        /// After the selection, before the transfer
+        static void startCb(SPI_Transfer *t){
+            SimBus  *sim = (SimBus *)t->context;
+            int     d = sim->device(t);
+            if(sim->thread_selected){ sim->error("transfer started during a blocking selection", d); }
+            if(sim->queue.empty() || (sim->queue.front() != t)){
+                sim->error("transfer started out of order", sim->index(t));
+            }
+            else{ sim->queue.pop_front(); }
+            if(SPI::selected() != 4 + d){ sim->error("Chip Select of the transfer", SPI::selected()); }
+            sim->selection(d);
+            sim->current = sim->index(t);
+            sim->nb_started++;
+        }
+
+        /// End of the transfer - event queue
+        static void doneCb(SPI_Transfer *t){
+            SimBus  *sim = (SimBus *)t->context;
+            int     k = sim->index(t);
+            int     expected = (sim->end_event[k] == SPI_EVENT_COMPLETE) ? SPI_BUS_OK : SPI_BUS_ERROR;
+            sim->nb_done[k]++;
+            if(t->result != expected){ sim->error("result of the transfer", t->result); }
+            if((expected == SPI_BUS_OK) && (t->rx_data[1] != (char)(1 ^ 0x5A))){
+                sim->error("data of the transfer", k);
+            }
+        }
+
+        /// New frames : one Chip Select and the format of the device
+        void    checkFrames(void){
+            std::deque<StubFrame> &frames = this->spi()->frames;
+            for(; this->checked_frames < frames.size(); this->checked_frames++){
+                StubFrame   &f = frames[this->checked_frames];
+                int d = f.cs - 4;
+                if((d < 0) || (d >= SIM_NB_DEVICES)){
+                    this->error("frame without a single Chip Select", f.cs);
+                    continue;
+                }
+                SimFormat   &e = this->format[d];
+                if((f.bits != e.bits) || (f.mode != e.mode) || (f.frequency != e.frequency)){
+                    this->error("frame with the format of another device", d);
+                }
+            }
+        }
+
+        void    submit(void){
+            int     k = simRandom(SIM_NB_DEVICES * SIM_TRANSFERS);
+            SPI_Transfer    *t = &this->transfers[k];
+            bool    pending = t->isPending();
+            if(this->bus.submit(t) == pending){ this->error("submit of a pending transfer", k); }
+            if(!pending){
+                this->queue.push_back(t);
+                if(this->thread_selected || this->spi()->busy){ this->nb_waiting++; }
+            }
+        }
+
+        void    complete(void){
+            SPI *spi = this->spi();
+            if(!spi->busy){ return; }
+            int     event = (simRandom(20) == 0) ? SPI_EVENT_ERROR : SPI_EVENT_COMPLETE;
+            this->end_event[this->current] = event;
+            if(event == SPI_EVENT_ERROR){ this->expected_errors++; }
+            spi->complete(event);
+        }
+
+        /// Blocking selection - the test thread waits for the end of the transfer in progress
+        void    threadSelect(void){
+            int     d = simRandom(SIM_NB_DEVICES);
+            if(this->spi()->busy){ this->complete(); }
+            this->dev[d]->select();
+            this->thread_selected = true;
+            this->selection(d);
+            this->nb_thread++;
+            this->dev[d]->write(0x40 + d);
+            char    buff[3];
+            this->dev[d]->write(NULL, 0, buff, 3);
+            // the event queue runs during the selection
+            for(uint32_t n = simRandom(4); n > 0; n--){
+                if(simRandom(2)){ this->submit(); }
+                stub_queue.dispatch_one();
+            }
+            this->thread_selected = false;
+            this->dev[d]->deselect();
+        }
+
+        void    setFormat(void){
+            int     d = simRandom(SIM_NB_DEVICES);
+            const int   freq[3] = {100000, 1000000, 2000000};
+            SimFormat   f = {(simRandom(2) ? 8 : 16), (int)simRandom(4), freq[simRandom(3)]};
+            // the format of a transfer in progress is not changed
+            if(this->spi()->busy){ return; }
+            this->dev[d]->setFormat(f.bits, f.mode, f.frequency);
+            this->format[d] = f;
+            if(this->last == d){ this->last = -1; }
+        }
+
+        /// End of all the transfers
+        void    drain(void){
+            for(int n = 0; n < 10 * SIM_NB_DEVICES * SIM_TRANSFERS; n++){
+                while(stub_queue.dispatch_one()){}
+                this->complete();
+                this->checkFrames();
+            }
+        }
+
+        bool    run(uint32_t steps){
+            for(uint32_t s = 0; s < steps; s++){
+                uint32_t    a = simRandom(100);
+                if(a < 35){ this->submit(); }
+                else if(a < 65){ stub_queue.dispatch_one(); }
+                else if(a < 90){ this->complete(); }
+                else if(a < 98){ this->threadSelect(); }
+                else{ this->setFormat(); }
+                this->checkFrames();
+            }
+            this->drain();
+            int     nb_pending = 0;
+            for(int k = 0; k < SIM_NB_DEVICES * SIM_TRANSFERS; k++){
+                if(this->transfers[k].isPending()){ nb_pending++; }
+            }
+            uint32_t    nb_done = 0;
+            for(int k = 0; k < SIM_NB_DEVICES * SIM_TRANSFERS; k++){ nb_done += this->nb_done[k]; }
+            if(nb_pending || this->bus.getPending() || !this->queue.empty()){
+                this->error("transfers never ended", nb_pending);
+            }
+            if(nb_done != this->nb_started){ this->error("done calls", nb_done); }
+            if(this->bus.getErrors() != this->expected_errors){ this->error("errors of the bus", this->bus.getErrors()); }
+            if((this->bus.getReconfigurations() != this->expected_reconfig)
+                    || (this->spi()->nb_format != this->expected_reconfig)){
+                this->error("reconfigurations", this->bus.getReconfigurations());
+            }
+            printf("%u transfers (%u submitted behind a selection or a transfer), %u blocking selections\n",
+                    this->nb_started, this->nb_waiting, this->nb_thread);
+            printf("%u reconfigurations (expected %u), %u errors, %u frames\n",
+                    this->bus.getReconfigurations(), this->expected_reconfig,
+                    this->bus.getErrors(), (unsigned)this->spi()->frames.size());
+            return (this->errors == 0) && (stub_violations == 0);
+        }
+};
+
+/**
+ * @brief Transfer submitted during a blocking selection, same device twice.
+ */
+bool basicSequence(void){
+    SimBus  sim;
+    bool    ok = true;
+    // blocking selection of the screen, transfer of the radio submitted during it
+    sim.dev[0]->select();
+    sim.thread_selected = true;
+    sim.selection(0);
+    sim.queue.push_back(&sim.transfers[2]);
+    sim.bus.submit(&sim.transfers[2]);
+    while(stub_queue.dispatch_one()){}
+    ok &= !sim.spi()->busy;
+    sim.thread_selected = false;
+    sim.dev[0]->deselect();
+    while(stub_queue.dispatch_one()){}
+    ok &= sim.spi()->busy;
+    sim.complete();
+    // same device again : no reprogramming
+    sim.queue.push_back(&sim.transfers[3]);
+    sim.bus.submit(&sim.transfers[3]);
+    while(stub_queue.dispatch_one()){}
+    sim.complete();
+    while(stub_queue.dispatch_one()){}
+    sim.checkFrames();
+    ok &= (sim.bus.getReconfigurations() == 2) && (sim.nb_done[2] == 1) && (sim.nb_done[3] == 1);
+    ok &= (sim.errors == 0) && (stub_violations == 0);
+    printf("Transfer during a selection, same device twice : %u reconfigurations  %s\n",
+            sim.bus.getReconfigurations(), ok ? "OK" : "FAILED");
+    return ok;
+}
+
+int main()
+{
+    int     failed = 0;
+    // Chip Select pins not selected
+    for(int p = 0; p < STUB_NB_PINS; p++){ stub_pins[p] = 1; }
+    failed += !basicSequence();
+    SimBus  sim;
+    bool    ok = sim.run(SIM_NB_STEPS);
+    printf("Random interleaving : %d errors  %s\n", sim.errors + stub_violations, ok ? "OK" : "FAILED");
+    failed += !ok;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * FILENAME :        mbed.h
+ *
+ * DESCRIPTION :
+ *       SPI_Bus / Host stand-in of MBED OS for main_SPI_Bus.cpp.
+ *
+ *       Only the parts of MBED OS used by SPI_Bus :
+ *          -> SPI records its format and frequency, and the frames
+ *              written with the selected Chip Select pins
+ *          -> an asynchronous transfer stays in progress until the test
+ *              calls SPI::complete() (end of transfer interrupt)
+ *          -> the shared event queue stores the calls until the test
+ *              calls EventQueue::dispatch_one()
+ *          -> Semaphore counts the tokens - a blocking acquire without
+ *              token is a dead-lock of the single thread of the test
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __MBED_HOST_STUB_H__
+#define __MBED_HOST_STUB_H__
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+
+/** Constant definition */
+#define     SPI_EVENT_ERROR         (1 << 1)
+#define     SPI_EVENT_COMPLETE      (1 << 2)
+#define     SPI_EVENT_RX_OVERFLOW   (1 << 3)
+#define     SPI_EVENT_ALL           (SPI_EVENT_ERROR | SPI_EVENT_COMPLETE | SPI_EVENT_RX_OVERFLOW)
+/// Number of pins of the stand-in
+#define     STUB_NB_PINS            16
+
+typedef int PinName;
+const PinName   NC = 0;
+enum DMAUsage { DMA_USAGE_NEVER, DMA_USAGE_OPPORTUNISTIC };
+
+/// Violation of the rules of the bus - counted by the stand-in
+extern int  stub_violations;
+void stubViolation(const char *what);
+
+/**************************************************************
+ *	Callbacks and event queue
+ **************************************************************/
+
+template <typename F> class Callback;
+
+template <typename R, typename... A>
+class Callback<R(A...)>{
+    public:
+        std::function<R(A...)>  f;
+        Callback(void){}
+        Callback(R (*func)(A...)) : f(func){}
+        template <typename T, typename M>
+        Callback(T *obj, M method){ f = [obj, method](A... a){ return (obj->*method)(a...); }; }
+        R operator()(A... a) const { return f(a...); }
+        explicit operator bool() const { return (bool)f; }
+};
+
+template <typename R, typename... A>
+Callback<R(A...)> callback(R (*func)(A...)){ return Callback<R(A...)>(func); }
+template <typename T, typename R, typename... A>
+Callback<R(A...)> callback(T *obj, R (T::*method)(A...)){ return Callback<R(A...)>(obj, method); }
+
+typedef Callback<void(int)>     event_callback_t;
+
+class EventQueue{
+    public:
+        std::deque<std::function<void()>>   calls;
+        int     id = 0;
+
+        template <typename F, typename... A>
+        int     call(F f, A... a){
+            this->calls.push_back([=](){ f(a...); });
+            return ++this->id;
+        }
+        /// Run the oldest call - false if the queue is empty
+        bool    dispatch_one(void){
+            if(this->calls.empty()){ return false; }
+            std::function<void()> c = this->calls.front();
+            this->calls.pop_front();
+            c();
+            return true;
+        }
+};
+EventQueue  *mbed_event_queue(void);
+
+class CriticalSectionLock{
+    public:
+        CriticalSectionLock(void){}
+        ~CriticalSectionLock(void){}
+};
+
+class Semaphore{
+    public:
+        int     count;
+        Semaphore(int c = 0) : count(c){}
+        void    acquire(void){
+            if(this->count == 0){ stubViolation("Semaphore::acquire without token (dead-lock)"); return; }
+            this->count--;
+        }
+        bool    try_acquire(void){
+            if(this->count == 0){ return false; }
+            this->count--;
+            return true;
+        }
+        void    release(void){ this->count++; }
+};
+
+/**************************************************************
+ *	Pins and SPI
+ **************************************************************/
+
+/// Level of the pins - Chip Select pins are active low
+extern int  stub_pins[STUB_NB_PINS];
+
+class DigitalOut{
+    public:
+        PinName     pin;
+        DigitalOut(PinName p, int value = 0) : pin(p){ this->write(value); }
+        void    write(int value){ stub_pins[this->pin] = value; }
+        int     read(void){ return stub_pins[this->pin]; }
+        DigitalOut &operator=(int value){ this->write(value); return *this; }
+};
+
+/**
+ * @brief Frame on the bus - format and selected pin at the time of the frame
+ */
+struct StubFrame{
+    int     bits, mode, frequency;
+    /// Selected pin - 0 if none, -1 if several
+    int     cs;
+    /// First byte of the data
+    int     data;
+    /// Asynchronous transfer
+    bool    async;
+};
+
+class SPI{
+    public:
+        int     bits, mode, hz;
+        uint32_t    nb_format;
+        /// Asynchronous transfer in progress
+        bool    busy;
+        event_callback_t    cb;
+        char    *rx;
+        int     rx_length;
+        std::deque<StubFrame>   frames;
+
+        SPI(PinName mosi, PinName miso, PinName sclk){
+            this->bits = 8; this->mode = 0; this->hz = 1000000;
+            this->nb_format = 0; this->busy = false; this->rx = NULL; this->rx_length = 0;
+        }
+        void    set_dma_usage(DMAUsage d){}
+        void    format(int b, int m){ this->bits = b; this->mode = m; this->nb_format++; }
+        void    frequency(int f){ this->hz = f; }
+        int     write(int value){
+            this->record(value, false);
+            return value ^ 0xFF;
+        }
+        int     write(const char *tx, int tx_length, char *rx, int rx_length){
+            this->record((tx && tx_length) ? (uint8_t)tx[0] : 0xFF, false);
+            for(int k = 0; k < rx_length; k++){ rx[k] = (char)(k ^ 0x5A); }
+            return (tx_length > rx_length) ? tx_length : rx_length;
+        }
+        int     transfer(const char *tx, int tx_length, char *rx, int rx_length,
+                        const event_callback_t &cb, int event){
+            this->record((tx && tx_length) ? (uint8_t)tx[0] : 0xFF, true);
+            this->busy = true;
+            this->cb = cb;
+            this->rx = rx;
+            this->rx_length = rx_length;
+            return 0;
+        }
+        /// End of the asynchronous transfer - interrupt
+        void    complete(int event){
+            for(int k = 0; k < this->rx_length; k++){ this->rx[k] = (char)(k ^ 0x5A); }
+            this->busy = false;
+            this->cb(event);
+        }
+        /// Selected Chip Select pin
+        static int  selected(void){
+            int cs = 0;
+            for(int p = 1; p < STUB_NB_PINS; p++){
+                if(stub_pins[p] == 0){ cs = (cs == 0) ? p : -1; }
+            }
+            return cs;
+        }
+        void    record(int data, bool async){
+            if(this->busy){ stubViolation("SPI used during an asynchronous transfer"); }
+            StubFrame f = {this->bits, this->mode, this->hz, SPI::selected(), data, async};
+            this->frames.push_back(f);
+        }
+};
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * FILENAME :        TMC2100_Motion.cpp
+ *
+ * DESCRIPTION :
+ *       TMC2100_Motion / Step Motor motion engine with acceleration ramps.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://learn.watterott.com/silentstepstick/pinconfig/tmc2100/
+ */
+
+#include "TMC2100_Motion.h"
+
+TMC2100_Motion::TMC2100_Motion(DigitalOut *en, DigitalOut *dir, DigitalOut *step){
+    this->__position = 0;
+    this->__target = 0;
+    this->__dir_sign = 1;
+    this->__moving = false;
+    this->__dir_forward = true;
+    /* Initialisation of enable output - disabled */
+    this->__en = en;
+    this->__en->write(1);
+    /* Initialisation of direction output */
+    this->__dir = dir;
+    this->__dir->write(0);
+    /* Initialisation of step output */
+    this->__step = step;
+    this->__step->write(0);
+}
+
+void TMC2100_Motion::enable(void){
+    this->__en->write(0);
+}
+
+void TMC2100_Motion::disable(void){
+    this->emergencyStop();
+    this->__en->write(1);
+}
+
+void TMC2100_Motion::setProfile(TMC2100_ProfileType type){
+    this->__profile.setType(type);
+}
+
+bool TMC2100_Motion::setMaxSpeed(float stepsPerSeconds){
+    return this->__profile.setMaxSpeed(stepsPerSeconds);
+}
+
+bool TMC2100_Motion::setAcceleration(float stepsPerSeconds2){
+    return this->__profile.setAcceleration(stepsPerSeconds2);
+}
+
+void TMC2100_Motion::setDirection(bool forward){
+    this->__dir_forward = forward;
+}
+
+/**************************************************************
+ *	Moves
+ **************************************************************/
+
+bool TMC2100_Motion::moveTo(int32_t position){
+    if(this->__moving){ return false; }
+    int32_t delta = position - this->__position;
+    this->__target = position;
+    if(delta == 0){ return true; }
+
+    this->__dir_sign = (delta > 0) ? 1 : -1;
+    this->__dir->write((delta > 0) == this->__dir_forward);
+    this->__profile.plan((delta > 0) ? delta : -delta);
+
+    uint32_t interval = this->__profile.nextInterval();
+    // first step is relative to now, the next ones to the previous step
+    this->__next_step = TickerDataClock::time_point(
+            std::chrono::microseconds(ticker_read_us(get_us_ticker_data()) + interval));
+    this->__moving = true;
+    this->__step_tim.attach_absolute(callback(this, &TMC2100_Motion::ISR_step), this->__next_step);
+    return true;
+}
+
+bool TMC2100_Motion::move(int32_t steps){
+    return this->moveTo(this->__position + steps);
+}
+
+void TMC2100_Motion::stop(void){
+    CriticalSectionLock lock;
+    if(!this->__moving){ return; }
+    this->__profile.requestStop();
+    this->__target = this->__position + this->__dir_sign * (int32_t)this->__profile.getStepsToGo();
+}
+
+void TMC2100_Motion::emergencyStop(void){
+    this->__step_tim.detach();
+    CriticalSectionLock lock;
+    this->__profile.abort();
+    this->__step->write(0);
+    this->__moving = false;
+    this->__target = this->__position;
+}
+
+void TMC2100_Motion::ISR_step(void){
+    this->__step->write(1);
+    this->__position += this->__dir_sign;
+    uint32_t interval = this->__profile.nextInterval();
+    this->__step->write(0);
+    if(interval == 0){
+        this->__moving = false;
+        return;
+    }
+    this->__next_step += std::chrono::microseconds(interval);
+    this->__step_tim.attach_absolute(callback(this, &TMC2100_Motion::ISR_step), this->__next_step);
+}
+
+/**************************************************************
+ *	State of the motor
+ **************************************************************/
+
+int32_t TMC2100_Motion::getPosition(void){
+    return this->__position;
+}
+
+void TMC2100_Motion::setPosition(int32_t position){
+    if(this->__moving){ return; }
+    this->__position = position;
+    this->__target = position;
+}
+
+int32_t TMC2100_Motion::getTarget(void){
+    return this->__target;
+}
+
+bool TMC2100_Motion::isMoving(void){
+    return this->__moving;
+}
+
+float TMC2100_Motion::getSpeed(void){
+    if(!this->__moving){ return 0; }
+    return this->__dir_sign * this->__profile.getSpeed();
+}
+
+void TMC2100_Motion::waitEndOfMove(void){
+    while(this->__moving){
+        thread_sleep_for(1);
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * FILENAME :        TMC2100_Motion.h
+ *
+ * DESCRIPTION :
+ *       TMC2100_Motion / Step Motor motion engine with acceleration ramps.
+ *
+ *       Steps are generated by a timer interrupt. Each move has
+ *  an exact number of steps and follows a trapezoidal
+ *  or a S-curve speed profile (see TMC2100_Profile).
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://learn.watterott.com/silentstepstick/pinconfig/tmc2100/
+ */
+
+#ifndef __TMC2100_MOTION_HEADER_H__
+#define __TMC2100_MOTION_HEADER_H__
+
+#include <cstdint>
+#include <mbed.h>
+#include "TMC2100_Profile.h"
+
+/**
+ * @class TMC2100_Motion
+ * @brief Control the position of a step motor with a TMC2100 module
+ * @details     The STEP pin is a DigitalOut driven by a Timeout :
+ *  the next step is scheduled at an absolute time, so the latency
+ *  of the interrupt does not accumulate along the move.
+ *      The STEP pulse lasts the computation of the next interval
+ *  (a few us), longer than the 100 ns required by the TMC2100.
+ */
+class TMC2100_Motion{
+    private:
+        /// interface to TMC2100 pins
+        DigitalOut  *__en;
+        DigitalOut  *__dir;
+        DigitalOut  *__step;
+
+        /// Speed profile of the moves
+        TMC2100_Profile     __profile;
+        /// Timer of the steps
+        Timeout     __step_tim;
+        /// Time of the next step
+        TickerDataClock::time_point     __next_step;
+
+        /// Position of the motor in steps
+        volatile int32_t    __position;
+        /// Target of the current move in steps
+        int32_t     __target;
+        /// Direction of the current move : +1 or -1
+        int8_t      __dir_sign;
+        /// A move is running
+        volatile bool       __moving;
+        /// Direction pin level for positive moves
+        bool        __dir_forward;
+
+        /**
+        * @brief Interrupt routine of the step engine.
+        */
+        void ISR_step(void);
+
+    public:
+        /**
+        * @brief Simple constructor of the TMC2100_Motion class.
+        * @details Create a TMC2100_Motion object with
+        *    an enable pin (Digital)
+        *    a direction pin (Digital)
+        *    a step pin (Digital)
+        *   The motor is disabled, at position 0.
+        * @param en enable pin of the TMC2100 module
+        * @param dir direction pin of the TMC2100 module
+        * @param step step pin of the TMC2100 module
+        */
+        TMC2100_Motion(DigitalOut *en, DigitalOut *dir, DigitalOut *step);
+
+        /**
+        * @brief Enable the TMC2100 outputs.
+        */
+        void enable(void);
+
+        /**
+        * @brief Disable the TMC2100 outputs - the motor is free.
+        */
+        void disable(void);
+
+        /**
+        * @brief Set the type of the speed profile - for the next moves.
+        * @param type TMC2100_TRAPEZOIDAL or TMC2100_S_CURVE
+        */
+        void setProfile(TMC2100_ProfileType type);
+
+        /**
+        * @brief Set the maximum speed - for the next moves.
+        * @param stepsPerSeconds speed in steps per second
+        * @return false if the speed is not positive.
+        */
+        bool setMaxSpeed(float stepsPerSeconds);
+
+        /**
+        * @brief Set the acceleration - for the next moves.
+        * @param stepsPerSeconds2 acceleration in steps per second^2
+        * @return false if the acceleration is not positive.
+        */
+        bool setAcceleration(float stepsPerSeconds2);
+
+        /**
+        * @brief Invert the direction pin.
+        * @param forward level of the direction pin for positive moves - default 1
+        */
+        void setDirection(bool forward);
+
+        /**
+        * @brief Move to an absolute position.
+        * @param position target position in steps
+        * @return false if a move is already running.
+        */
+        bool moveTo(int32_t position);
+
+        /**
+        * @brief Move of a relative number of steps.
+        * @param steps number of steps, negative to go backward
+        * @return false if a move is already running.
+        */
+        bool move(int32_t steps);
+
+        /**
+        * @brief Stop the current move with the deceleration ramp.
+        */
+        void stop(void);
+
+        /**
+        * @brief Stop the current move immediately (no ramp).
+        */
+        void emergencyStop(void);
+
+        /**
+        * @brief Return the position of the motor in steps.
+        */
+        int32_t getPosition(void);
+
+        /**
+        * @brief Set the position of the motor (when stopped).
+        * @param position new position in steps
+        */
+        void setPosition(int32_t position);
+
+        /**
+        * @brief Return the target of the current move in steps.
+        */
+        int32_t getTarget(void);
+
+        /**
+        * @brief Return true if a move is running.
+        */
+        bool isMoving(void);
+
+        /**
+        * @brief Return the current speed in steps per second (signed).
+        */
+        float getSpeed(void);
+
+        /**
+        * @brief Block until the current move is finished.
+        */
+        void waitEndOfMove(void);
+};
+
+#endif
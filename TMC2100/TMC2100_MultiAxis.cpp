@@ -0,0 +1,195 @@
+/**
+ * FILENAME :        TMC2100_MultiAxis.cpp
+ *
+ * DESCRIPTION :
+ *       TMC2100_MultiAxis / Coordinated moves of several TMC2100 axes.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://learn.watterott.com/silentstepstick/pinconfig/tmc2100/
+ */
+
+#include "TMC2100_MultiAxis.h"
+
+TMC2100_MultiAxis::TMC2100_MultiAxis(uint8_t nb_axes, DigitalOut *en[], DigitalOut *dir[], DigitalOut *step[])
+        : __planner(nb_axes){
+    this->__nb_axes = this->__planner.getNbAxes();
+    this->__block = NULL;
+    this->__event = 0;
+    this->__moving = false;
+    for(int i = 0; i < this->__nb_axes; i++){
+        /* Initialisation of enable output - disabled */
+        this->__en[i] = en[i];
+        this->__en[i]->write(1);
+        /* Initialisation of direction output */
+        this->__dir[i] = dir[i];
+        this->__dir[i]->write(0);
+        /* Initialisation of step output */
+        this->__step[i] = step[i];
+        this->__step[i]->write(0);
+        this->__dir_forward[i] = true;
+        this->__counter[i] = 0;
+        this->__position[i] = 0;
+    }
+}
+
+void        TMC2100_MultiAxis::enable(void){
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__en[i]->write(0);
+    }
+}
+
+void        TMC2100_MultiAxis::disable(void){
+    this->emergencyStop();
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__en[i]->write(1);
+    }
+}
+
+bool        TMC2100_MultiAxis::setAcceleration(float stepsPerSeconds2){
+    CriticalSectionLock lock;
+    return this->__planner.setAcceleration(stepsPerSeconds2);
+}
+
+void        TMC2100_MultiAxis::setJunctionDeviation(float steps){
+    CriticalSectionLock lock;
+    this->__planner.setJunctionDeviation(steps);
+}
+
+void        TMC2100_MultiAxis::setDirection(uint8_t axis, bool forward){
+    if(axis >= this->__nb_axes){ return; }
+    this->__dir_forward[axis] = forward;
+}
+
+/**************************************************************
+ *	Moves
+ **************************************************************/
+
+bool        TMC2100_MultiAxis::line(const int32_t target[], float stepsPerSeconds){
+    if(!this->__planner.prepareLine(target, stepsPerSeconds)){
+        // a null move is not an error
+        return (stepsPerSeconds > 0) && !this->__planner.isFull();
+    }
+    while(true){
+        // lookahead outside of the critical section - the step engine keeps running
+        this->__planner.recalculate();
+        CriticalSectionLock lock;
+        if(!this->__planner.commitLine()){
+            // a block was taken or released by the step engine during the lookahead
+            continue;
+        }
+        if(this->__moving){ return true; }
+        this->startBlock();
+        // first step event is relative to now, the next ones to the previous event
+        this->__next_step = TickerDataClock::time_point(
+                std::chrono::microseconds(ticker_read_us(get_us_ticker_data()) + this->nextInterval()));
+        this->__moving = true;
+        this->__step_tim.attach_absolute(callback(this, &TMC2100_MultiAxis::ISR_step), this->__next_step);
+        return true;
+    }
+}
+
+void        TMC2100_MultiAxis::emergencyStop(void){
+    this->__step_tim.detach();
+    CriticalSectionLock lock;
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__step[i]->write(0);
+    }
+    while(!this->__planner.isEmpty()){
+        this->__planner.discardCurrentBlock();
+    }
+    this->__block = NULL;
+    this->__moving = false;
+    // the queue restarts from the real position of the motors
+    int32_t position[TMC2100_MAX_AXES];
+    this->getPosition(position);
+    this->__planner.setPosition(position);
+}
+
+bool        TMC2100_MultiAxis::startBlock(void){
+    this->__block = this->__planner.getCurrentBlock();
+    if(this->__block == NULL){ return false; }
+    this->__event = 0;
+    for(int i = 0; i < this->__nb_axes; i++){
+        bool backward = (this->__block->dir_bits >> i) & 1;
+        this->__dir[i]->write(backward != this->__dir_forward[i]);
+        this->__counter[i] = -(int32_t)(this->__block->step_event_count >> 1);
+    }
+    return true;
+}
+
+uint32_t    TMC2100_MultiAxis::nextInterval(void){
+    return TMC2100_Planner::eventInterval(this->__block, this->__event);
+}
+
+void        TMC2100_MultiAxis::ISR_step(void){
+    TMC2100_Block *b = this->__block;
+    if(b == NULL){
+        this->__moving = false;
+        return;
+    }
+    /* Bresenham distribution of the steps */
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__counter[i] += b->steps[i];
+        if(this->__counter[i] > 0){
+            this->__counter[i] -= b->step_event_count;
+            this->__step[i]->write(1);
+            this->__position[i] += ((b->dir_bits >> i) & 1) ? -1 : 1;
+        }
+    }
+    this->__event++;
+    bool next = true;
+    if(this->__event >= b->step_event_count){
+        this->__planner.discardCurrentBlock();
+        next = this->startBlock();
+    }
+    uint32_t interval = next ? this->nextInterval() : 0;
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__step[i]->write(0);
+    }
+    if(!next){
+        this->__moving = false;
+        return;
+    }
+    this->__next_step += std::chrono::microseconds(interval);
+    this->__step_tim.attach_absolute(callback(this, &TMC2100_MultiAxis::ISR_step), this->__next_step);
+}
+
+/**************************************************************
+ *	State of the motors
+ **************************************************************/
+
+void        TMC2100_MultiAxis::getPosition(int32_t position[]){
+    CriticalSectionLock lock;
+    for(int i = 0; i < this->__nb_axes; i++){
+        position[i] = this->__position[i];
+    }
+}
+
+void        TMC2100_MultiAxis::setPosition(const int32_t position[]){
+    CriticalSectionLock lock;
+    if(this->__moving){ return; }
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__position[i] = position[i];
+    }
+    this->__planner.setPosition(position);
+}
+
+bool        TMC2100_MultiAxis::isMoving(void){
+    return this->__moving;
+}
+
+bool        TMC2100_MultiAxis::isFull(void){
+    CriticalSectionLock lock;
+    return this->__planner.isFull();
+}
+
+void        TMC2100_MultiAxis::waitEndOfMoves(void){
+    while(this->__moving){
+        thread_sleep_for(1);
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * FILENAME :        TMC2100_MultiAxis.h
+ *
+ * DESCRIPTION :
+ *       TMC2100_MultiAxis / Coordinated moves of several TMC2100 axes.
+ *
+ *       Linear moves are queued in a TMC2100_Planner. A single timer
+ *  interrupt executes the blocks of the planner : the steps of all
+ *  the axes are distributed with the Bresenham algorithm, so all
+ *  the axes start and stop together.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://learn.watterott.com/silentstepstick/pinconfig/tmc2100/
+ */
+
+#ifndef __TMC2100_MULTIAXIS_HEADER_H__
+#define __TMC2100_MULTIAXIS_HEADER_H__
+
+#include <cstdint>
+#include <mbed.h>
+#include "TMC2100_Profile.h"
+#include "TMC2100_Planner.h"
+
+/**
+ * @class TMC2100_MultiAxis
+ * @brief Control up to TMC2100_MAX_AXES step motors on coordinated paths
+ * @details     One step event per step of the dominant axis of a block.
+ *  Its rate follows the trapezoid computed by the planner. Like
+ *  TMC2100_Motion, the next event is scheduled at an absolute time.
+ *      The lookahead runs outside of the critical section when a move
+ *  is added : only the copy of the profiles and the new block in the
+ *  queue block the step engine. Add moves from the main thread, not
+ *  from an interrupt.
+ */
+class TMC2100_MultiAxis{
+    private:
+        /// Number of axes
+        uint8_t     __nb_axes;
+        /// interface to TMC2100 pins of each axis
+        DigitalOut  *__en[TMC2100_MAX_AXES];
+        DigitalOut  *__dir[TMC2100_MAX_AXES];
+        DigitalOut  *__step[TMC2100_MAX_AXES];
+        /// Direction pin level for positive moves of each axis
+        bool        __dir_forward[TMC2100_MAX_AXES];
+
+        /// Queue of moves
+        TMC2100_Planner     __planner;
+        /// Timer of the step events
+        Timeout     __step_tim;
+        /// Time of the next step event
+        TickerDataClock::time_point     __next_step;
+
+        /// Block under execution, NULL if stopped
+        TMC2100_Block   *__block;
+        /// Step events already done in the current block
+        uint32_t    __event;
+        /// Bresenham counters of each axis
+        int32_t     __counter[TMC2100_MAX_AXES];
+        /// Position of each motor in steps
+        volatile int32_t    __position[TMC2100_MAX_AXES];
+        /// Moves are running
+        volatile bool       __moving;
+
+        /**
+        * @brief Take the next block of the planner and set the directions.
+        * @return false if the queue is empty.
+        */
+        bool        startBlock(void);
+
+        /**
+        * @brief Interval before the next step event of the current block, in us.
+        */
+        uint32_t    nextInterval(void);
+
+        /**
+        * @brief Interrupt routine of the step engine.
+        */
+        void        ISR_step(void);
+
+    public:
+        /**
+        * @brief Simple constructor of the TMC2100_MultiAxis class.
+        * @details Create a TMC2100_MultiAxis object with, for each axis,
+        *    an enable pin (Digital)
+        *    a direction pin (Digital)
+        *    a step pin (Digital)
+        *   The motors are disabled, at position 0.
+        * @param nb_axes number of axes - up to TMC2100_MAX_AXES
+        * @param en array of enable pins of the TMC2100 modules
+        * @param dir array of direction pins of the TMC2100 modules
+        * @param step array of step pins of the TMC2100 modules
+        */
+        TMC2100_MultiAxis(uint8_t nb_axes, DigitalOut *en[], DigitalOut *dir[], DigitalOut *step[]);
+
+        /**
+        * @brief Enable the TMC2100 outputs of all the axes.
+        */
+        void        enable(void);
+
+        /**
+        * @brief Disable the TMC2100 outputs - the motors are free.
+        */
+        void        disable(void);
+
+        /**
+        * @brief Set the acceleration along the path - for the next moves.
+        * @param stepsPerSeconds2 acceleration in steps per second^2
+        * @return false if the acceleration is not positive.
+        */
+        bool        setAcceleration(float stepsPerSeconds2);
+
+        /**
+        * @brief Set the junction deviation - for the next moves.
+        * @param steps junction deviation in steps, 0 to stop at each corner
+        */
+        void        setJunctionDeviation(float steps);
+
+        /**
+        * @brief Invert the direction pin of an axis.
+        * @param axis index of the axis
+        * @param forward level of the direction pin for positive moves - default 1
+        */
+        void        setDirection(uint8_t axis, bool forward);
+
+        /**
+        * @brief Add a linear move to an absolute position.
+        * @details  The move starts immediately if the motors are stopped.
+        * @param target target position of each axis in steps
+        * @param stepsPerSeconds speed along the path in steps per second
+        * @return false if the queue is full or if the speed is not positive.
+        */
+        bool        line(const int32_t target[], float stepsPerSeconds);
+
+        /**
+        * @brief Stop immediately and clear the queue (no ramp).
+        */
+        void        emergencyStop(void);
+
+        /**
+        * @brief Return the position of each motor in steps.
+        * @param position array of the position of each axis
+        */
+        void        getPosition(int32_t position[]);
+
+        /**
+        * @brief Set the position of each motor (when stopped).
+        * @param position array of the position of each axis
+        */
+        void        setPosition(const int32_t position[]);
+
+        /**
+        * @brief Return true if moves are running.
+        */
+        bool        isMoving(void);
+
+        /**
+        * @brief Return true if the queue can not accept a new move.
+        */
+        bool        isFull(void);
+
+        /**
+        * @brief Block until all the queued moves are finished.
+        */
+        void        waitEndOfMoves(void);
+};
+
+#endif
@@ -0,0 +1,294 @@
+/**
+ * FILENAME :        TMC2100_Planner.cpp
+ *
+ * DESCRIPTION :
+ *       TMC2100_Planner / Coordinated multi-axis motion planner.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://github.com/grbl/grbl/blob/master/grbl/planner.c
+ */
+
+#include "TMC2100_Planner.h"
+#include <cmath>
+
+TMC2100_Planner::TMC2100_Planner(uint8_t nb_axes){
+    if(nb_axes > TMC2100_MAX_AXES){ nb_axes = TMC2100_MAX_AXES; }
+    this->__nb_axes = nb_axes;
+    this->__head = 0;
+    this->__tail = 0;
+    this->__tail_busy = false;
+    this->__plan_first = 0;
+    this->__plan_busy = false;
+    this->__prepared = false;
+    this->__accel = 1000;
+    this->__junction_deviation = 2.0f;
+    this->__prev_nominal = 0;
+    for(int i = 0; i < TMC2100_MAX_AXES; i++){
+        this->__position[i] = 0;
+        this->__prev_unit[i] = 0;
+    }
+}
+
+uint8_t     TMC2100_Planner::getNbAxes(void){
+    return this->__nb_axes;
+}
+
+bool        TMC2100_Planner::setAcceleration(float steps_per_s2){
+    if(steps_per_s2 <= 0){ return false; }
+    this->__accel = steps_per_s2;
+    return true;
+}
+
+void        TMC2100_Planner::setJunctionDeviation(float steps){
+    this->__junction_deviation = (steps < 0) ? 0 : steps;
+}
+
+uint8_t     TMC2100_Planner::nextIndex(uint8_t index){
+    return (index + 1) % TMC2100_PLANNER_SIZE;
+}
+
+uint8_t     TMC2100_Planner::prevIndex(uint8_t index){
+    return (index + TMC2100_PLANNER_SIZE - 1) % TMC2100_PLANNER_SIZE;
+}
+
+/**************************************************************
+ *	Queue of blocks
+ **************************************************************/
+
+bool        TMC2100_Planner::bufferLine(const int32_t target[], float speed){
+    if(!this->prepareLine(target, speed)){ return false; }
+    this->recalculate();
+    return this->commitLine();
+}
+
+bool        TMC2100_Planner::prepareLine(const int32_t target[], float speed){
+    this->__prepared = false;
+    if(this->isFull() || (speed <= 0)){ return false; }
+    TMC2100_Block *block = &(this->__blocks[this->__head]);
+    float   delta[TMC2100_MAX_AXES];
+    float   length2 = 0;
+
+    /* Steps of each axis - Bresenham distribution is done by the step generator */
+    block->dir_bits = 0;
+    block->step_event_count = 0;
+    for(int i = 0; i < TMC2100_MAX_AXES; i++){
+        int32_t d = (i < this->__nb_axes) ? target[i] - this->__position[i] : 0;
+        if(d < 0){ block->dir_bits |= (1 << i); }
+        block->steps[i] = (d < 0) ? -d : d;
+        if(block->steps[i] > block->step_event_count){
+            block->step_event_count = block->steps[i];
+        }
+        delta[i] = (float)d;
+        length2 += delta[i] * delta[i];
+    }
+    if(block->step_event_count == 0){ return false; }
+    block->length = sqrtf(length2);
+    block->nominal_speed = speed;
+
+    /* Junction speed with the previous block */
+    float   unit[TMC2100_MAX_AXES];
+    float   cos_theta = 0;
+    for(int i = 0; i < TMC2100_MAX_AXES; i++){
+        unit[i] = delta[i] / block->length;
+        // angle between the reversed previous direction and the new direction
+        cos_theta -= this->__prev_unit[i] * unit[i];
+    }
+    if(this->isEmpty()){
+        // start from standstill
+        block->max_entry_speed = 0;
+    }
+    else if(cos_theta > 0.999999f){
+        // reversal of the direction
+        block->max_entry_speed = 0;
+    }
+    else if(cos_theta < -0.999999f){
+        // straight line
+        block->max_entry_speed = fminf(speed, this->__prev_nominal);
+    }
+    else{
+        float sin_theta_d2 = sqrtf(0.5f * (1.0f - cos_theta));
+        float v2 = this->__accel * this->__junction_deviation * sin_theta_d2 / (1.0f - sin_theta_d2);
+        block->max_entry_speed = fminf(sqrtf(v2), fminf(speed, this->__prev_nominal));
+    }
+    block->entry_speed = block->max_entry_speed;
+    block->exit_speed = 0;
+
+    /* Constant part of the trapezoid */
+    float   rate_factor = block->step_event_count / block->length;
+    block->nominal_rate = speed * rate_factor;
+    block->accel_rate = this->__accel * rate_factor;
+
+    /* End of the block - previous block for the next junction after commitLine */
+    for(int i = 0; i < TMC2100_MAX_AXES; i++){
+        this->__next_position[i] = (i < this->__nb_axes) ? target[i] : 0;
+        this->__next_unit[i] = unit[i];
+    }
+    this->__prepared = true;
+    return true;
+}
+
+bool        TMC2100_Planner::commitLine(void){
+    if(!this->__prepared){ return false; }
+    // same state of the queue as during the lookahead
+    uint8_t first = this->__tail_busy ? this->nextIndex(this->__tail) : this->__tail;
+    if((first != this->__plan_first) || (this->__tail_busy != this->__plan_busy)){ return false; }
+
+    /* Copy of the profiles - the block under execution is not in the plan */
+    uint8_t head = this->nextIndex(this->__head);
+    for(uint8_t i = first; i != head; i = this->nextIndex(i)){
+        TMC2100_Block       *b = &(this->__blocks[i]);
+        TMC2100_Trapezoid   *t = &(this->__plan[i]);
+        b->entry_speed = t->entry_speed;
+        b->exit_speed = t->exit_speed;
+        b->entry_rate = t->entry_rate;
+        b->exit_rate = t->exit_rate;
+        b->accelerate_until = t->accelerate_until;
+        b->decelerate_after = t->decelerate_after;
+    }
+    for(int i = 0; i < TMC2100_MAX_AXES; i++){
+        if(i < this->__nb_axes){ this->__position[i] = this->__next_position[i]; }
+        this->__prev_unit[i] = this->__next_unit[i];
+    }
+    this->__prev_nominal = this->__blocks[this->__head].nominal_speed;
+    this->__head = head;
+    this->__prepared = false;
+    return true;
+}
+
+TMC2100_Block   *TMC2100_Planner::getCurrentBlock(void){
+    if(this->isEmpty()){ return NULL; }
+    this->__tail_busy = true;
+    return &(this->__blocks[this->__tail]);
+}
+
+void        TMC2100_Planner::discardCurrentBlock(void){
+    if(this->isEmpty()){ return; }
+    this->__tail_busy = false;
+    this->__tail = this->nextIndex(this->__tail);
+}
+
+bool        TMC2100_Planner::isFull(void){
+    return (this->nextIndex(this->__head) == this->__tail);
+}
+
+bool        TMC2100_Planner::isEmpty(void){
+    return (this->__head == this->__tail);
+}
+
+uint8_t     TMC2100_Planner::getNbBlocks(void){
+    return (this->__head + TMC2100_PLANNER_SIZE - this->__tail) % TMC2100_PLANNER_SIZE;
+}
+
+void        TMC2100_Planner::getPosition(int32_t position[]){
+    for(int i = 0; i < this->__nb_axes; i++){
+        position[i] = this->__position[i];
+    }
+}
+
+void        TMC2100_Planner::setPosition(const int32_t position[]){
+    if(!this->isEmpty()){ return; }
+    for(int i = 0; i < this->__nb_axes; i++){
+        this->__position[i] = position[i];
+    }
+}
+
+/**************************************************************
+ *	Lookahead
+ **************************************************************/
+
+void        TMC2100_Planner::recalculate(void){
+    if(!this->__prepared){ return; }
+    // state of the queue - the block under execution can not be modified
+    bool    busy = this->__tail_busy;
+    uint8_t tail = this->__tail;
+    uint8_t first = busy ? this->nextIndex(tail) : tail;
+    this->__plan_first = first;
+    this->__plan_busy = busy;
+    // the prepared block is the newest one
+    uint8_t newest = this->__head;
+    uint8_t i;
+
+    /* Reverse pass : each block must be able to decelerate to the next entry speed */
+    float   next_entry = 0;    // the last block ends at standstill
+    i = newest;
+    while(true){
+        TMC2100_Block *b = &(this->__blocks[i]);
+        float v = sqrtf(next_entry * next_entry + 2.0f * this->__accel * b->length);
+        this->__plan[i].entry_speed = fminf(b->max_entry_speed, v);
+        if(i == first){ break; }
+        next_entry = this->__plan[i].entry_speed;
+        i = this->prevIndex(i);
+    }
+
+    /* Forward pass : each block must be able to accelerate to the next entry speed */
+    float   entry = busy ? this->__blocks[tail].exit_speed : 0;
+    i = first;
+    while(true){
+        TMC2100_Block *b = &(this->__blocks[i]);
+        float exit = 0;
+        if(i != newest){
+            float v = sqrtf(entry * entry + 2.0f * this->__accel * b->length);
+            exit = fminf(this->__plan[this->nextIndex(i)].entry_speed, v);
+        }
+        this->computeTrapezoid(b, &(this->__plan[i]), entry, exit);
+        if(i == newest){ break; }
+        entry = exit;
+        i = this->nextIndex(i);
+    }
+}
+
+void        TMC2100_Planner::computeTrapezoid(const TMC2100_Block *block, TMC2100_Trapezoid *trap, float entry, float exit){
+    float   factor = block->step_event_count / block->length;
+    float   a = block->accel_rate;
+    float   n = (float)block->step_event_count;
+    trap->entry_speed = entry;
+    trap->exit_speed = exit;
+    trap->entry_rate = fmaxf(entry * factor, TMC2100_MIN_RATE);
+    trap->exit_rate = fmaxf(exit * factor, TMC2100_MIN_RATE);
+
+    float   nominal2 = block->nominal_rate * block->nominal_rate;
+    float   accel_steps = (nominal2 - trap->entry_rate * trap->entry_rate) / (2.0f * a);
+    float   decel_steps = (nominal2 - trap->exit_rate * trap->exit_rate) / (2.0f * a);
+    if(accel_steps < 0){ accel_steps = 0; }
+    if(decel_steps < 0){ decel_steps = 0; }
+    if(accel_steps + decel_steps > n){
+        // no cruise : intersection of the acceleration and deceleration ramps
+        accel_steps = (2.0f * a * n + trap->exit_rate * trap->exit_rate
+                        - trap->entry_rate * trap->entry_rate) / (4.0f * a);
+        if(accel_steps < 0){ accel_steps = 0; }
+        if(accel_steps > n){ accel_steps = n; }
+        decel_steps = n - accel_steps;
+    }
+    trap->accelerate_until = (uint32_t)accel_steps;
+    trap->decelerate_after = block->step_event_count - (uint32_t)decel_steps;
+}
+
+/**************************************************************
+ *	Step events
+ **************************************************************/
+
+uint32_t    TMC2100_Planner::eventInterval(const TMC2100_Block *block, uint32_t event){
+    float   rate = block->nominal_rate;
+    float   nominal2 = rate * rate;
+    float   v2 = nominal2;
+    // speed at the middle of the next interval : lowest of the acceleration ramp,
+    // the deceleration ramp and the nominal rate (not reached by short blocks)
+    if(event < block->decelerate_after){
+        float va = block->entry_rate * block->entry_rate + block->accel_rate * (2.0f * event + 1);
+        if(va < v2){ v2 = va; }
+    }
+    if(event >= block->accelerate_until){
+        uint32_t remaining = block->step_event_count - event;
+        float vd = block->exit_rate * block->exit_rate + block->accel_rate * (2.0f * remaining - 1);
+        if(vd < v2){ v2 = vd; }
+    }
+    if(v2 < nominal2){ rate = sqrtf(v2); }
+    if(rate < TMC2100_MIN_RATE){ rate = TMC2100_MIN_RATE; }
+    uint32_t interval = (uint32_t)(TMC2100_TIME_UNIT / rate);
+    return (interval < TMC2100_MIN_INTERVAL_US) ? TMC2100_MIN_INTERVAL_US : interval;
+}
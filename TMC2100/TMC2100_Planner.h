@@ -0,0 +1,275 @@
+/**
+ * FILENAME :        TMC2100_Planner.h
+ *
+ * DESCRIPTION :
+ *       TMC2100_Planner / Coordinated multi-axis motion planner.
+ *
+ *       Linear moves of up to TMC2100_MAX_AXES axes are queued
+ *  in a ring buffer of blocks. Each new block triggers a lookahead
+ *  over the queue : speeds at the junctions between blocks are
+ *  limited by the angle of the junction and by the acceleration,
+ *  then the speed profile (trapezoid) of each block is computed.
+ *
+ *       This file does not depend on MBED OS. It can be compiled
+ *  on a computer to measure the planning throughput and to check
+ *  the step output of the blocks.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://github.com/grbl/grbl/blob/master/grbl/planner.c
+ */
+
+#ifndef __TMC2100_PLANNER_HEADER_H__
+#define __TMC2100_PLANNER_HEADER_H__
+
+#include <cstdint>
+#include "TMC2100_Profile.h"
+
+/** Constant definition */
+/// Maximum number of axes
+#define     TMC2100_MAX_AXES            4
+/// Number of blocks of the ring buffer (one is always kept free)
+#define     TMC2100_PLANNER_SIZE        16
+/// Lowest speed of the step events, in steps per second
+#define     TMC2100_MIN_RATE            20.0f
+
+/**
+ * @struct TMC2100_Block
+ * @brief Linear move of all the axes, with its speed profile
+ * @details     Speeds are given in steps per second along the path
+ *  (euclidean length in steps) and in step events per second
+ *  for the step generator (one event per step of the dominant axis).
+ */
+struct TMC2100_Block{
+    /// Number of steps of each axis (absolute value)
+    uint32_t    steps[TMC2100_MAX_AXES];
+    /// Direction of each axis : bit i is set if axis i goes backward
+    uint8_t     dir_bits;
+    /// Number of step events - steps of the dominant axis
+    uint32_t    step_event_count;
+    /// Euclidean length in steps
+    float       length;
+
+    /// Nominal speed along the path
+    float       nominal_speed;
+    /// Highest entry speed allowed by the junction
+    float       max_entry_speed;
+    /// Planned entry speed along the path
+    float       entry_speed;
+    /// Planned exit speed along the path
+    float       exit_speed;
+
+    /// Entry rate in step events per second
+    float       entry_rate;
+    /// Nominal rate in step events per second
+    float       nominal_rate;
+    /// Exit rate in step events per second
+    float       exit_rate;
+    /// Acceleration in step events per second^2
+    float       accel_rate;
+    /// Step event where the acceleration ends
+    uint32_t    accelerate_until;
+    /// Step event where the deceleration starts
+    uint32_t    decelerate_after;
+};
+
+/**
+ * @struct TMC2100_Trapezoid
+ * @brief Speed profile of a block computed by the lookahead
+ * @details     The lookahead writes the profiles in a separate table :
+ *  they are copied to the blocks only when the new block is published.
+ */
+struct TMC2100_Trapezoid{
+    /// Planned entry and exit speeds along the path
+    float       entry_speed;
+    float       exit_speed;
+    /// Entry and exit rates in step events per second
+    float       entry_rate;
+    float       exit_rate;
+    /// Step event where the acceleration ends
+    uint32_t    accelerate_until;
+    /// Step event where the deceleration starts
+    uint32_t    decelerate_after;
+};
+
+/**
+ * @class TMC2100_Planner
+ * @brief Queue of linear moves with junction speed lookahead
+ * @details     The oldest block can be executed by the step generator
+ *  while new blocks are added : the block under execution is never
+ *  modified by the lookahead.
+ *      A new block is added in three steps : prepareLine (geometry of the
+ *  block, not yet in the queue), recalculate (lookahead, in a separate
+ *  table) and commitLine (copy of the profiles, new block in the queue).
+ *  Only commitLine must not run at the same time as the step generator
+ *  (see TMC2100_MultiAxis) : it fails if a block was taken or released
+ *  since the lookahead, which must then be done again.
+ */
+class TMC2100_Planner{
+    private:
+        /// Ring buffer of blocks
+        TMC2100_Block   __blocks[TMC2100_PLANNER_SIZE];
+        /// Index of the next free block
+        uint8_t     __head;
+        /// Index of the oldest block
+        volatile uint8_t    __tail;
+        /// The oldest block is under execution
+        volatile bool       __tail_busy;
+
+        /// Profiles computed by the lookahead
+        TMC2100_Trapezoid   __plan[TMC2100_PLANNER_SIZE];
+        /// State of the queue used by the lookahead : first block and block under execution
+        uint8_t     __plan_first;
+        bool        __plan_busy;
+        /// A block is prepared at the head of the queue
+        bool        __prepared;
+        /// Position and unit vector at the end of the prepared block
+        int32_t     __next_position[TMC2100_MAX_AXES];
+        float       __next_unit[TMC2100_MAX_AXES];
+
+        /// Number of axes
+        uint8_t     __nb_axes;
+        /// Acceleration along the path in steps per second^2
+        float       __accel;
+        /// Junction deviation in steps - higher values allow faster corners
+        float       __junction_deviation;
+
+        /// Position at the end of the last block
+        int32_t     __position[TMC2100_MAX_AXES];
+        /// Unit vector of the last block
+        float       __prev_unit[TMC2100_MAX_AXES];
+        /// Nominal speed of the last block
+        float       __prev_nominal;
+
+        /**
+        * @brief Index of the next block in the ring buffer.
+        */
+        uint8_t     nextIndex(uint8_t index);
+
+        /**
+        * @brief Index of the previous block in the ring buffer.
+        */
+        uint8_t     prevIndex(uint8_t index);
+
+        /**
+        * @brief Compute the trapezoid of a block in step events.
+        * @param block block to plan
+        * @param trap profile of the block
+        * @param entry entry speed along the path
+        * @param exit exit speed along the path
+        */
+        void        computeTrapezoid(const TMC2100_Block *block, TMC2100_Trapezoid *trap, float entry, float exit);
+
+    public:
+        /**
+        * @brief Simple constructor of the TMC2100_Planner class.
+        * @param nb_axes number of axes - up to TMC2100_MAX_AXES
+        */
+        TMC2100_Planner(uint8_t nb_axes);
+
+        /**
+        * @brief Return the number of axes.
+        */
+        uint8_t     getNbAxes(void);
+
+        /**
+        * @brief Set the acceleration along the path - for the next blocks.
+        * @param steps_per_s2 acceleration in steps per second^2
+        * @return false if the acceleration is not positive.
+        */
+        bool        setAcceleration(float steps_per_s2);
+
+        /**
+        * @brief Set the junction deviation - for the next blocks.
+        * @details  Distance in steps between the corner and the
+        *   virtual arc followed at the junction speed. 0 stops at each corner.
+        * @param steps junction deviation in steps
+        */
+        void        setJunctionDeviation(float steps);
+
+        /**
+        * @brief Add a linear move to an absolute position.
+        * @details  prepareLine, recalculate and commitLine in a row - when
+        *   the step generator is not running (or on a computer).
+        * @param target target position of each axis in steps
+        * @param speed nominal speed along the path in steps per second
+        * @return false if the queue is full (or if the move is null).
+        */
+        bool        bufferLine(const int32_t target[], float speed);
+
+        /**
+        * @brief Prepare a linear move at the head of the queue.
+        * @details  The block is not in the queue until commitLine.
+        * @param target target position of each axis in steps
+        * @param speed nominal speed along the path in steps per second
+        * @return false if the queue is full (or if the move is null).
+        */
+        bool        prepareLine(const int32_t target[], float speed);
+
+        /**
+        * @brief Reverse and forward passes of the lookahead, including the prepared block.
+        * @details  The profiles are computed in a separate table : the
+        *   step generator can run during the lookahead.
+        */
+        void        recalculate(void);
+
+        /**
+        * @brief Copy the profiles of the lookahead and add the prepared block to the queue.
+        * @details  Must not run at the same time as getCurrentBlock or discardCurrentBlock.
+        * @return false if the step generator took or released a block since
+        *   the lookahead (call recalculate again).
+        */
+        bool        commitLine(void);
+
+        /**
+        * @brief Return the block to execute, NULL if the queue is empty.
+        * @details  The block is marked as under execution.
+        */
+        TMC2100_Block   *getCurrentBlock(void);
+
+        /**
+        * @brief Release the block under execution.
+        */
+        void        discardCurrentBlock(void);
+
+        /**
+        * @brief Interval before a step event of a block, in us.
+        * @details  Rate of the trapezoid at the middle of the interval.
+        * @param block block under execution
+        * @param event index of the step event in the block
+        */
+        static uint32_t eventInterval(const TMC2100_Block *block, uint32_t event);
+
+        /**
+        * @brief Return true if the queue is full.
+        */
+        bool        isFull(void);
+
+        /**
+        * @brief Return true if the queue is empty.
+        */
+        bool        isEmpty(void);
+
+        /**
+        * @brief Return the number of blocks in the queue.
+        */
+        uint8_t     getNbBlocks(void);
+
+        /**
+        * @brief Return the position at the end of the queued moves.
+        * @param position array of the position of each axis
+        */
+        void        getPosition(int32_t position[]);
+
+        /**
+        * @brief Set the position (when the queue is empty).
+        * @param position array of the position of each axis
+        */
+        void        setPosition(const int32_t position[]);
+};
+
+#endif
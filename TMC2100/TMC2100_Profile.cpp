@@ -0,0 +1,212 @@
+/**
+ * FILENAME :        TMC2100_Profile.cpp
+ *
+ * DESCRIPTION :
+ *       TMC2100_Profile / Step timing of a move with acceleration ramps.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see D. Austin, Generate stepper-motor speed profiles in real time, 2005
+ */
+
+#include "TMC2100_Profile.h"
+#include <cmath>
+
+TMC2100_Profile::TMC2100_Profile(void){
+    this->__type = TMC2100_TRAPEZOIDAL;
+    this->__max_speed = 1000;
+    this->__accel = 1000;
+    this->abort();
+}
+
+void    TMC2100_Profile::setType(TMC2100_ProfileType type){
+    this->__type = type;
+}
+
+bool    TMC2100_Profile::setMaxSpeed(float steps_per_s){
+    if(steps_per_s <= 0){ return false; }
+    // speed is limited by the shortest interval
+    if(steps_per_s > TMC2100_TIME_UNIT / TMC2100_MIN_INTERVAL_US){
+        steps_per_s = TMC2100_TIME_UNIT / TMC2100_MIN_INTERVAL_US;
+    }
+    this->__max_speed = steps_per_s;
+    return true;
+}
+
+bool    TMC2100_Profile::setAcceleration(float steps_per_s2){
+    if(steps_per_s2 <= 0){ return false; }
+    this->__accel = steps_per_s2;
+    return true;
+}
+
+void    TMC2100_Profile::plan(uint32_t steps){
+    this->abort();
+    if(steps == 0){ return; }
+    this->__steps_to_go = steps;
+    this->__phase = TMC2100_ACCEL;
+
+    if(this->__type == TMC2100_S_CURVE){
+        // a ramp to v lasts 1.5 v / a and takes 0.75 v^2 / a steps
+        this->__peak_speed = sqrtf(steps * this->__accel / 1.5f);
+        if(this->__peak_speed > this->__max_speed){ this->__peak_speed = this->__max_speed; }
+        this->__ramp_time = 1.5f * this->__peak_speed / this->__accel;
+        this->__ramp_steps = 0.5f * this->__peak_speed * this->__ramp_time;
+        this->__m = 0;
+        this->__t_lo = 0;
+        this->__t_hi = this->sCurveTime(1);
+        this->__start_speed = 1.0f / this->__t_hi;
+    }
+    else{
+        // a ramp to v takes v^2 / 2a steps
+        this->__peak_speed = sqrtf(steps * this->__accel);
+        if(this->__peak_speed > this->__max_speed){ this->__peak_speed = this->__max_speed; }
+        this->__cmin = TMC2100_TIME_UNIT / this->__peak_speed;
+        // first interval with the correction factor of D. Austin
+        this->__cn = 0.676f * TMC2100_TIME_UNIT * sqrtf(2.0f / this->__accel);
+        if(this->__cn < this->__cmin){ this->__cn = this->__cmin; }
+        this->__start_speed = TMC2100_TIME_UNIT / this->__cn;
+    }
+}
+
+uint32_t    TMC2100_Profile::nextInterval(void){
+    if((this->__phase == TMC2100_IDLE) || (this->__steps_to_go == 0)){
+        this->__phase = TMC2100_IDLE;
+        this->__speed = 0;
+        return 0;
+    }
+    // index in the ramp : distance to the nearest end of the move
+    uint32_t m = this->__steps_done;
+    if(this->__steps_to_go <= this->__steps_done){
+        m = this->__steps_to_go - 1;
+        this->__phase = TMC2100_DECEL;
+    }
+    if(this->__phase == TMC2100_ACCEL){
+        this->__accel_steps++;
+    }
+
+    float interval;
+    if(this->__type == TMC2100_S_CURVE){
+        interval = this->nextSCurve(m);
+    }
+    else{
+        interval = this->nextTrapezoidal(m);
+    }
+    this->__steps_to_go--;
+    this->__steps_done++;
+    if(interval < TMC2100_MIN_INTERVAL_US){ interval = TMC2100_MIN_INTERVAL_US; }
+    this->__speed = TMC2100_TIME_UNIT / interval;
+    return (uint32_t)(interval + 0.5f);
+}
+
+float   TMC2100_Profile::nextTrapezoidal(uint32_t m){
+    // one more step in the acceleration ramp
+    if((m > this->__n) && (this->__phase == TMC2100_ACCEL)){
+        this->__n++;
+        this->__cn -= (2.0f * this->__cn) / (4.0f * this->__n + 1.0f);
+        if(this->__cn <= this->__cmin){
+            this->__phase = TMC2100_CRUISE;
+        }
+    }
+    // back in the ramp : inverse of the acceleration step
+    while(m < this->__n){
+        this->__cn += (2.0f * this->__cn) / (4.0f * this->__n - 1.0f);
+        this->__n--;
+    }
+    // cn is not limited, so that the deceleration mirrors the acceleration
+    return (this->__cn < this->__cmin) ? this->__cmin : this->__cn;
+}
+
+float   TMC2100_Profile::sCurveTime(float k){
+    if(k >= this->__ramp_steps){
+        return this->__ramp_time + (k - this->__ramp_steps) / this->__peak_speed;
+    }
+    // position in the ramp : vp * T * (u^3 - u^4 / 2), u = t / T
+    float   vt = this->__peak_speed * this->__ramp_time;
+    float   u = cbrtf(k / vt);
+    for(int i = 0; i < 4; i++){
+        float   u2 = u * u;
+        float   x = vt * u2 * (u - 0.5f * u2) - k;
+        float   v = vt * u2 * (3.0f - 2.0f * u);
+        if(v <= 0){ break; }
+        u -= x / v;
+    }
+    if(u > 1){ u = 1; }
+    return u * this->__ramp_time;
+}
+
+float   TMC2100_Profile::nextSCurve(uint32_t m){
+    // both steps at the peak speed
+    if(m >= this->__ramp_steps){
+        if(this->__phase == TMC2100_ACCEL){ this->__phase = TMC2100_CRUISE; }
+        return TMC2100_TIME_UNIT / this->__peak_speed;
+    }
+    // next or previous step of the ramp : one time is already known
+    if(m == this->__m + 1){
+        this->__t_lo = this->__t_hi;
+        this->__t_hi = this->sCurveTime(m + 1);
+    }
+    else if(m + 1 == this->__m){
+        this->__t_hi = this->__t_lo;
+        this->__t_lo = this->sCurveTime(m);
+    }
+    else if(m != this->__m){
+        this->__t_lo = this->sCurveTime(m);
+        this->__t_hi = this->sCurveTime(m + 1);
+    }
+    this->__m = m;
+    if((this->__phase == TMC2100_ACCEL) && (m + 1 >= this->__ramp_steps)){
+        this->__phase = TMC2100_CRUISE;
+    }
+    return (this->__t_hi - this->__t_lo) * TMC2100_TIME_UNIT;
+}
+
+void    TMC2100_Profile::requestStop(void){
+    if((this->__phase == TMC2100_ACCEL) || (this->__phase == TMC2100_CRUISE)){
+        // as many steps as the acceleration ramp done so far
+        if(this->__steps_to_go > this->__accel_steps){
+            this->__steps_to_go = this->__accel_steps;
+        }
+    }
+}
+
+void    TMC2100_Profile::abort(void){
+    this->__phase = TMC2100_IDLE;
+    this->__steps_to_go = 0;
+    this->__steps_done = 0;
+    this->__accel_steps = 0;
+    this->__peak_speed = 0;
+    this->__start_speed = 0;
+    this->__speed = 0;
+    this->__n = 0;
+    this->__cn = 0;
+    this->__cmin = 0;
+    this->__ramp_time = 0;
+    this->__ramp_steps = 0;
+    this->__m = 0;
+    this->__t_lo = 0;
+    this->__t_hi = 0;
+}
+
+TMC2100_Phase   TMC2100_Profile::getPhase(void){
+    return this->__phase;
+}
+
+float   TMC2100_Profile::getSpeed(void){
+    return this->__speed;
+}
+
+float   TMC2100_Profile::getPeakSpeed(void){
+    return this->__peak_speed;
+}
+
+uint32_t    TMC2100_Profile::getStepsToGo(void){
+    return this->__steps_to_go;
+}
+
+uint32_t    TMC2100_Profile::getStepsDone(void){
+    return this->__steps_done;
+}
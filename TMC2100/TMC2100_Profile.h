@@ -0,0 +1,196 @@
+/**
+ * FILENAME :        TMC2100_Profile.h
+ *
+ * DESCRIPTION :
+ *       TMC2100_Profile / Step timing of a move with acceleration ramps.
+ *
+ *       This file does not depend on MBED OS. It can be compiled
+ *  on a computer to simulate the step timing of a move
+ *  and compare it to the requested speed profile.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see D. Austin, Generate stepper-motor speed profiles in real time, 2005
+ */
+
+#ifndef __TMC2100_PROFILE_HEADER_H__
+#define __TMC2100_PROFILE_HEADER_H__
+
+#include <cstdint>
+
+/** Constant definition */
+/// Time unit of the intervals (1 us)
+#define     TMC2100_TIME_UNIT           1000000.0f
+/// Shortest interval between two steps in us (ISR duration of the step engine)
+#define     TMC2100_MIN_INTERVAL_US     20
+
+/** @enum TMC2100_ProfileType */
+enum TMC2100_ProfileType {
+    /// Constant acceleration - linear speed ramps
+    TMC2100_TRAPEZOIDAL = 0,
+    /// Limited jerk - speed follows 3u^2 - 2u^3 during the ramps
+    TMC2100_S_CURVE
+};
+
+/** @enum TMC2100_Phase */
+enum TMC2100_Phase {
+    TMC2100_IDLE = 0,
+    TMC2100_ACCEL,
+    TMC2100_CRUISE,
+    TMC2100_DECEL
+};
+
+/**
+ * @class TMC2100_Profile
+ * @brief Compute the interval before each step of a move
+ * @details     The interval of a step only depends on its distance
+ *  to the nearest end of the move (steps done or steps to go) : the
+ *  deceleration is the mirror of the acceleration and the number
+ *  of steps of a move is always exact.
+ *      The trapezoidal profile uses the incremental approximation
+ *  of D. Austin (one division per step), backward for the deceleration.
+ *      The S-curve profile inverts the position in the ramp (Newton)
+ *  to get the time of each step. Each ramp lasts 1.5 * vmax / acceleration,
+ *  so the peak acceleration is the requested acceleration.
+ */
+class TMC2100_Profile{
+    private:
+        /// Type of the profile
+        TMC2100_ProfileType     __type;
+        /// Maximum speed in steps per second
+        float       __max_speed;
+        /// Acceleration in steps per second^2
+        float       __accel;
+
+        /// Phase of the move
+        TMC2100_Phase   __phase;
+        /// Peak speed of the current move (lower than max speed for short moves)
+        float       __peak_speed;
+        /// Remaining steps of the move
+        uint32_t    __steps_to_go;
+        /// Steps already done
+        uint32_t    __steps_done;
+        /// Number of steps of the acceleration ramp
+        uint32_t    __accel_steps;
+
+        /// Trapezoidal profile - current interval in us
+        float       __cn;
+        /// Trapezoidal profile - shortest interval in us
+        float       __cmin;
+        /// Trapezoidal profile - index of the current interval in the ramp
+        uint32_t    __n;
+
+        /// S-curve profile - duration of a ramp in s
+        float       __ramp_time;
+        /// S-curve profile - number of steps of a ramp
+        float       __ramp_steps;
+        /// S-curve profile - index of the last step in the ramp
+        uint32_t    __m;
+        /// S-curve profile - time of the steps m and m+1 in the ramp, in s
+        float       __t_lo;
+        float       __t_hi;
+        /// Speed of the first step in steps per second
+        float       __start_speed;
+        /// Current speed in steps per second
+        float       __speed;
+
+        /**
+        * @brief Time to do a number of steps from standstill, S-curve profile.
+        * @param k number of steps
+        * @return time in s
+        */
+        float   sCurveTime(float k);
+
+        /**
+        * @brief Interval of the next step of a trapezoidal profile, in us.
+        * @param m index of the step in the ramp
+        */
+        float   nextTrapezoidal(uint32_t m);
+
+        /**
+        * @brief Interval of the next step of a S-curve profile, in us.
+        * @param m index of the step in the ramp
+        */
+        float   nextSCurve(uint32_t m);
+
+    public:
+        /**
+        * @brief Simple constructor of the TMC2100_Profile class.
+        * @details Trapezoidal profile, 1000 steps/s, 1000 steps/s^2.
+        */
+        TMC2100_Profile(void);
+
+        /**
+        * @brief Set the type of the profile - for the next moves.
+        * @param type TMC2100_TRAPEZOIDAL or TMC2100_S_CURVE
+        */
+        void    setType(TMC2100_ProfileType type);
+
+        /**
+        * @brief Set the maximum speed - for the next moves.
+        * @param steps_per_s speed in steps per second
+        * @return false if the speed is not positive.
+        */
+        bool    setMaxSpeed(float steps_per_s);
+
+        /**
+        * @brief Set the acceleration - for the next moves.
+        * @param steps_per_s2 acceleration in steps per second^2
+        * @return false if the acceleration is not positive.
+        */
+        bool    setAcceleration(float steps_per_s2);
+
+        /**
+        * @brief Prepare a move of a number of steps, from standstill.
+        * @param steps number of steps of the move
+        */
+        void    plan(uint32_t steps);
+
+        /**
+        * @brief Compute the interval before the next step.
+        * @details Each call accounts for one step of the move.
+        * @return interval in us, 0 if the move is finished.
+        */
+        uint32_t    nextInterval(void);
+
+        /**
+        * @brief Stop the move with the deceleration ramp.
+        */
+        void    requestStop(void);
+
+        /**
+        * @brief Stop the move immediately.
+        */
+        void    abort(void);
+
+        /**
+        * @brief Return the phase of the move.
+        */
+        TMC2100_Phase   getPhase(void);
+
+        /**
+        * @brief Return the current speed in steps per second.
+        */
+        float   getSpeed(void);
+
+        /**
+        * @brief Return the peak speed of the current move in steps per second.
+        */
+        float   getPeakSpeed(void);
+
+        /**
+        * @brief Return the number of steps to do.
+        */
+        uint32_t    getStepsToGo(void);
+
+        /**
+        * @brief Return the number of steps already done.
+        */
+        uint32_t    getStepsDone(void);
+};
+
+#endif
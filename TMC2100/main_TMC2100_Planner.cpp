@@ -0,0 +1,249 @@
+/**
+ * FILENAME :        main_TMC2100_Planner.cpp
+ *
+ * DESCRIPTION :
+ *       TMC2100_Planner / Throughput and step output of the planner on a computer.
+ *
+ *       This program does not depend on MBED OS :
+ *          g++ -O2 main_TMC2100_Planner.cpp TMC2100_Planner.cpp TMC2100_Profile.cpp -o planner
+ *          ./planner       -> benchmark and checks, exit code 1 if one fails
+ *
+ *       Benchmark : time to add a move with a full queue (lookahead over
+ *  TMC2100_PLANNER_SIZE-1 blocks) and time of commitLine, the only part
+ *  in the critical section of TMC2100_MultiAxis::line.
+ *
+ *       Step output : the step engine of TMC2100_MultiAxis (Bresenham
+ *  distribution and TMC2100_Planner::eventInterval) runs between the
+ *  lookahead and the commit of the new moves. It checks :
+ *          -> the number of steps of each axis in each block and the final position
+ *          -> the speed along the path (nominal speed, junctions)
+ *          -> the acceleration along the path
+ *          -> the new lookahead when a block is taken during the previous one
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include "TMC2100_Planner.h"
+
+/** Constant definition */
+#define SIM_NB_AXES         3
+#define SIM_ACCEL           8000.0f
+#define SIM_MAX_SPEED       2000.0f
+#define SIM_NB_LINES        2000
+#define SIM_BENCH_LINES     100000
+/// Number of step events between two new moves
+#define SIM_EVENTS_PER_LINE 40
+/// Step events for the acceleration check
+#define SIM_ACCEL_WINDOW    16
+/// Tolerance of the speed and acceleration checks
+#define SIM_TOLERANCE       0.1f
+
+/// Pseudo-random moves - same sequence on each run
+static uint32_t sim_seed = 12345;
+int32_t simRandom(int32_t range){
+    sim_seed = sim_seed * 1103515245 + 12345;
+    return (int32_t)((sim_seed >> 8) % (2 * range + 1)) - range;
+}
+
+void randomTarget(int32_t target[], float *speed){
+    for(int i = 0; i < SIM_NB_AXES; i++){
+        target[i] += simRandom(400);
+    }
+    *speed = 200.0f + (simRandom(1000) + 1000) * (SIM_MAX_SPEED - 200.0f) / 2000.0f;
+}
+
+/**************************************************************
+ *	Benchmark
+ **************************************************************/
+
+void benchmark(void){
+    typedef std::chrono::steady_clock   clk;
+    TMC2100_Planner     planner(SIM_NB_AXES);
+    int32_t     target[SIM_NB_AXES] = {0};
+    float       speed;
+    double      t_line = 0, t_commit = 0;
+    planner.setAcceleration(SIM_ACCEL);
+
+    for(int k = 0; k < SIM_BENCH_LINES; k++){
+        // the oldest block is under execution : longest lookahead
+        if(planner.isFull()){ planner.discardCurrentBlock(); }
+        planner.getCurrentBlock();
+        randomTarget(target, &speed);
+        clk::time_point t0 = clk::now();
+        if(!planner.prepareLine(target, speed)){ continue; }
+        planner.recalculate();
+        clk::time_point t1 = clk::now();
+        planner.commitLine();
+        clk::time_point t2 = clk::now();
+        t_line += std::chrono::duration<double>(t2 - t0).count();
+        t_commit += std::chrono::duration<double>(t2 - t1).count();
+    }
+    printf("Planner : %d blocks, %.2f us per move (%.0f moves/s), commitLine %.3f us\n",
+            TMC2100_PLANNER_SIZE, 1e6 * t_line / SIM_BENCH_LINES,
+            SIM_BENCH_LINES / t_line, 1e6 * t_commit / SIM_BENCH_LINES);
+}
+
+/**************************************************************
+ *	Step output
+ **************************************************************/
+
+/**
+ * @class SimStepper
+ * @brief Step engine of TMC2100_MultiAxis, without the timer and the pins
+ */
+class SimStepper{
+    public:
+        TMC2100_Planner     *planner;
+        TMC2100_Block   *block;
+        uint32_t    event;
+        int32_t     counter[SIM_NB_AXES];
+        int32_t     position[SIM_NB_AXES];
+        uint32_t    block_steps[SIM_NB_AXES];
+        /// Results of the checks
+        int         errors;
+        uint32_t    nb_blocks;
+        uint32_t    nb_events;
+        double      time;
+        float       max_speed_ratio;
+        float       max_accel_ratio;
+        float       max_junction;
+        /// Rate history for the acceleration check
+        float       rates[SIM_ACCEL_WINDOW];
+        float       last_speed;
+
+        SimStepper(TMC2100_Planner *p){
+            this->planner = p;
+            this->block = NULL;
+            this->errors = 0;
+            this->nb_blocks = 0;
+            this->nb_events = 0;
+            this->time = 0;
+            this->max_speed_ratio = 0;
+            this->max_accel_ratio = 0;
+            this->max_junction = 0;
+            this->last_speed = 0;
+            for(int i = 0; i < SIM_NB_AXES; i++){ this->position[i] = 0; }
+        }
+
+        bool startBlock(void){
+            this->block = this->planner->getCurrentBlock();
+            if(this->block == NULL){ return false; }
+            this->event = 0;
+            for(int i = 0; i < SIM_NB_AXES; i++){
+                this->counter[i] = -(int32_t)(this->block->step_event_count >> 1);
+                this->block_steps[i] = 0;
+            }
+            // speed along the path at the junction
+            float speed = this->block->entry_rate * this->block->length / this->block->step_event_count;
+            float jump = fabsf(speed - this->last_speed);
+            if(jump > this->max_junction){ this->max_junction = jump; }
+            return true;
+        }
+
+        void endBlock(void){
+            TMC2100_Block *b = this->block;
+            for(int i = 0; i < SIM_NB_AXES; i++){
+                if(this->block_steps[i] != b->steps[i]){ this->errors++; }
+            }
+            this->last_speed = b->exit_rate * b->length / b->step_event_count;
+            this->nb_blocks++;
+            this->planner->discardCurrentBlock();
+        }
+
+        /**
+        * @brief One step event - as TMC2100_MultiAxis::ISR_step.
+        * @return false if the queue is empty.
+        */
+        bool step(void){
+            if((this->block == NULL) && !this->startBlock()){ return false; }
+            TMC2100_Block *b = this->block;
+            uint32_t interval = TMC2100_Planner::eventInterval(b, this->event);
+            float rate = TMC2100_TIME_UNIT / interval;
+            this->time += interval / 1e6;
+            for(int i = 0; i < SIM_NB_AXES; i++){
+                this->counter[i] += b->steps[i];
+                if(this->counter[i] > 0){
+                    this->counter[i] -= b->step_event_count;
+                    this->block_steps[i]++;
+                    this->position[i] += ((b->dir_bits >> i) & 1) ? -1 : 1;
+                }
+            }
+            /* Speed : lower than the nominal rate */
+            float ratio = rate / b->nominal_rate - 1.0f;
+            if(ratio > this->max_speed_ratio){ this->max_speed_ratio = ratio; }
+            /* Acceleration : v^2 changes by 2 a per step event */
+            uint8_t w = this->event % SIM_ACCEL_WINDOW;
+            if(this->event >= SIM_ACCEL_WINDOW){
+                float dv2 = fabsf(rate * rate - this->rates[w] * this->rates[w]);
+                ratio = dv2 / (2.0f * b->accel_rate * SIM_ACCEL_WINDOW) - 1.0f;
+                if(ratio > this->max_accel_ratio){ this->max_accel_ratio = ratio; }
+            }
+            this->rates[w] = rate;
+            this->event++;
+            this->nb_events++;
+            if(this->event >= b->step_event_count){
+                this->endBlock();
+                this->block = NULL;
+            }
+            return true;
+        }
+};
+
+bool stepOutput(void){
+    TMC2100_Planner     planner(SIM_NB_AXES);
+    SimStepper  stepper(&planner);
+    int32_t     target[SIM_NB_AXES] = {0};
+    float       speed;
+    int         nb_retries = 0;
+    planner.setAcceleration(SIM_ACCEL);
+    planner.setJunctionDeviation(2.0f);
+
+    for(int k = 0; k < SIM_NB_LINES; k++){
+        randomTarget(target, &speed);
+        while(planner.isFull()){ stepper.step(); }
+        if(!planner.prepareLine(target, speed)){ continue; }
+        planner.recalculate();
+        // the step engine runs during the lookahead
+        for(int e = 0; e < SIM_EVENTS_PER_LINE; e++){ stepper.step(); }
+        while(!planner.commitLine()){
+            nb_retries++;
+            planner.recalculate();
+        }
+    }
+    while(stepper.step()){}
+
+    int32_t end_position[SIM_NB_AXES];
+    planner.getPosition(end_position);
+    for(int i = 0; i < SIM_NB_AXES; i++){
+        if((stepper.position[i] != target[i]) || (end_position[i] != target[i])){ stepper.errors++; }
+    }
+    // speed reached from standstill in one step event (up to sqrt(nb_axes) steps along the path)
+    float junction_limit = sqrtf(2.0f * SIM_ACCEL * SIM_NB_AXES);
+    bool ok = (stepper.errors == 0) && (nb_retries > 0)
+                && (stepper.max_speed_ratio < SIM_TOLERANCE)
+                && (stepper.max_accel_ratio < SIM_TOLERANCE)
+                && (stepper.max_junction < junction_limit)
+                && (stepper.last_speed < junction_limit);
+
+    printf("Steps : %u blocks, %u step events in %.2f s, %d errors, %d new lookaheads\n",
+            stepper.nb_blocks, stepper.nb_events, stepper.time, stepper.errors, nb_retries);
+    printf("Steps : speed +%.2f %%, acceleration +%.2f %%, junction %.1f steps/s (limit %.1f)  %s\n",
+            100 * stepper.max_speed_ratio, 100 * stepper.max_accel_ratio,
+            stepper.max_junction, junction_limit, ok ? "OK" : "FAILED");
+    return ok;
+}
+
+int main()
+{
+    benchmark();
+    return stepOutput() ? 0 : 1;
+}
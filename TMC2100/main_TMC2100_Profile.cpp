@@ -0,0 +1,143 @@
+/**
+ * FILENAME :        main_TMC2100_Profile.cpp
+ *
+ * DESCRIPTION :
+ *       TMC2100_Profile / Simulation of the step timing on a computer.
+ *
+ *       This program does not depend on MBED OS :
+ *          g++ -O2 main_TMC2100_Profile.cpp TMC2100_Profile.cpp -o profile
+ *          ./profile            -> checks of the moves, exit code 1 if one fails
+ *          ./profile 2000 t     -> intervals of a move of 2000 steps (t or s)
+ *
+ *       For each profile and each length of move, the simulation checks :
+ *          -> the number of steps of the move
+ *          -> the duration of the move, compared to the ideal profile
+ *          -> the symmetry of the ramps (interval i and interval n-1-i)
+ *          -> the last interval, compared to the first one (short moves)
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "TMC2100_Profile.h"
+
+/** Constant definition */
+#define SIM_MAX_SPEED       4000.0f
+#define SIM_ACCEL           8000.0f
+/// Error of the duration of a move
+#define SIM_DURATION_ERROR  0.05
+/// Shortest trapezoidal move for the duration check (Austin approximation of the first steps)
+#define SIM_AUSTIN_STEPS    100
+/// Difference between the intervals of the acceleration and the deceleration
+#define SIM_SYMMETRY_ERROR  0.02
+/// Rounding of the intervals to 1 us
+#define SIM_ROUNDING_US     1
+
+/**
+ * @brief Duration of a move of the ideal profile, in s
+ */
+double idealDuration(TMC2100_ProfileType type, uint32_t steps, double vmax, double a){
+    if(type == TMC2100_S_CURVE){
+        // ramp of 1.5 v / a seconds and 0.75 v^2 / a steps
+        double vp = sqrt(steps * a / 1.5);
+        if(vp > vmax){ vp = vmax; }
+        return 3.0 * vp / a + (steps - 1.5 * vp * vp / a) / vp;
+    }
+    // ramp of v / a seconds and v^2 / 2a steps
+    double vp = sqrt(steps * a);
+    if(vp > vmax){ vp = vmax; }
+    return 2.0 * vp / a + (steps - vp * vp / a) / vp;
+}
+
+/**
+ * @brief Intervals of a move, in us
+ */
+std::vector<uint32_t> simulate(TMC2100_Profile &profile, uint32_t steps){
+    std::vector<uint32_t> intervals;
+    uint32_t    interval;
+    profile.plan(steps);
+    // more calls than steps : the move has to stop by itself
+    for(uint32_t k = 0; k < steps + 10; k++){
+        interval = profile.nextInterval();
+        if(interval == 0){ break; }
+        intervals.push_back(interval);
+    }
+    return intervals;
+}
+
+/**
+ * @brief Check a move and print the results.
+ * @return true if all the checks are successful.
+ */
+bool checkMove(TMC2100_ProfileType type, uint32_t steps){
+    TMC2100_Profile profile;
+    profile.setType(type);
+    profile.setMaxSpeed(SIM_MAX_SPEED);
+    profile.setAcceleration(SIM_ACCEL);
+    std::vector<uint32_t> c = simulate(profile, steps);
+    uint32_t    n = c.size();
+
+    double  duration = 0;
+    double  symmetry = 0;
+    for(uint32_t i = 0; i < n; i++){
+        duration += c[i] / 1e6;
+        double diff = fabs((double)c[i] - (double)c[n - 1 - i]);
+        if(diff > SIM_ROUNDING_US){
+            diff /= (c[i] < c[n - 1 - i]) ? c[i] : c[n - 1 - i];
+            if(diff > symmetry){ symmetry = diff; }
+        }
+    }
+    double  ideal = idealDuration(type, steps, SIM_MAX_SPEED, SIM_ACCEL);
+    double  error = fabs(duration - ideal) / ideal;
+
+    bool    ok_steps = (n == steps);
+    // no ramp for a single step, Austin approximation not accurate for short moves
+    bool    ok_duration = (steps < 2) || ((type == TMC2100_TRAPEZOIDAL) && (steps < SIM_AUSTIN_STEPS)) ||
+                            (error < SIM_DURATION_ERROR);
+    bool    ok_symmetry = (symmetry < SIM_SYMMETRY_ERROR);
+    // the last step is as slow as the first one
+    bool    ok_last = (n > 0) && (c[n - 1] <= c[0] * (1 + SIM_SYMMETRY_ERROR) + SIM_ROUNDING_US);
+    bool    ok = ok_steps && ok_duration && ok_symmetry && ok_last;
+
+    printf("%s %6u steps : %6u done, %8.4f s (ideal %8.4f s, %5.2f %%), "
+            "symmetry %5.2f %%, first %6u us, last %6u us  %s\n",
+            (type == TMC2100_S_CURVE) ? "S" : "T", steps, n, duration, ideal, 100 * error,
+            100 * symmetry, n ? c[0] : 0, n ? c[n - 1] : 0, ok ? "OK" : "FAILED");
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc > 1){
+        TMC2100_Profile profile;
+        profile.setType(((argc > 2) && (argv[2][0] == 's')) ? TMC2100_S_CURVE : TMC2100_TRAPEZOIDAL);
+        profile.setMaxSpeed(SIM_MAX_SPEED);
+        profile.setAcceleration(SIM_ACCEL);
+        std::vector<uint32_t> c = simulate(profile, atoi(argv[1]));
+        uint32_t    time = 0;
+        for(uint32_t i = 0; i < c.size(); i++){
+            time += c[i];
+            printf("%u;%u;%u\n", i + 1, c[i], time);
+        }
+        return 0;
+    }
+
+    const uint32_t  moves[] = {1, 2, 3, 4, 5, 7, 10, 25, 100, 999, 1000, 10000};
+    int     failed = 0;
+    for(uint32_t k = 0; k < sizeof(moves) / sizeof(moves[0]); k++){
+        failed += !checkMove(TMC2100_TRAPEZOIDAL, moves[k]);
+    }
+    for(uint32_t k = 0; k < sizeof(moves) / sizeof(moves[0]); k++){
+        failed += !checkMove(TMC2100_S_CURVE, moves[k]);
+    }
+    printf("%d failed move(s)\n", failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * FILENAME :        Telemetry.cpp
+ *
+ * DESCRIPTION :
+ *       Telemetry / Binary stream of typed values on a serial link.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ * @see https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing
+ */
+
+#include "Telemetry.h"
+#include <cstring>
+
+Telemetry::Telemetry(PinName tx, PinName rx, int baud) : __serial(tx, rx, baud){
+    this->__head = 0;
+    this->__tail = 0;
+    this->__tx_len = 0;
+    this->__dropped = 0;
+    this->__tx_errors = 0;
+    this->__serial.set_dma_usage_tx(DMA_USAGE_ALWAYS);
+}
+
+bool        Telemetry::sendInt32(uint8_t id, int32_t value){
+    return this->sendRecord(TELEMETRY_INT32, id, &value, 1);
+}
+
+bool        Telemetry::sendInt32(uint8_t id, const int32_t *values, uint8_t nb){
+    return this->sendRecord(TELEMETRY_INT32, id, values, nb);
+}
+
+bool        Telemetry::sendFloat(uint8_t id, float value){
+    return this->sendRecord(TELEMETRY_FLOAT, id, &value, 1);
+}
+
+bool        Telemetry::sendFloat(uint8_t id, const float *values, uint8_t nb){
+    return this->sendRecord(TELEMETRY_FLOAT, id, values, nb);
+}
+
+uint32_t    Telemetry::getDropped(void){
+    return this->__dropped;
+}
+
+uint32_t    Telemetry::getTxErrors(void){
+    return this->__tx_errors;
+}
+
+uint16_t    Telemetry::getPending(void){
+    CriticalSectionLock lock;
+    return (this->__head + TELEMETRY_BUFFER_SIZE - this->__tail) % TELEMETRY_BUFFER_SIZE;
+}
+
+/**************************************************************
+ *	Frames
+ **************************************************************/
+
+uint16_t    Telemetry::cobsEncode(const uint8_t *in, uint16_t len, uint8_t *out){
+    uint16_t    code_index = 0;     // index of the current code byte
+    uint16_t    out_index = 1;
+    uint8_t     code = 1;           // distance to the next 0x00
+    for(uint16_t i = 0; i < len; i++){
+        if(in[i] == 0){
+            out[code_index] = code;
+            code_index = out_index++;
+            code = 1;
+        }
+        else{
+            out[out_index++] = in[i];
+            code++;
+            if(code == 0xFF){
+                // block of 254 non-zero bytes
+                out[code_index] = code;
+                code_index = out_index++;
+                code = 1;
+            }
+        }
+    }
+    out[code_index] = code;
+    return out_index;
+}
+
+bool        Telemetry::sendRecord(uint8_t type, uint8_t id, const void *values, uint8_t nb){
+    if(nb > TELEMETRY_MAX_VALUES){ nb = TELEMETRY_MAX_VALUES; }
+    uint8_t     record[TELEMETRY_RECORD_SIZE];
+    uint8_t     frame[TELEMETRY_FRAME_SIZE];
+    uint32_t    timestamp = us_ticker_read();
+    uint16_t    len = TELEMETRY_HEADER_SIZE + 4 * nb;
+
+    /* Record - little endian, as the Cortex-M core */
+    record[0] = type;
+    record[1] = id;
+    memcpy(&record[2], &timestamp, 4);
+    memcpy(&record[TELEMETRY_HEADER_SIZE], values, 4 * nb);
+    uint8_t     checksum = 0;
+    for(uint16_t i = 0; i < len; i++){
+        checksum += record[i];
+    }
+    record[len++] = checksum;
+
+    /* Frame */
+    uint16_t    size = cobsEncode(record, len, frame);
+    frame[size++] = 0x00;
+
+    /* Copy in the ring buffer */
+    CriticalSectionLock lock;
+    uint16_t    used = (this->__head + TELEMETRY_BUFFER_SIZE - this->__tail) % TELEMETRY_BUFFER_SIZE;
+    if(used + size >= TELEMETRY_BUFFER_SIZE){
+        this->__dropped++;
+        return false;
+    }
+    uint16_t    first = TELEMETRY_BUFFER_SIZE - this->__head;
+    if(first > size){ first = size; }
+    memcpy(&this->__buffer[this->__head], frame, first);
+    memcpy(&this->__buffer[0], &frame[first], size - first);
+    this->__head = (this->__head + size) % TELEMETRY_BUFFER_SIZE;
+    this->startTransfer();
+    return true;
+}
+
+/**************************************************************
+ *	Transfers
+ **************************************************************/
+
+void        Telemetry::startTransfer(void){
+    if((this->__tx_len != 0) || (this->__head == this->__tail)){ return; }
+    // contiguous bytes only - the end of the buffer is sent by the next transfer
+    uint16_t    len = (this->__head > this->__tail) ?
+            this->__head - this->__tail : TELEMETRY_BUFFER_SIZE - this->__tail;
+    this->__tx_len = len;
+    int ret = this->__serial.write(&this->__buffer[this->__tail], len,
+            callback(this, &Telemetry::txDone), SERIAL_EVENT_TX_COMPLETE);
+    if(ret != 0){
+        // refused : no end of transfer event - the next frame starts it again
+        this->__tx_len = 0;
+        this->__tx_errors++;
+    }
+}
+
+void        Telemetry::txDone(int event){
+    CriticalSectionLock lock;
+    this->__tail = (this->__tail + this->__tx_len) % TELEMETRY_BUFFER_SIZE;
+    this->__tx_len = 0;
+    this->startTransfer();
+}
@@ -0,0 +1,50 @@
+/**
+ * FILENAME :        main_Telemetry.cpp
+ *
+ * DESCRIPTION :
+ *       Telemetry / Program for testing the binary telemetry library.
+ *
+ *       Sends a counter and 2 float values at 1 kHz from a Ticker
+ *  interrupt. Decode the stream on the computer with :
+ *       python tools/telemetry_decode.py COMx 921600
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "mbed.h"
+#include "Telemetry.h"
+
+#define     WAIT_TIME_MS    1000
+/// Channels of the values
+#define     CHANNEL_COUNTER 1
+#define     CHANNEL_SIGNALS 2
+#define     CHANNEL_DROPPED 3
+
+Telemetry   my_telemetry(USBTX, USBRX);
+Ticker      my_tik;
+int32_t     counter = 0;
+
+void ISR_tik(void){
+    float   signals[2];
+    counter++;
+    signals[0] = (counter % 1000) / 1000.0f;
+    signals[1] = 1.0f - signals[0];
+    my_telemetry.sendInt32(CHANNEL_COUNTER, counter);
+    my_telemetry.sendFloat(CHANNEL_SIGNALS, signals, 2);
+}
+
+int main()
+{
+    my_tik.attach(&ISR_tik, 1ms);
+
+    while (true)
+    {
+        thread_sleep_for(WAIT_TIME_MS);
+        my_telemetry.sendInt32(CHANNEL_DROPPED, (int32_t)my_telemetry.getDropped());
+    }
+}
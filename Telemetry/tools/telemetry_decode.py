@@ -0,0 +1,99 @@
+# -*- coding: utf-8 -*-
+"""
+FILENAME :        telemetry_decode.py
+
+DESCRIPTION :
+      Telemetry / Decoder of the binary stream of the Telemetry library.
+
+      Reads the frames from a serial port (pyserial) or from a file
+  of raw bytes, checks them and prints one CSV line per record :
+      id,timestamp_us,value1,value2,...
+
+      python telemetry_decode.py COM3 921600
+      python telemetry_decode.py capture.bin
+
+NOTES :
+      Developped by Villou / LEnsE
+
+AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+
+      LEnsE / Institut d'Optique Graduate School
+"""
+
+import struct
+import sys
+
+TELEMETRY_INT32 = 0x01
+TELEMETRY_FLOAT = 0x02
+TELEMETRY_HEADER_SIZE = 6
+
+
+def cobs_decode(frame):
+    """Decode a COBS frame (without the 0x00 delimiter). Return None if invalid."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_record(record):
+    """Return (id, timestamp, values) of a record. Return None if invalid."""
+    if len(record) < TELEMETRY_HEADER_SIZE + 1:
+        return None
+    if (sum(record[:-1]) & 0xFF) != record[-1]:
+        return None
+    data_type, channel = record[0], record[1]
+    timestamp, = struct.unpack('<I', record[2:6])
+    payload = record[TELEMETRY_HEADER_SIZE:-1]
+    if len(payload) % 4 != 0:
+        return None
+    nb = len(payload) // 4
+    if data_type == TELEMETRY_INT32:
+        values = struct.unpack('<%di' % nb, payload)
+    elif data_type == TELEMETRY_FLOAT:
+        values = struct.unpack('<%df' % nb, payload)
+    else:
+        return None
+    return channel, timestamp, values
+
+
+def decode_stream(read):
+    """Decode frames from a function returning bytes (None at the end). Yield the records."""
+    frame = bytearray()
+    while True:
+        data = read()
+        if data is None:
+            return
+        for byte in data:
+            if byte != 0:
+                frame.append(byte)
+                continue
+            record = cobs_decode(bytes(frame))
+            frame = bytearray()
+            if record is None:
+                continue
+            result = decode_record(record)
+            if result is not None:
+                yield result
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    if len(sys.argv) >= 3:
+        import serial
+        link = serial.Serial(sys.argv[1], int(sys.argv[2]), timeout=1)
+        read = lambda: link.read(4096)
+    else:
+        source = open(sys.argv[1], 'rb')
+        read = lambda: source.read(4096) or None
+    for channel, timestamp, values in decode_stream(read):
+        print(','.join([str(channel), str(timestamp)] + [str(v) for v in values]))
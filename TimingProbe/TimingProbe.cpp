@@ -0,0 +1,119 @@
+/**
+ * FILENAME :        TimingProbe.cpp
+ *
+ * DESCRIPTION :
+ *       TimingProbe / Duration and period statistics of code sections.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "TimingProbe.h"
+#include <cstdio>
+#include <cstring>
+
+TimingProbe *TimingProbe::__first = NULL;
+
+TimingProbe::TimingProbe(const char *name){
+    this->__name = name;
+    this->__budget = 0;
+    this->__entry = 0;
+    this->reset();
+    /* Registration in the list of the probes */
+    this->__next = TimingProbe::__first;
+    TimingProbe::__first = this;
+    TimingProbe::init();
+}
+
+void TimingProbe::init(void){
+#ifndef TIMING_PROBE_HOST
+    if((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0){
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+}
+
+void TimingProbe::setBudget(uint32_t budget){
+    this->__budget = budget;
+}
+
+void TimingProbe::reset(void){
+#ifndef TIMING_PROBE_HOST
+    CriticalSectionLock lock;
+#endif
+    memset(&(this->__stats), 0, sizeof(TimingProbe_Stats));
+    this->__stats.min = UINT32_MAX;
+    this->__stats.period_min = UINT32_MAX;
+}
+
+void TimingProbe::setName(const char *name){
+    this->__name = name;
+}
+
+const char *TimingProbe::getName(void){
+    return this->__name;
+}
+
+void TimingProbe::getStats(TimingProbe_Stats *stats){
+#ifndef TIMING_PROBE_HOST
+    CriticalSectionLock lock;
+#endif
+    memcpy(stats, &(this->__stats), sizeof(TimingProbe_Stats));
+}
+
+/**************************************************************
+ *	Dump
+ **************************************************************/
+
+void TimingProbe::dump(TimingProbe_Output output){
+    TimingProbe_Stats   s;
+    char    line[TIMING_PROBE_LINE_SIZE];
+    this->getStats(&s);
+
+    if(s.count == 0){
+        snprintf(line, TIMING_PROBE_LINE_SIZE, "%s : no data\r\n", this->__name);
+        output(line);
+        return;
+    }
+    snprintf(line, TIMING_PROBE_LINE_SIZE, "%s : n=%lu min=%lu mean=%lu max=%lu over=%lu\r\n",
+            this->__name, (unsigned long)s.count, (unsigned long)s.min,
+            (unsigned long)(s.sum / s.count), (unsigned long)s.max, (unsigned long)s.overruns);
+    output(line);
+    if(s.count > 1){
+        snprintf(line, TIMING_PROBE_LINE_SIZE, "  period min=%lu max=%lu jitter=%lu\r\n",
+                (unsigned long)s.period_min, (unsigned long)s.period_max,
+                (unsigned long)(s.period_max - s.period_min));
+        output(line);
+    }
+    for(int k = 0; k < TIMING_PROBE_NB_BINS; k++){
+        if(s.bins[k] == 0){ continue; }
+        snprintf(line, TIMING_PROBE_LINE_SIZE, "  [2^%d, 2^%d[ : %lu\r\n", k, k + 1, (unsigned long)s.bins[k]);
+        output(line);
+    }
+}
+
+void TimingProbe::dumpAll(TimingProbe_Output output){
+    char    line[TIMING_PROBE_LINE_SIZE];
+#ifdef TIMING_PROBE_HOST
+    snprintf(line, TIMING_PROBE_LINE_SIZE, "TimingProbe - unit : ns\r\n");
+#else
+    snprintf(line, TIMING_PROBE_LINE_SIZE, "TimingProbe - unit : cycle (%lu MHz)\r\n",
+            (unsigned long)(SystemCoreClock / 1000000));
+#endif
+    output(line);
+    for(TimingProbe *p = TimingProbe::__first; p != NULL; p = p->__next){
+        p->dump(output);
+    }
+}
+
+void TimingProbe::resetAll(void){
+    for(TimingProbe *p = TimingProbe::__first; p != NULL; p = p->__next){
+        p->reset();
+    }
+}
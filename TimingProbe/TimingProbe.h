@@ -0,0 +1,200 @@
+/**
+ * FILENAME :        TimingProbe.h
+ *
+ * DESCRIPTION :
+ *       TimingProbe / Duration and period statistics of code sections.
+ *
+ *       Each probe timestamps the entry and the exit of a section
+ *  of code (an ISR, a control cycle...) with the DWT cycle counter.
+ *  It accumulates min / max / mean of the duration, min / max of
+ *  the period between two entries (jitter) and a histogram of the
+ *  durations in powers of 2. All the data are in fixed memory.
+ *
+ *       With TIMING_PROBE_HOST defined, this file does not depend
+ *  on MBED OS : the timestamps are given by the host clock, in ns.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef __TIMINGPROBE_HEADER_H__
+#define __TIMINGPROBE_HEADER_H__
+
+#include <cstdint>
+#ifdef TIMING_PROBE_HOST
+#include <chrono>
+#else
+#include <mbed.h>
+#endif
+
+/** Constant definition */
+/// Number of bins of the histogram - bin k counts durations in [2^k, 2^(k+1)[
+#define     TIMING_PROBE_NB_BINS        32
+/// Size of a line of the dump
+#define     TIMING_PROBE_LINE_SIZE      128
+
+/** Probe macros - empty versions in TimingProbe_config.h for the other libraries */
+/// Probe of a file (static object)
+#define     TIMING_PROBE(var, label)    static TimingProbe var(label)
+/// Probe of each object of a class : member, named in the constructor
+#define     TIMING_PROBE_MEMBER(var)    TimingProbe var
+#define     TIMING_PROBE_NAME(var, label)   var.setName(label)
+#define     TIMING_PROBE_START(var)     var.start()
+#define     TIMING_PROBE_STOP(var)      var.stop()
+
+/// Output function of the dump - one line per call
+typedef void (*TimingProbe_Output)(const char *line);
+
+/**
+ * @struct TimingProbe_Stats
+ * @brief Statistics of a probe, in timestamp unit
+ */
+struct TimingProbe_Stats{
+    /// Number of executions
+    uint32_t    count;
+    /// Shortest duration
+    uint32_t    min;
+    /// Longest duration
+    uint32_t    max;
+    /// Sum of the durations (for the mean)
+    uint64_t    sum;
+    /// Shortest period between two entries
+    uint32_t    period_min;
+    /// Longest period between two entries
+    uint32_t    period_max;
+    /// Number of durations longer than the budget
+    uint32_t    overruns;
+    /// Histogram of the durations
+    uint32_t    bins[TIMING_PROBE_NB_BINS];
+};
+
+/**
+ * @class TimingProbe
+ * @brief Measure the duration of a section of code
+ * @details     start() and stop() are inline and only use a few
+ *  cycles (one read of the cycle counter, a few compares, additions
+ *  and a CLZ instruction) : probes can stay in production code.
+ *      A probe must not be nested with itself. Its statistics are
+ *  updated by a single context (thread or interrupt).
+ *      All the probes are registered in a list, to dump them
+ *  on demand with TimingProbe::dumpAll.
+ */
+class TimingProbe{
+    private:
+        /// Name of the probe
+        const char  *__name;
+        /// Statistics
+        TimingProbe_Stats   __stats;
+        /// Timestamp of the last entry
+        uint32_t    __entry;
+        /// Longest expected duration - 0 if not used
+        uint32_t    __budget;
+        /// Next probe of the list
+        TimingProbe *__next;
+        /// First probe of the list
+        static TimingProbe  *__first;
+
+    public:
+        /**
+        * @brief Simple constructor of the TimingProbe class.
+        * @details The probe is added to the list of the probes and
+        *   the cycle counter is started.
+        * @param name name of the probe (displayed by the dump)
+        */
+        TimingProbe(const char *name = "TimingProbe");
+
+        /**
+        * @brief Start the cycle counter of the core.
+        */
+        static void init(void);
+
+        /**
+        * @brief Return the current timestamp.
+        * @return cycles of the core, or ns with TIMING_PROBE_HOST
+        */
+        static inline uint32_t now(void){
+#ifdef TIMING_PROBE_HOST
+            return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+            return DWT->CYCCNT;
+#endif
+        }
+
+        /**
+        * @brief Timestamp of the entry of the section.
+        */
+        inline void start(void){
+            uint32_t t = now();
+            if(this->__stats.count != 0){
+                uint32_t period = t - this->__entry;
+                if(period < this->__stats.period_min){ this->__stats.period_min = period; }
+                if(period > this->__stats.period_max){ this->__stats.period_max = period; }
+            }
+            this->__entry = t;
+        }
+
+        /**
+        * @brief Timestamp of the exit of the section and update of the statistics.
+        */
+        inline void stop(void){
+            uint32_t d = now() - this->__entry;
+            if(d < this->__stats.min){ this->__stats.min = d; }
+            if(d > this->__stats.max){ this->__stats.max = d; }
+            if(this->__budget && (d > this->__budget)){ this->__stats.overruns++; }
+            this->__stats.sum += d;
+            this->__stats.count++;
+            this->__stats.bins[(d == 0) ? 0 : (31 - __builtin_clz(d))]++;
+        }
+
+        /**
+        * @brief Set the longest expected duration.
+        * @param budget duration in timestamp unit, 0 to disable the overrun count
+        */
+        void setBudget(uint32_t budget);
+
+        /**
+        * @brief Clear the statistics.
+        */
+        void reset(void);
+
+        /**
+        * @brief Set the name of the probe - probe member of a class.
+        * @param name name of the probe (displayed by the dump)
+        */
+        void setName(const char *name);
+
+        /**
+        * @brief Return the name of the probe.
+        */
+        const char *getName(void);
+
+        /**
+        * @brief Copy the statistics of the probe.
+        * @param stats structure to fill
+        */
+        void getStats(TimingProbe_Stats *stats);
+
+        /**
+        * @brief Write the statistics of the probe, line by line.
+        * @param output function called for each line
+        */
+        void dump(TimingProbe_Output output);
+
+        /**
+        * @brief Write the statistics of all the probes.
+        * @param output function called for each line
+        */
+        static void dumpAll(TimingProbe_Output output);
+
+        /**
+        * @brief Clear the statistics of all the probes.
+        */
+        static void resetAll(void);
+};
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * FILENAME :        main_TimingProbe.cpp
+ *
+ * DESCRIPTION :
+ *       TimingProbe / Program for testing the timing probes library.
+ *
+ * NOTES :
+ *       Developped by Villou / LEnsE
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include "mbed.h"
+#include <string.h>
+#include "TimingProbe.h"
+
+#define WAIT_TIME_MS 5000
+UnbufferedSerial    my_pc(USBTX, USBRX);
+char            charStr[128];
+
+DigitalOut      my_led(LED1);
+Ticker          my_tik;
+
+TIMING_PROBE(probe_tik, "ISR_tik");
+
+void ISR_tik(void){
+    TIMING_PROBE_START(probe_tik);
+    my_led = !my_led;
+    TIMING_PROBE_STOP(probe_tik);
+}
+
+void print_line(const char *line){
+    my_pc.write(line, strlen(line));
+}
+
+int main()
+{
+    my_pc.baud(115200);
+    sprintf(charStr, "Mbed OS %d.%d.%d.\r\n", MBED_MAJOR_VERSION, MBED_MINOR_VERSION, MBED_PATCH_VERSION);
+    my_pc.write(charStr, strlen(charStr));
+
+    // overrun if the ISR is longer than 1 us
+    probe_tik.setBudget(SystemCoreClock / 1000000);
+    my_tik.attach(&ISR_tik, 1ms);
+
+    while (true)
+    {
+        thread_sleep_for(WAIT_TIME_MS);
+        TimingProbe::dumpAll(print_line);
+        TimingProbe::resetAll();
+    }
+}
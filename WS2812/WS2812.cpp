@@ -1,4 +1,7 @@
 #include "WS2812.h"
+#include "TimingProbe_config.h"
+
+TIMING_PROBE(probe_send_leds, "WS2812::send_leds");
 
 /* WS2812B */
 /*  T0H = 0.4us / T0L = 0.85us
@@ -51,6 +54,7 @@ void WS2812::send_led_trame(int cl){
 }
 
 void WS2812::send_leds(int *leds){
+    TIMING_PROBE_START(probe_send_leds);
     __disable_irq();
     if(this->__nb_bits == 32){
         
@@ -59,6 +63,7 @@ void WS2812::send_leds(int *leds){
         this->send_led_trame(leds[k]);
     }
     __enable_irq();
+    TIMING_PROBE_STOP(probe_send_leds);
 }
 
 void WS2812::set_timings(int t0h, int t0l, int t1h, int t1l){
@@ -0,0 +1,65 @@
+/**
+ * FILENAME :        MCC_PI.cpp
+ *
+ * DESCRIPTION :
+ *       Fixed-point Proportional - Integral controller with feed-forward.
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include    "MCC_PI.h"
+
+MCC_PI::MCC_PI(void){
+    this->_kp = 0;
+    this->_ki = 0;
+    this->_kff = 0;
+    this->_limit = MCC_PI_FULL_SCALE;
+    this->_integral = 0;
+    this->_out = 0;
+}
+
+void MCC_PI::setGains(float kp, float ki, float kff){
+    this->_kp = (int32_t)(kp * (1 << MCC_PI_SHIFT));
+    this->_ki = (int32_t)(ki * (1 << MCC_PI_SHIFT));
+    this->_kff = (int32_t)(kff * (1 << MCC_PI_SHIFT));
+}
+
+void MCC_PI::setLimit(int32_t limit){
+    this->_limit = (limit < 0) ? -limit : limit;
+}
+
+void MCC_PI::reset(void){
+    this->_integral = 0;
+    this->_out = 0;
+}
+
+int32_t MCC_PI::update(int32_t setpoint, int32_t measure){
+    int32_t     error = setpoint - measure;
+    int64_t     limit = (int64_t)this->_limit << MCC_PI_SHIFT;
+    int64_t     integral = this->_integral + (int64_t)this->_ki * error;
+    // the integral term alone can not exceed the limit
+    if(integral > limit){ integral = limit; }
+    if(integral < -limit){ integral = -limit; }
+
+    int64_t     out = (int64_t)this->_kff * setpoint + (int64_t)this->_kp * error;
+    if(((out + integral) > limit) && (error > 0)){
+        // saturated : the integral term is frozen
+        integral = this->_integral;
+    }
+    else if(((out + integral) < -limit) && (error < 0)){
+        integral = this->_integral;
+    }
+    this->_integral = integral;
+    out += integral;
+
+    if(out > limit){ out = limit; }
+    if(out < -limit){ out = -limit; }
+    this->_out = (int32_t)(out >> MCC_PI_SHIFT);
+    return this->_out;
+}
+
+int32_t MCC_PI::getOutput(void){
+    return this->_out;
+}
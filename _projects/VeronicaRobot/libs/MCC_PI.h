@@ -0,0 +1,91 @@
+/**
+ * FILENAME :        MCC_PI.h
+ *
+ * DESCRIPTION :
+ *       Fixed-point Proportional - Integral controller with feed-forward.
+ *
+ *       This file does not depend on MBED OS. It can be compiled
+ *  on a computer to simulate the loop with a model of the motor.
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef     __MCC_PI_H_HEADER_H__
+#define     __MCC_PI_H_HEADER_H__
+
+#include    <cstdint>
+
+/** Constant definition */
+/// Number of fractional bits of the gains (Q16.16)
+#define     MCC_PI_SHIFT        16
+/// Full scale of the output (Q15 : 32767 = 100 %)
+#define     MCC_PI_FULL_SCALE   32767
+
+/**
+ * @class MCC_PI
+ * @brief Proportional - Integral controller in fixed-point
+ * @details     out = kff * setpoint + kp * error + sum(ki * error)
+ *      Gains are stored in Q16.16, the integral term in Q16.16 of
+ *  the output unit. Each update uses only integer operations
+ *  (no division) : its execution time does not depend on the values.
+ *      Anti-windup : the integral term is frozen when the output
+ *  is saturated and the error would push it further.
+ */
+class MCC_PI{
+    private:
+        /// Proportional gain in Q16.16
+        int32_t         _kp;
+        /// Integral gain per cycle in Q16.16
+        int32_t         _ki;
+        /// Feed-forward gain in Q16.16
+        int32_t         _kff;
+        /// Limit of the output (symmetric)
+        int32_t         _limit;
+        /// Integral term in Q16.16
+        int64_t         _integral;
+        /// Last output
+        int32_t         _out;
+
+    public:
+        /**
+        * @brief Simple constructor of the MCC_PI class.
+        * @details All the gains are 0, the limit is MCC_PI_FULL_SCALE.
+        */
+        MCC_PI(void);
+
+        /**
+        * @brief Set the gains of the controller.
+        * @param kp proportional gain
+        * @param ki integral gain per cycle (Ki * period of the loop)
+        * @param kff feed-forward gain
+        */
+        void setGains(float kp, float ki, float kff = 0);
+
+        /**
+        * @brief Set the limit of the output.
+        * @param limit highest absolute value of the output
+        */
+        void setLimit(int32_t limit);
+
+        /**
+        * @brief Reset the integral term.
+        */
+        void reset(void);
+
+        /**
+        * @brief Compute a new output of the controller.
+        * @param setpoint setpoint of the loop
+        * @param measure measure of the loop
+        * @return output, between -limit and limit
+        */
+        int32_t update(int32_t setpoint, int32_t measure);
+
+        /**
+        * @brief Return the last output of the controller.
+        */
+        int32_t getOutput(void);
+};
+
+#endif
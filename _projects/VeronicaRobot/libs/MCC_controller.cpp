@@ -0,0 +1,144 @@
+/**
+ * FILENAME :        MCC_controller.cpp
+ *
+ * DESCRIPTION :
+ *       Speed and synchronization control of two Direct Current motors.
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include    "MCC_controller.h"
+#include "TimingProbe_config.h"
+
+TIMING_PROBE(probe_control, "MCC_controller::controlCycle");
+
+MCC_controller::MCC_controller(MCC_motor *left, MCC_motor *right)
+        : _control_thread(osPriorityRealtime, MCC_CONTROL_STACK_SIZE){
+    this->_motor[0] = left;
+    this->_motor[1] = right;
+    this->_sync = true;
+    this->_running = false;
+    this->_thread_started = false;
+    this->_ticks = 0;
+    this->_cycles = 0;
+    this->_overruns = 0;
+    this->_sync_ref = 0;
+    this->_period_q16 = 0;
+    for(int i = 0; i < 2; i++){
+        this->_setpoint[i] = 0;
+        this->_speed[i] = 0;
+        this->_origin[i] = 0;
+    }
+}
+
+MCC_PI *MCC_controller::getSpeedLoop(uint8_t wheel){
+    return &(this->_speed_loop[wheel & 1]);
+}
+
+MCC_PI *MCC_controller::getSyncLoop(void){
+    return &(this->_sync_loop);
+}
+
+void MCC_controller::setSync(bool enable){
+    CriticalSectionLock lock;
+    this->_sync = enable;
+}
+
+void MCC_controller::setSpeed(int32_t left, int32_t right){
+    CriticalSectionLock lock;
+    this->_setpoint[0] = left;
+    this->_setpoint[1] = right;
+}
+
+int32_t MCC_controller::getSpeed(uint8_t wheel){
+    return this->_speed[wheel & 1];
+}
+
+uint32_t MCC_controller::getOverruns(void){
+    return this->_overruns;
+}
+
+/**************************************************************
+ *	Control loop
+ **************************************************************/
+
+void MCC_controller::start(std::chrono::microseconds period){
+    if(this->_running){ return; }
+    this->_period_q16 = (int32_t)(((int64_t)period.count() << MCC_PI_SHIFT) / 1000000);
+    this->_sync_ref = 0;
+    for(int i = 0; i < 2; i++){
+        this->_origin[i] = this->_motor[i]->getCoderCnt();
+        this->_speed_loop[i].reset();
+    }
+    this->_sync_loop.reset();
+    this->_cycles = this->_ticks;
+    this->_running = true;
+    if(!this->_thread_started){
+        this->_control_thread.start(callback(this, &MCC_controller::controlTask));
+        this->_thread_started = true;
+    }
+    this->_control_tik.attach(callback(this, &MCC_controller::ISR_control), period);
+}
+
+void MCC_controller::stop(void){
+    this->_control_tik.detach();
+    this->_running = false;
+    this->_motor[0]->stop();
+    this->_motor[1]->stop();
+}
+
+void MCC_controller::ISR_control(void){
+    this->_ticks++;
+    this->_control_flags.set(MCC_CONTROL_FLAG);
+}
+
+void MCC_controller::controlTask(void){
+    while(true){
+        this->_control_flags.wait_any(MCC_CONTROL_FLAG);
+        if(!this->_running){ continue; }
+        // a tick arrived while the previous cycle was running
+        uint32_t ticks = this->_ticks;
+        if(ticks - this->_cycles > 1){
+            this->_overruns += ticks - this->_cycles - 1;
+        }
+        this->_cycles = ticks;
+        this->controlCycle();
+    }
+}
+
+void MCC_controller::controlCycle(void){
+    TIMING_PROBE_START(probe_control);
+    int32_t     setpoint[2];
+    bool        sync;
+    {
+        CriticalSectionLock lock;
+        setpoint[0] = this->_setpoint[0];
+        setpoint[1] = this->_setpoint[1];
+        sync = this->_sync;
+    }
+
+    /* Measures */
+    int32_t     position[2];
+    for(int i = 0; i < 2; i++){
+        this->_speed[i] = (int32_t)this->_motor[i]->getCoderSpeed();
+        position[i] = this->_motor[i]->getCoderCnt() - this->_origin[i];
+    }
+
+    /* Synchronization loop */
+    this->_sync_ref += (int64_t)(setpoint[0] - setpoint[1]) * this->_period_q16;
+    if(sync){
+        int32_t correction = this->_sync_loop.update(
+                (int32_t)(this->_sync_ref >> MCC_PI_SHIFT), position[0] - position[1]);
+        setpoint[0] += correction;
+        setpoint[1] -= correction;
+    }
+
+    /* Speed loops */
+    for(int i = 0; i < 2; i++){
+        int32_t out = this->_speed_loop[i].update(setpoint[i], this->_speed[i]);
+        this->_motor[i]->rotate((float)out / MCC_PI_FULL_SCALE);
+    }
+    TIMING_PROBE_STOP(probe_control);
+}
@@ -0,0 +1,154 @@
+/**
+ * FILENAME :        MCC_controller.h
+ *
+ * DESCRIPTION :
+ *       Speed and synchronization control of two Direct Current motors.
+ *
+ *       A Ticker wakes up a high priority thread at a fixed rate.
+ *  Each cycle measures the speed of the wheels (see MCC_motor),
+ *  runs a synchronization loop on the difference of position
+ *  and a speed loop on each wheel (see MCC_PI), then updates
+ *  the duty cycle of the motors.
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#ifndef     __MCC_CONTROLLER_H_HEADER_H__
+#define     __MCC_CONTROLLER_H_HEADER_H__
+
+#include    "mbed.h"
+#include    "MCC_motor.h"
+#include    "MCC_PI.h"
+
+/** Constant definition */
+/// Default period of the control loop
+#define     MCC_CONTROL_PERIOD      10ms
+/// Stack size of the control thread
+#define     MCC_CONTROL_STACK_SIZE  1024
+/// Event flag of the control cycle
+#define     MCC_CONTROL_FLAG        0x01
+
+/**
+ * @class MCC_controller
+ * @brief Closed-loop speed control of two wheels
+ * @details     Speeds are in counts of the coder per second.
+ *      The synchronization loop keeps the difference of position
+ *  between the wheels equal to the integral of the difference of
+ *  the setpoints (0 for a straight line). Its output corrects
+ *  the setpoints of the speed loops, in opposite directions.
+ *      The work of a cycle is bounded : 3 updates of MCC_PI,
+ *  2 speed estimations and 2 PWM updates. Nothing is done
+ *  in interrupt context.
+ */
+class MCC_controller{
+    private:
+        /// Motors of the wheels
+        MCC_motor       *_motor[2];
+        /// Speed loop of each wheel - output is the duty cycle in Q15
+        MCC_PI          _speed_loop[2];
+        /// Synchronization loop - output is a speed in counts per second
+        MCC_PI          _sync_loop;
+        /// Synchronization loop is used
+        bool            _sync;
+
+        /// Setpoints of the wheels in counts per second
+        int32_t         _setpoint[2];
+        /// Measured speeds of the wheels in counts per second
+        volatile int32_t    _speed[2];
+        /// Counters of the coders at the start of the control
+        int32_t         _origin[2];
+        /// Expected difference of position in counts (Q16.16)
+        int64_t         _sync_ref;
+        /// Period of the loop in s (Q16.16)
+        int32_t         _period_q16;
+
+        /// Control is running
+        volatile bool   _running;
+        /// Ticker of the control cycles
+        Ticker          _control_tik;
+        /// Thread of the control cycles
+        Thread          _control_thread;
+        /// Flags set by the ticker
+        EventFlags      _control_flags;
+        /// Thread is started
+        bool            _thread_started;
+        /// Number of ticks of the Ticker
+        volatile uint32_t   _ticks;
+        /// Number of cycles done
+        uint32_t        _cycles;
+        /// Number of ticks missed by the thread
+        volatile uint32_t   _overruns;
+
+        /**
+        * @brief Interrupt routine of the Ticker - wakes up the thread.
+        */
+        void ISR_control(void);
+
+        /**
+        * @brief Main loop of the control thread.
+        */
+        void controlTask(void);
+
+        /**
+        * @brief One cycle of the control.
+        */
+        void controlCycle(void);
+
+    public:
+        /**
+        * @brief Simple constructor of the MCC_controller class.
+        * @param left motor of the left wheel (coder pins must be set)
+        * @param right motor of the right wheel (coder pins must be set)
+        */
+        MCC_controller(MCC_motor *left, MCC_motor *right);
+
+        /**
+        * @brief Return the speed loop of a wheel - to set the gains.
+        * @param wheel 0 for left, 1 for right
+        */
+        MCC_PI *getSpeedLoop(uint8_t wheel);
+
+        /**
+        * @brief Return the synchronization loop - to set the gains.
+        */
+        MCC_PI *getSyncLoop(void);
+
+        /**
+        * @brief Use or not the synchronization loop.
+        * @param enable true to use the synchronization loop
+        */
+        void setSync(bool enable);
+
+        /**
+        * @brief Set the speed setpoints of the wheels.
+        * @param left setpoint of the left wheel in counts per second
+        * @param right setpoint of the right wheel in counts per second
+        */
+        void setSpeed(int32_t left, int32_t right);
+
+        /**
+        * @brief Return the measured speed of a wheel in counts per second.
+        * @param wheel 0 for left, 1 for right
+        */
+        int32_t getSpeed(uint8_t wheel);
+
+        /**
+        * @brief Start the control loop.
+        * @param period period of the control loop
+        */
+        void start(std::chrono::microseconds period = MCC_CONTROL_PERIOD);
+
+        /**
+        * @brief Stop the control loop and the motors.
+        */
+        void stop(void);
+
+        /**
+        * @brief Return the number of control cycles missed by the thread.
+        */
+        uint32_t getOverruns(void);
+};
+
+#endif
@@ -11,11 +11,21 @@
 
  #include   "MCC_motor.h"
 
+// state detection of CPR encoder - https://www.cuidevices.com/blog/what-is-encoder-ppr-cpr-and-lpr#cpr
+//  state = (B << 1) + A ; clockwise : 0 > 2 > 3 > 1 > 0
+const int8_t MCC_motor::_coder_table[16] = {
+    /* old 0 */     0, -1,  1, MCC_CODER_ILLEGAL,
+    /* old 1 */     1,  0, MCC_CODER_ILLEGAL, -1,
+    /* old 2 */    -1, MCC_CODER_ILLEGAL,  0,  1,
+    /* old 3 */    MCC_CODER_ILLEGAL,  1, -1,  0
+};
+
 MCC_motor::MCC_motor(PwmOut *D1, PwmOut *D2){
     this->_enable = false;
     this->_enGlobal = false;
     this->_coder = false;
     this->_period_us = 500;
+    TIMING_PROBE_NAME(this->_probe_coder, "MCC_motor::ISR_coder_counter");
 
     if (D1){ delete this->_D1; }
     this->_D1 = D1;
@@ -106,7 +116,13 @@ void MCC_motor::setCoderPin(InterruptIn *cA, InterruptIn *cB, bool inc){
     if (cB){ delete this->_cB; }
         this->_cB = cB; 
     this->_cnt_coder = 0;
+    this->_err_coder = 0;
+    this->_edge_us = us_ticker_read();
+    this->_speed_cnt = 0;
+    this->_speed_edge_us = this->_edge_us;
+    this->_speed = 0;
     this->_inc_cnt = inc;
+    this->_coder_old_state = (this->_cB->read() << 1) + this->_cA->read();
     // 4 states per count
     this->_cA->rise(callback(this, &MCC_motor::ISR_coder_counter));
     this->_cA->fall(callback(this, &MCC_motor::ISR_coder_counter));
@@ -115,19 +131,58 @@ void MCC_motor::setCoderPin(InterruptIn *cA, InterruptIn *cB, bool inc){
 }
 
 int MCC_motor::getCoderCnt(void){
-    return this->_cnt_coder;
+    return core_util_atomic_load_s32(&this->_cnt_coder);
 }
 
-void MCC_motor::ISR_coder_counter(void){
-    // state detection of CPR encoder - https://www.cuidevices.com/blog/what-is-encoder-ppr-cpr-and-lpr#cpr
-    this->_coder_new_state = (this->_cB->read() << 1) + this->_cA->read();
-    if(this->_coder_anticlockwise[this->_coder_old_state] == this->_coder_new_state){
-        this->_cnt_coder--;
+uint32_t MCC_motor::getCoderErrors(void){
+    return core_util_atomic_load_u32(&this->_err_coder);
+}
+
+float MCC_motor::getCoderSpeed(void){
+    int32_t     cnt;
+    uint32_t    edge_us;
+    {
+        CriticalSectionLock lock;
+        cnt = this->_cnt_coder;
+        edge_us = this->_edge_us;
+    }
+    uint32_t    now_us = us_ticker_read();
+    int32_t     delta_cnt = cnt - this->_speed_cnt;
+    uint32_t    delta_us = edge_us - this->_speed_edge_us;
+
+    if((delta_cnt != 0) && (delta_us != 0)){
+        // new edges : counts between the first and the last edges
+        this->_speed = delta_cnt * 1000000.0f / delta_us;
+        this->_speed_cnt = cnt;
+        this->_speed_edge_us = edge_us;
     }
     else{
-        if(this->_coder_clockwise[this->_coder_old_state] == this->_coder_new_state){
-            this->_cnt_coder++;
+        uint32_t    wait_us = now_us - this->_speed_edge_us;
+        if(wait_us > MCC_SPEED_TIMEOUT_US){
+            this->_speed = 0;
+        }
+        else if(wait_us != 0){
+            // the next edge is at least 1 count away
+            float   bound = 1000000.0f / wait_us;
+            if(this->_speed > bound){ this->_speed = bound; }
+            if(this->_speed < -bound){ this->_speed = -bound; }
         }
     }
-    this->_coder_old_state = this->_coder_new_state;    
-}
\ No newline at end of file
+    return this->_speed;
+}
+
+void MCC_motor::ISR_coder_counter(void){
+    TIMING_PROBE_START(this->_probe_coder);
+    uint8_t     new_state = (this->_cB->read() << 1) + this->_cA->read();
+    int8_t      inc = _coder_table[(this->_coder_old_state << 2) | new_state];
+    this->_coder_old_state = new_state;
+    if(inc == MCC_CODER_ILLEGAL){
+        this->_err_coder++;
+    }
+    else if(inc != 0){
+        // the ISR is the only writer : load + store is enough
+        this->_cnt_coder += inc;
+        this->_edge_us = us_ticker_read();
+    }
+    TIMING_PROBE_STOP(this->_probe_coder);
+}
@@ -13,8 +13,13 @@
 #define     __MCC_MOTOR_H_HEADER_H__
 
 #include    "mbed.h"
+#include    "TimingProbe_config.h"
 
-
+/** Constant definition */
+/// Value of an illegal transition in the decoding table (both channels changed)
+#define     MCC_CODER_ILLEGAL       2
+/// No edge during this time (in us) means the motor is stopped
+#define     MCC_SPEED_TIMEOUT_US    100000
 
 /**
  * @class MCC_motor
@@ -39,8 +44,12 @@ class MCC_motor{
 
         /// Coder used or no
         bool            _coder;
-        /// Counter for the coder
-        int             _cnt_coder;
+        /// Counter for the coder - written by the ISR only
+        volatile int32_t    _cnt_coder;
+        /// Number of illegal transitions (missed edges)
+        volatile uint32_t   _err_coder;
+        /// Time of the last edge in us
+        volatile uint32_t   _edge_us;
         /// Counter incrementation direction.
         bool            _inc_cnt;
 
@@ -51,10 +60,18 @@ class MCC_motor{
         /// tik number per tour value for CPR encoder
         int             tik_per_tour;
         /// state of the encoder
-        uint8_t         _coder_new_state;
         uint8_t         _coder_old_state;
-        const       uint8_t         _coder_anticlockwise[4] = {1, 3, 0, 2};
-        const       uint8_t         _coder_clockwise[4] = {2, 0, 3, 1};
+        /// Decoding table - index is (old_state << 2) | new_state
+        static const    int8_t      _coder_table[16];
+
+        /// Speed estimation - counter at the last call
+        int32_t         _speed_cnt;
+        /// Speed estimation - time of the last edge at the last call in us
+        uint32_t        _speed_edge_us;
+        /// Speed estimation - last value in counts per second
+        float           _speed;
+        /// Duration of the coder interrupt routine of this motor (TIMING_PROBE_ENABLED)
+        TIMING_PROBE_MEMBER(_probe_coder);
 
 
     public:
@@ -135,6 +152,24 @@ class MCC_motor{
         */
         int getCoderCnt(void);
 
+        /**
+        * @brief Return the number of illegal transitions of the coder.
+        * @details Both channels changed between two interrupts : an edge was missed.
+        * @return number of illegal transitions
+        */
+        uint32_t getCoderErrors(void);
+
+        /**
+        * @brief Return the speed of the coder in counts per second.
+        * @details Counts since the last call divided by the time between
+        *   the last edges (M/T method) : accurate at high speed (many counts)
+        *   and at low speed (edge period). Without new edge, the speed
+        *   is bounded by the time since the last edge.
+        *   To call periodically, from a single thread.
+        * @return speed in counts per second (signed)
+        */
+        float getCoderSpeed(void);
+
         /**
         * @brief Interrupt SubRoutine for coder event detection.
         */        
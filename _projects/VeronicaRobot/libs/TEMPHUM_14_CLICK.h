@@ -20,11 +20,13 @@
 
 #include <cstdint>
 #include <mbed.h>
+#include "I2C_Bus.h"
  
 /** Constant definition */
 #define     DEBUG_MODE                  1
 
 #define     TEMPHUM_14_CLICK_ADD            0x40
+#define     TEMPHUM_14_CLICK_FREQ           400000
 #define     TEMPHUM_14_CLICK_PART_ID        0x0A
 #define     TEMPHUM_14_CLICK_DIAG           0x08
 #define     TEMPHUM_14_CLICK_CONV           0x40
@@ -57,9 +59,23 @@ class TempHum_14_Click{
         
         /// I2C interface pins 
         I2C             *__i2c = NULL;
+        /// Shared I2C bus - NULL if the I2C interface is used
+        I2C_Bus         *__bus = NULL;
         /// reset input of the HTU31
         DigitalOut      *__reset = NULL;
 
+        /**
+        * @brief Write data to the sensor, on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int writeData(const char *buff, int size);
+
+        /**
+        * @brief Read data from the sensor, on the I2C interface or on the bus
+        * @return 0 if acknowledgement is done
+        */
+        int readData(char *buff, int size);
+
     public:
         /**
         * @brief Simple constructor of the TempHum_14_Click class.
@@ -71,6 +87,14 @@ class TempHum_14_Click{
         */
         TempHum_14_Click(I2C *_i2c, DigitalOut *_rst);
 
+        /**
+        * @brief Constructor of the TempHum_14_Click class on a shared I2C bus.
+        * @details Transactions are sent at TEMPHUM_14_CLICK_FREQ
+        * @param _bus shared I2C bus
+        * @param _rst reset input of the HTU31 
+        */
+        TempHum_14_Click(I2C_Bus *_bus, DigitalOut *_rst);
+
         /**
         * @brief Reset of the sensor
         * @details Reset of the sensor / 5 ms
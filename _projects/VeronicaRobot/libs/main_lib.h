@@ -17,6 +17,7 @@
 #include    "TEMPHUM_14_CLICK.h"
 #include    "MOD24_NRF.h"
 #include    "MCC_motor.h"
+#include    "MCC_controller.h"
 #define     WAIT_TIME_MS 500 
 
 // For debugging
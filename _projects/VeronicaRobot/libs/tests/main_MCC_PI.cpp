@@ -0,0 +1,229 @@
+/**
+ * FILENAME :        main_MCC_PI.cpp
+ *
+ * DESCRIPTION :
+ *       Simulation of the speed loop (MCC_PI) with a model of the motor.
+ *
+ *       This program does not depend on MBED OS. It has its own main()
+ *  and is not compiled with the robot (tests/.mbedignore). From libs :
+ *          g++ -O2 -I. tests/main_MCC_PI.cpp MCC_PI.cpp -o mcc_pi
+ *          ./mcc_pi        -> checks of the loop, exit code 1 if one fails
+ *          ./mcc_pi csv    -> time;setpoint;speed;output of all the tests
+ *
+ *       The motor is a first order system : speed in counts per second,
+ *  input in Q15 (MCC_PI_FULL_SCALE = 100 % PWM), measured as in
+ *  MCC_controller (counts of the coder during one period).
+ *       Each test checks the response of the loop :
+ *          -> step inside the range : overshoot, settling time, static error
+ *          -> step above the highest speed : output saturated, integral term
+ *              limited (anti-windup), then return to a reachable setpoint
+ *              compared to the same loop without anti-windup
+ *          -> load on the motor : the integral term cancels the static error
+ *          -> lower limit of the output (setLimit), negative speeds
+ **
+ * AUTHOR :    Julien VILLEMEJANE        START DATE :    19/oct/2026
+ *
+ *       LEnsE / Institut d'Optique Graduate School
+ */
+
+#include    <cstdio>
+#include    <cstring>
+#include    <cmath>
+#include    "MCC_PI.h"
+
+/** Constant definition */
+/// Period of the loop in s (MCC_CONTROL_PERIOD)
+#define     SIM_PERIOD          0.01
+/// Speed of the motor at 100 % PWM, in counts per second
+#define     SIM_MOTOR_SPEED     3000.0
+/// Time constant of the motor in s
+#define     SIM_MOTOR_TAU       0.05
+/// Sub-steps of the model during one period
+#define     SIM_SUBSTEPS        20
+/// Static error and band of the settling time, in counts per second
+/// (resolution of the measure : 1 count per period)
+#define     SIM_BAND            (2.0 / SIM_PERIOD)
+/// Overshoot, relative to the step of the setpoint
+#define     SIM_OVERSHOOT       0.25
+/// Settling time in s
+#define     SIM_SETTLING        0.3
+
+/// Print all the samples (csv argument)
+bool        sim_csv = false;
+double      sim_time = 0;
+
+/**
+ * @class SimMotor
+ * @brief First order model of a DC motor with a coder
+ */
+class SimMotor{
+    public:
+        double      speed;
+        double      position;
+        int32_t     last_count;
+        /// Load : speed lost at 100 % PWM, in counts per second
+        double      load;
+
+        SimMotor(void){
+            this->speed = 0;
+            this->position = 0;
+            this->last_count = 0;
+            this->load = 0;
+        }
+
+        /**
+        * @brief One period of the loop with a constant input.
+        * @param out input in Q15
+        * @return measured speed in counts per second
+        */
+        int32_t run(int32_t out){
+            double u = (double)out / MCC_PI_FULL_SCALE;
+            double dt = SIM_PERIOD / SIM_SUBSTEPS;
+            for(int k = 0; k < SIM_SUBSTEPS; k++){
+                double target = u * SIM_MOTOR_SPEED - this->load;
+                this->speed += (target - this->speed) * dt / SIM_MOTOR_TAU;
+                this->position += this->speed * dt;
+            }
+            int32_t count = (int32_t)floor(this->position);
+            int32_t measure = (int32_t)((count - this->last_count) / SIM_PERIOD);
+            this->last_count = count;
+            return measure;
+        }
+};
+
+/**
+ * @class SimFloatPI
+ * @brief Same controller without anti-windup (reference)
+ */
+class SimFloatPI{
+    public:
+        double      kp, ki, kff, integral, limit;
+
+        int32_t update(int32_t setpoint, int32_t measure){
+            double error = setpoint - measure;
+            this->integral += this->ki * error;
+            double out = this->kff * setpoint + this->kp * error + this->integral;
+            if(out > this->limit){ out = this->limit; }
+            if(out < -this->limit){ out = -this->limit; }
+            return (int32_t)out;
+        }
+};
+
+/**
+ * @struct SimResult
+ * @brief Response of the loop to a setpoint
+ */
+struct SimResult{
+    int32_t     final_speed;
+    int32_t     max_speed;
+    int32_t     min_speed;
+    int32_t     max_out;
+    int32_t     min_out;
+    /// Time to enter the band around the setpoint for good, in s
+    double      settling;
+};
+
+/**
+ * @brief Run a loop for a duration with a constant setpoint.
+ */
+template <class PI>
+SimResult simulate(PI &pi, SimMotor &motor, int32_t setpoint, double duration){
+    SimResult   res;
+    int32_t     measure = (int32_t)motor.speed;
+    res.max_speed = INT32_MIN;
+    res.min_speed = INT32_MAX;
+    res.max_out = INT32_MIN;
+    res.min_out = INT32_MAX;
+    res.settling = 0;
+    for(double t = 0; t < duration; t += SIM_PERIOD){
+        int32_t out = pi.update(setpoint, measure);
+        measure = motor.run(out);
+        sim_time += SIM_PERIOD;
+        if(sim_csv){ printf("%.2f;%d;%d;%d\n", sim_time, setpoint, measure, out); }
+        if(measure > res.max_speed){ res.max_speed = measure; }
+        if(measure < res.min_speed){ res.min_speed = measure; }
+        if(out > res.max_out){ res.max_out = out; }
+        if(out < res.min_out){ res.min_out = out; }
+        if(fabs((double)(measure - setpoint)) > SIM_BAND){ res.settling = t + SIM_PERIOD; }
+    }
+    res.final_speed = measure;
+    return res;
+}
+
+int         sim_failed = 0;
+
+void check(const char *name, bool ok, const char *format, double a, double b){
+    char    values[64];
+    snprintf(values, sizeof(values), format, a, b);
+    if(!sim_csv){ printf("%-48s %-36s %s\n", name, values, ok ? "OK" : "FAILED"); }
+    if(!ok){ sim_failed++; }
+}
+
+int main(int argc, char *argv[])
+{
+    sim_csv = (argc > 1) && (strcmp(argv[1], "csv") == 0);
+    /* Gains : the PI zero cancels the pole of the motor */
+    double  g = SIM_MOTOR_SPEED / MCC_PI_FULL_SCALE;      // counts/s per LSB
+    double  kp = 1.0 / g;
+    double  ki = kp * SIM_PERIOD / SIM_MOTOR_TAU;
+    double  kff = 1.0 / g;
+    MCC_PI      pi;
+    SimMotor    motor;
+    SimResult   res;
+    pi.setGains(kp, ki, kff);
+
+    /* Step inside the range */
+    res = simulate(pi, motor, 1500, 1.0);
+    check("Step 0 -> 1500 : overshoot, settling (s)",
+            (res.max_speed <= 1500 * (1 + SIM_OVERSHOOT)) && (res.settling < SIM_SETTLING),
+            "%.0f, %.2f", res.max_speed, res.settling);
+    check("Step 0 -> 1500 : static error",
+            fabs((double)(res.final_speed - 1500)) <= SIM_BAND,
+            "%.0f (band %.0f)", res.final_speed - 1500, SIM_BAND);
+
+    /* Saturation : the setpoint can not be reached */
+    res = simulate(pi, motor, 4500, 2.0);
+    check("Step 1500 -> 4500 : output, speed",
+            (res.max_out == MCC_PI_FULL_SCALE) && (res.final_speed <= SIM_MOTOR_SPEED),
+            "%.0f, %.0f", res.max_out, res.final_speed);
+    // the integral term is the same as before the saturation
+    res = simulate(pi, motor, 1500, 1.0);
+    SimResult   res_aw = res;
+    check("Step 4500 -> 1500 : undershoot, settling (s)",
+            (res.min_speed >= 1500 - 1500 * SIM_OVERSHOOT) && (res.settling < SIM_SETTLING),
+            "%.0f, %.2f", res.min_speed, res.settling);
+
+    /* Same sequence without anti-windup */
+    SimFloatPI  ref = {kp, ki, kff, 0, MCC_PI_FULL_SCALE};
+    SimMotor    motor_ref;
+    bool        csv = sim_csv;
+    sim_csv = false;
+    simulate(ref, motor_ref, 1500, 1.0);
+    simulate(ref, motor_ref, 4500, 2.0);
+    res = simulate(ref, motor_ref, 1500, 1.0);
+    sim_csv = csv;
+    check("Without anti-windup : final speed, settling (s)",
+            res.settling > 2 * res_aw.settling, "%.0f, %.2f", res.final_speed, res.settling);
+
+    /* Load on the motor */
+    motor.load = 600;
+    res = simulate(pi, motor, 1500, 1.0);
+    check("Load of 600 counts/s : lowest speed, error",
+            fabs((double)(res.final_speed - 1500)) <= SIM_BAND,
+            "%.0f, %.0f", res.min_speed, res.final_speed - 1500);
+    motor.load = 0;
+
+    /* Lower limit of the output, negative speeds */
+    pi.setLimit(MCC_PI_FULL_SCALE / 2);
+    res = simulate(pi, motor, -3000, 2.0);
+    check("Limit 50 %, step -> -3000 : output, speed",
+            (res.min_out >= -MCC_PI_FULL_SCALE / 2) && (res.final_speed >= -SIM_MOTOR_SPEED / 2 - SIM_BAND),
+            "%.0f, %.0f", res.min_out, res.final_speed);
+    res = simulate(pi, motor, -1000, 1.0);
+    check("Step -3000 -> -1000 : overshoot, settling (s)",
+            (res.max_speed <= -1000 + 2000 * SIM_OVERSHOOT) && (res.settling < SIM_SETTLING),
+            "%.0f, %.2f", res.max_speed, res.settling);
+
+    if(!sim_csv){ printf("%d failed test(s)\n", sim_failed); }
+    return sim_failed ? 1 : 0;
+}
@@ -35,35 +35,8 @@ void        ISR_displayCnt(void){
 }
 
 /// control
-bool        controlEnable = true;
-float       rc_setpoint = 0;
-float       rc_gain = 1/100.0;
-float       display_gain = 1/1000.0;
-Ticker      controlTik;
-AnalogOut   controlError(A2);
-
-/// Proportional - Integral - Derivative digital controller 
-void        ISR_controlSpeed(void){
-    int     error;              /// Proportional
-    int     error_o = error;    /// Integral - old value of the error
-    error = my_mcc3.getCoderCnt()-my_mcc2.getCoderCnt();
-    /// Displaying on A2
-    float   errorF = 0.5 + error * display_gain;
-    controlError.write(errorF);
-
-    /// Gain control
-    float rc3 = rc_setpoint;
-    float rc2 = rc_setpoint + error * rc_gain;
-    //if(rc2 < 0.5) rc2 = 0.5;
-    //if(rc2 > 1.0) rc2 = 1.0;
-
-    /// Outputs update
-    if(controlEnable){
-        my_mcc2.rotate(rc2);
-        my_mcc3.rotate(rc3);
-    }
-
-}
+MCC_controller  my_control(&my_mcc2, &my_mcc3);
+int32_t     speed_setpoint = 0;      // counts per second
 
 
 // MAIN FUNCTION
@@ -77,13 +50,22 @@ int main()
     //initNRF24(2450);
 
     my_mcc2.setEnablePin(&Mx_en, true);
+    my_mcc3.setEnablePin(&Mx_en, true);
     my_mcc2.setCoderPin(&M2_A, &M2_B);
     my_mcc3.setCoderPin(&M3_B, &M3_A);
 
     displayTik.attach(&ISR_displayCnt, 500ms);
-    controlTik.attach(&ISR_controlSpeed, 20ms);
+
+    /// Speed loops : duty cycle (Q15) from the speed (counts/s)
+    my_control.getSpeedLoop(0)->setGains(20.0, 0.5, 8.0);
+    my_control.getSpeedLoop(1)->setGains(20.0, 0.5, 8.0);
+    /// Synchronization loop : speed correction (counts/s) from the position error (counts)
+    my_control.getSyncLoop()->setGains(5.0, 0.05);
+    my_control.getSyncLoop()->setLimit(500);
+    my_control.setSpeed(speed_setpoint, speed_setpoint);
 
     my_mcc2.setEnable();
+    my_control.start();
 
     while (true)
     {
@@ -176,7 +176,10 @@ nRF24L01P::nRF24L01P(PinName mosi,
                      PinName sck, 
                      PinName csn,
                      PinName ce,
-                     PinName irq) : spi_(mosi, miso, sck), nCS_(csn), ce_(ce), nIRQ_(irq) {
+                     PinName irq) : nCS_(csn), ce_(ce), nIRQ_(irq) {
+
+    spi_ = new SPI(mosi, miso, sck);
+    dev_ = NULL;
 
     mode = _NRF24L01P_MODE_UNKNOWN;
 
@@ -184,8 +187,42 @@ nRF24L01P::nRF24L01P(PinName mosi,
 
     nCS_ = 1;
 
-    spi_.frequency(_NRF24L01P_SPI_MAX_DATA_RATE/5);     // 2Mbit, 1/5th the maximum transfer rate for the SPI bus
-    spi_.format(8,0);                                   // 8-bit, ClockPhase = 0, ClockPolarity = 0
+    spi_->frequency(_NRF24L01P_SPI_MAX_DATA_RATE/5);    // 2Mbit, 1/5th the maximum transfer rate for the SPI bus
+    spi_->format(8,0);                                  // 8-bit, ClockPhase = 0, ClockPolarity = 0
+
+    init();
+
+}
+
+
+nRF24L01P::nRF24L01P(SPI_Device *dev,
+                     PinName ce,
+                     PinName irq) : nCS_(NC), ce_(ce), nIRQ_(irq) {
+
+    spi_ = NULL;
+    dev_ = dev;
+
+    mode = _NRF24L01P_MODE_UNKNOWN;
+
+    disable();
+
+    // 2Mbit, 8-bit, ClockPhase = 0, ClockPolarity = 0 - applied at each selection if another device used the bus
+    dev_->setFormat(8, 0, _NRF24L01P_SPI_MAX_DATA_RATE/5);
+
+    init();
+
+}
+
+
+nRF24L01P::~nRF24L01P() {
+
+    // the SPI interface is created only without a shared bus
+    if ( dev_ == NULL ) delete spi_;
+
+}
+
+
+void nRF24L01P::init(void) {
 
     wait_us(_NRF24L01P_TIMING_Tundef2pd_us);    // Wait for Power-on reset
 
@@ -212,6 +249,29 @@ nRF24L01P::nRF24L01P(PinName mosi,
 }
 
 
+void nRF24L01P::select(void) {
+
+    if ( dev_ ) dev_->select();
+    else nCS_ = 0;
+
+}
+
+
+void nRF24L01P::deselect(void) {
+
+    if ( dev_ ) dev_->deselect();
+    else nCS_ = 1;
+
+}
+
+
+int nRF24L01P::spiWrite(int value) {
+
+    return dev_ ? dev_->write(value) : spi_->write(value);
+
+}
+
+
 void nRF24L01P::powerUp(void) {
 
     int config = getRegister(_NRF24L01P_REG_CONFIG);
@@ -600,21 +660,21 @@ void nRF24L01P::setRxAddress(unsigned long long address, int width, int pipe) {
 
     int cn = (_NRF24L01P_SPI_CMD_WR_REG | (rxAddrPxRegister & _NRF24L01P_REG_ADDRESS_MASK));
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(cn);
+    int status = spiWrite(cn);
 
     while ( width-- > 0 ) {
 
         //
         // LSByte first
         //
-        spi_.write((int) (address & 0xFF));
+        spiWrite((int) (address & 0xFF));
         address >>= 8;
 
     }
 
-    nCS_ = 1;
+    deselect();
 
     int enRxAddr = getRegister(_NRF24L01P_REG_EN_RXADDR);
 
@@ -677,21 +737,21 @@ void nRF24L01P::setTxAddress(unsigned long long address, int width) {
 
     int cn = (_NRF24L01P_SPI_CMD_WR_REG | (_NRF24L01P_REG_TX_ADDR & _NRF24L01P_REG_ADDRESS_MASK));
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(cn);
+    int status = spiWrite(cn);
 
     while ( width-- > 0 ) {
 
         //
         // LSByte first
         //
-        spi_.write((int) (address & 0xFF));
+        spiWrite((int) (address & 0xFF));
         address >>= 8;
 
     }
 
-    nCS_ = 1;
+    deselect();
 
 }
 
@@ -743,20 +803,20 @@ unsigned long long nRF24L01P::getRxAddress(int pipe) {
 
     unsigned long long address = 0;
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(cn);
+    int status = spiWrite(cn);
 
     for ( int i=0; i<width; i++ ) {
 
         //
         // LSByte first
         //
-        address |= ( ( (unsigned long long)( spi_.write(_NRF24L01P_SPI_CMD_NOP) & 0xFF ) ) << (i*8) );
+        address |= ( ( (unsigned long long)( spiWrite(_NRF24L01P_SPI_CMD_NOP) & 0xFF ) ) << (i*8) );
 
     }
 
-    nCS_ = 1;
+    deselect();
 
     if ( !( ( pipe == NRF24L01P_PIPE_P0 ) || ( pipe == NRF24L01P_PIPE_P1 ) ) ) {
 
@@ -799,20 +859,20 @@ unsigned long long nRF24L01P::getTxAddress(void) {
 
     unsigned long long address = 0;
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(cn);
+    int status = spiWrite(cn);
 
     for ( int i=0; i<width; i++ ) {
 
         //
         // LSByte first
         //
-        address |= ( ( (unsigned long long)( spi_.write(_NRF24L01P_SPI_CMD_NOP) & 0xFF ) ) << (i*8) );
+        address |= ( ( (unsigned long long)( spiWrite(_NRF24L01P_SPI_CMD_NOP) & 0xFF ) ) << (i*8) );
 
     }
 
-    nCS_ = 1;
+    deselect();
 
     return address;
 }
@@ -851,17 +911,17 @@ int nRF24L01P::write(int pipe, char *data, int count) {
     // Clear the Status bit
     setRegister(_NRF24L01P_REG_STATUS, _NRF24L01P_STATUS_TX_DS);
 	
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(_NRF24L01P_SPI_CMD_WR_TX_PAYLOAD);
+    int status = spiWrite(_NRF24L01P_SPI_CMD_WR_TX_PAYLOAD);
 
     for ( int i = 0; i < count; i++ ) {
 
-        spi_.write(*data++);
+        spiWrite(*data++);
 
     }
 
-    nCS_ = 1;
+    deselect();
 
     int originalMode = mode;
     setTransmitMode();
@@ -908,25 +968,25 @@ int nRF24L01P::read(int pipe, char *data, int count) {
 
     if ( readable(pipe) ) {
 
-        nCS_ = 0;
+        select();
 
-        int status = spi_.write(_NRF24L01P_SPI_CMD_R_RX_PL_WID);
+        int status = spiWrite(_NRF24L01P_SPI_CMD_R_RX_PL_WID);
 
-        int rxPayloadWidth = spi_.write(_NRF24L01P_SPI_CMD_NOP);
+        int rxPayloadWidth = spiWrite(_NRF24L01P_SPI_CMD_NOP);
         
-        nCS_ = 1;
+        deselect();
 
         if ( ( rxPayloadWidth < 0 ) || ( rxPayloadWidth > _NRF24L01P_RX_FIFO_SIZE ) ) {
     
             // Received payload error: need to flush the FIFO
 
-            nCS_ = 0;
+            select();
     
-            int status = spi_.write(_NRF24L01P_SPI_CMD_FLUSH_RX);
+            int status = spiWrite(_NRF24L01P_SPI_CMD_FLUSH_RX);
     
-            int rxPayloadWidth = spi_.write(_NRF24L01P_SPI_CMD_NOP);
+            int rxPayloadWidth = spiWrite(_NRF24L01P_SPI_CMD_NOP);
             
-            nCS_ = 1;
+            deselect();
             
             //
             // At this point, we should retry the reception,
@@ -937,17 +997,17 @@ int nRF24L01P::read(int pipe, char *data, int count) {
 
             if ( rxPayloadWidth < count ) count = rxPayloadWidth;
 
-            nCS_ = 0;
+            select();
         
-            int status = spi_.write(_NRF24L01P_SPI_CMD_RD_RX_PAYLOAD);
+            int status = spiWrite(_NRF24L01P_SPI_CMD_RD_RX_PAYLOAD);
         
             for ( int i = 0; i < count; i++ ) {
         
-                *data++ = spi_.write(_NRF24L01P_SPI_CMD_NOP);
+                *data++ = spiWrite(_NRF24L01P_SPI_CMD_NOP);
         
             }
 
-            nCS_ = 1;
+            deselect();
 
             // Clear the Status bit
             setRegister(_NRF24L01P_REG_STATUS, _NRF24L01P_STATUS_RX_DR);
@@ -986,13 +1046,13 @@ void nRF24L01P::setRegister(int regAddress, int regData) {
 
     int cn = (_NRF24L01P_SPI_CMD_WR_REG | (regAddress & _NRF24L01P_REG_ADDRESS_MASK));
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(cn);
+    int status = spiWrite(cn);
 
-    spi_.write(regData & 0xFF);
+    spiWrite(regData & 0xFF);
 
-    nCS_ = 1;
+    deselect();
 
     ce_ = originalCe;
     wait_us( _NRF24L01P_TIMING_Tpece2csn_us );
@@ -1004,13 +1064,13 @@ int nRF24L01P::getRegister(int regAddress) {
 
     int cn = (_NRF24L01P_SPI_CMD_RD_REG | (regAddress & _NRF24L01P_REG_ADDRESS_MASK));
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(cn);
+    int status = spiWrite(cn);
 
-    int dn = spi_.write(_NRF24L01P_SPI_CMD_NOP);
+    int dn = spiWrite(_NRF24L01P_SPI_CMD_NOP);
 
-    nCS_ = 1;
+    deselect();
 
     return dn;
 
@@ -1018,11 +1078,11 @@ int nRF24L01P::getRegister(int regAddress) {
 
 int nRF24L01P::getStatusRegister(void) {
 
-    nCS_ = 0;
+    select();
 
-    int status = spi_.write(_NRF24L01P_SPI_CMD_NOP);
+    int status = spiWrite(_NRF24L01P_SPI_CMD_NOP);
 
-    nCS_ = 1;
+    deselect();
 
     return status;
 
@@ -41,6 +41,7 @@
  * Includes
  */
 #include "mbed.h"
+#include "SPI_Bus.h"
 
 /**
  * Defines
@@ -99,6 +100,32 @@ public:
      */
     nRF24L01P(PinName mosi, PinName miso, PinName sck, PinName csn, PinName ce, PinName irq = NC);
 
+    /**
+     * Constructor on a shared SPI bus.
+     *
+     * The format of the device is set to 8 bits, mode 0, 2 MHz.
+     * The not chip select line is driven by the device.
+     *
+     * @param dev device on a shared SPI bus (with the csn pin).
+     * @param ce mbed pin to use for the chip enable line.
+     * @param irq mbed pin to use for the interrupt request line.
+     */
+    nRF24L01P(SPI_Device *dev, PinName ce, PinName irq = NC);
+
+    /**
+     * Destructor.
+     *
+     * Deletes the SPI interface created by the first constructor.
+     * The device on a shared SPI bus is owned by the caller.
+     */
+    ~nRF24L01P();
+
+    /**
+     * Not copyable : the SPI interface is owned by a single object.
+     */
+    nRF24L01P(const nRF24L01P &) = delete;
+    nRF24L01P &operator=(const nRF24L01P &) = delete;
+
     /**
      * Set the RF frequency.
      *
@@ -337,7 +364,28 @@ private:
      */
     int getStatusRegister(void);
 
-    SPI         spi_;
+    /**
+     * Configuration of the device after the reset (common to both constructors).
+     */
+    void init(void);
+
+    /**
+     * Select the device (takes the shared bus).
+     */
+    void select(void);
+
+    /**
+     * Deselect the device (releases the shared bus).
+     */
+    void deselect(void);
+
+    /**
+     * Write a byte and return the received byte, on the SPI interface or on the shared bus.
+     */
+    int spiWrite(int value);
+
+    SPI         *spi_;
+    SPI_Device  *dev_;
     DigitalOut  nCS_;
     DigitalOut  ce_;
     InterruptIn nIRQ_;